@@ -28,6 +28,13 @@
 	#define GAIA_ECS_CHUNK_ALLOCATOR 1
 #endif
 
+//! If enabled, chunk rows and chunk byte offsets are 32-bit and the chunk allocator provides additional
+//! 128 KiB - 1 MiB block size classes. Archetypes containing a component registered with GAIA_CHUNK_SIZE(Wide)
+//! are placed in these wide chunks. Other archetypes keep using the regular 8 - 64 KiB chunks.
+#ifndef GAIA_ECS_WIDE_CHUNKS
+	#define GAIA_ECS_WIDE_CHUNKS 0
+#endif
+
 //! Hashing algorithm. GAIA_ECS_HASH_FNV1A or GAIA_ECS_HASH_MURMUR2A
 #ifndef GAIA_ECS_HASH
 	#define GAIA_ECS_HASH GAIA_ECS_HASH_MURMUR2A
@@ -38,6 +45,26 @@
 	#define GAIA_USE_PREFETCH 1
 #endif
 
+//! Number of chunks ahead of the one being processed for which dense query runners prefetch the first cache lines
+//! of queried component columns. The chunk header and component records are prefetched one chunk further ahead so
+//! they are likely in cache by the time the columns are looked up. Set to 0 to disable. Requires GAIA_USE_PREFETCH.
+#ifndef GAIA_QUERY_PREFETCH_DISTANCE
+	#define GAIA_QUERY_PREFETCH_DISTANCE 2
+#endif
+
+//! If enabled, the chunk allocator keeps one page pool per NUMA node, archetypes are assigned a home node
+//! and parallel queries prefer running each chunk batch on a worker of the node owning the chunk memory.
+#ifndef GAIA_USE_NUMA
+	#define GAIA_USE_NUMA 0
+#endif
+
+//! If enabled together with GAIA_USE_NUMA, libnuma is used to detect the topology and to bind chunk memory
+//! to nodes explicitly. Requires linking with libnuma. Otherwise, the topology is read from the OS and chunk
+//! memory ends up on the node of the thread touching it first.
+#ifndef GAIA_USE_LIBNUMA
+	#define GAIA_USE_LIBNUMA 0
+#endif
+
 //! If enabled, util::SmallFunc and util::MoveFunc use SmallBlockAllocator for callables too large for their inline buffer.
 //! Disable this to allocate those larger callables with the platform heap.
 #ifndef GAIA_FUNC_WRAPPER_SMALLBLOCK
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -3007,5 +3008,205 @@ namespace gaia {
 		void sort(C& c, TCmpFunc cmpFunc, TSwapFunc swapFunc) {
 			sort(c.begin(), c.end(), cmpFunc, swapFunc);
 		}
+
+		//! Stable bottom-up merge sort.
+		//! Runs of up to 32 elements are insertion-sorted first. The ranges are then merged pairwise,
+		//! ping-ponging between \a beg and \a tmp. The result always ends up in [beg, end).
+		//! \tparam T Element type. Must be cheap to copy.
+		//! \tparam TCmpFunc Functor type for comparison: bool cmpFunc(lhs, rhs)
+		//! \param beg Pointer to first element
+		//! \param end Pointer to one-past-last element
+		//! \param tmp Scratch buffer with room for at least (end - beg) elements
+		//! \param cmpFunc Comparison function. Must return true when \a lhs goes strictly before \a rhs.
+		template <typename T, typename TCmpFunc>
+		void merge_sort(T* beg, T* end, T* tmp, TCmpFunc cmpFunc) {
+			const auto n = (uint32_t)(end - beg);
+			constexpr uint32_t RunSize = 32;
+
+			for (uint32_t from = 0; from < n; from += RunSize) {
+				const auto to = from + RunSize < n ? from + RunSize : n;
+				for (uint32_t i = from + 1; i < to; ++i) {
+					auto value = beg[i];
+					uint32_t j = i;
+					for (; j > from && cmpFunc(value, beg[j - 1]); --j)
+						beg[j] = beg[j - 1];
+					beg[j] = value;
+				}
+			}
+
+			T* pSrc = beg;
+			T* pDst = tmp;
+			for (uint32_t width = RunSize; width < n; width *= 2) {
+				for (uint32_t from = 0; from < n; from += 2 * width) {
+					const auto mid = from + width < n ? from + width : n;
+					const auto to = from + 2 * width < n ? from + 2 * width : n;
+
+					uint32_t l = from;
+					uint32_t r = mid;
+					uint32_t o = from;
+					while (l < mid && r < to)
+						pDst[o++] = cmpFunc(pSrc[r], pSrc[l]) ? pSrc[r++] : pSrc[l++];
+					while (l < mid)
+						pDst[o++] = pSrc[l++];
+					while (r < to)
+						pDst[o++] = pSrc[r++];
+				}
+				core::swap(pSrc, pDst);
+			}
+
+			if (pSrc != beg)
+				memcpy((void*)beg, (const void*)pSrc, n * sizeof(T));
+		}
+
+		//! Converts an arithmetic value into an unsigned key that sorts in the same order as the value.
+		//! Signed integers get their sign bit flipped. Floating-point values get the sign bit flipped when positive
+		//! and all bits flipped when negative, so the IEEE-754 bit patterns sort as unsigned integers.
+		//! \tparam T Integral or floating-point type
+		//! \param value Value to convert
+		//! \return Order-preserving unsigned key of the same width as \a T
+		template <typename T>
+		GAIA_NODISCARD auto radix_key(T value) {
+			static_assert(std::is_arithmetic_v<T>, "radix_key supports only arithmetic types");
+			if constexpr (std::is_same_v<T, bool>) {
+				return (uint8_t)value;
+			} else if constexpr (std::is_floating_point_v<T>) {
+				using TKey = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+				static_assert(sizeof(T) == sizeof(TKey), "Unsupported floating-point type");
+				TKey bits;
+				memcpy(&bits, &value, sizeof(T));
+				constexpr TKey SignBit = (TKey)1 << (sizeof(TKey) * 8 - 1);
+				return (bits & SignBit) != 0 ? (TKey)~bits : (TKey)(bits | SignBit);
+			} else if constexpr (std::is_signed_v<T>) {
+				using TKey = std::make_unsigned_t<T>;
+				constexpr TKey SignBit = (TKey)1 << (sizeof(TKey) * 8 - 1);
+				return (TKey)((TKey)value ^ SignBit);
+			} else {
+				return value;
+			}
+		}
+
+		namespace detail {
+			template <typename T, typename = void>
+			struct radix_key_value {
+				using type = T;
+			};
+			template <typename T>
+			struct radix_key_value<T, std::enable_if_t<std::is_enum_v<T>>> {
+				using type = std::underlying_type_t<T>;
+			};
+
+			//! Appends the radix key of a value to the low bits of a composite key.
+			template <typename T>
+			struct radix_key_packer {
+				using TValue = typename radix_key_value<T>::type;
+				static constexpr uint32_t Bits = (uint32_t)sizeof(decltype(radix_key(TValue{}))) * 8;
+
+				GAIA_NODISCARD static uint64_t pack(uint64_t key, const T& value) {
+					if constexpr (Bits < 64)
+						key <<= Bits;
+					else
+						key = 0;
+					return key | (uint64_t)radix_key((TValue)value);
+				}
+			};
+
+			template <typename... T>
+			struct radix_key_packer<std::tuple<T...>> {
+				static constexpr uint32_t Bits = (radix_key_packer<std::decay_t<T>>::Bits + ... + 0U);
+
+				GAIA_NODISCARD static uint64_t pack(uint64_t key, const std::tuple<T...>& value) {
+					return pack_inter(key, value, std::index_sequence_for<T...>{});
+				}
+
+				template <size_t... Is>
+				GAIA_NODISCARD static uint64_t
+				pack_inter(uint64_t key, const std::tuple<T...>& value, std::index_sequence<Is...> /*no_name*/) {
+					((key = radix_key_packer<std::decay_t<T>>::pack(key, std::get<Is>(value))), ...);
+					return key;
+				}
+			};
+
+			template <typename T0, typename T1>
+			struct radix_key_packer<std::pair<T0, T1>> {
+				using TPacker0 = radix_key_packer<std::decay_t<T0>>;
+				using TPacker1 = radix_key_packer<std::decay_t<T1>>;
+				static constexpr uint32_t Bits = TPacker0::Bits + TPacker1::Bits;
+
+				GAIA_NODISCARD static uint64_t pack(uint64_t key, const std::pair<T0, T1>& value) {
+					return TPacker1::pack(TPacker0::pack(key, value.first), value.second);
+				}
+			};
+		} // namespace detail
+
+		//! Converts an arithmetic or enum value, or a std::tuple / std::pair of them, into a single unsigned key
+		//! that sorts in the same order as the value. Tuple elements are compared lexicographically, so the first
+		//! element ends up in the most significant bits of the key.
+		//! \tparam T Arithmetic, enum, std::tuple or std::pair type. The packed width can't exceed 64 bits.
+		//! \param value Value to convert
+		//! \return Order-preserving 64-bit key
+		template <typename T>
+		GAIA_NODISCARD uint64_t radix_key_pack(const T& value) {
+			using TPacker = detail::radix_key_packer<std::decay_t<T>>;
+			static_assert(TPacker::Bits <= 64, "Composite radix keys are limited to 64 bits");
+			return TPacker::pack(0, value);
+		}
+
+		//! Stable LSD radix sort of unsigned keys carrying a payload.
+		//! One counting pass per key byte is made. Bytes that are the same for all keys are skipped.
+		//! \tparam TKey Unsigned integral key type
+		//! \tparam TValue Payload type moved together with keys
+		//! \param keys Keys to sort
+		//! \param values Payloads aligned with \a keys
+		//! \param keysTmp Scratch buffer with room for \a n keys
+		//! \param valuesTmp Scratch buffer with room for \a n payloads
+		//! \param n Number of elements
+		//! \note The sorted result always ends up in \a keys and \a values.
+		template <typename TKey, typename TValue>
+		void radix_sort(TKey* keys, TValue* values, TKey* keysTmp, TValue* valuesTmp, uint32_t n) {
+			static_assert(std::is_unsigned_v<TKey>, "radix_sort requires unsigned keys. Use radix_key to convert values");
+			if (n < 2)
+				return;
+
+			constexpr uint32_t Passes = sizeof(TKey);
+			uint32_t counts[Passes][256]{};
+			GAIA_FOR(n) {
+				const auto key = keys[i];
+				for (uint32_t p = 0; p < Passes; ++p)
+					++counts[p][(key >> (p * 8)) & 0xFF];
+			}
+
+			TKey* pSrcKeys = keys;
+			TValue* pSrcValues = values;
+			TKey* pDstKeys = keysTmp;
+			TValue* pDstValues = valuesTmp;
+			for (uint32_t p = 0; p < Passes; ++p) {
+				auto& cnt = counts[p];
+				// All keys share this byte, nothing would move
+				if (cnt[(pSrcKeys[0] >> (p * 8)) & 0xFF] == n)
+					continue;
+
+				uint32_t offset = 0;
+				for (auto& c: cnt) {
+					const auto c0 = c;
+					c = offset;
+					offset += c0;
+				}
+
+				GAIA_FOR(n) {
+					const auto key = pSrcKeys[i];
+					const auto dstIdx = cnt[(key >> (p * 8)) & 0xFF]++;
+					pDstKeys[dstIdx] = key;
+					pDstValues[dstIdx] = pSrcValues[i];
+				}
+
+				core::swap(pSrcKeys, pDstKeys);
+				core::swap(pSrcValues, pDstValues);
+			}
+
+			if (pSrcKeys != keys) {
+				memcpy((void*)keys, (const void*)pSrcKeys, n * sizeof(TKey));
+				memcpy((void*)values, (const void*)pSrcValues, n * sizeof(TValue));
+			}
+		}
 	} // namespace core
 } // namespace gaia
@@ -57,6 +57,35 @@ namespace gaia {
 			}
 		};
 
+		//! Occupancy distribution of the chunks of an archetype
+		struct ChunkFillHistogram {
+			//! Number of fill ratio buckets
+			static constexpr uint32_t Buckets = 8;
+
+			//! Number of partially filled chunks per bucket. Bucket i holds chunks filled to [i/Buckets, (i+1)/Buckets).
+			uint32_t chunks[Buckets];
+			//! Number of full chunks
+			uint32_t full;
+			//! Number of entities stored in the counted chunks
+			uint32_t entities;
+
+			//! Returns the bucket a chunk of a given occupancy falls into
+			//! \param size Number of entities in the chunk
+			//! \param capacity Capacity of the chunk
+			//! \return Bucket index smaller than Buckets.
+			GAIA_NODISCARD static uint32_t bucket(uint32_t size, uint32_t capacity) {
+				GAIA_ASSERT(size < capacity);
+				return size * Buckets / capacity;
+			}
+
+			//! Returns the number of counted chunks
+			GAIA_NODISCARD uint32_t chunk_cnt() const {
+				uint32_t cnt = full;
+				GAIA_FOR(Buckets) cnt += chunks[i];
+				return cnt;
+			}
+		};
+
 		class ArchetypeBase {
 		protected:
 			//! Archetype ID - used to address the archetype directly in the world's list or archetypes
@@ -95,13 +124,23 @@ namespace gaia {
 
 			struct Properties {
 				//! The number of data entities this archetype can take (e.g 5 = 5 entities with all their components)
-				uint16_t capacity;
+				ChunkRow capacity;
 				//! How many bytes of data is needed for a fully utilized chunk
 				ChunkDataOffset chunkDataBytes;
 				//! The number of generic entities/components
 				uint8_t genEntities;
 				//! Total number of entities/components
 				uint8_t cntEntities;
+				//! NUMA node chunks of this archetype are placed on
+				uint8_t numaNode;
+				//! The number of entities a tiny chunk of this archetype can take. Zero if tiny chunks are not used.
+				ChunkRow tinyCapacity;
+				//! How many bytes of data is needed for a fully utilized tiny chunk
+				ChunkDataOffset tinyChunkDataBytes;
+				//! Offset of dirty row bitsets in a regular chunk. Zero if no component tracks changes per row.
+				ChunkDataOffset dirtyRowsOffset;
+				//! Offset of dirty row bitsets in a tiny chunk. Zero if no component tracks changes per row.
+				ChunkDataOffset tinyDirtyRowsOffset;
 			};
 
 		private:
@@ -128,6 +167,8 @@ namespace gaia {
 				const ComponentCacheItem* compItems[ChunkHeader::MAX_COMPONENTS]{};
 				//! Array of components offset indices
 				ChunkDataOffset compOffs[ChunkHeader::MAX_COMPONENTS];
+				//! Array of components offset indices used by tiny chunks
+				ChunkDataOffset tinyCompOffs[ChunkHeader::MAX_COMPONENTS];
 			};
 
 			struct StorageData {
@@ -135,6 +176,8 @@ namespace gaia {
 				cnt::darray<Chunk*> chunks;
 				//! Index of the first chunk with enough space to add at least one entity
 				uint32_t firstFreeChunkIdx = 0;
+				//! Number of tiny chunks in the chunk array
+				uint32_t tinyChunks = 0;
 			};
 
 			struct RuntimeData {
@@ -147,12 +190,14 @@ namespace gaia {
 				uint32_t deleteReq : 1;
 				//! If set the archetype is to be deleted
 				uint32_t dead : 1;
+				//! If set the archetype waits for its chunks to be resized
+				uint32_t resizeQueued : 1;
 				//! Max lifespan of the archetype
 				uint32_t lifespanCountdownMax : ARCHETYPE_LIFESPAN_BITS;
 				//! Remaining lifespan of the archetype
 				uint32_t lifespanCountdown : ARCHETYPE_LIFESPAN_BITS;
 
-				RuntimeData(): deleteReq(0), dead(0), lifespanCountdownMax(1), lifespanCountdown(0) {}
+				RuntimeData(): deleteReq(0), dead(0), resizeQueued(0), lifespanCountdownMax(1), lifespanCountdown(0) {}
 			};
 
 			struct EdgeData {
@@ -404,7 +449,8 @@ namespace gaia {
 					uint32_t offs, const ComponentCacheItem* const* pItems, uint32_t cnt, uint32_t cap, uint32_t maxDataOffset) {
 				GAIA_FOR(cnt) {
 					const auto comp = comp_from_item(pItems[i]);
-					if (!component_uses_table_storage(comp))
+					// Cold components live in side blocks and do not take any space in the chunk
+					if (!component_uses_table_storage(comp) || component_uses_cold_storage(comp))
 						continue;
 
 					const auto* pItem = pItems[i];
@@ -420,19 +466,14 @@ namespace gaia {
 			}
 
 			static void reg_components(
-					Archetype& arch, EntitySpan ids, const ComponentCacheItem* const* pItems, uint8_t from, uint8_t to,
-					uint32_t& currOff, uint32_t count) {
-				auto& ofs = arch.m_shape.compOffs;
-
-				// Set component ids
-				GAIA_FOR2(from, to) arch.m_shape.ids[i] = ids[i];
-
+					ChunkDataOffset* ofs, const ComponentCacheItem* const* pItems, uint8_t from, uint8_t to, uint32_t& currOff,
+					uint32_t count) {
 				// Calculate offsets and assign them indices according to our mappings
 				GAIA_FOR2(from, to) {
 					const auto comp = comp_from_item(pItems[i]);
 					const auto compIdx = i;
 
-					if (!component_uses_table_storage(comp)) {
+					if (!component_uses_table_storage(comp) || component_uses_cold_storage(comp)) {
 						ofs[compIdx] = {};
 					} else {
 						const auto alig = comp.alig();
@@ -444,6 +485,47 @@ namespace gaia {
 				}
 			}
 
+			//! Reserves space for dirty row bitsets of components tracking changes per row.
+			//! \param currOff Current byte offset inside the chunk payload. Moved past the reserved space.
+			//! \param cnt Number of components tracking changes per row
+			//! \param capacity Number of rows of the chunk
+			//! \return Offset of the first bitset. Zero if \a cnt is zero.
+			static ChunkDataOffset reg_dirty_rows(uint32_t& currOff, uint32_t cnt, uint32_t capacity) {
+				if (cnt == 0)
+					return {};
+
+				currOff = mem::align(currOff, alignof(uint64_t));
+				const auto offset = currOff;
+				currOff += cnt * Chunk::dirty_rows_bytes(capacity);
+				return (ChunkDataOffset)offset;
+			}
+
+			//! Rounds \a capacity down to a multiple of ChunkHeader::SIMD_ROW_GRANULE, or to a power of two if it is
+			//! smaller than that. Vectors of up to that many rows then never cross the end of a column.
+			//! \param capacity Number of rows the chunk could hold
+			//! \return Number of rows the chunk is going to hold.
+			GAIA_NODISCARD static uint32_t simd_padded_capacity(uint32_t capacity) {
+				constexpr uint32_t Granule = ChunkHeader::SIMD_ROW_GRANULE;
+				if (capacity >= Granule)
+					return capacity - (capacity % Granule);
+				return capacity == 0 ? 0 : core::closest_pow2(capacity);
+			}
+
+			//! Allocates a new chunk of the archetype.
+			//! \param chunkIdx Index of the chunk in the chunk array
+			//! \param tiny If true, the chunk uses the tiny layout. Otherwise, the regular layout is used.
+			//! \return The new chunk.
+			Chunk* create_chunk(uint32_t chunkIdx, bool tiny) {
+				const auto& p = m_shape.properties;
+				return Chunk::create(
+						m_world, m_cc, chunkIdx, p.numaNode, //
+						tiny ? p.tinyCapacity : p.capacity, p.cntEntities, p.genEntities, //
+						tiny ? p.tinyChunkDataBytes : p.chunkDataBytes, //
+						m_worldVersion, m_shape.dataOffsets, m_shape.ids, m_shape.compItems,
+						tiny ? m_shape.tinyCompOffs : m_shape.compOffs, //
+						tiny ? p.tinyDirtyRowsOffset : p.dirtyRowsOffset);
+			}
+
 		public:
 			Archetype(Archetype&&) = delete;
 			Archetype(const Archetype&) = delete;
@@ -474,13 +556,12 @@ namespace gaia {
 					s.load(chunkIdx);
 
 					auto* pChunk = m_storage.chunks[chunkIdx];
+					// Serialized chunks are always loaded into regular chunks because the saved data might
+					// not fit a tiny one. The world gets rid of tiny chunks before loading.
+					GAIA_ASSERT(pChunk == nullptr || !is_tiny(*pChunk));
 					// If the chunk doesn't exist it means it's not a part of the initial setup.
 					if (pChunk == nullptr) {
-						pChunk = Chunk::create(
-								m_world, m_cc, chunkIdx, //
-								m_shape.properties.capacity, m_shape.properties.cntEntities, //
-								m_shape.properties.genEntities, m_shape.properties.chunkDataBytes, //
-								m_worldVersion, m_shape.dataOffsets, m_shape.ids, m_shape.compItems, m_shape.compOffs);
+						pChunk = create_chunk(chunkIdx, false);
 						m_storage.chunks[chunkIdx] = pChunk;
 					}
 
@@ -501,8 +582,15 @@ namespace gaia {
 				return detail::cmp_comps(ids_view(), other.m_comps);
 			}
 
-			GAIA_NODISCARD static Archetype*
-			create(const World& world, ArchetypeId archetypeId, uint32_t& worldVersion, EntitySpan ids) {
+			//! Creates a new archetype.
+			//! \param world World the archetype belongs to
+			//! \param archetypeId Id of the archetype
+			//! \param worldVersion World version
+			//! \param ids Entities/components the archetype is made of
+			//! \param tinyChunks If true, the first chunk of the archetype is tiny when its layout allows it
+			//! \return New archetype.
+			GAIA_NODISCARD static Archetype* create(
+					const World& world, ArchetypeId archetypeId, uint32_t& worldVersion, EntitySpan ids, bool tinyChunks) {
 				const auto& cc = comp_cache(world);
 
 				auto* newArch = mem::AllocHelper::alloc<Archetype>("Archetype");
@@ -519,6 +607,14 @@ namespace gaia {
 				const auto cnt = (uint32_t)ids.size();
 				newArch->m_shape.properties.cntEntities = (uint8_t)ids.size();
 
+#if GAIA_USE_NUMA
+				// When memory can be bound to nodes, archetypes are spread over nodes evenly.
+				// Otherwise, chunks end up where the creating thread touches them first.
+				newArch->m_shape.properties.numaNode = mt::numa_can_bind_memory()
+																									 ? (uint8_t)(archetypeId % mt::numa_node_cnt())
+																									 : (uint8_t)mt::numa_curr_node();
+#endif
+
 				auto compItems = std::span(&newArch->m_shape.compItems[0], cnt);
 				GAIA_FOR(cnt) compItems[i] = ids[i].pair() ? cc.find_pair_payload(ids[i]) : cc.find(ids[i]);
 
@@ -547,9 +643,22 @@ namespace gaia {
 
 				uint32_t genCompsSize = 0;
 				uint32_t uniCompsSize = 0;
-				GAIA_FOR(entsGeneric) genCompsSize += comp_from_item(newArch->m_shape.compItems[i]).size();
+				GAIA_FOR(entsGeneric) {
+					// Cold components do not affect the chunk capacity
+					const auto comp = comp_from_item(newArch->m_shape.compItems[i]);
+					if (!component_uses_cold_storage(comp))
+						genCompsSize += comp.size();
+				}
 				GAIA_FOR2(entsGeneric, cnt) uniCompsSize += comp_from_item(newArch->m_shape.compItems[i]).size();
 
+				// Components tracking changes per row need a dirty bitset in each chunk
+				uint32_t dirtyRowsCnt = 0;
+				GAIA_FOR(entsGeneric) {
+					const auto* pItem = newArch->m_shape.compItems[i];
+					if (Chunk::tracks_dirty_rows(pItem))
+						++dirtyRowsCnt;
+				}
+
 				auto compute_max_entities_for_chunk = [&](uint32_t maxEntities, uint32_t dataLimit) -> uint32_t {
 					uint32_t low = 1;
 					uint32_t high = maxEntities;
@@ -559,10 +668,19 @@ namespace gaia {
 					auto try_fit = [&](uint32_t count) -> bool {
 						const uint32_t currOff = offs.firstByte_EntityData + (count * sizeof(Entity));
 
-						if (!est_max_entities_per_chunk(currOff, newArch->m_shape.compItems, entsGeneric, count, dataLimit))
+						// Dirty row bitsets are placed after all component data
+						uint32_t limit = dataLimit;
+						if (dirtyRowsCnt != 0) {
+							const uint32_t dirtyRowsBytes = alignof(uint64_t) + dirtyRowsCnt * Chunk::dirty_rows_bytes(count);
+							if (dirtyRowsBytes >= limit)
+								return false;
+							limit -= dirtyRowsBytes;
+						}
+
+						if (!est_max_entities_per_chunk(currOff, newArch->m_shape.compItems, entsGeneric, count, limit))
 							return false;
 						if (!est_max_entities_per_chunk(
-										currOff, newArch->m_shape.compItems + entsGeneric, cnt - entsGeneric, 1, dataLimit))
+										currOff, newArch->m_shape.compItems + entsGeneric, cnt - entsGeneric, 1, limit))
 							return false;
 
 						return true;
@@ -600,34 +718,90 @@ namespace gaia {
 					return compute_max_entities_for_chunk(maxEntities > 0 ? maxEntities : 1, dataLimit);
 				};
 
+				// Archetypes with any generic component asking for wide chunks are placed in the wide size classes
+				bool wideChunks = false;
+#if GAIA_ECS_WIDE_CHUNKS
+				GAIA_FOR(entsGeneric) {
+					const auto* pItem = newArch->m_shape.compItems[i];
+					if (pItem != nullptr && pItem->chunkSize == ChunkSizeHint::Wide) {
+						wideChunks = true;
+						break;
+					}
+				}
+#endif
+
 				if (archetypeId == 0) {
 					// Keep the root archetype compact enough to avoid growing the maximum row snapshot used by iterators.
 					maxGenItemsInArchetype = compute_max_entities_for_size_type(2);
-				} else {
-					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType) {
+				} else if (!wideChunks) {
+					for (uint32_t sizeType = 0; sizeType < RegularMemoryBlockSizeClasses; ++sizeType) {
 						maxGenItemsInArchetype = compute_max_entities_for_size_type(sizeType);
 						if (maxGenItemsInArchetype >= MinEntitiesPerChunk)
 							break;
 					}
 				}
+#if GAIA_ECS_WIDE_CHUNKS
+				else {
+					// Wide chunks exist to cut the number of chunk boundaries. Start at the smallest wide class and only
+					// upsize until the chunk holds more rows than 16-bit rows could address.
+					constexpr uint32_t MinEntitiesPerWideChunk = 65536;
+					for (uint32_t sizeType = RegularMemoryBlockSizeClasses; sizeType < MemoryBlockSizeClasses; ++sizeType) {
+						maxGenItemsInArchetype = compute_max_entities_for_size_type(sizeType);
+						if (maxGenItemsInArchetype >= MinEntitiesPerWideChunk)
+							break;
+					}
+				}
+#endif
 
 				// MAX_CHUNK_ENTITIES is intentionally based on the 32 KiB class to keep iterator snapshots bounded.
 				// Wide archetypes can still use the 64 KiB-class blocks because their row count stays below this cap.
-				if (maxGenItemsInArchetype > ChunkHeader::MAX_CHUNK_ENTITIES)
-					maxGenItemsInArchetype = ChunkHeader::MAX_CHUNK_ENTITIES;
+				// Wide chunks are bounded by the largest wide class instead.
+				uint32_t maxChunkEntities = ChunkHeader::MAX_CHUNK_ENTITIES;
+#if GAIA_ECS_WIDE_CHUNKS
+				if (wideChunks)
+					maxChunkEntities = ChunkHeader::MAX_WIDE_CHUNK_ENTITIES;
+#endif
+				if (maxGenItemsInArchetype > maxChunkEntities)
+					maxGenItemsInArchetype = maxChunkEntities;
+				maxGenItemsInArchetype = simd_padded_capacity(maxGenItemsInArchetype);
+
+				// Set component ids
+				GAIA_FOR(cnt) newArch->m_shape.ids[i] = ids[i];
 
 				// Update the offsets according to the recalculated maxGenItemsInArchetype
 				auto currOff = offs.firstByte_EntityData + ((uint32_t)sizeof(Entity) * maxGenItemsInArchetype);
 				reg_components(
-						*newArch, ids, newArch->m_shape.compItems, (uint8_t)0, (uint8_t)entsGeneric, currOff,
+						newArch->m_shape.compOffs, newArch->m_shape.compItems, (uint8_t)0, (uint8_t)entsGeneric, currOff,
 						maxGenItemsInArchetype);
 				reg_components(
-						*newArch, ids, newArch->m_shape.compItems, (uint8_t)entsGeneric, (uint8_t)ids.size(), currOff, 1);
+						newArch->m_shape.compOffs, newArch->m_shape.compItems, (uint8_t)entsGeneric, (uint8_t)cnt, currOff, 1);
+				newArch->m_shape.properties.dirtyRowsOffset = reg_dirty_rows(currOff, dirtyRowsCnt, maxGenItemsInArchetype);
 
-				newArch->m_shape.properties.capacity = (uint16_t)maxGenItemsInArchetype;
+				newArch->m_shape.properties.capacity = (ChunkRow)maxGenItemsInArchetype;
 				newArch->m_shape.properties.chunkDataBytes = (ChunkDataOffset)currOff;
 				newArch->m_shape.properties.genEntities = (uint8_t)entsGeneric;
 
+				// The first chunk of a sparsely populated archetype is tiny. Most archetypes only ever hold a few
+				// entities and a full-sized chunk would be mostly empty. Archetypes with unique components are
+				// excluded because their chunks can't be merged freely.
+				constexpr uint32_t MinEntitiesPerTinyChunk = ChunkHeader::SIMD_ROW_GRANULE;
+				const uint32_t tinyDataLimit = Chunk::chunk_data_bytes(TinyMemoryBlockSize);
+				if (tinyChunks && archetypeId != 0 && !wideChunks && entsGeneric == cnt &&
+						tinyDataLimit > offs.firstByte_EntityData + MinEntitiesPerTinyChunk * sizeof(Entity)) {
+					const uint32_t tinyGenItems =
+							simd_padded_capacity(compute_max_entities_for_size_type(TinyMemoryBlockSizeType));
+					if (tinyGenItems >= MinEntitiesPerTinyChunk && tinyGenItems < maxGenItemsInArchetype) {
+						currOff = offs.firstByte_EntityData + ((uint32_t)sizeof(Entity) * tinyGenItems);
+						reg_components(
+								newArch->m_shape.tinyCompOffs, newArch->m_shape.compItems, (uint8_t)0, (uint8_t)cnt, currOff,
+								tinyGenItems);
+						newArch->m_shape.properties.tinyDirtyRowsOffset = reg_dirty_rows(currOff, dirtyRowsCnt, tinyGenItems);
+
+						newArch->m_shape.properties.tinyCapacity = (ChunkRow)tinyGenItems;
+						newArch->m_shape.properties.tinyChunkDataBytes = (ChunkDataOffset)currOff;
+					}
+				}
+
 				return newArch;
 			}
 
@@ -656,7 +830,7 @@ namespace gaia {
 			//! \param row Row of the entity
 			//! \param enableEntity Enables the entity
 			//! \param recs Entity containers
-			void enable_entity(Chunk* pChunk, uint16_t row, bool enableEntity, EntityContainers& recs) {
+			void enable_entity(Chunk* pChunk, ChunkRow row, bool enableEntity, EntityContainers& recs) {
 				pChunk->enable_entity(row, enableEntity, recs);
 				// m_disabledMask.set(pChunk->idx(), enableEntity ? true : pChunk->has_disabled_entities());
 			}
@@ -677,6 +851,12 @@ namespace gaia {
 				// index with the current chunk's index and then do the swapping.
 				m_storage.chunks.back()->set_idx(chunkIndex);
 				core::swap_erase(m_storage.chunks, chunkIndex);
+				if (is_tiny(*pChunk))
+					--m_storage.tinyChunks;
+
+				// The last chunk took the place of the removed one and might have some space left
+				if (m_storage.firstFreeChunkIdx > chunkIndex)
+					m_storage.firstFreeChunkIdx = chunkIndex;
 
 				// Delete the chunk now. Otherwise, if the chunk happened to be the last
 				// one we would end up overriding released memory.
@@ -705,17 +885,78 @@ namespace gaia {
 				GAIA_ASSERT(chunkCnt < UINT32_MAX);
 
 				// No free space found anywhere. Let's create a new chunk.
-				auto* pChunk = Chunk::create(
-						m_world, m_cc, chunkCnt, //
-						m_shape.properties.capacity, m_shape.properties.cntEntities, //
-						m_shape.properties.genEntities, m_shape.properties.chunkDataBytes, //
-						m_worldVersion, m_shape.dataOffsets, m_shape.ids, m_shape.compItems, m_shape.compOffs);
+				// The first chunk of the archetype is tiny if the archetype supports it.
+				auto* pChunk = add_chunk(chunkCnt == 0 && has_tiny_chunks());
+				m_storage.firstFreeChunkIdx = chunkCnt;
+				return pChunk;
+			}
 
-				m_storage.firstFreeChunkIdx = m_storage.chunks.size();
+			//! Creates a new chunk and appends it to the list of chunks managed by the archetype.
+			//! \param tiny If true, a tiny chunk is created. Otherwise, a regular chunk is created.
+			//! \return The new chunk.
+			//! \warning The index of the first free chunk is not updated.
+			Chunk* add_chunk(bool tiny) {
+				auto* pChunk = create_chunk((uint32_t)m_storage.chunks.size(), tiny);
 				m_storage.chunks.push_back(pChunk);
+				if (tiny)
+					++m_storage.tinyChunks;
 				return pChunk;
 			}
 
+			//! Returns true if the archetype places its first entities into a tiny chunk
+			GAIA_NODISCARD bool has_tiny_chunks() const {
+				return m_shape.properties.tinyCapacity != 0;
+			}
+
+			//! Returns true if  chunk is a tiny chunk
+			GAIA_NODISCARD bool is_tiny(const Chunk& chunk) const {
+				return has_tiny_chunks() && chunk.capacity() == m_shape.properties.tinyCapacity;
+			}
+
+			//! Returns the number of tiny chunks in the chunk array
+			GAIA_NODISCARD uint32_t tiny_chunk_cnt() const {
+				return m_storage.tinyChunks;
+			}
+
+			//! Returns true if the archetype outgrew its tiny chunk and the tiny chunk should be merged
+			//! into regular chunks.
+			GAIA_NODISCARD bool needs_promotion() const {
+				return m_storage.tinyChunks != 0 && m_storage.chunks.size() > 1;
+			}
+
+			//! Returns true if the archetype shrank so much its only regular chunk should be replaced
+			//! with a tiny one. Half of the tiny capacity is used as a threshold so the archetype does not
+			//! switch back and forth when the population oscillates.
+			GAIA_NODISCARD bool needs_demotion() const {
+				if (!has_tiny_chunks() || m_storage.tinyChunks != 0 || m_storage.chunks.size() != 1)
+					return false;
+
+				const uint32_t size = m_storage.chunks[0]->size();
+				return size != 0 && size <= (uint32_t)m_shape.properties.tinyCapacity / 2;
+			}
+
+			//! Marks the archetype as waiting for its chunks to be resized
+			void resize_queued(bool value) {
+				m_runtime.resizeQueued = value;
+			}
+
+			//! Returns true if the archetype is waiting for its chunks to be resized
+			GAIA_NODISCARD bool resize_queued() const {
+				return m_runtime.resizeQueued;
+			}
+
+			//! Returns the size of the memory block allocated for  chunk in bytes
+			GAIA_NODISCARD uint32_t chunk_block_bytes(const Chunk& chunk) const {
+				const auto dataBytes =
+						is_tiny(chunk) ? m_shape.properties.tinyChunkDataBytes : m_shape.properties.chunkDataBytes;
+				return mem_block_size(mem_block_size_type(Chunk::chunk_total_bytes(dataBytes)));
+			}
+
+			//! Makes the next search for a chunk with space left start at the first chunk
+			void reset_free_chunk_idx() {
+				m_storage.firstFreeChunkIdx = 0;
+			}
+
 			//! Tries to update the index of the first chunk that has space left
 			//! for at least one entity.
 			//! \warning Always use in tandem with foc_free_chunk()
@@ -752,7 +993,7 @@ namespace gaia {
 			//! \param chunk Chunk to remove the entity from
 			//! \param row Row of the entity
 			//! \param recs Entity containers
-			void remove_entity_raw(Chunk& chunk, uint16_t row, EntityContainers& recs) {
+			void remove_entity_raw(Chunk& chunk, ChunkRow row, EntityContainers& recs) {
 				chunk.remove_entity(row, recs);
 				try_update_free_chunk_idx(chunk);
 			}
@@ -761,7 +1002,7 @@ namespace gaia {
 			//! \param chunk Chunk to remove the entity from
 			//! \param row Row of the entity
 			//! \param recs Entity containers
-			void remove_entity(Chunk& chunk, uint16_t row, EntityContainers& recs) {
+			void remove_entity(Chunk& chunk, ChunkRow row, EntityContainers& recs) {
 				remove_entity_raw(chunk, row, recs);
 				chunk.update_versions();
 			}
@@ -770,10 +1011,38 @@ namespace gaia {
 				return m_shape.properties;
 			}
 
+			//! Returns offsets of the parts of the chunk data area shared by all chunks of the archetype
+			GAIA_NODISCARD const ChunkDataOffsets& data_offsets() const {
+				return m_shape.dataOffsets;
+			}
+
+			//! Returns the NUMA node chunks of the archetype are placed on
+			GAIA_NODISCARD uint32_t numa_node() const {
+				return m_shape.properties.numaNode;
+			}
+
 			GAIA_NODISCARD const cnt::darray<Chunk*>& chunks() const {
 				return m_storage.chunks;
 			}
 
+			//! Calculates the occupancy distribution of the archetype's chunks.
+			//! Empty chunks are not counted because they are already waiting for deletion.
+			GAIA_NODISCARD ChunkFillHistogram fill_histogram() const {
+				ChunkFillHistogram hist{};
+				for (const auto* pChunk: m_storage.chunks) {
+					const uint32_t size = pChunk->size();
+					if (size == 0)
+						continue;
+
+					hist.entities += size;
+					if (pChunk->full())
+						++hist.full;
+					else
+						++hist.chunks[ChunkFillHistogram::bucket(size, pChunk->capacity())];
+				}
+				return hist;
+			}
+
 			GAIA_NODISCARD LookupHash lookup_hash() const {
 				return m_shape.hashLookup;
 			}
@@ -861,196 +1130,326 @@ namespace gaia {
 
 			//----------------------------------------------------------------------
 
-			//! Given a flat index, returns an entity at that index.
-			//! E.g., if there are 2 chunks, the first one with 10 entities and the second one with 5,
-			//! flat index of 12 means the second entity inside the second chunk.
-			//! \param flatIdx Flat index of entity inside the archetype
-			//! \return Entity at given flat index
+			//! Row of an entity taking part in sort_entities().
+			struct SortRowRef {
+				Chunk* pChunk;
+				ChunkRow row;
+			};
+
+			//! Scratch buffers used by one sort_entities() call.
+			struct SortScratch {
+				//! Rows in their current flat order.
+				cnt::darray<SortRowRef> rows;
+				//! Pointers to the sorted data of each row. Used by comparator sorts.
+				cnt::darray<const void*> keyPtrs;
+				//! Flat row indices. After sorting, order[i] is the row that belongs to position i.
+				cnt::darray<uint32_t> order;
+				//! Merge/radix scratch for \a order.
+				cnt::darray<uint32_t> orderTmp;
+				//! Entities in sorted order.
+				cnt::darray<Entity> entities;
+				//! Values of one column in sorted order.
+				cnt::darray<uint8_t> bytes;
+				//! Dirty row flags of one column in sorted order. Visited flags when swapping along cycles.
+				cnt::darray<uint8_t> dirty;
+			};
+
+			//! Collects rows of enabled or disabled entities in flat archetype order.
+			//! Disabled entities are stored at the front of each chunk, enabled ones after them.
+			//! \tparam Enabled True to collect enabled rows, false to collect disabled rows
+			//! \param[out] rows Receives the rows
 			template <bool Enabled>
-			Entity get_flat_entity(size_t flatIdx) const {
-				size_t offset = 0;
-				for (const auto* pChunk: chunks()) {
-					if (pChunk->empty())
-						continue;
+			void sort_collect_rows(cnt::darray<SortRowRef>& rows) const {
+				rows.clear();
+				for (auto* pChunk: m_storage.chunks) {
+					const auto from = Enabled ? (ChunkRow)pChunk->size_disabled() : (ChunkRow)0;
+					const auto to = Enabled ? (ChunkRow)pChunk->size() : (ChunkRow)pChunk->size_disabled();
+					for (auto row = from; row < to; ++row)
+						rows.push_back({pChunk, row});
+				}
+			}
 
-					uint32_t cnt = 0;
-					if constexpr (Enabled) {
-						cnt = pChunk->size_enabled();
-					} else {
-						cnt = pChunk->size_disabled();
-					}
+			//! Returns a pointer to the data a row is sorted by.
+			//! \param ref Row reference
+			//! \param compIdx Component index, or BadIndex when sorting by the entity itself
+			//! \return Pointer to the component data or to the entity of the row
+			GAIA_NODISCARD static const void* sort_key_ptr(const SortRowRef& ref, uint32_t compIdx) {
+				if (compIdx == BadIndex)
+					return &ref.pChunk->entity_view()[ref.row];
+				return ref.pChunk->comp_ptr(compIdx, ref.row);
+			}
+
+			//! Moves whole rows so the row found at rows[order[i]] ends up at rows[i].
+			//! Each column is gathered into a scratch buffer in sorted order and written back sequentially, so all
+			//! reads of a pass are independent of each other. AoS values are move-constructed into the buffer and
+			//! move-assigned back. SoA columns replay the swaps of a single cycle-following pass instead.
+			//! Entity records are updated once per moved row.
+			//! \param rows Rows in their flat order before sorting
+			//! \param order Sorted permutation
+			//! \param scratch Scratch buffers
+			void sort_apply_permutation(
+					const cnt::darray<SortRowRef>& rows, const cnt::darray<uint32_t>& order, SortScratch& scratch) {
+				const auto n = (uint32_t)order.size();
+				uint32_t firstMoved = 0;
+				while (firstMoved < n && order[firstMoved] == firstMoved)
+					++firstMoved;
+				if (firstMoved == n)
+					return;
 
-					if (flatIdx < offset + cnt) {
-						if constexpr (Enabled) {
-							const auto idx = (uint32_t)(flatIdx - offset) + pChunk->size_disabled();
-							return pChunk->entity_view()[idx];
-						} else {
-							const auto idx = (uint32_t)(flatIdx - offset);
-							return pChunk->entity_view()[idx];
-						}
-					}
+				auto& world = const_cast<World&>(m_world);
+				const auto cnt = n - firstMoved;
 
-					offset += cnt;
+				// Entities
+				auto& entities = scratch.entities;
+				entities.resize(cnt);
+				for (uint32_t i = firstMoved; i < n; ++i) {
+					const auto& ref = rows[order[i]];
+					entities[i - firstMoved] = ref.pChunk->entity_view()[ref.row];
 				}
+				for (uint32_t i = firstMoved; i < n; ++i) {
+					if (order[i] == i)
+						continue;
 
-				GAIA_ASSERT(false);
-				return EntityBad;
-			}
+					const auto& ref = rows[i];
+					const auto entity = entities[i - firstMoved];
+					ref.pChunk->place_entity(ref.row, entity, fetch_mut(world, entity));
+				}
 
-			//! Given a flat index, returns pointer to component data at that index.
-			//! E.g., if there are 2 chunks, the first one with 10 entities and the second one with 5,
-			//! flat index of 12 means component data for the second entity inside the second chunk.
-			//! \param compIdx Component index we are searching for
-			//! \param flatIdx Flat index of entity inside the archetype
-			//! \param[out] outEntity Entity belonging to the flatIdx
-			//! \return Pointer to component data at given flat index
-			template <bool Enabled>
-			const void* get_flat_comp_ptr(uint32_t compIdx, size_t flatIdx, Entity& outEntity) const {
-				size_t offset = 0;
-				for (const auto* pChunk: chunks()) {
-					if (pChunk->empty())
+				// Component data
+				const auto* pFirstChunk = rows[0].pChunk;
+				const auto recs = pFirstChunk->comp_rec_view();
+				GAIA_FOR_(pFirstChunk->size_generic(), j) {
+					const auto& rec = recs[j];
+					if (!component_uses_table_storage(rec.comp) || rec.comp.size() == 0)
 						continue;
 
-					uint32_t cnt = 0;
-					if constexpr (Enabled) {
-						cnt = pChunk->size_enabled();
+					const auto* pItem = rec.pItem;
+					if (rec.comp.soa() != 0) {
+						sort_swap_rows(rows, order, firstMoved, scratch, *pItem, j);
 					} else {
-						cnt = pChunk->size_disabled();
+						const auto size = rec.comp.size();
+						const auto alig = rec.comp.alig();
+						auto& bytes = scratch.bytes;
+						bytes.resize(cnt * size + alig);
+						auto* pTmp = (uint8_t*)(((uintptr_t)bytes.data() + alig - 1) & ~(uintptr_t)(alig - 1));
+
+						for (uint32_t i = firstMoved; i < n; ++i) {
+							const auto& ref = rows[order[i]];
+							pItem->ctor_move(
+									pTmp, ref.pChunk->comp_ptr_mut(j), i - firstMoved, ref.row, cnt, ref.pChunk->capacity());
+						}
+						for (uint32_t i = firstMoved; i < n; ++i) {
+							const auto& ref = rows[i];
+							pItem->move(ref.pChunk->comp_ptr_mut(j), pTmp, ref.row, i - firstMoved, ref.pChunk->capacity(), cnt);
+						}
+						pItem->dtor_n(pTmp, cnt);
 					}
 
-					if (flatIdx < offset + cnt) {
-						if constexpr (Enabled) {
-							const auto idx = (uint32_t)(flatIdx - offset) + pChunk->size_disabled();
-							const auto* pData = pChunk->comp_ptr(compIdx, idx);
-							outEntity = pChunk->entity_view()[idx];
-							return pData;
-						} else {
-							const auto idx = (uint32_t)(flatIdx - offset);
-							const auto* pData = pChunk->comp_ptr(compIdx, idx);
-							outEntity = pChunk->entity_view()[idx];
-							return pData;
+					if (pFirstChunk->tracks_dirty_rows(j)) {
+						auto& dirty = scratch.dirty;
+						dirty.resize(cnt);
+						for (uint32_t i = firstMoved; i < n; ++i) {
+							const auto& ref = rows[order[i]];
+							dirty[i - firstMoved] = ref.pChunk->dirty_row(j, ref.row) ? 1 : 0;
+						}
+						for (uint32_t i = firstMoved; i < n; ++i) {
+							const auto& ref = rows[i];
+							ref.pChunk->set_dirty_row(j, ref.row, dirty[i - firstMoved] != 0);
 						}
 					}
-
-					offset += cnt;
 				}
+			}
+
+			//! Applies the permutation to a single column by swapping values along the cycles of \a order.
+			//! A cycle of length L costs L-1 swaps. Used for SoA columns which can not be staged value by value.
+			//! \param rows Rows in their flat order before sorting
+			//! \param order Sorted permutation
+			//! \param firstMoved Index of the first row that moves
+			//! \param scratch Scratch buffers
+			//! \param item Component of the column
+			//! \param compIdx Column index
+			static void sort_swap_rows(
+					const cnt::darray<SortRowRef>& rows, const cnt::darray<uint32_t>& order, uint32_t firstMoved,
+					SortScratch& scratch, const ComponentCacheItem& item, uint32_t compIdx) {
+				const auto n = (uint32_t)order.size();
+				auto& visited = scratch.dirty;
+				visited.resize(n);
+				GAIA_FOR(n) visited[i] = 0;
+
+				for (uint32_t i = firstMoved; i < n; ++i) {
+					if (visited[i] != 0 || order[i] == i)
+						continue;
 
-				GAIA_ASSERT(false);
-				return nullptr;
+					visited[i] = 1;
+					auto curr = i;
+					while (order[curr] != i) {
+						const auto next = order[curr];
+						visited[next] = 1;
+
+						const auto& refA = rows[curr];
+						const auto& refB = rows[next];
+						item.swap(
+								refA.pChunk->comp_ptr_mut(compIdx), refB.pChunk->comp_ptr_mut(compIdx), refA.row, refB.row,
+								refA.pChunk->capacity(), refB.pChunk->capacity());
+						curr = next;
+					}
+				}
 			}
 
-			//! Generic in-place quicksort across chunks
+			//! Sorts enabled or disabled entities with a comparator.
+			//! Row data pointers are extracted once, the row indices are merge-sorted and the resulting
+			//! permutation is applied in a single pass.
+			//! \tparam Enabled True to sort enabled rows, false to sort disabled rows
+			//! \param compIdx Component index, or BadIndex when sorting by the entity itself
+			//! \param func Comparator
+			//! \param scratch Scratch buffers
 			template <bool Enabled>
-			void sort_entities_inter(size_t low, size_t high, TSortByFunc func) {
-				if (low >= high)
+			void sort_entities_inter(uint32_t compIdx, TSortByFunc func, SortScratch& scratch) {
+				sort_collect_rows<Enabled>(scratch.rows);
+				const auto n = (uint32_t)scratch.rows.size();
+				if (n < 2)
 					return;
 
-				Entity pivotEntity = get_flat_entity<Enabled>(high);
-
-				size_t i = low;
-				for (size_t j = low; j < high; ++j) {
-					Entity jEntity = get_flat_entity<Enabled>(j);
-					if (func(m_world, &jEntity, &pivotEntity) < 0) {
-						if (i != j) {
-							Entity iEntity = get_flat_entity<Enabled>(i);
-							Chunk::swap_chunk_entities(const_cast<World&>(m_world), iEntity, jEntity);
-						}
-						++i;
-					}
+				scratch.keyPtrs.resize(n);
+				scratch.order.resize(n);
+				scratch.orderTmp.resize(n);
+				GAIA_FOR(n) {
+					scratch.keyPtrs[i] = sort_key_ptr(scratch.rows[i], compIdx);
+					scratch.order[i] = i;
 				}
 
-				{
-					Entity iEntity = get_flat_entity<Enabled>(i);
-					Chunk::swap_chunk_entities(const_cast<World&>(m_world), iEntity, pivotEntity);
-				}
+				const auto* pKeys = scratch.keyPtrs.data();
+				core::merge_sort(
+						scratch.order.data(), scratch.order.data() + n, scratch.orderTmp.data(), [&](uint32_t lhs, uint32_t rhs) {
+							return func(m_world, pKeys[lhs], pKeys[rhs]) < 0;
+						});
+
+				sort_apply_permutation(scratch.rows, scratch.order, scratch);
+			}
+
+			//! Sorts enabled or disabled entities by unsigned keys extracted from each row.
+			//! Keys are extracted once and LSD radix-sorted, then the resulting permutation is applied in a single pass.
+			//! \tparam Enabled True to sort enabled rows, false to sort disabled rows
+			//! \tparam TKeyFunc Key extractor: TKey keyFunc(const void* pData) with TKey unsigned
+			//! \param compIdx Component index, or BadIndex when sorting by the entity itself
+			//! \param keyFunc Key extractor
+			//! \param scratch Scratch buffers
+			template <bool Enabled, typename TKeyFunc>
+			void sort_entities_by_key_inter(uint32_t compIdx, TKeyFunc& keyFunc, SortScratch& scratch) {
+				using TKey = std::decay_t<decltype(keyFunc((const void*)nullptr))>;
+
+				sort_collect_rows<Enabled>(scratch.rows);
+				const auto n = (uint32_t)scratch.rows.size();
+				if (n < 2)
+					return;
 
-				if (i > 0)
-					sort_entities_inter<Enabled>(low, i - 1, func);
-				sort_entities_inter<Enabled>(i + 1, high, func);
-			}
+				cnt::darray<TKey> keys(n);
+				cnt::darray<TKey> keysTmp(n);
+				scratch.order.resize(n);
+				scratch.orderTmp.resize(n);
+				GAIA_FOR(n) {
+					keys[i] = keyFunc(sort_key_ptr(scratch.rows[i], compIdx));
+					scratch.order[i] = i;
+				}
 
-			//! Generic in-place quicksort across chunks
-			template <bool Enabled>
-			void sort_entities_inter(
-					const ComponentCacheItem* pItem, uint32_t compIdx, size_t low, size_t high, TSortByFunc func) {
-				if (low >= high)
+				core::radix_sort(keys.data(), scratch.order.data(), keysTmp.data(), scratch.orderTmp.data(), n);
+				sort_apply_permutation(scratch.rows, scratch.order, scratch);
+			}
+
+			//! Sorts enabled or disabled entities by 64-bit keys extracted one chunk run at a time.
+			//! Keys are extracted once and LSD radix-sorted, then the resulting permutation is applied in a single pass.
+			//! \tparam Enabled True to sort enabled rows, false to sort disabled rows
+			//! \tparam TKeysFunc Key extractor filling keys of \a cnt rows starting at row \a from:
+			//!                   void keysFunc(const Chunk& chunk, uint32_t from, uint32_t cnt, uint64_t* pKeys)
+			//! \param keysFunc Key extractor
+			//! \param scratch Scratch buffers
+			template <bool Enabled, typename TKeysFunc>
+			void sort_entities_by_keys_inter(TKeysFunc& keysFunc, SortScratch& scratch) {
+				sort_collect_rows<Enabled>(scratch.rows);
+				const auto n = (uint32_t)scratch.rows.size();
+				if (n < 2)
 					return;
 
-				Entity pivotEntity;
-				const void* pPivotData = get_flat_comp_ptr<Enabled>(compIdx, high, pivotEntity);
-
-				size_t i = low;
-				for (size_t j = low; j < high; ++j) {
-					Entity jEntity;
-					const void* jData = get_flat_comp_ptr<Enabled>(compIdx, j, jEntity);
-					if (func(m_world, jData, pPivotData) < 0) {
-						if (i != j) {
-							Entity iEntity;
-							(void)get_flat_comp_ptr<Enabled>(compIdx, i, iEntity);
-							Chunk::swap_chunk_entities(const_cast<World&>(m_world), iEntity, jEntity);
-						}
-						++i;
-					}
-				}
+				cnt::darray<uint64_t> keys(n);
+				cnt::darray<uint64_t> keysTmp(n);
+				uint32_t keyIdx = 0;
+				for (const auto* pChunk: m_storage.chunks) {
+					const auto from = Enabled ? (uint32_t)pChunk->size_disabled() : 0U;
+					const auto to = Enabled ? (uint32_t)pChunk->size() : (uint32_t)pChunk->size_disabled();
+					if (from == to)
+						continue;
 
-				{
-					Entity iEntity;
-					(void)get_flat_comp_ptr<Enabled>(compIdx, i, iEntity);
-					Chunk::swap_chunk_entities(const_cast<World&>(m_world), iEntity, pivotEntity);
+					keysFunc(*pChunk, from, to - from, keys.data() + keyIdx);
+					keyIdx += to - from;
 				}
 
-				if (i > 0)
-					sort_entities_inter<Enabled>(pItem, compIdx, low, i - 1, func);
-				sort_entities_inter<Enabled>(pItem, compIdx, i + 1, high, func);
+				scratch.order.resize(n);
+				scratch.orderTmp.resize(n);
+				GAIA_FOR(n) scratch.order[i] = i;
+
+				core::radix_sort(keys.data(), scratch.order.data(), keysTmp.data(), scratch.orderTmp.data(), n);
+				sort_apply_permutation(scratch.rows, scratch.order, scratch);
+			}
+
+			//! Returns the index of the column sorted by, or BadIndex when sorting by the entity itself.
+			//! \param entity Entity to sort by
+			//! \return Column index
+			GAIA_NODISCARD uint32_t sort_comp_idx(Entity entity) const {
+				if (entity == EntityBad || m_storage.chunks.empty())
+					return BadIndex;
+				return m_storage.chunks[0]->comp_idx(entity);
 			}
 
 			//! Sorts all entities in the archetypes according to the given function.
+			//! Enabled and disabled entities are sorted separately so they stay in their respective row ranges.
+			//! The sort is stable.
 			//! \param entity Entity to sort by
 			//! \param func Function to sort by
 			void sort_entities(Entity entity, TSortByFunc func) {
-				// TODO: We currently have to calculate the number of entities in the archetype from chunks.
-				//       Additionally, to get the right index we need to loop through chunks again because
-				//       the entities are not spread evenly among chunks (we can't just divide the index by
-				//       the number of chunks and module with the same number to get the index inside a chunk).
-				//       This is not optimal, and makes sorting more expensive.
-
-				if (entity == EntityBad) {
-					{
-						uint32_t entities = 0;
-						for (const auto* pChunk: m_storage.chunks)
-							entities += pChunk->size_enabled();
-						if (entities != 0)
-							sort_entities_inter<true>(0, entities - 1, func);
-					}
-					{
-						uint32_t entities = 0;
-						for (const auto* pChunk: m_storage.chunks)
-							entities += pChunk->size_disabled();
-						if (entities != 0)
-							sort_entities_inter<false>(0, entities - 1, func);
-					}
-				} else {
-					const auto* pItem = m_cc.find(entity);
-					GAIA_ASSERT(pItem != nullptr && "Trying to sort by a component that has not been registered");
-					if (pItem == nullptr)
-						return;
-
-					const auto compIdx = chunks()[0]->comp_idx(entity);
-					{
-						uint32_t entities = 0;
-						for (const auto* pChunk: m_storage.chunks)
-							entities += pChunk->size_enabled();
-						if (entities != 0)
-							sort_entities_inter<true>(pItem, compIdx, 0, entities - 1, func);
-					}
-					{
-						uint32_t entities = 0;
-						for (const auto* pChunk: m_storage.chunks)
-							entities += pChunk->size_disabled();
-						if (entities != 0)
-							sort_entities_inter<false>(pItem, compIdx, 0, entities - 1, func);
-					}
-				}
+				GAIA_PROF_SCOPE(Archetype::sort_entities);
+
+				GAIA_ASSERT(entity == EntityBad || m_cc.find(entity) != nullptr);
+				const auto compIdx = sort_comp_idx(entity);
+
+				SortScratch scratch;
+				sort_entities_inter<true>(compIdx, func, scratch);
+				sort_entities_inter<false>(compIdx, func, scratch);
+			}
+
+			//! Sorts all entities in the archetype by an unsigned key extracted from each row.
+			//! Enabled and disabled entities are sorted separately so they stay in their respective row ranges.
+			//! The sort is stable.
+			//! \tparam TKeyFunc Key extractor: TKey keyFunc(const void* pData) with TKey unsigned. Use core::radix_key
+			//!                  to turn signed and floating-point values into such keys.
+			//! \param entity Entity to sort by. Its data, or the entity itself for EntityBad, is passed to \a keyFunc.
+			//! \param keyFunc Key extractor
+			template <typename TKeyFunc>
+			void sort_entities_by_key(Entity entity, TKeyFunc keyFunc) {
+				GAIA_PROF_SCOPE(Archetype::sort_entities_by_key);
+
+				GAIA_ASSERT(entity == EntityBad || m_cc.find(entity) != nullptr);
+				const auto compIdx = sort_comp_idx(entity);
+
+				SortScratch scratch;
+				sort_entities_by_key_inter<true>(compIdx, keyFunc, scratch);
+				sort_entities_by_key_inter<false>(compIdx, keyFunc, scratch);
+			}
+
+			//! Sorts all entities in the archetype by 64-bit keys extracted from whole runs of chunk rows.
+			//! This is the path used by queries sorted by projected keys. Reading keys a run at a time lets the
+			//! extractor resolve its columns once per chunk.
+			//! Enabled and disabled entities are sorted separately so they stay in their respective row ranges.
+			//! The sort is stable.
+			//! \tparam TKeysFunc Key extractor filling keys of \a cnt rows starting at row \a from:
+			//!                   void keysFunc(const Chunk& chunk, uint32_t from, uint32_t cnt, uint64_t* pKeys)
+			//! \param keysFunc Key extractor
+			template <typename TKeysFunc>
+			void sort_entities_by_keys(TKeysFunc keysFunc) {
+				GAIA_PROF_SCOPE(Archetype::sort_entities_by_keys);
+
+				SortScratch scratch;
+				sort_entities_by_keys_inter<true>(keysFunc, scratch);
+				sort_entities_by_keys_inter<false>(keysFunc, scratch);
 			}
 
 			//----------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "gaia/cnt/bitset_iterator.h"
 #include "gaia/cnt/sarray_ext.h"
 #include "gaia/core/utility.h"
 #include "gaia/ecs/archetype_common.h"
@@ -30,7 +31,138 @@ namespace gaia {
 		class Chunk;
 		void world_invalidate_sorted_queries_for_entity(World& world, Entity entity);
 		void world_invalidate_sorted_queries(World& world);
-		void world_notify_on_set(World& world, Entity term, Chunk& chunk, uint16_t from, uint16_t to);
+		void world_notify_on_set(World& world, Entity term, Chunk& chunk, ChunkRow from, ChunkRow to);
+
+		//! Read-only bitset view over the dirty rows of a component stored in a chunk.
+		//! Satisfies the interface expected by cnt::bitset_const_iterator.
+		class GAIA_API DirtyRowsView {
+		public:
+			//! Backing-word type.
+			using size_type = uint64_t;
+			//! Number of bits stored in each backing word.
+			static constexpr uint32_t BitsPerItem = 64;
+
+		private:
+			const uint64_t* m_pData = nullptr;
+			uint32_t m_size = 0;
+
+		public:
+			DirtyRowsView() = default;
+			DirtyRowsView(const uint64_t* pData, uint32_t size): m_pData(pData), m_size(size) {}
+
+			//! Returns the word stored at the index \a wordIdx.
+			GAIA_NODISCARD size_type data(uint32_t wordIdx) const {
+				return m_pData[wordIdx];
+			}
+
+			//! Returns the number of words covering the view.
+			GAIA_NODISCARD uint32_t items() const {
+				return (m_size + BitsPerItem - 1) / BitsPerItem;
+			}
+
+			//! Returns the number of rows covered by the view.
+			GAIA_NODISCARD uint32_t size() const {
+				return m_size;
+			}
+
+			//! Returns true if the row \a pos is dirty.
+			GAIA_NODISCARD bool test(uint32_t pos) const {
+				GAIA_ASSERT(pos < m_size);
+				return (m_pData[pos / BitsPerItem] & ((size_type)1 << (pos % BitsPerItem))) != 0;
+			}
+		};
+
+		//! Range of dirty rows of a component. Row indices are relative to the first row of the range.
+		struct DirtyRowRun {
+			//! First dirty row
+			uint32_t from;
+			//! One past the last dirty row
+			uint32_t to;
+		};
+
+		//! Iterable sequence of runs of consecutive dirty rows of a component within a row range of a chunk.
+		//! If the component does not track changes per row, the whole range is reported as a single run.
+		class GAIA_API DirtyRowRuns {
+			DirtyRowsView m_bits;
+			uint32_t m_from = 0;
+			uint32_t m_to = 0;
+			bool m_tracked = false;
+
+			GAIA_NODISCARD uint32_t next_dirty(uint32_t pos) const {
+				if (pos >= m_to)
+					return m_to;
+				if (!m_tracked || m_bits.test(pos))
+					return pos;
+				const auto idx = *cnt::const_iterator<DirtyRowsView>(m_bits, pos, true);
+				return idx < m_to ? idx : m_to;
+			}
+
+			GAIA_NODISCARD uint32_t next_clean(uint32_t pos) const {
+				if (!m_tracked || pos >= m_to)
+					return m_to;
+				const auto idx = *cnt::const_iterator_inverse<DirtyRowsView>(m_bits, pos, true);
+				return idx < m_to ? idx : m_to;
+			}
+
+		public:
+			class iterator {
+				const DirtyRowRuns* m_pRuns = nullptr;
+				DirtyRowRun m_run{};
+
+			public:
+				iterator() = default;
+				iterator(const DirtyRowRuns& runs, uint32_t pos): m_pRuns(&runs) {
+					m_run.from = runs.next_dirty(pos);
+					m_run.to = runs.next_clean(m_run.from);
+				}
+
+				GAIA_NODISCARD DirtyRowRun operator*() const {
+					return {m_run.from - m_pRuns->m_from, m_run.to - m_pRuns->m_from};
+				}
+
+				iterator& operator++() {
+					m_run.from = m_pRuns->next_dirty(m_run.to);
+					m_run.to = m_pRuns->next_clean(m_run.from);
+					return *this;
+				}
+
+				GAIA_NODISCARD bool operator==(const iterator& other) const {
+					return m_run.from == other.m_run.from;
+				}
+
+				GAIA_NODISCARD bool operator!=(const iterator& other) const {
+					return m_run.from != other.m_run.from;
+				}
+			};
+
+			DirtyRowRuns() = default;
+			//! \param pData Dirty row bitset. Nullptr if the component does not track changes per row.
+			//! \param from First row of the range
+			//! \param to One past the last row of the range
+			DirtyRowRuns(const uint64_t* pData, uint32_t from, uint32_t to):
+					m_bits(pData, to), m_from(from), m_to(to), m_tracked(pData != nullptr) {}
+
+			GAIA_NODISCARD iterator begin() const {
+				return iterator(*this, m_from);
+			}
+
+			GAIA_NODISCARD iterator end() const {
+				return iterator(*this, m_to);
+			}
+
+			//! Returns true if there are no dirty rows in the range.
+			GAIA_NODISCARD bool empty() const {
+				return begin() == end();
+			}
+
+			//! Returns the number of dirty rows in the range.
+			GAIA_NODISCARD uint32_t count() const {
+				uint32_t cnt = 0;
+				for (auto run: *this)
+					cnt += run.to - run.from;
+				return cnt;
+			}
+		};
 
 		class GAIA_API Chunk final {
 		public:
@@ -64,7 +196,7 @@ namespace gaia {
 
 			Chunk(
 					const World& wld, const ComponentCache& cc, //
-					uint32_t chunkIndex, uint16_t capacity, uint8_t genEntities, //
+					uint32_t chunkIndex, ChunkRow capacity, uint8_t genEntities, //
 					uint32_t& worldVersion): //
 					m_header(wld, cc, chunkIndex, capacity, genEntities, worldVersion) {
 				// Chunk data area consist of memory offsets, entities, and component data. Normally,  we would need
@@ -81,7 +213,7 @@ namespace gaia {
 
 			void init(
 					uint32_t cntEntities, const Entity* ids, const ComponentCacheItem* const* pItems,
-					const ChunkDataOffsets& headerOffsets, const ChunkDataOffset* compOffs) {
+					const ChunkDataOffsets& headerOffsets, const ChunkDataOffset* compOffs, ChunkDataOffset dirtyRowsOffset) {
 				m_header.cntEntities = (uint8_t)cntEntities;
 
 				// Cache pointers to versions
@@ -106,11 +238,29 @@ namespace gaia {
 					GAIA_FOR_(cntEntities, j) {
 						dst[j].comp =
 								pItems[j] == nullptr ? Component(IdentifierIdBad, 0, 0, 0, DataStorageType::Table) : pItems[j]->comp;
-						dst[j].pData = &data(compOffs[j]);
+						// Cold data live in side blocks allocated once the chunk is initialized
+						dst[j].pData = component_uses_cold_storage(dst[j].comp) ? nullptr : &data(compOffs[j]);
 						dst[j].pItem = pItems[j];
+						dst[j].pDirtyRows = nullptr;
 					}
 				}
 
+				// Cache pointers to dirty row bitsets
+				if (dirtyRowsOffset != 0) {
+					auto* pDirtyRows = (uint64_t*)&data(dirtyRowsOffset);
+					const auto words = dirty_rows_bytes(m_header.capacity) / (uint32_t)sizeof(uint64_t);
+					GAIA_FOR_(m_header.genEntities, j) {
+						if (!tracks_dirty_rows(pItems[j]))
+							continue;
+
+						m_records.pRecords[j].pDirtyRows = pDirtyRows;
+						pDirtyRows += words;
+						++m_header.cntDirtyRows;
+					}
+					GAIA_ASSERT(m_header.cntDirtyRows > 0);
+					clear_dirty_rows();
+				}
+
 				m_records.pEntities = (Entity*)&data(headerOffsets.firstByte_EntityData);
 
 				// Now that records are set, we use the cached component descriptors to set ctor/dtor masks.
@@ -259,7 +409,7 @@ namespace gaia {
 
 					// Update version number if necessary so we know RW access was used on the chunk
 					if constexpr (WorldVersionUpdateWanted) {
-						update_world_version(compIdx);
+						update_world_version(compIdx, from, to);
 
 #if GAIA_ENABLE_SET_HOOKS
 						const auto& rec = m_records.pRecords[compIdx];
@@ -287,7 +437,7 @@ namespace gaia {
 
 					// Update version number if necessary so we know RW access was used on the chunk
 					if constexpr (WorldVersionUpdateWanted) {
-						update_world_version(compIdx);
+						update_world_version(compIdx, from, to);
 
 #if GAIA_ENABLE_SET_HOOKS
 						const auto& rec = m_records.pRecords[compIdx];
@@ -339,7 +489,7 @@ namespace gaia {
 			GAIA_NODISCARD GAIA_FORCEINLINE auto comp_ptr_mut_gen(uint32_t compIdx, uint32_t row) {
 				// Update version number if necessary so we know RW access was used on the chunk
 				if constexpr (WorldVersionUpdateWanted) {
-					update_world_version(compIdx);
+					update_world_version(compIdx, row, row + 1);
 
 #if GAIA_ENABLE_SET_HOOKS
 					const auto& rec = m_records.pRecords[compIdx];
@@ -353,12 +503,12 @@ namespace gaia {
 
 			//! Finishes a raw write over a chunk range by updating versions, running set hooks once,
 			//! and notifying `OnSet` observers after the callback completed.
-			void finish_write(uint32_t compIdx, uint16_t from, uint16_t to) {
+			void finish_write(uint32_t compIdx, ChunkRow from, ChunkRow to) {
 				GAIA_ASSERT(compIdx < m_header.cntEntities);
 				if (from >= to)
 					return;
 
-				update_world_version(compIdx);
+				update_world_version(compIdx, from, to);
 
 #if GAIA_ENABLE_SET_HOOKS
 				const auto& rec = m_records.pRecords[compIdx];
@@ -377,7 +527,7 @@ namespace gaia {
 			//! \param row Row of entity in the chunk
 			//! \return Value stored in the component if smaller than 8 bytes. Const reference to the value otherwise.
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) comp_inter(uint16_t row) const {
+			GAIA_NODISCARD decltype(auto) comp_inter(ChunkRow row) const {
 				using U = typename actual_type_t<T>::Type;
 				using RetValueType = decltype(view<T>()[0]);
 
@@ -391,7 +541,7 @@ namespace gaia {
 			}
 
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) comp_inter_idx(uint16_t row, uint32_t compIdx) const {
+			GAIA_NODISCARD decltype(auto) comp_inter_idx(ChunkRow row, uint32_t compIdx) const {
 				using U = typename actual_type_t<T>::Type;
 				using RetValueType = decltype(view_raw<T>((const void*)nullptr, 1)[0]);
 
@@ -412,7 +562,7 @@ namespace gaia {
 			}
 
 			template <typename T, bool WorldVersionUpdateWanted>
-			GAIA_NODISCARD decltype(auto) comp_mut_idx(uint16_t row, uint32_t compIdx) {
+			GAIA_NODISCARD decltype(auto) comp_mut_idx(ChunkRow row, uint32_t compIdx) {
 				using U = typename actual_type_t<T>::Type;
 
 				GAIA_ASSERT(row < m_header.capacity);
@@ -431,7 +581,7 @@ namespace gaia {
 			Chunk& operator=(Chunk&& chunk) = delete;
 			~Chunk() = default;
 
-			static constexpr uint16_t chunk_header_size() {
+			static constexpr ChunkDataOffset chunk_header_size() {
 				const auto dataAreaOffset =
 						// ChunkAllocator reserves the first few bytes for internal purposes
 						MemoryBlockUsableOffset +
@@ -442,11 +592,11 @@ namespace gaia {
 				return dataAreaOffset;
 			}
 
-			static constexpr uint16_t chunk_total_bytes(uint16_t dataSize) {
+			static constexpr ChunkDataOffset chunk_total_bytes(ChunkDataOffset dataSize) {
 				return chunk_header_size() + dataSize;
 			}
 
-			static constexpr uint16_t chunk_data_bytes(uint16_t totalSize) {
+			static constexpr ChunkDataOffset chunk_data_bytes(ChunkDataOffset totalSize) {
 				return totalSize - chunk_header_size();
 			}
 
@@ -464,8 +614,8 @@ namespace gaia {
 			//! \return Newly allocated chunk
 			static Chunk* create(
 					const World& wld, const ComponentCache& cc, //
-					uint32_t chunkIndex, uint16_t capacity, uint8_t cntEntities, uint8_t genEntities, //
-					uint16_t dataBytes, uint32_t& worldVersion,
+					uint32_t chunkIndex, uint8_t numaNode, ChunkRow capacity, uint8_t cntEntities, uint8_t genEntities, //
+					ChunkRow dataBytes, uint32_t& worldVersion,
 					// data offsets
 					const ChunkDataOffsets& offsets,
 					// component entities
@@ -473,12 +623,15 @@ namespace gaia {
 					// resolved component storage items
 					const ComponentCacheItem* const* pItems,
 					// component offsets
-					const ChunkDataOffset* compOffs) {
+					const ChunkDataOffset* compOffs,
+					// dirty row bitsets offset
+					ChunkDataOffset dirtyRowsOffset) {
 				const auto totalBytes = chunk_total_bytes(dataBytes);
 #if GAIA_ECS_CHUNK_ALLOCATOR
-				auto* pChunk = (Chunk*)ChunkAllocator::get().alloc(totalBytes);
+				auto* pChunk = (Chunk*)ChunkAllocator::get().alloc(totalBytes, numaNode);
 				(void)new (pChunk) Chunk(wld, cc, chunkIndex, capacity, genEntities, worldVersion);
 #else
+				(void)numaNode;
 				GAIA_ASSERT(totalBytes <= MaxMemoryBlockSize);
 				const auto sizeType = mem_block_size_type(totalBytes);
 				const auto allocSize = mem_block_size(sizeType);
@@ -487,7 +640,8 @@ namespace gaia {
 				auto* pChunk = new (pChunkMem) Chunk(wld, cc, chunkIndex, capacity, genEntities, worldVersion);
 #endif
 
-				pChunk->init((uint32_t)cntEntities, ids, pItems, offsets, compOffs);
+				pChunk->init((uint32_t)cntEntities, ids, pItems, offsets, compOffs, dirtyRowsOffset);
+				pChunk->alloc_cold_data(numaNode);
 				return pChunk;
 			}
 
@@ -502,6 +656,7 @@ namespace gaia {
 
 				// Call destructors for components that need it
 				pChunk->call_all_dtors();
+				pChunk->free_cold_data();
 
 				pChunk->~Chunk();
 #if GAIA_ECS_CHUNK_ALLOCATOR
@@ -511,6 +666,75 @@ namespace gaia {
 #endif
 			}
 
+		private:
+			//! Returns the number of bytes of the side block holding \a capacity rows of the cold component \a comp
+			GAIA_NODISCARD static uint32_t cold_block_bytes(Component comp, uint32_t capacity) {
+				return comp.size() * capacity;
+			}
+
+			//! Returns true if the side block of the cold component \a comp comes from ChunkAllocator.
+			//! Blocks too big for the largest size class are allocated on the heap instead.
+			GAIA_NODISCARD static bool cold_block_uses_chunk_allocator(Component comp, uint32_t capacity) {
+#if GAIA_ECS_CHUNK_ALLOCATOR
+				// Blocks are over-allocated by the alignment so the data can be aligned inside them
+				return cold_block_bytes(comp, capacity) + comp.alig() <= MaxMemoryBlockSize;
+#else
+				(void)comp;
+				(void)capacity;
+				return false;
+#endif
+			}
+
+			//! Allocates side blocks of all cold components of the chunk.
+			//! Rows of a side block map 1:1 to rows of the chunk.
+			//! \param numaNode NUMA node the memory should be placed on
+			void alloc_cold_data([[maybe_unused]] uint8_t numaNode) {
+				const auto cap = (uint32_t)m_header.capacity;
+				GAIA_FOR(m_header.genEntities) {
+					auto& rec = m_records.pRecords[i];
+					if (!component_uses_cold_storage(rec.comp))
+						continue;
+
+					const auto bytes = cold_block_bytes(rec.comp, cap);
+					const auto alig = rec.comp.alig();
+#if GAIA_ECS_CHUNK_ALLOCATOR
+					if (cold_block_uses_chunk_allocator(rec.comp, cap)) {
+						auto* pBlock = (uint8_t*)ChunkAllocator::get().alloc(bytes + alig, numaNode);
+						rec.pData = (uint8_t*)mem::align((uintptr_t)pBlock, (uintptr_t)alig);
+						continue;
+					}
+#endif
+					rec.pData = (uint8_t*)mem::mem_alloc_alig("ColdData", bytes, alig);
+				}
+			}
+
+			//! Releases side blocks of all cold components of the chunk
+			void free_cold_data() {
+				// ChunkAllocator blocks start at a MemoryBlockAlignment boundary. The data is aligned to at most
+				// as many bytes so the pointer returned by the allocator can be reconstructed.
+				static_assert(MemoryBlockAlignment >= 64, "GAIA_STORAGE(Cold) alignment limit exceeds block alignment");
+
+				const auto cap = (uint32_t)m_header.capacity;
+				GAIA_FOR(m_header.genEntities) {
+					auto& rec = m_records.pRecords[i];
+					if (!component_uses_cold_storage(rec.comp) || rec.pData == nullptr)
+						continue;
+
+#if GAIA_ECS_CHUNK_ALLOCATOR
+					if (cold_block_uses_chunk_allocator(rec.comp, cap)) {
+						const auto blockAddr =
+								((uintptr_t)rec.pData - MemoryBlockUsableOffset) & ~(uintptr_t)(MemoryBlockAlignment - 1);
+						ChunkAllocator::get().free((void*)(blockAddr + MemoryBlockUsableOffset));
+						rec.pData = nullptr;
+						continue;
+					}
+#endif
+					mem::mem_free_alig("ColdData", rec.pData);
+					rec.pData = nullptr;
+				}
+			}
+
+		public:
 			void save(ser::serializer& s) const {
 				s.save(m_header.count);
 				if (m_header.count == 0)
@@ -545,8 +769,10 @@ namespace gaia {
 			}
 
 			void load(ser::serializer& s) {
-				uint16_t prevCount = m_header.count;
+				ChunkRow prevCount = m_header.count;
 				s.load(m_header.count);
+				// Dirty rows are not serialized. Loaded rows count as changed.
+				clear_dirty_rows();
 				if (m_header.count == 0)
 					return;
 
@@ -582,6 +808,8 @@ namespace gaia {
 						rec.pItem->load(s, rec.pData, 0, cnt, cap);
 					}
 				}
+
+				GAIA_FOR(m_header.genEntities) mark_dirty_rows(i, 0, cnt);
 			}
 
 			//! Remove the last entity from a chunk.
@@ -595,6 +823,7 @@ namespace gaia {
 				entity_view_mut()[m_header.count - 1] = EntityBad;
 #endif
 
+				set_dirty_row(m_header.count - 1, false);
 				--m_header.count;
 			}
 
@@ -612,7 +841,7 @@ namespace gaia {
 			//! \param to Last valid entity row
 			//! \return Entity of component view with read-only access
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) view(uint16_t from, uint16_t to) const {
+			GAIA_NODISCARD decltype(auto) view(ChunkRow from, ChunkRow to) const {
 				using U = typename actual_type_t<T>::Type;
 
 				// Always consider full range for SoA
@@ -640,7 +869,7 @@ namespace gaia {
 			//! \param to Last valid entity row
 			//! \return Entity or component view with read-write access
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) view_mut(uint16_t from, uint16_t to) {
+			GAIA_NODISCARD decltype(auto) view_mut(ChunkRow from, ChunkRow to) {
 				using U = typename actual_type_t<T>::Type;
 				static_assert(!std::is_same_v<U, Entity>, "Modifying chunk entities via view_mut is forbidden");
 
@@ -672,7 +901,7 @@ namespace gaia {
 			//! \param to Last valid entity row
 			//! \return Component view with read-write access
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) sview_mut(uint16_t from, uint16_t to) {
+			GAIA_NODISCARD decltype(auto) sview_mut(ChunkRow from, ChunkRow to) {
 				using U = typename actual_type_t<T>::Type;
 				static_assert(!std::is_same_v<U, Entity>, "Modifying chunk entities via sview_mut is forbidden");
 
@@ -763,7 +992,7 @@ namespace gaia {
 			//! \param to Last valid entity row
 			//! \return Entity or component view
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) view_auto(uint16_t from, uint16_t to) {
+			GAIA_NODISCARD decltype(auto) view_auto(ChunkRow from, ChunkRow to) {
 				using UOriginal = typename actual_type_t<T>::TypeOriginal;
 				if constexpr (core::is_mut_v<UOriginal>)
 					return view_mut<T>(from, to);
@@ -785,7 +1014,7 @@ namespace gaia {
 			//! \param to Last valid entity row
 			//! \return Entity or component view
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) sview_auto(uint16_t from, uint16_t to) {
+			GAIA_NODISCARD decltype(auto) sview_auto(ChunkRow from, ChunkRow to) {
 				using UOriginal = typename actual_type_t<T>::TypeOriginal;
 				if constexpr (core::is_mut_v<UOriginal>)
 					return sview_mut<T>(from, to);
@@ -838,9 +1067,47 @@ namespace gaia {
 				return rec.pData + ((uintptr_t)rec.comp.size() * offset);
 			}
 
+			//! Hints the CPU to start fetching the chunk header and the component records.
+			//! Nothing is read from the chunk so the call does not stall even if the chunk is not cached.
+			//! \param recordsOffset Offset of component records in the data area. Same for all chunks of an archetype.
+			//! \param cntRecords Number of component records
+			GAIA_FORCEINLINE void prefetch_header(uint32_t recordsOffset, uint32_t cntRecords) const {
+				constexpr uint32_t CacheLineSize = 64;
+				gaia::prefetch(this, PrefetchHint::PREFETCH_HINT_T1);
+				gaia::prefetch((const uint8_t*)this + CacheLineSize, PrefetchHint::PREFETCH_HINT_T1);
+
+				const auto* pRecords = &data(recordsOffset);
+				const auto recordsBytes = cntRecords * (uint32_t)sizeof(ComponentRecord);
+				for (uint32_t i = 0; i < recordsBytes; i += CacheLineSize)
+					gaia::prefetch(pRecords + i, PrefetchHint::PREFETCH_HINT_T1);
+			}
+
+			//! Hints the CPU to start fetching the first cache line of the data of components from the first enabled row.
+			//! Reads the chunk header and component records so they should be prefetched beforehand.
+			//! \param pCompIndices Indices of components. Entries equal to 0xFF are ignored.
+			//! \param cnt Number of indices
+			GAIA_FORCEINLINE void prefetch_data(const uint8_t* pCompIndices, uint32_t cnt) const {
+				const auto row = (uint32_t)m_header.rowFirstEnabledEntity;
+				GAIA_FOR(cnt) {
+					const auto compIdx = pCompIndices[i];
+					if (compIdx == 0xFF)
+						continue;
+
+					GAIA_ASSERT(compIdx < m_header.cntEntities);
+					const auto& rec = m_records.pRecords[compIdx];
+					if (!component_uses_table_storage(rec.comp))
+						continue;
+
+					// Unique components have only one row. SoA data is split into per-field arrays, so only the start
+					// of the first array is prefetched.
+					const auto compRow = compIdx < m_header.genEntities && rec.comp.soa() == 0 ? row : 0U;
+					gaia::prefetch(rec.pData + (uintptr_t)rec.comp.size() * compRow, PrefetchHint::PREFETCH_HINT_T1);
+				}
+			}
+
 			//! Make \param entity a part of the chunk at the version of the world.
 			//! \return Row of entity within the chunk.
-			GAIA_NODISCARD uint16_t add_entity(Entity entity) {
+			GAIA_NODISCARD ChunkRow add_entity(Entity entity) {
 				const auto row = m_header.count++;
 
 				// Zero after increase of value means an overflow!
@@ -849,6 +1116,9 @@ namespace gaia {
 				++m_header.countEnabled;
 				entity_view_mut()[row] = entity;
 
+				// A new row counts as changed
+				set_dirty_row(row, true);
+
 				return row;
 			}
 
@@ -980,7 +1250,7 @@ namespace gaia {
 			//! \param entity Entity to move
 			//! \param row Entity's row within its chunk
 			//! \param recs Entity containers
-			void move_entity_data(Entity entity, uint16_t row, EntityContainers& recs) {
+			void move_entity_data(Entity entity, ChunkRow row, EntityContainers& recs) {
 				GAIA_PROF_SCOPE(Chunk::move_entity_data);
 
 				auto& ec = recs[entity];
@@ -1126,17 +1396,96 @@ namespace gaia {
 				}
 			}
 
+			//! Moves the last \a cnt rows of \a pSrcChunk to the end of \a pDstChunk in bulk.
+			//! Both chunks have to belong to the same archetype. Entity records of the moved entities are updated
+			//! and their enabled state is preserved. Versions are not touched.
+			//! \param pSrcChunk Source chunk
+			//! \param pDstChunk Destination chunk
+			//! \param cnt Number of rows to move
+			//! \param recs Entity containers
+			static void move_last_rows(Chunk* pSrcChunk, Chunk* pDstChunk, uint32_t cnt, EntityContainers& recs) {
+				GAIA_PROF_SCOPE(Chunk::move_last_rows);
+
+				GAIA_ASSERT(pSrcChunk != nullptr);
+				GAIA_ASSERT(pDstChunk != nullptr);
+				GAIA_ASSERT(pSrcChunk != pDstChunk);
+				GAIA_ASSERT(cnt <= pSrcChunk->size());
+				GAIA_ASSERT(pDstChunk->size() + cnt <= pDstChunk->capacity());
+				GAIA_ASSERT(pSrcChunk->ids_view().size() == pDstChunk->ids_view().size());
+
+				if (cnt == 0)
+					return;
+
+				auto& srcHeader = pSrcChunk->m_header;
+				auto& dstHeader = pDstChunk->m_header;
+				const uint32_t srcRow = srcHeader.count - cnt;
+				const uint32_t dstRow = dstHeader.count;
+
+				// Move component data column by column.
+				// Unique components do not change place in the chunk so there is no need to move them.
+				auto srcRecs = pSrcChunk->comp_rec_view();
+				GAIA_FOR(srcHeader.genEntities) {
+					const auto& rec = srcRecs[i];
+					if (!component_uses_table_storage(rec.comp))
+						continue;
+
+					auto* pSrc = (void*)pSrcChunk->comp_ptr_mut(i);
+					auto* pDst = (void*)pDstChunk->comp_ptr_mut(i);
+					rec.pItem->ctor_move_n(pDst, pSrc, dstRow, srcRow, cnt, pDstChunk->capacity(), pSrcChunk->capacity());
+					if (srcHeader.hasAnyCustomGenDtor)
+						rec.pItem->dtor_n((void*)pSrcChunk->comp_ptr_mut(i, srcRow), cnt);
+				}
+
+				// Move entities and bring their records up-to-date
+				{
+					// The destination rows lie past the current size of the destination chunk so they are
+					// addressed directly rather than via entity_view_mut()
+					auto* srcEntities = pSrcChunk->m_records.pEntities;
+					auto* dstEntities = pDstChunk->m_records.pEntities;
+					GAIA_FOR(cnt) {
+						const auto entity = srcEntities[srcRow + i];
+						dstEntities[dstRow + i] = entity;
+#if GAIA_ASSERT_ENABLED
+						srcEntities[srcRow + i] = EntityBad;
+#endif
+
+						auto& ec = recs[entity];
+						ec.pChunk = pDstChunk;
+						ec.row = (ChunkRow)(dstRow + i);
+						ec.pEntity = &dstEntities[dstRow + i];
+
+						move_dirty_row(pSrcChunk, srcRow + i, pDstChunk, dstRow + i);
+					}
+				}
+
+				// Disabled rows precede the enabled ones so any moved disabled rows sit at the front of the moved range
+				const uint32_t srcDisabled = srcHeader.rowFirstEnabledEntity;
+				const uint32_t movedDisabled = srcDisabled > srcRow ? srcDisabled - srcRow : 0;
+
+				srcHeader.count = (ChunkRow)srcRow;
+				srcHeader.rowFirstEnabledEntity = (ChunkRow)(srcDisabled - movedDisabled);
+				srcHeader.countEnabled = (ChunkRow)(srcRow - srcHeader.rowFirstEnabledEntity);
+
+				// Moved rows arrive enabled. Disable those which were disabled before.
+				dstHeader.count = (ChunkRow)(dstRow + cnt);
+				dstHeader.countEnabled = (ChunkRow)(dstHeader.countEnabled + cnt);
+				GAIA_FOR(movedDisabled) {
+					const auto entity = pDstChunk->entity_view()[dstRow + i];
+					pDstChunk->enable_entity(recs[entity].row, false, recs);
+				}
+			}
+
 			//! Tries to remove the entity at \a row.
 			//! Removal is done via swapping with last entity in chunk.
 			//! Upon removal, all associated data is also removed.
 			//! If the entity at the given row already is the last chunk entity, it is removed directly.
 			//! \param row Row within a chunk
 			//! \param recs Entity containers
-			void remove_entity_inter(uint16_t row, EntityContainers& recs) {
+			void remove_entity_inter(ChunkRow row, EntityContainers& recs) {
 				GAIA_PROF_SCOPE(Chunk::remove_entity_inter);
 
-				const uint16_t rowA = row;
-				const uint16_t rowB = m_header.count - 1;
+				const ChunkRow rowA = row;
+				const ChunkRow rowB = m_header.count - 1;
 				// The "rowA" entity is the one we are going to destroy so it needs to precede the "rowB"
 				GAIA_ASSERT(rowA <= rowB);
 
@@ -1172,6 +1521,7 @@ namespace gaia {
 						pSrc = (void*)comp_ptr_mut(i, rowB);
 						rec.pItem->dtor(pSrc);
 					}
+					move_dirty_row(this, rowB, this, rowA);
 
 					// Entity has been replaced with the last one in our chunk. Update its container record.
 					ecB.row = rowA;
@@ -1196,7 +1546,7 @@ namespace gaia {
 			//! If the entity at the given row already is the last chunk entity, it is removed directly.
 			//! \param row Row within a chunk
 			//! \param recs Entity containers
-			void remove_entity(uint16_t row, EntityContainers& recs) {
+			void remove_entity(ChunkRow row, EntityContainers& recs) {
 				if GAIA_UNLIKELY (m_header.count == 0)
 					return;
 
@@ -1205,15 +1555,12 @@ namespace gaia {
 				if (enabled(row)) {
 					// Entity was previously enabled. Swap with the last entity
 					remove_entity_inter(row, recs);
-					// If this was the first enabled entity make sure to update the row
-					if (m_header.rowFirstEnabledEntity > 0 && row == m_header.rowFirstEnabledEntity)
-						--m_header.rowFirstEnabledEntity;
 					// At this point the last entity is no longer valid so remove it
 					remove_last_entity();
 					--m_header.countEnabled;
 				} else {
 					// Entity was previously disabled. Swap with the last disabled entity
-					const uint16_t pivot = size_disabled() - 1;
+					const ChunkRow pivot = size_disabled() - 1;
 					swap_chunk_entities(row, pivot, recs);
 					// Once swapped, try to swap with the last (enabled) entity in the chunk.
 					remove_entity_inter(pivot, recs);
@@ -1230,7 +1577,7 @@ namespace gaia {
 			//! \param rowB Row of the entityB within chunk
 			//! \param[out] recs Entity container records
 			//! \warning "rowA" must he smaller or equal to "rowB"
-			void swap_chunk_entities(uint16_t rowA, uint16_t rowB, EntityContainers& recs) {
+			void swap_chunk_entities(ChunkRow rowA, ChunkRow rowB, EntityContainers& recs) {
 				// If there are at least two different entities inside to swap
 				if GAIA_UNLIKELY (m_header.count <= 1 || rowA == rowB)
 					return;
@@ -1260,6 +1607,7 @@ namespace gaia {
 					GAIA_ASSERT(rec.pData == comp_ptr_mut(i));
 					rec.pItem->swap(rec.pData, rec.pData, rowA, rowB, capacity(), capacity());
 				}
+				swap_dirty_rows(this, rowA, this, rowB);
 
 				// Update indices in entity container.
 				ecA.row = rowB;
@@ -1310,9 +1658,10 @@ namespace gaia {
 							// Rows
 							ecA.row, ecB.row,
 							// Chunk capacities
-							pChunkA->capacity(), pChunkA->capacity() //
+							pChunkA->capacity(), pChunkB->capacity() //
 					);
 				}
+				swap_dirty_rows(pChunkA, ecA.row, pChunkB, ecB.row);
 
 				// Update indices and chunks in entity container.
 				core::swap(ecA.row, ecB.row);
@@ -1321,11 +1670,26 @@ namespace gaia {
 				ecB.pEntity = &ecB.pChunk->entity_view()[ecB.row];
 			}
 
+			//! Stores \a entity on \a row and points its entity record \a ec at it.
+			//! Component data is left untouched. Used when rows are reordered one column at a time.
+			//! \param row Row within the chunk
+			//! \param entity Entity to store
+			//! \param ec Entity container record of \a entity
+			void place_entity(ChunkRow row, Entity entity, EntityContainer& ec) {
+				GAIA_ASSERT(row < m_header.count);
+
+				auto ev = entity_view_mut();
+				ev[row] = entity;
+				ec.pChunk = this;
+				ec.row = row;
+				ec.pEntity = &ev[row];
+			}
+
 			//! Enables or disables the entity on a given row in the chunk.
 			//! \param row Row of the entity within chunk
 			//! \param enableEntity Enables or disables the entity
 			//! \param recs Entity container records
-			void enable_entity(uint16_t row, bool enableEntity, EntityContainers& recs) {
+			void enable_entity(ChunkRow row, bool enableEntity, EntityContainers& recs) {
 				GAIA_ASSERT(row < m_header.count && "Entity chunk row out of bounds!");
 
 				if (enableEntity) {
@@ -1358,10 +1722,10 @@ namespace gaia {
 			//! Checks if the entity is enabled.
 			//! \param row Row of the entity within chunk
 			//! \return True if entity is enabled. False otherwise.
-			bool enabled(uint16_t row) const {
+			bool enabled(ChunkRow row) const {
 				GAIA_ASSERT(m_header.count > 0);
 
-				return row >= (uint16_t)m_header.rowFirstEnabledEntity;
+				return row >= (ChunkRow)m_header.rowFirstEnabledEntity;
 			}
 
 			//! Returns a mutable pointer to chunk data.
@@ -1433,7 +1797,7 @@ namespace gaia {
 
 					auto* pSrc = (void*)comp_ptr_mut(i, 0);
 					const auto e = ids[i];
-					const auto cnt = (e.kind() == EntityKind::EK_Gen) ? m_header.count : (uint16_t)1;
+					const auto cnt = (e.kind() == EntityKind::EK_Gen) ? m_header.count : (ChunkRow)1;
 					pItem->func_dtor(pSrc, cnt);
 				}
 			};
@@ -1474,7 +1838,7 @@ namespace gaia {
 			//! \param row Row of entity in the chunk
 			//! \warning It is expected the component \a T is present. Undefined behavior otherwise.
 			template <typename T>
-			decltype(auto) set(uint16_t row) {
+			decltype(auto) set(ChunkRow row) {
 				verify_comp<T>();
 
 				GAIA_ASSERT2(
@@ -1485,7 +1849,7 @@ namespace gaia {
 				::gaia::ecs::update_version(m_header.worldVersion);
 
 				GAIA_ASSERT(row < m_header.capacity);
-				world_notify_on_set(*const_cast<World*>(m_header.world), comp_entity<T>(), *this, row, (uint16_t)(row + 1));
+				world_notify_on_set(*const_cast<World*>(m_header.world), comp_entity<T>(), *this, row, (ChunkRow)(row + 1));
 				return view_mut<T>()[row];
 			}
 
@@ -1494,7 +1858,7 @@ namespace gaia {
 			//! \param row Row of entity in the chunk
 			//! \param compIdx Pre-resolved component column index
 			template <typename T>
-			decltype(auto) set_idx(uint16_t row, uint32_t compIdx) {
+			decltype(auto) set_idx(ChunkRow row, uint32_t compIdx) {
 				verify_comp<T>();
 
 				GAIA_ASSERT2(
@@ -1505,7 +1869,7 @@ namespace gaia {
 				::gaia::ecs::update_version(m_header.worldVersion);
 
 				world_notify_on_set(
-						*const_cast<World*>(m_header.world), m_records.pCompEntities[compIdx], *this, row, (uint16_t)(row + 1));
+						*const_cast<World*>(m_header.world), m_records.pCompEntities[compIdx], *this, row, (ChunkRow)(row + 1));
 				return comp_mut_idx<T, true>(row, compIdx);
 			}
 
@@ -1531,7 +1895,7 @@ namespace gaia {
 			//! \param type Component/entity/pair
 			//! \warning It is expected the component \a T is present. Undefined behavior otherwise.
 			template <typename T>
-			decltype(auto) set(uint16_t row, Entity type) {
+			decltype(auto) set(ChunkRow row, Entity type) {
 				const uint32_t compIdx = comp_idx(type);
 				GAIA_ASSERT2(
 						actual_type_t<T>::Kind == EntityKind::EK_Gen || row == 0,
@@ -1543,7 +1907,7 @@ namespace gaia {
 				::gaia::ecs::update_version(m_header.worldVersion);
 
 				GAIA_ASSERT(row < m_header.capacity);
-				world_notify_on_set(*const_cast<World*>(m_header.world), type, *this, row, (uint16_t)(row + 1));
+				world_notify_on_set(*const_cast<World*>(m_header.world), type, *this, row, (ChunkRow)(row + 1));
 				return comp_mut_idx<T, true>(row, compIdx);
 			}
 
@@ -1553,7 +1917,7 @@ namespace gaia {
 			//! \warning It is expected the component \a T is present. Undefined behavior otherwise.
 			//! \warning World version is not updated so Query filters will not be able to catch this change.
 			template <typename T>
-			decltype(auto) sset(uint16_t row) {
+			decltype(auto) sset(ChunkRow row) {
 				GAIA_ASSERT2(
 						actual_type_t<T>::Kind == EntityKind::EK_Gen || row == 0,
 						"Set providing a row can only be used with generic components");
@@ -1565,7 +1929,7 @@ namespace gaia {
 			//! Sets the value of a generic component using a pre-resolved component column.
 			//! \warning World version is not updated so Query filters will not be able to catch this change.
 			template <typename T>
-			decltype(auto) sset_idx(uint16_t row, uint32_t compIdx) {
+			decltype(auto) sset_idx(ChunkRow row, uint32_t compIdx) {
 				verify_comp<T>();
 
 				GAIA_ASSERT2(
@@ -1594,7 +1958,7 @@ namespace gaia {
 			//! \warning It is expected the component \a T is present. Undefined behavior otherwise.
 			//! \warning World version is not updated so Query filters will not be able to catch this change.
 			template <typename T>
-			decltype(auto) sset(uint16_t row, Entity type) {
+			decltype(auto) sset(ChunkRow row, Entity type) {
 				static_assert(core::is_raw_v<T>);
 
 				const uint32_t compIdx = comp_idx(type);
@@ -1619,7 +1983,7 @@ namespace gaia {
 			//! \warning It is expected the component \a T is present. Undefined behavior otherwise.
 			//! \return Value stored in the component.
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) get(uint16_t row) const {
+			GAIA_NODISCARD decltype(auto) get(ChunkRow row) const {
 				static_assert(
 						actual_type_t<T>::Kind == EntityKind::EK_Gen,
 						"Get providing a row can only be used with generic components");
@@ -1632,7 +1996,7 @@ namespace gaia {
 			//! \param row Row of entity in the chunk
 			//! \param compIdx Pre-resolved component column index
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) get_idx(uint16_t row, uint32_t compIdx) const {
+			GAIA_NODISCARD decltype(auto) get_idx(ChunkRow row, uint32_t compIdx) const {
 				static_assert(
 						actual_type_t<T>::Kind == EntityKind::EK_Gen,
 						"Get providing a row can only be used with generic components");
@@ -1646,7 +2010,7 @@ namespace gaia {
 			//! \param type Component/entity/pair
 			//! \warning It is expected the component is present. Undefined behavior otherwise.
 			template <typename T>
-			GAIA_NODISCARD decltype(auto) get(uint16_t row, Entity type) const {
+			GAIA_NODISCARD decltype(auto) get(ChunkRow row, Entity type) const {
 				GAIA_ASSERT(row < m_header.count);
 				const uint32_t compIdx = comp_idx(type);
 				GAIA_ASSERT2(
@@ -1802,7 +2166,7 @@ namespace gaia {
 			}
 
 			//! Returns the total number of entities in the chunk (both enabled and disabled)
-			GAIA_NODISCARD uint16_t size() const {
+			GAIA_NODISCARD ChunkRow size() const {
 				return m_header.count;
 			}
 
@@ -1812,17 +2176,17 @@ namespace gaia {
 			}
 
 			//! Return the number of entities in the chunk which are enabled
-			GAIA_NODISCARD uint16_t size_enabled() const {
+			GAIA_NODISCARD ChunkRow size_enabled() const {
 				return m_header.countEnabled;
 			}
 
 			//! Return the number of entities in the chunk which are enabled
-			GAIA_NODISCARD uint16_t size_disabled() const {
-				return (uint16_t)m_header.rowFirstEnabledEntity;
+			GAIA_NODISCARD ChunkRow size_disabled() const {
+				return (ChunkRow)m_header.rowFirstEnabledEntity;
 			}
 
 			//! Returns the number of entities in the chunk
-			GAIA_NODISCARD uint16_t capacity() const {
+			GAIA_NODISCARD ChunkRow capacity() const {
 				return m_header.capacity;
 			}
 
@@ -1831,6 +2195,188 @@ namespace gaia {
 				return m_header.genEntities;
 			}
 
+			//----------------------------------------------------------------------
+			// Per-row change tracking
+			//----------------------------------------------------------------------
+
+			//! Returns true if the component described by \a pItem tracks changes per row
+			GAIA_NODISCARD static bool tracks_dirty_rows(const ComponentCacheItem* pItem) {
+				return pItem != nullptr && pItem->changeTracking == ChangeTracking::Row && pItem->comp.size() != 0 &&
+							 pItem->comp.soa() == 0 && component_uses_table_storage(pItem->comp);
+			}
+
+			//! Returns the number of bytes of a dirty row bitset for a chunk with \a capacity rows
+			GAIA_NODISCARD static constexpr uint32_t dirty_rows_bytes(uint32_t capacity) {
+				return ((capacity + 63) / 64) * (uint32_t)sizeof(uint64_t);
+			}
+
+			//! Returns true if the component at the index \a compIdx tracks changes per row
+			GAIA_NODISCARD bool tracks_dirty_rows(uint32_t compIdx) const {
+				return m_header.cntDirtyRows != 0 && m_records.pRecords[compIdx].pDirtyRows != nullptr;
+			}
+
+			//! Returns runs of dirty rows of the component at the index \a compIdx within rows [\a from, \a to).
+			//! If the component does not track changes per row, the whole range is reported as dirty.
+			GAIA_NODISCARD DirtyRowRuns dirty_rows(uint32_t compIdx, uint32_t from, uint32_t to) const {
+				GAIA_ASSERT(to <= m_header.count);
+				const uint64_t* pBits = m_header.cntDirtyRows != 0 ? m_records.pRecords[compIdx].pDirtyRows : nullptr;
+				return {pBits, from, to};
+			}
+
+			//! Marks rows [\a from, \a to) of the component at the index \a compIdx dirty.
+			//! Does nothing unless the component tracks changes per row.
+			GAIA_FORCEINLINE void mark_dirty_rows(uint32_t compIdx, uint32_t from, uint32_t to) {
+				if GAIA_LIKELY (m_header.cntDirtyRows == 0)
+					return;
+
+				auto* pBits = m_records.pRecords[compIdx].pDirtyRows;
+				if (pBits != nullptr)
+					set_dirty_bits(pBits, from, to, true);
+			}
+
+			//! Marks rows [\a from, \a to) of the component \a T dirty.
+			//! Does nothing unless the component tracks changes per row.
+			template <typename T>
+			GAIA_FORCEINLINE void mark_dirty_rows(uint32_t from, uint32_t to) {
+				if GAIA_LIKELY (m_header.cntDirtyRows == 0)
+					return;
+
+				mark_dirty_rows(comp_idx(comp_entity<T>()), from, to);
+			}
+
+			//! Clears the dirty state of rows [\a from, \a to) of the component at the index \a compIdx
+			void clear_dirty_rows(uint32_t compIdx, uint32_t from, uint32_t to) {
+				if (m_header.cntDirtyRows == 0)
+					return;
+
+				auto* pBits = m_records.pRecords[compIdx].pDirtyRows;
+				if (pBits != nullptr)
+					set_dirty_bits(pBits, from, to, false);
+			}
+
+			//! Clears the dirty state of all rows of all components tracking changes per row
+			void clear_dirty_rows() {
+				if (m_header.cntDirtyRows == 0)
+					return;
+
+				// Bitsets of all components are stored back to back starting with the first tracked component
+				// so a single memset is enough
+				GAIA_FOR(m_header.genEntities) {
+					auto* pBits = m_records.pRecords[i].pDirtyRows;
+					if (pBits == nullptr)
+						continue;
+
+					std::memset(pBits, 0, (size_t)m_header.cntDirtyRows * dirty_rows_bytes(m_header.capacity));
+					break;
+				}
+			}
+
+			//! Returns true if \a row of the component at the index \a compIdx is dirty.
+			//! The component must track changes per row.
+			GAIA_NODISCARD bool dirty_row(uint32_t compIdx, uint32_t row) const {
+				GAIA_ASSERT(tracks_dirty_rows(compIdx));
+				const auto* pBits = m_records.pRecords[compIdx].pDirtyRows;
+				return (pBits[row / 64] & (uint64_t(1) << (row % 64))) != 0;
+			}
+
+			//! Sets or clears the dirty state of \a row of the component at the index \a compIdx.
+			//! The component must track changes per row.
+			void set_dirty_row(uint32_t compIdx, uint32_t row, bool value) {
+				GAIA_ASSERT(tracks_dirty_rows(compIdx));
+				auto* pBits = m_records.pRecords[compIdx].pDirtyRows;
+				if (value)
+					pBits[row / 64] |= uint64_t(1) << (row % 64);
+				else
+					pBits[row / 64] &= ~(uint64_t(1) << (row % 64));
+			}
+
+		private:
+			//! Sets or clears bits [\a from, \a to) of the bitset \a pBits
+			static void set_dirty_bits(uint64_t* pBits, uint32_t from, uint32_t to, bool value) {
+				if (from >= to)
+					return;
+
+				const uint32_t wordFrom = from / 64;
+				const uint32_t wordTo = (to - 1) / 64;
+				const uint64_t maskFrom = ~uint64_t(0) << (from % 64);
+				const uint64_t maskTo = ~uint64_t(0) >> (63 - ((to - 1) % 64));
+
+				if (wordFrom == wordTo) {
+					const uint64_t mask = maskFrom & maskTo;
+					pBits[wordFrom] = value ? (pBits[wordFrom] | mask) : (pBits[wordFrom] & ~mask);
+					return;
+				}
+
+				pBits[wordFrom] = value ? (pBits[wordFrom] | maskFrom) : (pBits[wordFrom] & ~maskFrom);
+				for (uint32_t i = wordFrom + 1; i < wordTo; ++i)
+					pBits[i] = value ? ~uint64_t(0) : uint64_t(0);
+				pBits[wordTo] = value ? (pBits[wordTo] | maskTo) : (pBits[wordTo] & ~maskTo);
+			}
+
+			//! Moves the dirty state of all components from \a srcRow of \a pSrcChunk to \a dstRow of \a pDstChunk.
+			//! The source row is left clean.
+			static void move_dirty_row(Chunk* pSrcChunk, uint32_t srcRow, Chunk* pDstChunk, uint32_t dstRow) {
+				if GAIA_LIKELY (pSrcChunk->m_header.cntDirtyRows == 0)
+					return;
+
+				GAIA_FOR(pSrcChunk->m_header.genEntities) {
+					auto* pSrcBits = pSrcChunk->m_records.pRecords[i].pDirtyRows;
+					if (pSrcBits == nullptr)
+						continue;
+
+					auto* pDstBits = pDstChunk->m_records.pRecords[i].pDirtyRows;
+					const uint64_t srcMask = uint64_t(1) << (srcRow % 64);
+					const uint64_t dstMask = uint64_t(1) << (dstRow % 64);
+					const bool dirty = (pSrcBits[srcRow / 64] & srcMask) != 0;
+					pSrcBits[srcRow / 64] &= ~srcMask;
+					if (dirty)
+						pDstBits[dstRow / 64] |= dstMask;
+					else
+						pDstBits[dstRow / 64] &= ~dstMask;
+				}
+			}
+
+			//! Swaps the dirty state of all components between \a rowA of \a pChunkA and \a rowB of \a pChunkB
+			static void swap_dirty_rows(Chunk* pChunkA, uint32_t rowA, Chunk* pChunkB, uint32_t rowB) {
+				if GAIA_LIKELY (pChunkA->m_header.cntDirtyRows == 0)
+					return;
+
+				GAIA_FOR(pChunkA->m_header.genEntities) {
+					auto* pBitsA = pChunkA->m_records.pRecords[i].pDirtyRows;
+					if (pBitsA == nullptr)
+						continue;
+
+					auto* pBitsB = pChunkB->m_records.pRecords[i].pDirtyRows;
+					const uint64_t maskA = uint64_t(1) << (rowA % 64);
+					const uint64_t maskB = uint64_t(1) << (rowB % 64);
+					const bool dirtyA = (pBitsA[rowA / 64] & maskA) != 0;
+					const bool dirtyB = (pBitsB[rowB / 64] & maskB) != 0;
+					if (dirtyA == dirtyB)
+						continue;
+
+					pBitsA[rowA / 64] ^= maskA;
+					pBitsB[rowB / 64] ^= maskB;
+				}
+			}
+
+			//! Sets or clears the dirty state of \a row for all components tracking changes per row
+			void set_dirty_row(uint32_t row, bool value) {
+				if GAIA_LIKELY (m_header.cntDirtyRows == 0)
+					return;
+
+				GAIA_FOR(m_header.genEntities) {
+					auto* pBits = m_records.pRecords[i].pDirtyRows;
+					if (pBits == nullptr)
+						continue;
+
+					if (value)
+						pBits[row / 64] |= uint64_t(1) << (row % 64);
+					else
+						pBits[row / 64] &= ~(uint64_t(1) << (row % 64));
+				}
+			}
+
+		public:
 			//! Returns true if the provided version is newer than the one stored internally.
 			//! Use when checking if there was a movement in data in the world. E.g. if an entity
 			//! was added, removed or moved in its archetype.
@@ -1866,6 +2412,13 @@ namespace gaia {
 						*const_cast<World*>(m_header.world), m_records.pCompEntities[compIdx]);
 			}
 
+			//! Update the version of a component at the index \param compIdx and marks rows [\a from, \a to) dirty
+			//! if the component tracks changes per row.
+			GAIA_FORCEINLINE void update_world_version(uint32_t compIdx, uint32_t from, uint32_t to) {
+				update_world_version(compIdx);
+				mark_dirty_rows(compIdx, from, to);
+			}
+
 			//! Updates the entity-order version after rows were added, removed, or reordered.
 			GAIA_FORCEINLINE void update_entity_order_version() {
 				m_header.entityOrderVersion = m_header.worldVersion;
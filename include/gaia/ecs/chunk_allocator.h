@@ -1,6 +1,7 @@
 #pragma once
 #include "gaia/config/config.h"
 
+#include <atomic>
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
@@ -11,8 +12,17 @@
 #include "gaia/core/dyn_singleton.h"
 #include "gaia/core/utility.h"
 #include "gaia/mem/mem_alloc.h"
+#include "gaia/mt/numa.h"
+#include "gaia/mt/spinlock.h"
 #include "gaia/util/logging.h"
 
+#if GAIA_PLATFORM_LINUX || GAIA_PLATFORM_APPLE || GAIA_PLATFORM_FREEBSD
+	#include <sys/mman.h>
+	#define GAIA_ECS_CHUNK_ARENA 1
+#else
+	#define GAIA_ECS_CHUNK_ARENA 0
+#endif
+
 namespace gaia {
 	namespace ecs {
 		//! \cond INTERNAL
@@ -26,6 +36,7 @@ namespace gaia {
 			};
 
 			class ChunkAllocatorImpl;
+			struct ChunkAllocatorThreadCache;
 		} // namespace detail
 		//! \endcond
 
@@ -33,20 +44,65 @@ namespace gaia {
 		static constexpr uint32_t MemoryBlockAlignment = 64;
 		//! Size of the smallest allocator block class in bytes.
 		static constexpr uint32_t MinMemoryBlockSize = 1024 * 8;
-		//! Number of chunk allocator block size classes: 8, 16, 32 and 64 KiB-class blocks.
-		static constexpr uint32_t MemoryBlockSizeClasses = 4;
+		//! Size of the largest regular block of memory in bytes. Kept below 64 KiB so regular chunks stay addressable
+		//! by 16-bit offsets.
+		static constexpr uint32_t MaxRegularMemoryBlockSize = UINT16_MAX & ~(MemoryBlockAlignment - 1);
+		//! Size of the tiny allocator block class in bytes. Used by archetypes holding just a few entities.
+		static constexpr uint32_t TinyMemoryBlockSize = 1024 * 2;
+		//! Number of regular chunk allocator block size classes: 8, 16, 32 and 64 KiB-class blocks.
+		static constexpr uint32_t RegularMemoryBlockSizeClasses = 4;
+#if GAIA_ECS_WIDE_CHUNKS
+		//! Number of chunk allocator block size classes: 8, 16, 32 and 64 KiB-class blocks followed by
+		//! 128, 256, 512 KiB and 1 MiB wide blocks and the 2 KiB tiny block.
+		static constexpr uint32_t MemoryBlockSizeClasses = 9;
+		//! Size of the largest allocated block of memory in bytes.
+		static constexpr uint32_t MaxMemoryBlockSize = 1024 * 1024;
+#else
+		//! Number of chunk allocator block size classes: 8, 16, 32 and 64 KiB-class blocks followed by
+		//! the 2 KiB tiny block.
+		static constexpr uint32_t MemoryBlockSizeClasses = RegularMemoryBlockSizeClasses + 1;
 		//! Size of the largest allocated block of memory in bytes. Kept below 64 KiB because chunk sizes are 16-bit.
-		static constexpr uint32_t MaxMemoryBlockSize = UINT16_MAX & ~(MemoryBlockAlignment - 1);
+		static constexpr uint32_t MaxMemoryBlockSize = MaxRegularMemoryBlockSize;
+#endif
+		//! Size-class index of the tiny block class. It is the last class so the indices of the other classes
+		//! grow with their block size.
+		static constexpr uint32_t TinyMemoryBlockSizeType = MemoryBlockSizeClasses - 1;
+#if GAIA_USE_NUMA
+		//! Number of NUMA nodes the chunk allocator keeps separate page pools for.
+		static constexpr uint32_t ChunkAllocatorNumaNodes = mt::MaxNumaNodes;
+#else
+		//! Number of NUMA nodes the chunk allocator keeps separate page pools for.
+		static constexpr uint32_t ChunkAllocatorNumaNodes = 1;
+#endif
+		//! Number of blocks a thread-local chunk allocator cache can hold per size class.
+		static constexpr uint32_t ChunkAllocatorCacheBlocks = 8;
+		//! Number of blocks moved between a thread-local cache and the shared pages at once.
+		static constexpr uint32_t ChunkAllocatorCacheBatch = ChunkAllocatorCacheBlocks / 2;
+		//! Alignment of the virtual memory range reserved by the chunk allocator arena. Matches the size of
+		//! a transparent huge page on x86-64 and ARM64.
+		static constexpr uint32_t ChunkArenaAlignment = 2 * 1024 * 1024;
+		//! Granularity of memory pages carved from the chunk allocator arena. Pages are returned to the OS one by one
+		//! so their ranges must not share an OS page with their neighbors. 64 KiB covers all common OS page sizes.
+		static constexpr uint32_t ChunkArenaPageGranularity = 64 * 1024;
 		//! Reserved bytes at the start of each block for allocator metadata and chunk header alignment headroom.
 		//! Validated against the actual chunk layout in Chunk::chunk_header_size().
+#if GAIA_ECS_WIDE_CHUNKS
+		//! 32-bit rows make the chunk header 8 bytes bigger so the headroom shrinks accordingly.
+		static constexpr uint32_t MemoryBlockUsableOffset = 32;
+#else
 		static constexpr uint32_t MemoryBlockUsableOffset = 40;
+#endif
 
 		//! Returns the block size represented by an allocator size-class index.
 		//! \param sizeType Size-class index in the range supported by the allocator.
 		//! \return Block size in bytes.
-		constexpr uint16_t mem_block_size(uint32_t sizeType) {
-			constexpr uint16_t sizes[] = {
-					MinMemoryBlockSize, MinMemoryBlockSize * 2, MinMemoryBlockSize * 4, MaxMemoryBlockSize};
+		constexpr uint32_t mem_block_size(uint32_t sizeType) {
+			constexpr uint32_t sizes[] = {
+					MinMemoryBlockSize, MinMemoryBlockSize * 2, MinMemoryBlockSize * 4, MaxRegularMemoryBlockSize,
+#if GAIA_ECS_WIDE_CHUNKS
+					1024 * 128, 1024 * 256, 1024 * 512, MaxMemoryBlockSize,
+#endif
+					TinyMemoryBlockSize};
 			return sizes[sizeType];
 		}
 
@@ -55,13 +111,24 @@ namespace gaia {
 		//! \return Allocator size-class index.
 		constexpr uint8_t mem_block_size_type(uint32_t sizeBytes) {
 			GAIA_ASSERT(sizeBytes > 0);
+			if (sizeBytes <= TinyMemoryBlockSize)
+				return (uint8_t)TinyMemoryBlockSizeType;
 			if (sizeBytes <= MinMemoryBlockSize)
 				return 0;
 			if (sizeBytes <= MinMemoryBlockSize * 2)
 				return 1;
 			if (sizeBytes <= MinMemoryBlockSize * 4)
 				return 2;
+#if GAIA_ECS_WIDE_CHUNKS
+			if (sizeBytes <= MaxRegularMemoryBlockSize)
+				return 3;
+			uint8_t sizeType = RegularMemoryBlockSizeClasses;
+			while (sizeBytes > mem_block_size(sizeType))
+				++sizeType;
+			return sizeType;
+#else
 			return 3;
+#endif
 		}
 
 #if GAIA_ECS_CHUNK_ALLOCATOR
@@ -80,10 +147,50 @@ namespace gaia {
 			//! Number of completely empty pages
 			uint32_t num_pages_empty;
 	#endif
+			//! Number of blocks parked in thread-local caches. They are accounted for in mem_used.
+			uint32_t num_blocks_cached;
+			//! Number of allocations served directly from thread-local caches
+			uint64_t cache_hits;
+			//! Number of allocations which had to refill a thread-local cache from the shared pages
+			uint64_t cache_misses;
+		};
+
+		struct GAIA_API ChunkAllocatorCacheStats final {
+			//! Number of blocks currently held by the cache
+			uint32_t num_blocks[MemoryBlockSizeClasses];
+			//! Number of allocations served by the cache
+			uint64_t hits[MemoryBlockSizeClasses];
+			//! Number of allocations the cache could not serve
+			uint64_t misses[MemoryBlockSizeClasses];
+
+			//! Returns the ratio of allocations served by the cache for a given size class.
+			//! \param sizeType Size-class index
+			//! \return Hit rate in the range [0, 1]. Zero if nothing was allocated yet.
+			GAIA_NODISCARD double hit_rate(uint32_t sizeType) const {
+				const auto total = hits[sizeType] + misses[sizeType];
+				return total != 0 ? (double)hits[sizeType] / (double)total : 0.0;
+			}
+		};
+
+		struct GAIA_API ChunkAllocatorArenaStats final {
+			//! Size of the reserved virtual range. Zero when the arena is not used.
+			uint64_t mem_reserved;
+			//! Bytes of the virtual range carved into pages so far
+			uint64_t mem_carved;
+			//! Bytes of carved pages whose physical memory was returned to the OS
+			uint64_t mem_released;
+			//! Number of pages which did not fit into the arena and were allocated from the heap
+			uint32_t num_pages_spilled;
 		};
 
 		struct GAIA_API ChunkAllocatorStats final {
 			ChunkAllocatorPageStats stats[MemoryBlockSizeClasses];
+			//! Number of allocated pages placed on each NUMA node
+			uint32_t num_pages_node[ChunkAllocatorNumaNodes];
+			//! Arena statistics
+			ChunkAllocatorArenaStats arena;
+			//! Number of thread-local caches registered with the allocator
+			uint32_t num_caches;
 		};
 
 		using ChunkAllocator = core::dyn_singleton<detail::ChunkAllocatorImpl>;
@@ -113,8 +220,8 @@ namespace gaia {
 				//! Implicit list of blocks
 				BlockArray m_blocks;
 
-				//! Block size type, 0=8K, 1=16K, 2=32K, 3=64K-class blocks
-				uint32_t m_sizeType : 2;
+				//! Block size type, 0=8K, 1=16K, 2=32K, 3=64K-class blocks, 4-7=128K-1M wide blocks, last=2K tiny blocks
+				uint32_t m_sizeType : 4;
 				//! Number of blocks in the block array
 				uint32_t m_blockCnt : NBlocks_Bits;
 				//! Number of used blocks out of NBlocks
@@ -123,16 +230,19 @@ namespace gaia {
 				uint32_t m_nextFreeBlock : NBlocks_Bits;
 				//! Number of blocks to recycle
 				uint32_t m_freeBlocks : NBlocks_Bits;
+				//! NUMA node the page memory is placed on
+				uint32_t m_node : 3;
 				//! Free bits to use in the future
-				// uint32_t m_unused : 6;
+				// uint32_t m_unused : 1;
 
 	#if GAIA_ASSERT_ENABLED
 				uint64_t m_usedMask = 0;
 	#endif
 
-				MemoryPage(void* ptr, uint8_t sizeType):
+				MemoryPage(void* ptr, uint8_t sizeType, uint8_t node):
 						MemoryPageHeader(ptr), m_sizeType(sizeType), m_blockCnt(0), m_usedBlocks(0), m_nextFreeBlock(0),
-						m_freeBlocks(0) {
+						m_freeBlocks(0), m_node(node) {
+					static_assert(ChunkAllocatorNumaNodes <= 8);
 	#if GAIA_ASSERT_ENABLED
 					static_assert(sizeof(MemoryPage) <= 72);
 	#else
@@ -361,16 +471,197 @@ namespace gaia {
 				cnt::fwd_llist<MemoryPage> pagesFull;
 
 				GAIA_NODISCARD bool empty() const {
-					return pagesEmpty.empty() && pagesPartial.empty() && pagesFull.empty();
+					return pagesEmpty.size() == 0 && pagesPartial.size() == 0 && pagesFull.size() == 0;
+				}
+			};
+
+			//! Virtual memory range pages of the chunk allocator are carved from.
+			//! The range is reserved once and pages are handed out contiguously so chunks of the same size class
+			//! end up next to each other, which reduces TLB pressure when iterating many chunks. Optionally, the OS
+			//! is asked to back the range with transparent huge pages.
+			//! Physical memory of released pages is returned to the OS but their address range is kept for reuse.
+			struct ChunkArena {
+				//! Address returned by the OS for the reserved range
+				void* m_pMapping = nullptr;
+				//! Size of the mapping in bytes
+				uint64_t m_mappingSize = 0;
+				//! First usable (aligned) byte of the range
+				uint8_t* m_pBase = nullptr;
+				//! Usable size of the range in bytes
+				uint64_t m_reserved = 0;
+				//! Bump offset of the next page to carve
+				uint64_t m_carved = 0;
+				//! Number of bytes held by released pages
+				uint64_t m_released = 0;
+				//! Number of pages allocated from the heap because the arena was exhausted
+				uint32_t m_spilled = 0;
+				//! Pages whose memory was given back to the OS, ready to be reused
+				cnt::fwd_llist<MemoryPage> m_pagesReleased[MemoryBlockSizeClasses];
+
+				GAIA_NODISCARD bool active() const {
+					return m_pBase != nullptr;
+				}
+
+				GAIA_NODISCARD bool owns(const void* ptr) const {
+					const auto addr = (uintptr_t)ptr;
+					const auto base = (uintptr_t)m_pBase;
+					return addr >= base && addr < base + m_reserved;
+				}
+
+				//! Reserves the virtual range.
+				//! \param bytes Number of bytes to reserve
+				//! \param hugePages If true, transparent huge pages are requested for the range
+				//! \return True on success, false otherwise.
+				bool init(uint64_t bytes, [[maybe_unused]] bool hugePages) {
+					GAIA_ASSERT(!active());
+	#if GAIA_ECS_CHUNK_ARENA
+					bytes = (bytes + ChunkArenaAlignment - 1) & ~(uint64_t)(ChunkArenaAlignment - 1);
+
+		#if defined(MAP_NORESERVE)
+					constexpr int MapFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+		#else
+					constexpr int MapFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+		#endif
+					// Over-reserve so the usable part can be aligned to the huge page boundary
+					const uint64_t mappingSize = bytes + ChunkArenaAlignment;
+					void* pMapping = ::mmap(nullptr, (size_t)mappingSize, PROT_READ | PROT_WRITE, MapFlags, -1, 0);
+					if (pMapping == MAP_FAILED)
+						return false;
+
+					m_pMapping = pMapping;
+					m_mappingSize = mappingSize;
+					m_pBase = (uint8_t*)(((uintptr_t)pMapping + ChunkArenaAlignment - 1) & ~(uintptr_t)(ChunkArenaAlignment - 1));
+					m_reserved = bytes;
+					m_carved = 0;
+					m_released = 0;
+					m_spilled = 0;
+
+		#if defined(MADV_HUGEPAGE)
+					if (hugePages)
+						(void)::madvise(m_pBase, (size_t)m_reserved, MADV_HUGEPAGE);
+		#endif
+					return true;
+	#else
+					(void)bytes;
+					return false;
+	#endif
+				}
+
+				//! Releases the virtual range. All carved pages need to be released before.
+				void done() {
+					if (!active())
+						return;
+
+					// Pages still in use keep the range mapped. We rather leak it than pull memory from under them.
+					GAIA_ASSERT(m_released == m_carved && "Arena pages still in use");
+					if (m_released != m_carved)
+						return;
+
+					for (auto& pages: m_pagesReleased) {
+						while (pages.first != nullptr) {
+							auto* pPage = pages.first;
+							pages.unlink(pPage);
+							pPage->~MemoryPage();
+							mem::AllocHelper::free("MemoryPage", pPage);
+						}
+					}
+
+	#if GAIA_ECS_CHUNK_ARENA
+					(void)::munmap(m_pMapping, (size_t)m_mappingSize);
+	#endif
+					m_pMapping = nullptr;
+					m_mappingSize = 0;
+					m_pBase = nullptr;
+					m_reserved = 0;
+					m_carved = 0;
+					m_released = 0;
+				}
+
+				//! Returns the size of the address range an arena page of the given size class occupies.
+				//! \param sizeType Size-class index
+				//! \return Size in bytes rounded up to ChunkArenaPageGranularity.
+				GAIA_NODISCARD static uint64_t page_bytes(uint32_t sizeType) {
+					const auto bytes = (uint64_t)mem_block_size(sizeType) * MemoryPage::NBlocks;
+					return (bytes + ChunkArenaPageGranularity - 1) & ~(uint64_t)(ChunkArenaPageGranularity - 1);
+				}
+
+				//! Carves \param bytes from the arena.
+				//! \return Pointer to the carved memory or nullptr if the arena is exhausted.
+				GAIA_NODISCARD uint8_t* carve(uint64_t bytes) {
+					if (m_carved + bytes > m_reserved)
+						return nullptr;
+
+					auto* pData = m_pBase + m_carved;
+					m_carved += bytes;
+					return pData;
+				}
+
+				//! Hands the physical memory backing \param pData back to the OS. The address range stays reserved.
+				static void discard([[maybe_unused]] void* pData, [[maybe_unused]] uint64_t bytes) {
+	#if GAIA_ECS_CHUNK_ARENA && defined(MADV_DONTNEED)
+					(void)::madvise(pData, (size_t)bytes, MADV_DONTNEED);
+	#endif
+				}
+			};
+
+			//! Per-thread magazine of free blocks for each size class.
+			//! Blocks parked here stay live from the point of view of their pages. They are handed out without touching
+			//! the shared page lists and are returned to them in batches.
+			struct ChunkAllocatorThreadCache {
+				struct Magazine {
+					//! Cached blocks, only the first cnt items are valid
+					void* blocks[ChunkAllocatorCacheBlocks];
+					//! Number of cached blocks
+					uint32_t cnt = 0;
+				};
+
+				//! Magazines for each NUMA node and size class
+				Magazine m_magazines[ChunkAllocatorNumaNodes][MemoryBlockSizeClasses]{};
+				//! Number of allocations served by the cache. Written only by the owning thread.
+				std::atomic<uint64_t> m_hits[MemoryBlockSizeClasses]{};
+				//! Number of allocations the cache could not serve. Written only by the owning thread.
+				std::atomic<uint64_t> m_misses[MemoryBlockSizeClasses]{};
+				//! Guards the magazines. Only contended when the allocator drains the cache from another thread.
+				mt::SpinLock m_lock;
+				//! Allocator the cache is registered with
+				ChunkAllocatorImpl* m_pOwner = nullptr;
+				//! Next cache registered with the same allocator
+				ChunkAllocatorThreadCache* m_pNext = nullptr;
+
+				ChunkAllocatorThreadCache() = default;
+				~ChunkAllocatorThreadCache();
+
+				ChunkAllocatorThreadCache(ChunkAllocatorThreadCache&&) = delete;
+				ChunkAllocatorThreadCache(const ChunkAllocatorThreadCache&) = delete;
+				ChunkAllocatorThreadCache& operator=(ChunkAllocatorThreadCache&&) = delete;
+				ChunkAllocatorThreadCache& operator=(const ChunkAllocatorThreadCache&) = delete;
+
+				static void bump(std::atomic<uint64_t>& counter) {
+					// Only the owning thread writes the counter so there is no need for an atomic RMW operation
+					counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 				}
 			};
 
 			//! Allocator for ECS Chunks. Memory is organized in pages of chunks.
+			//! The allocator is thread-safe. Page lists are guarded by a lock. Optionally, each thread can keep
+			//! a small magazine of free blocks per size class so independent worlds running on different threads
+			//! create and destroy chunks without contending on the shared page lists. See set_thread_caches().
 			class ChunkAllocatorImpl {
 				friend ::gaia::ecs::ChunkAllocator;
-
-				//! Container for pages storing various-sized chunks
-				MemoryPageContainer m_pages[MemoryBlockSizeClasses];
+				friend ChunkAllocatorThreadCache;
+
+				//! Container for pages storing various-sized chunks. One set of containers per NUMA node.
+				MemoryPageContainer m_pages[ChunkAllocatorNumaNodes][MemoryBlockSizeClasses];
+				//! Guards page containers and the list of registered thread caches
+				mutable mt::SpinLock m_lock;
+				//! List of registered thread-local caches
+				ChunkAllocatorThreadCache* m_pCaches = nullptr;
+				//! Number of registered thread-local caches
+				uint32_t m_cacheCnt = 0;
+				//! When true, allocations go through thread-local caches
+				std::atomic_bool m_useThreadCaches{};
+				//! Virtual range pages are carved from when the arena mode is enabled
+				ChunkArena m_arena;
 
 				//! When true, destruction has been requested
 				bool m_isDone = false;
@@ -395,6 +686,8 @@ namespace gaia {
 			public:
 				~ChunkAllocatorImpl() {
 					on_delete();
+					detach_caches();
+					m_arena.done();
 				}
 
 				ChunkAllocatorImpl(ChunkAllocatorImpl&& world) = delete;
@@ -402,15 +695,227 @@ namespace gaia {
 				ChunkAllocatorImpl& operator=(ChunkAllocatorImpl&&) = delete;
 				ChunkAllocatorImpl& operator=(const ChunkAllocatorImpl&) = delete;
 
+				//! Enables or disables thread-local block caches.
+				//! When enabled, each thread allocating chunks keeps up to ChunkAllocatorCacheBlocks free blocks per size
+				//! class and exchanges them with the shared pages in batches of ChunkAllocatorCacheBatch blocks.
+				//! Disabling the caches returns all cached blocks to the shared pages.
+				//! \param enable True to enable the caches, false to disable them.
+				void set_thread_caches(bool enable) {
+					m_useThreadCaches.store(enable, std::memory_order_relaxed);
+					if (!enable) {
+						core::lock_scope lock(m_lock);
+						drain_caches_inter();
+					}
+				}
+
+				//! Returns true if thread-local block caches are enabled.
+				GAIA_NODISCARD bool thread_caches() const {
+					return m_useThreadCaches.load(std::memory_order_relaxed);
+				}
+
+				//! Enables or disables the arena mode.
+				//! In arena mode, one big virtual range is reserved up-front and pages are carved from it contiguously.
+				//! Empty pages released by flush() hand their physical memory back to the OS but keep their address
+				//! range so it can be reused. Pages which do not fit into the range are allocated from the heap.
+				//! The mode can only be changed while the allocator owns no pages, e.g. right after flush(true).
+				//! \param reserveBytes Size of the virtual range to reserve. Zero disables the arena mode.
+				//! \param hugePages If true, the range is backed by transparent huge pages if the OS supports them.
+				//! \return True if the mode was changed. False if pages are still in use or the platform can't reserve
+				//!         the range.
+				bool set_arena(uint64_t reserveBytes, bool hugePages = true) {
+					core::lock_scope lock(m_lock);
+					for (const auto& nodePages: m_pages) {
+						for (const auto& c: nodePages) {
+							if (!c.empty())
+								return false;
+						}
+					}
+
+					m_arena.done();
+					if (reserveBytes == 0)
+						return true;
+
+					return m_arena.init(reserveBytes, hugePages);
+				}
+
+				//! Returns true if the arena mode is enabled.
+				GAIA_NODISCARD bool arena() const {
+					core::lock_scope lock(m_lock);
+					return m_arena.active();
+				}
+
 				//! Allocates memory
-				void* alloc(uint32_t bytesWanted) {
+				//! \param bytesWanted Number of bytes to allocate
+				//! \param node NUMA node the memory should be placed on. Only used when GAIA_USE_NUMA is enabled.
+				void* alloc(uint32_t bytesWanted, uint32_t node = 0) {
 					GAIA_ASSERT(bytesWanted > 0);
 					GAIA_ASSERT(bytesWanted <= MaxMemoryBlockSize);
 					if (bytesWanted == 0 || bytesWanted > MaxMemoryBlockSize)
 						return nullptr;
 
 					const auto sizeType = mem_block_size_type(bytesWanted);
-					auto& container = m_pages[sizeType];
+					const auto nodeIdx = node_idx(node);
+					if (m_useThreadCaches.load(std::memory_order_relaxed))
+						return alloc_cached(thread_cache(), nodeIdx, sizeType, bytesWanted);
+
+					core::lock_scope lock(m_lock);
+					void* pBlock = alloc_inter(nodeIdx, sizeType, bytesWanted);
+					verify_inter();
+					return pBlock;
+				}
+
+				//! Releases memory allocated for pointer
+				void free(void* pBlock) {
+					GAIA_ASSERT(pBlock != nullptr);
+					if (pBlock == nullptr)
+						return;
+
+					if (m_useThreadCaches.load(std::memory_order_relaxed) && !m_isDone) {
+						free_cached(thread_cache(), pBlock);
+						return;
+					}
+
+					bool deleteThis = false;
+					{
+						core::lock_scope lock(m_lock);
+						free_inter(pBlock);
+						verify_inter();
+						deleteThis = can_delete_inter();
+					}
+					if (deleteThis)
+						delete this;
+				}
+
+				//! Returns allocator statistics
+				ChunkAllocatorStats stats() const {
+					ChunkAllocatorStats stats{};
+
+					core::lock_scope lock(m_lock);
+					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType)
+						stats.stats[sizeType] = page_stats(sizeType);
+					for (uint32_t node = 0; node < ChunkAllocatorNumaNodes; ++node) {
+						for (const auto& container: m_pages[node]) {
+							stats.num_pages_node[node] += (uint32_t)container.pagesEmpty.size() +
+																						(uint32_t)container.pagesPartial.size() +
+																						(uint32_t)container.pagesFull.size();
+						}
+					}
+
+					stats.arena.mem_reserved = m_arena.m_reserved;
+					stats.arena.mem_carved = m_arena.m_carved;
+					stats.arena.mem_released = m_arena.m_released;
+					stats.arena.num_pages_spilled = m_arena.m_spilled;
+
+					stats.num_caches = m_cacheCnt;
+					for (auto* pCache = m_pCaches; pCache != nullptr; pCache = pCache->m_pNext) {
+						const auto cacheStats = cache_stats(*pCache);
+						for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType) {
+							auto& s = stats.stats[sizeType];
+							s.num_blocks_cached += cacheStats.num_blocks[sizeType];
+							s.cache_hits += cacheStats.hits[sizeType];
+							s.cache_misses += cacheStats.misses[sizeType];
+						}
+					}
+					return stats;
+				}
+
+				//! Returns statistics of the calling thread's cache
+				ChunkAllocatorCacheStats thread_cache_stats() {
+					return cache_stats(thread_cache());
+				}
+
+				//! Flushes unused memory.
+				//! Keeps a small, size-class-specific empty-page cache warm by default.
+				//! \param releaseAll If true, thread-local caches are drained and all empty pages are released.
+				void flush(bool releaseAll = false) {
+					core::lock_scope lock(m_lock);
+					if (releaseAll)
+						drain_caches_inter();
+
+					for (auto& nodePages: m_pages) {
+						uint32_t i = 0;
+						for (auto& page: nodePages)
+							flushPages(page, i++, releaseAll);
+					}
+					verify_inter();
+				}
+
+				//! Performs diagnostics of the memory used.
+				void diag() const {
+					auto diagPage = [](const ChunkAllocatorPageStats& stats, uint32_t sizeType) {
+						GAIA_LOG_N("ChunkAllocator %uK stats", mem_block_size(sizeType) / 1024);
+						GAIA_LOG_N("  Allocated: %" PRIu64 " B", stats.mem_total);
+						GAIA_LOG_N("  Reserved by live blocks: %" PRIu64 " B", stats.mem_used);
+						GAIA_LOG_N("  Pages: %u", stats.num_pages);
+						GAIA_LOG_N("  Reusable pages: %u", stats.num_pages_free);
+	#if !GAIA_DEBUG
+						GAIA_LOG_N(
+								"  Utilization: %.1f%%",
+								stats.mem_total ? 100.0 * ((double)stats.mem_used / (double)stats.mem_total) : 0);
+	#else
+						GAIA_LOG_N("  Requested: %" PRIu64 " B", stats.mem_requested);
+						GAIA_LOG_N("  Free capacity: %" PRIu64 " B", stats.mem_total - stats.mem_used);
+						GAIA_LOG_N("  Internal slack: %" PRIu64 " B", stats.mem_used - stats.mem_requested);
+						GAIA_LOG_N(
+								"  Utilization: %.1f%%",
+								stats.mem_total ? 100.0 * ((double)stats.mem_requested / (double)stats.mem_total) : 0);
+						GAIA_LOG_N("  Empty pages: %u", stats.num_pages_empty);
+	#endif
+						const auto cacheAllocs = stats.cache_hits + stats.cache_misses;
+						if (cacheAllocs != 0) {
+							GAIA_LOG_N("  Cached blocks: %u", stats.num_blocks_cached);
+							GAIA_LOG_N(
+									"  Cache hit rate: %.1f%% (%" PRIu64 "/%" PRIu64 ")", 100.0 * ((double)stats.cache_hits / (double)cacheAllocs),
+									stats.cache_hits, cacheAllocs);
+						}
+					};
+
+					auto memStats = stats();
+					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType)
+						diagPage(memStats.stats[sizeType], sizeType);
+
+					if (memStats.arena.mem_reserved != 0) {
+						GAIA_LOG_N("ChunkAllocator arena stats");
+						GAIA_LOG_N("  Reserved: %" PRIu64 " B", memStats.arena.mem_reserved);
+						GAIA_LOG_N("  Carved: %" PRIu64 " B", memStats.arena.mem_carved);
+						GAIA_LOG_N("  Released: %" PRIu64 " B", memStats.arena.mem_released);
+						GAIA_LOG_N("  Spilled pages: %u", memStats.arena.num_pages_spilled);
+					}
+				}
+
+				void verify() const {
+	#if GAIA_ASSERT_ENABLED
+					core::lock_scope lock(m_lock);
+					verify_inter();
+	#endif
+				}
+
+			private:
+				static constexpr const char* s_strChunkAlloc_Chunk = "Chunk";
+				static constexpr const char* s_strChunkAlloc_MemPage = "MemoryPage";
+
+				GAIA_CLANG_WARNING_PUSH()
+				// Memory is aligned so we can silence this warning
+				GAIA_CLANG_WARNING_DISABLE("-Wcast-align")
+
+				static MemoryBlockHeader& block_header_from_ptr(void* pBlock) {
+					return *(MemoryBlockHeader*)((uint8_t*)pBlock - MemoryBlockUsableOffset);
+				}
+
+				GAIA_CLANG_WARNING_POP()
+
+				//! Maps a requested NUMA node onto the index of its page pool
+				GAIA_NODISCARD static uint32_t node_idx([[maybe_unused]] uint32_t node) {
+	#if GAIA_USE_NUMA
+					return node % mt::numa_node_cnt();
+	#else
+					return 0;
+	#endif
+				}
+
+				//! Allocates a block from the shared pages. The lock needs to be held by the caller.
+				void* alloc_inter(uint32_t node, uint8_t sizeType, [[maybe_unused]] uint32_t bytesWanted) {
+					auto& container = m_pages[node][sizeType];
 
 					MemoryPageState prevState = MemoryPageState::Partial;
 					auto* pPage = container.pagesPartial.first;
@@ -419,7 +924,7 @@ namespace gaia {
 						pPage = container.pagesEmpty.first;
 						if (pPage == nullptr) {
 							prevState = MemoryPageState::Detached;
-							pPage = alloc_page(sizeType);
+							pPage = alloc_page(node, sizeType);
 						}
 					}
 
@@ -431,22 +936,13 @@ namespace gaia {
 	#endif
 
 					move_page(container, pPage, prevState, state_for(*pPage));
-					verify();
 					return pBlock;
 				}
 
-				GAIA_CLANG_WARNING_PUSH()
-				// Memory is aligned so we can silence this warning
-				GAIA_CLANG_WARNING_DISABLE("-Wcast-align")
-
-				//! Releases memory allocated for pointer
-				void free(void* pBlock) {
-					GAIA_ASSERT(pBlock != nullptr);
-					if (pBlock == nullptr)
-						return;
-
+				//! Returns a block to the shared pages. The lock needs to be held by the caller.
+				void free_inter(void* pBlock) {
 					// Decode the page from the address
-					const auto& header = *(const MemoryBlockHeader*)((uint8_t*)pBlock - MemoryBlockUsableOffset);
+					const auto& header = block_header_from_ptr(pBlock);
 					const auto pageAddr = header.m_pageAddr;
 					GAIA_ASSERT(pageAddr % sizeof(uintptr_t) == 0);
 	#if GAIA_DEBUG
@@ -455,7 +951,7 @@ namespace gaia {
 					auto* pPage = (MemoryPage*)pageAddr;
 					const auto prevState = state_for(*pPage);
 
-					auto& container = m_pages[pPage->m_sizeType];
+					auto& container = m_pages[pPage->m_node][pPage->m_sizeType];
 
 	#if GAIA_ASSERT_ENABLED
 					if (prevState == MemoryPageState::Full) {
@@ -474,108 +970,252 @@ namespace gaia {
 
 					// Update lists
 					move_page(container, pPage, prevState, state_for(*pPage));
-					verify();
 
 					// Special handling for the allocator signaled to destroy itself
-					if (m_isDone) {
-						if (pPage->empty()) {
-							container.pagesEmpty.unlink(pPage);
-							free_page(pPage);
-						}
+					if (m_isDone && pPage->empty()) {
+						container.pagesEmpty.unlink(pPage);
+						free_page(pPage);
+					}
+				}
+
+				//! Allocates a block through the thread-local cache \param cache.
+				//! On a miss, a batch of blocks is taken from the shared pages with a single lock acquisition.
+				void* alloc_cached(ChunkAllocatorThreadCache& cache, uint32_t node, uint8_t sizeType, uint32_t bytesWanted) {
+					void* pBlock = nullptr;
+					{
+						core::lock_scope lock(cache.m_lock);
+						auto& magazine = cache.m_magazines[node][sizeType];
+						if (magazine.cnt != 0)
+							pBlock = magazine.blocks[--magazine.cnt];
+					}
+
+					if (pBlock != nullptr) {
+						ChunkAllocatorThreadCache::bump(cache.m_hits[sizeType]);
+	#if GAIA_DEBUG
+						block_header_from_ptr(pBlock).m_requestedBytes = bytesWanted;
+	#endif
+						return pBlock;
+					}
 
-						try_delete_this();
+					ChunkAllocatorThreadCache::bump(cache.m_misses[sizeType]);
+
+					// Refill the magazine. Locks are never nested in the cache -> allocator order.
+					void* batch[ChunkAllocatorCacheBatch];
+					{
+						core::lock_scope lock(m_lock);
+						GAIA_FOR(ChunkAllocatorCacheBatch) batch[i] = alloc_inter(node, sizeType, bytesWanted);
+						verify_inter();
+					}
+
+					{
+						core::lock_scope lock(cache.m_lock);
+						auto& magazine = cache.m_magazines[node][sizeType];
+						GAIA_FOR2(1, ChunkAllocatorCacheBatch) {
+							GAIA_ASSERT(magazine.cnt < ChunkAllocatorCacheBlocks);
+							magazine.blocks[magazine.cnt++] = batch[i];
+						}
 					}
+
+					return batch[0];
 				}
 
-				GAIA_CLANG_WARNING_POP()
+				//! Releases a block into the thread-local cache \param cache.
+				//! When the magazine is full, a batch of blocks is returned to the shared pages.
+				void free_cached(ChunkAllocatorThreadCache& cache, void* pBlock) {
+					const auto* pPage = (const MemoryPage*)block_header_from_ptr(pBlock).m_pageAddr;
+					const auto sizeType = pPage->m_sizeType;
+					const auto node = pPage->m_node;
 
-				//! Returns allocator statistics
-				ChunkAllocatorStats stats() const {
-					ChunkAllocatorStats stats{};
-					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType)
-						stats.stats[sizeType] = page_stats(sizeType);
-					return stats;
+	#if GAIA_DEBUG
+					std::memset(pBlock, MemoryPage::FreedBlockPattern, mem_block_size(sizeType) - MemoryBlockUsableOffset);
+	#endif
+
+					void* batch[ChunkAllocatorCacheBatch];
+					{
+						core::lock_scope lock(cache.m_lock);
+						auto& magazine = cache.m_magazines[node][sizeType];
+						if (magazine.cnt < ChunkAllocatorCacheBlocks) {
+							magazine.blocks[magazine.cnt++] = pBlock;
+							return;
+						}
+
+						// The magazine is full. Keep the most recently freed block and return the oldest ones.
+						GAIA_FOR(ChunkAllocatorCacheBatch) batch[i] = magazine.blocks[i];
+						GAIA_FOR2(ChunkAllocatorCacheBatch, ChunkAllocatorCacheBlocks) {
+							magazine.blocks[i - ChunkAllocatorCacheBatch] = magazine.blocks[i];
+						}
+						magazine.cnt -= ChunkAllocatorCacheBatch;
+						magazine.blocks[magazine.cnt++] = pBlock;
+					}
+
+					core::lock_scope lock(m_lock);
+					GAIA_FOR(ChunkAllocatorCacheBatch) free_inter(batch[i]);
+					verify_inter();
 				}
 
-				//! Flushes unused memory.
-				//! Keeps a small, size-class-specific empty-page cache warm by default.
-				void flush(bool releaseAll = false) {
-					uint32_t i = 0;
-					for (auto& page: m_pages)
-						flushPages(page, i++, releaseAll);
-					verify();
+				//! Returns the calling thread's cache. Registers it with the allocator on first use.
+				ChunkAllocatorThreadCache& thread_cache() {
+					static thread_local ChunkAllocatorThreadCache t_cache;
+					if GAIA_UNLIKELY (t_cache.m_pOwner == nullptr) {
+						core::lock_scope lock(m_lock);
+						t_cache.m_pOwner = this;
+						t_cache.m_pNext = m_pCaches;
+						m_pCaches = &t_cache;
+						++m_cacheCnt;
+					}
+					return t_cache;
 				}
 
-				//! Performs diagnostics of the memory used.
-				void diag() const {
-					auto diagPage = [](const ChunkAllocatorPageStats& stats, uint32_t sizeType) {
-						GAIA_LOG_N("ChunkAllocator %uK stats", mem_block_size(sizeType) / 1024);
-						GAIA_LOG_N("  Allocated: %" PRIu64 " B", stats.mem_total);
-						GAIA_LOG_N("  Reserved by live blocks: %" PRIu64 " B", stats.mem_used);
-						GAIA_LOG_N("  Pages: %u", stats.num_pages);
-						GAIA_LOG_N("  Reusable pages: %u", stats.num_pages_free);
-	#if !GAIA_DEBUG
-						GAIA_LOG_N(
-								"  Utilization: %.1f%%",
-								stats.mem_total ? 100.0 * ((double)stats.mem_used / (double)stats.mem_total) : 0);
-	#else
-						GAIA_LOG_N("  Requested: %" PRIu64 " B", stats.mem_requested);
-						GAIA_LOG_N("  Free capacity: %" PRIu64 " B", stats.mem_total - stats.mem_used);
-						GAIA_LOG_N("  Internal slack: %" PRIu64 " B", stats.mem_used - stats.mem_requested);
-						GAIA_LOG_N(
-								"  Utilization: %.1f%%",
-								stats.mem_total ? 100.0 * ((double)stats.mem_requested / (double)stats.mem_total) : 0);
-						GAIA_LOG_N("  Empty pages: %u", stats.num_pages_empty);
-	#endif
-					};
+				//! Returns all blocks held by \param cache to the shared pages.
+				//! The allocator lock needs to be held by the caller.
+				void drain_cache_inter(ChunkAllocatorThreadCache& cache) {
+					core::lock_scope lock(cache.m_lock);
+					for (auto& nodeMagazines: cache.m_magazines) {
+						for (auto& magazine: nodeMagazines) {
+							GAIA_FOR(magazine.cnt) free_inter(magazine.blocks[i]);
+							magazine.cnt = 0;
+						}
+					}
+				}
 
-					auto memStats = stats();
-					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType)
-						diagPage(memStats.stats[sizeType], sizeType);
+				//! Returns all blocks held by thread-local caches to the shared pages.
+				//! The allocator lock needs to be held by the caller.
+				void drain_caches_inter() {
+					for (auto* pCache = m_pCaches; pCache != nullptr; pCache = pCache->m_pNext)
+						drain_cache_inter(*pCache);
 				}
 
-				void verify() const {
-	#if GAIA_ASSERT_ENABLED
-					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType)
-						verify_container(m_pages[sizeType], sizeType);
-	#endif
+				//! Called when a thread owning \param cache exits.
+				void release_cache(ChunkAllocatorThreadCache& cache) {
+					bool deleteThis = false;
+					{
+						core::lock_scope lock(m_lock);
+						drain_cache_inter(cache);
+
+						auto** ppCache = &m_pCaches;
+						while (*ppCache != &cache)
+							ppCache = &(*ppCache)->m_pNext;
+						*ppCache = cache.m_pNext;
+						--m_cacheCnt;
+
+						cache.m_pOwner = nullptr;
+						cache.m_pNext = nullptr;
+						deleteThis = can_delete_inter();
+					}
+					if (deleteThis)
+						delete this;
 				}
 
-			private:
-				static constexpr const char* s_strChunkAlloc_Chunk = "Chunk";
-				static constexpr const char* s_strChunkAlloc_MemPage = "MemoryPage";
+				//! Unregisters all thread caches so they do not reference the allocator once it is gone
+				void detach_caches() {
+					core::lock_scope lock(m_lock);
+					auto* pCache = m_pCaches;
+					while (pCache != nullptr) {
+						auto* pNext = pCache->m_pNext;
+						{
+							core::lock_scope cacheLock(pCache->m_lock);
+							pCache->m_pOwner = nullptr;
+							pCache->m_pNext = nullptr;
+						}
+						pCache = pNext;
+					}
+					m_pCaches = nullptr;
+					m_cacheCnt = 0;
+				}
 
-				static MemoryPage* alloc_page(uint8_t sizeType) {
+				static ChunkAllocatorCacheStats cache_stats(ChunkAllocatorThreadCache& cache) {
+					ChunkAllocatorCacheStats stats{};
+					core::lock_scope lock(cache.m_lock);
+					for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType) {
+						stats.num_blocks[sizeType] = 0;
+						for (const auto& nodeMagazines: cache.m_magazines)
+							stats.num_blocks[sizeType] += nodeMagazines[sizeType].cnt;
+						stats.hits[sizeType] = cache.m_hits[sizeType].load(std::memory_order_relaxed);
+						stats.misses[sizeType] = cache.m_misses[sizeType].load(std::memory_order_relaxed);
+					}
+					return stats;
+				}
+
+				MemoryPage* alloc_page(uint32_t node, uint8_t sizeType) {
 					const uint32_t size = mem_block_size(sizeType) * MemoryPage::NBlocks;
+
+					if (m_arena.active()) {
+						const auto arenaSize = ChunkArena::page_bytes(sizeType);
+
+						// Reuse an address range released before
+						auto& released = m_arena.m_pagesReleased[sizeType];
+						if (released.first != nullptr) {
+							auto* pMemoryPage = released.first;
+							released.unlink(pMemoryPage);
+							m_arena.m_released -= arenaSize;
+
+							auto* pPageData = pMemoryPage->m_data;
+							pMemoryPage->~MemoryPage();
+							// The range may have belonged to a different node before
+							mt::numa_bind_mem(pPageData, arenaSize, node);
+							return new (pMemoryPage) MemoryPage(pPageData, sizeType, (uint8_t)node);
+						}
+
+						if (auto* pPageData = m_arena.carve(arenaSize)) {
+							mt::numa_bind_mem(pPageData, arenaSize, node);
+							auto* pMemoryPage = mem::AllocHelper::alloc<MemoryPage>(s_strChunkAlloc_MemPage);
+							return new (pMemoryPage) MemoryPage(pPageData, sizeType, (uint8_t)node);
+						}
+
+						// The arena is exhausted, fall back to the heap
+						++m_arena.m_spilled;
+					}
+
 					auto* pPageData = mem::AllocHelper::alloc_alig<uint8_t>(s_strChunkAlloc_Chunk, MemoryBlockAlignment, size);
+					// Without libnuma this is a no-op and the page lands on the node of the thread touching it first
+					mt::numa_bind_mem(pPageData, size, node);
 					auto* pMemoryPage = mem::AllocHelper::alloc<MemoryPage>(s_strChunkAlloc_MemPage);
-					return new (pMemoryPage) MemoryPage(pPageData, sizeType);
+					return new (pMemoryPage) MemoryPage(pPageData, sizeType, (uint8_t)node);
 				}
 
-				static void free_page(MemoryPage* pMemoryPage) {
+				void free_page(MemoryPage* pMemoryPage) {
 					GAIA_ASSERT(pMemoryPage != nullptr);
 
+					if (m_arena.owns(pMemoryPage->m_data)) {
+						// Keep the address range, give the physical memory back to the OS
+						const auto size = ChunkArena::page_bytes(pMemoryPage->m_sizeType);
+						ChunkArena::discard(pMemoryPage->m_data, size);
+						m_arena.m_released += size;
+						m_arena.m_pagesReleased[pMemoryPage->m_sizeType].link(pMemoryPage);
+						return;
+					}
+
 					mem::AllocHelper::free_alig(s_strChunkAlloc_Chunk, pMemoryPage->m_data);
 					pMemoryPage->~MemoryPage();
 					mem::AllocHelper::free(s_strChunkAlloc_MemPage, pMemoryPage);
 				}
 
 				void done() {
+					core::lock_scope lock(m_lock);
 					m_isDone = true;
+
+					// Blocks parked in thread caches would keep their pages alive forever
+					drain_caches_inter();
 				}
 
-				void try_delete_this() {
-					// When there is nothing left, delete the allocator
-					bool allEmpty = true;
-					for (const auto& c: m_pages)
-						allEmpty = allEmpty && c.empty();
-					if (allEmpty)
-						delete this;
+				//! Returns true when nothing is left and the allocator signaled to destroy itself can be deleted.
+				//! The lock needs to be held by the caller.
+				bool can_delete_inter() const {
+					if (!m_isDone)
+						return false;
+
+					for (const auto& nodePages: m_pages) {
+						for (const auto& c: nodePages) {
+							if (!c.empty())
+								return false;
+						}
+					}
+					return true;
 				}
 
 				static constexpr uint32_t warm_pages_to_keep(uint32_t sizeType) {
-					constexpr uint8_t WarmPagesPerSizeClass[] = {1, 1, 0, 0};
-					return WarmPagesPerSizeClass[sizeType];
+					constexpr uint8_t WarmPagesPerSizeClass[RegularMemoryBlockSizeClasses] = {1, 1, 0, 0};
+					return sizeType < RegularMemoryBlockSizeClasses ? WarmPagesPerSizeClass[sizeType] : 0;
 				}
 
 				static MemoryPageState state_for(const MemoryPage& page) {
@@ -639,32 +1279,44 @@ namespace gaia {
 					}
 				}
 
+				void verify_inter() const {
+	#if GAIA_ASSERT_ENABLED
+					for (const auto& nodePages: m_pages) {
+						for (uint32_t sizeType = 0; sizeType < MemoryBlockSizeClasses; ++sizeType)
+							verify_container(nodePages[sizeType], sizeType);
+					}
+	#endif
+				}
+
 				ChunkAllocatorPageStats page_stats(uint32_t sizeType) const {
 					ChunkAllocatorPageStats stats{};
-					const auto& container = m_pages[sizeType];
 					const auto blockSize = (uint64_t)mem_block_size(sizeType);
 					const auto pageSize = blockSize * MemoryPage::NBlocks;
 
-					stats.num_pages = (uint32_t)container.pagesEmpty.size() + (uint32_t)container.pagesPartial.size() +
-														(uint32_t)container.pagesFull.size();
-					stats.num_pages_free = (uint32_t)container.pagesEmpty.size() + (uint32_t)container.pagesPartial.size();
-					stats.mem_total = stats.num_pages * pageSize;
-					stats.mem_used = container.pagesFull.size() * pageSize;
+					for (const auto& nodePages: m_pages) {
+						const auto& container = nodePages[sizeType];
+						const auto numPages = (uint32_t)container.pagesEmpty.size() + (uint32_t)container.pagesPartial.size() +
+																	(uint32_t)container.pagesFull.size();
+						stats.num_pages += numPages;
+						stats.num_pages_free += (uint32_t)container.pagesEmpty.size() + (uint32_t)container.pagesPartial.size();
+						stats.mem_total += numPages * pageSize;
+						stats.mem_used += container.pagesFull.size() * pageSize;
 
 	#if GAIA_DEBUG
-					stats.num_pages_empty = (uint32_t)container.pagesEmpty.size();
+						stats.num_pages_empty += (uint32_t)container.pagesEmpty.size();
 
-					for (const auto& page: container.pagesFull)
-						stats.mem_requested += page.requested_bytes();
+						for (const auto& page: container.pagesFull)
+							stats.mem_requested += page.requested_bytes();
 
-					for (const auto& page: container.pagesPartial) {
-						stats.mem_used += page.used_blocks_cnt() * blockSize;
-						stats.mem_requested += page.requested_bytes();
-					}
+						for (const auto& page: container.pagesPartial) {
+							stats.mem_used += page.used_blocks_cnt() * blockSize;
+							stats.mem_requested += page.requested_bytes();
+						}
 	#else
-					for (const auto& page: container.pagesPartial)
-						stats.mem_used += page.used_blocks_cnt() * blockSize;
+						for (const auto& page: container.pagesPartial)
+							stats.mem_used += page.used_blocks_cnt() * blockSize;
 	#endif
+					}
 
 					return stats;
 				}
@@ -692,6 +1344,16 @@ namespace gaia {
 					}
 				}
 			};
+
+			inline ChunkAllocatorThreadCache::~ChunkAllocatorThreadCache() {
+				ChunkAllocatorImpl* pOwner = nullptr;
+				{
+					core::lock_scope lock(m_lock);
+					pOwner = m_pOwner;
+				}
+				if (pOwner != nullptr)
+					pOwner->release_cache(*this);
+			}
 		} // namespace detail
 		//! \endcond
 
@@ -35,6 +35,8 @@ namespace gaia {
 			uint8_t* pData;
 			//! Pointer to component cache record
 			const ComponentCacheItem* pItem;
+			//! Pointer to the dirty row bitset of the component. Nullptr unless the component tracks changes per row.
+			uint64_t* pDirtyRows;
 		};
 
 		struct GAIA_API ChunkRecords {
@@ -53,10 +55,22 @@ namespace gaia {
 			//! Maximum number of components on archetype
 			static constexpr uint32_t MAX_COMPONENTS = 1U << MAX_COMPONENTS_BITS;
 
-			//! Maximum number of entities per chunk.
+			//! Maximum number of entities per regular chunk.
 			//! Defined as sizeof(big_chunk) / sizeof(entity)
-			static constexpr uint16_t MAX_CHUNK_ENTITIES = (mem_block_size(2) - 64) / sizeof(Entity);
-			static constexpr uint16_t MAX_CHUNK_ENTITIES_BITS = (uint16_t)core::count_bits(MAX_CHUNK_ENTITIES);
+			static constexpr ChunkRow MAX_CHUNK_ENTITIES = (mem_block_size(2) - 64) / sizeof(Entity);
+#if GAIA_ECS_WIDE_CHUNKS
+			//! Maximum number of entities per wide chunk.
+			//! Defined as sizeof(widest_chunk) / sizeof(entity)
+			static constexpr ChunkRow MAX_WIDE_CHUNK_ENTITIES =
+					(MaxMemoryBlockSize - 64) / sizeof(Entity);
+			static constexpr ChunkRow MAX_CHUNK_ENTITIES_BITS = (ChunkRow)core::count_bits(MAX_WIDE_CHUNK_ENTITIES);
+#else
+			static constexpr ChunkRow MAX_CHUNK_ENTITIES_BITS = (ChunkRow)core::count_bits(MAX_CHUNK_ENTITIES);
+#endif
+
+			//! Chunk capacities are multiples of this many rows so padded SIMD views (see Iter::simd_view) never reach
+			//! past the end of a column. Chunks too small to hold that many rows use the largest power of two below it.
+			static constexpr uint32_t SIMD_ROW_GRANULE = 16;
 
 			static constexpr uint16_t CHUNK_LIFESPAN_BITS = 4;
 			//! Number of ticks before empty chunks are removed
@@ -71,14 +85,14 @@ namespace gaia {
 			//! Index in World's chunk-delete queue. BadIndex when not queued for deletion.
 			uint32_t deleteQueueIndex;
 			//! Total number of entities in the chunk.
-			uint16_t count;
+			ChunkRow count;
 			//! Number of enabled entities in the chunk.
-			uint16_t countEnabled;
+			ChunkRow countEnabled;
 			//! Capacity (copied from the owner archetype).
-			uint16_t capacity;
+			ChunkRow capacity;
 
 			//! Index of the first enabled entity in the chunk
-			uint16_t rowFirstEnabledEntity : MAX_CHUNK_ENTITIES_BITS;
+			ChunkRow rowFirstEnabledEntity : MAX_CHUNK_ENTITIES_BITS;
 			//! True if there's any generic component that requires custom construction
 			uint16_t hasAnyCustomGenCtor : 1;
 			//! True if there's any unique component that requires custom construction
@@ -98,6 +112,8 @@ namespace gaia {
 			uint8_t genEntities;
 			//! Number of components on the archetype
 			uint8_t cntEntities;
+			//! Number of components tracking changes per row
+			uint8_t cntDirtyRows;
 			//! Version of the world (stable pointer to parent world's world version)
 			uint32_t& worldVersion;
 			//! Version tracking entity order changes inside the chunk.
@@ -108,7 +124,7 @@ namespace gaia {
 			ChunkHeader(): worldVersion(s_worldVersionDummy), entityOrderVersion(0) {}
 
 			ChunkHeader(
-					const World& wld, const ComponentCache& compCache, uint32_t chunkIndex, uint16_t cap, uint8_t genEntitiesCnt,
+					const World& wld, const ComponentCache& compCache, uint32_t chunkIndex, ChunkRow cap, uint8_t genEntitiesCnt,
 					uint32_t& version):
 					world(&wld), cc(&compCache), index(chunkIndex), deleteQueueIndex(BadIndex), count(0), countEnabled(0),
 					capacity(cap),
@@ -116,7 +132,7 @@ namespace gaia {
 					rowFirstEnabledEntity(0), hasAnyCustomGenCtor(0), hasAnyCustomUniCtor(0), hasAnyCustomGenDtor(0),
 					hasAnyCustomUniDtor(0), lifespanCountdown(0), dead(0), unused(0),
 					//
-					genEntities(genEntitiesCnt), cntEntities(0), worldVersion(version), entityOrderVersion(0) {
+					genEntities(genEntitiesCnt), cntEntities(0), cntDirtyRows(0), worldVersion(version), entityOrderVersion(0) {
 				// Make sure the alignment is right
 				GAIA_ASSERT(uintptr_t(this) % (sizeof(size_t)) == 0);
 			}
@@ -112,8 +112,8 @@ namespace gaia {
 			struct BfsChunkRun {
 				const Archetype* pArchetype = nullptr;
 				Chunk* pChunk = nullptr;
-				uint16_t from = 0;
-				uint16_t to = 0;
+				ChunkRow from = 0;
+				ChunkRow to = 0;
 				uint32_t offset = 0;
 			};
 
@@ -420,7 +420,7 @@ namespace gaia {
 				}
 
 				static EntityTermViewGet entity_chunk_stable(
-						const Entity* pEntities, const Chunk* pChunk, World* pWorld, Entity id, uint16_t rowBase, uint32_t cnt) {
+						const Entity* pEntities, const Chunk* pChunk, World* pWorld, Entity id, ChunkRow rowBase, uint32_t cnt) {
 					uint32_t compIdx = BadIndex;
 					const U* pDataInherited = nullptr;
 					bool direct = false;
@@ -566,6 +566,10 @@ namespace gaia {
 				GAIA_NODISCARD constexpr size_t size() const noexcept {
 					return cnt;
 				}
+
+				GAIA_NODISCARD const value_type* data() const noexcept {
+					return pData;
+				}
 			};
 
 			//! Read-only field proxy for a single SoA member resolved through the world.
@@ -614,6 +618,14 @@ namespace gaia {
 				GAIA_NODISCARD constexpr size_t size() const noexcept {
 					return cnt;
 				}
+
+				GAIA_NODISCARD value_type* data() noexcept {
+					return pData;
+				}
+
+				GAIA_NODISCARD const value_type* data() const noexcept {
+					return pData;
+				}
 			};
 
 			//! Mutable field proxy for a single SoA member resolved through the world.
@@ -1044,6 +1056,45 @@ namespace gaia {
 				}
 			};
 
+			//! Scratch state of a QueryImpl::each_simd() iteration.
+			//! Padded SIMD views may cover rows of live entities outside of the iterated range, e.g. disabled entities
+			//! sharing a vector with the first enabled one. Values of such rows are saved when a mutable view is handed
+			//! out and written back once the callback returns so writes to padding lanes are never observable.
+			struct SimdIterState {
+				using FuncRestore = void (*)(uint8_t* pColumn, uint32_t capacity, uint32_t row, uint32_t cnt, const uint8_t*);
+
+				struct SavedRows {
+					//! Writes the saved values back to the column
+					FuncRestore restore;
+					//! Column the rows were saved from
+					uint8_t* pColumn;
+					//! Capacity of the chunk owning the column
+					uint32_t capacity;
+					//! First saved row
+					uint32_t row;
+					//! Number of saved rows
+					uint32_t cnt;
+					//! Offset of the saved values in the byte buffer
+					uint32_t offset;
+				};
+
+				//! Values of saved rows
+				cnt::darray<uint8_t> bytes;
+				//! Saved row ranges
+				cnt::darray<SavedRows> rows;
+
+				//! Writes all saved rows back. Ranges saved later are restored first so if the same rows were saved
+				//! more than once, the oldest values win.
+				void restore() {
+					for (auto i = (uint32_t)rows.size(); i > 0; --i) {
+						const auto& saved = rows[i - 1];
+						saved.restore(saved.pColumn, saved.capacity, saved.row, saved.cnt, bytes.data() + saved.offset);
+					}
+					rows.clear();
+					bytes.clear();
+				}
+			};
+
 			class ChunkIterImpl {
 				friend struct ChunkIterTypedOps;
 
@@ -1073,16 +1124,23 @@ namespace gaia {
 				Entity m_touchedTerms[ChunkHeader::MAX_COMPONENTS];
 				uint8_t m_touchedTermCnt = 0;
 				//! Stable copy of the currently iterated entity rows for mutable world-resolved views.
+#if GAIA_ECS_WIDE_CHUNKS
+				//! Wide chunks can hold too many rows to keep the copy inline.
+				cnt::darray<Entity> m_entitySnapshot;
+#else
 				Entity m_entitySnapshot[ChunkHeader::MAX_CHUNK_ENTITIES];
+#endif
 				bool m_entitySnapshotValid = false;
 				//! Row of the first entity we iterate from
-				uint16_t m_from;
+				ChunkRow m_from;
 				//! Row of the last entity we iterate to
-				uint16_t m_to;
+				ChunkRow m_to;
 				//! GroupId. 0 if not set.
 				GroupId m_groupId = 0;
 				//! User-owned pointer supplied by the caller driving this iteration.
 				void* m_pCtx = nullptr;
+				//! SIMD scratch state. Set only while running a QueryImpl::each_simd() callback.
+				SimdIterState* m_pSimd = nullptr;
 
 			public:
 				ChunkIterImpl() = default;
@@ -1130,7 +1188,7 @@ namespace gaia {
 					m_to = end_index(m_pChunk, m_constraints);
 				}
 
-				void set_chunk(Chunk* pChunk, uint16_t from, uint16_t to) {
+				void set_chunk(Chunk* pChunk, ChunkRow from, ChunkRow to) {
 					if (from == 0 && to == 0) {
 						set_chunk(pChunk);
 						return;
@@ -1204,7 +1262,7 @@ namespace gaia {
 				//! \param from First row exposed from \a pChunk.
 				//! \param to One-past-the-end row exposed from \a pChunk.
 				void set_query_chunk(
-						const Archetype* pArchetype, const uint8_t* pCompIndices, Chunk* pChunk, uint16_t from, uint16_t to) {
+						const Archetype* pArchetype, const uint8_t* pCompIndices, Chunk* pChunk, ChunkRow from, ChunkRow to) {
 					GAIA_ASSERT(pArchetype != nullptr);
 					GAIA_ASSERT(pChunk != nullptr);
 					if (m_pArchetype != pArchetype)
@@ -1230,10 +1288,23 @@ namespace gaia {
 					m_touchedTermCnt = 0;
 				}
 
+				GAIA_NODISCARD const Entity* entity_snapshot_data() const {
+#if GAIA_ECS_WIDE_CHUNKS
+					return m_entitySnapshot.data();
+#else
+					return m_entitySnapshot;
+#endif
+				}
+
 				GAIA_NODISCARD const Entity* entity_snapshot() {
 					if (!m_entitySnapshotValid) {
 						const auto cnt = size();
+#if GAIA_ECS_WIDE_CHUNKS
+						if (m_entitySnapshot.size() < cnt)
+							m_entitySnapshot.resize(cnt);
+#else
 						GAIA_ASSERT(cnt <= ChunkHeader::MAX_CHUNK_ENTITIES);
+#endif
 
 						const auto entities = m_pChunk->entity_view();
 						GAIA_FOR(cnt) {
@@ -1243,7 +1314,7 @@ namespace gaia {
 						m_entitySnapshotValid = true;
 					}
 
-					return m_entitySnapshot;
+					return entity_snapshot_data();
 				}
 
 				GAIA_NODISCARD auto touched_comp_indices() const {
@@ -1256,7 +1327,7 @@ namespace gaia {
 
 				GAIA_NODISCARD auto entity_rows() {
 					if (m_entitySnapshotValid)
-						return std::span<const Entity>{m_entitySnapshot, size()};
+						return std::span<const Entity>{entity_snapshot_data(), size()};
 
 					return std::span<const Entity>{m_pChunk->entity_view().data() + from(), size()};
 				}
@@ -1476,7 +1547,7 @@ namespace gaia {
 					if (trackWrite) {
 						touch_comp_idx(compIdx);
 						if (m_writeIm)
-							m_pChunk->update_world_version(compIdx);
+							m_pChunk->update_world_version(compIdx, from(), to());
 					}
 
 					const auto& rec = m_pChunk->comp_rec_view()[compIdx];
@@ -1506,7 +1577,7 @@ namespace gaia {
 					if (trackWrite) {
 						touch_comp_idx(compIdx);
 						if (m_writeIm)
-							m_pChunk->update_world_version(compIdx);
+							m_pChunk->update_world_version(compIdx, from(), to());
 					}
 
 					const auto elemSize = rec.comp.size();
@@ -1876,7 +1947,7 @@ namespace gaia {
 				//! Checks if the entity at the current iterator index is enabled.
 				//! \return True it the entity is enabled. False otherwise.
 				GAIA_NODISCARD bool enabled(uint32_t index) const {
-					const auto row = (uint16_t)(from() + index);
+					const auto row = (ChunkRow)(from() + index);
 					return m_pChunk->enabled(row);
 				}
 
@@ -1902,19 +1973,116 @@ namespace gaia {
 					return m_pChunk->template has<T>();
 				}
 
-				GAIA_NODISCARD static uint16_t start_index(Chunk* pChunk, Constraints constraints) noexcept {
+				//! Returns runs of rows whose component \a T was written since its dirty rows were last cleared.
+				//! Row indices are relative to the iterator, the same way view indices are.
+				//! If \a T does not track changes per row (see GAIA_CHANGE_TRACKING), all rows are reported.
+				//! \tparam T Component
+				//! \return Iterable sequence of DirtyRowRun.
+				template <typename T>
+				GAIA_NODISCARD DirtyRowRuns dirty_rows() const {
+					const auto compIdx = m_pChunk->comp_idx(m_pChunk->template comp_entity<T>());
+					GAIA_ASSERT(compIdx != BadIndex);
+					return m_pChunk->dirty_rows(compIdx, from(), to());
+				}
+
+				//! Clears the dirty state of the component \a T for all rows accessible via the iterator.
+				//! \tparam T Component
+				template <typename T>
+				void clear_dirty_rows() {
+					const auto compIdx = m_pChunk->comp_idx(m_pChunk->template comp_entity<T>());
+					GAIA_ASSERT(compIdx != BadIndex);
+					m_pChunk->clear_dirty_rows(compIdx, from(), to());
+				}
+
+				//! \name SIMD views
+				//! \{
+				//! Views covering whole vectors of \a Width rows, starting at the iterator's first row rounded down to
+				//! a multiple of \a Width. Kernels can therefore run over full vectors with no scalar head or tail loop.
+				//! Rows covered only because of the padding are never reported as changed. Those belonging to live
+				//! entities outside of the iterated range are restored once the QueryImpl::each_simd() callback returns.
+				//! Mutable views are only available inside QueryImpl::each_simd().
+				//! Columns are aligned to the component's alignment. Use GAIA_LAYOUT(SoA8) or GAIA_LAYOUT(SoA16) when
+				//! aligned vector loads are needed.
+
+				//! Returns the number of padding lanes in front of the first iterated row.
+				//! Lane `i` of a SIMD view corresponds to entity `i - simd_offset<Width>()` of regular views.
+				//! \tparam Width Number of lanes in a vector
+				template <uint32_t Width>
+				GAIA_NODISCARD uint32_t simd_offset() const {
+					return from() - simd_from<Width>();
+				}
+
+				//! Returns the number of lanes covered by SIMD views. Always a multiple of \a Width.
+				//! \tparam Width Number of lanes in a vector
+				template <uint32_t Width>
+				GAIA_NODISCARD uint32_t simd_size() const {
+					return simd_to<Width>() - simd_from<Width>();
+				}
+
+				//! Returns a read-only padded view of the component \a T.
+				//! \tparam T Component
+				//! \tparam Width Number of lanes in a vector
+				template <typename T, uint32_t Width>
+				GAIA_NODISCARD auto simd_view() const {
+					return simd_view_inter<T, Width>(simd_comp_idx<T>());
+				}
+
+				//! Returns a read-only padded view of the component \a T for the query term \a termIdx.
+				//! \tparam T Component
+				//! \tparam Width Number of lanes in a vector
+				//! \param termIdx Query term index
+				template <typename T, uint32_t Width>
+				GAIA_NODISCARD auto simd_view(uint32_t termIdx) const {
+					GAIA_ASSERT(m_pCompIndices != nullptr && m_pCompIndices[termIdx] != 0xFF);
+					return simd_view_inter<T, Width>(m_pCompIndices[termIdx]);
+				}
+
+				//! Returns a mutable padded view of the component \a T.
+				//! \tparam T Component
+				//! \tparam Width Number of lanes in a vector
+				template <typename T, uint32_t Width>
+				GAIA_NODISCARD auto simd_view_mut() {
+					return simd_view_mut_inter<T, Width>(simd_comp_idx<T>());
+				}
+
+				//! Returns a mutable padded view of the component \a T for the query term \a termIdx.
+				//! \tparam T Component
+				//! \tparam Width Number of lanes in a vector
+				//! \param termIdx Query term index
+				template <typename T, uint32_t Width>
+				GAIA_NODISCARD auto simd_view_mut(uint32_t termIdx) {
+					GAIA_ASSERT(m_pCompIndices != nullptr && m_pCompIndices[termIdx] != 0xFF);
+					return simd_view_mut_inter<T, Width>(m_pCompIndices[termIdx]);
+				}
+				//! \}
+
+				//! Starts a SIMD callback. Mutable SIMD views save padding rows of live entities into \a pState.
+				//! \param pState Scratch state kept alive until simd_end() is called
+				void simd_begin(SimdIterState* pState) {
+					GAIA_ASSERT(pState != nullptr);
+					m_pSimd = pState;
+				}
+
+				//! Finishes a SIMD callback. Padding rows saved since simd_begin() are written back.
+				void simd_end() {
+					GAIA_ASSERT(m_pSimd != nullptr);
+					m_pSimd->restore();
+					m_pSimd = nullptr;
+				}
+
+				GAIA_NODISCARD static ChunkRow start_index(Chunk* pChunk, Constraints constraints) noexcept {
 					if (constraints == Constraints::EnabledOnly)
 						return pChunk->size_disabled();
 					return 0;
 				}
 
-				GAIA_NODISCARD static uint16_t end_index(Chunk* pChunk, Constraints constraints) noexcept {
+				GAIA_NODISCARD static ChunkRow end_index(Chunk* pChunk, Constraints constraints) noexcept {
 					if (constraints == Constraints::DisabledOnly)
 						return pChunk->size_disabled();
 					return pChunk->size();
 				}
 
-				GAIA_NODISCARD static uint16_t size(Chunk* pChunk, Constraints constraints) noexcept {
+				GAIA_NODISCARD static ChunkRow size(Chunk* pChunk, Constraints constraints) noexcept {
 					if (constraints == Constraints::EnabledOnly)
 						return pChunk->size_enabled();
 					if (constraints == Constraints::DisabledOnly)
@@ -1923,17 +2091,17 @@ namespace gaia {
 				}
 
 				//! Returns the number of entities accessible via the iterator
-				GAIA_NODISCARD uint16_t size() const noexcept {
-					return (uint16_t)(to() - from());
+				GAIA_NODISCARD ChunkRow size() const noexcept {
+					return (ChunkRow)(to() - from());
 				}
 
 				//! Returns the first row covered by the iterator in the current chunk.
-				GAIA_NODISCARD uint16_t row_begin() const noexcept {
+				GAIA_NODISCARD ChunkRow row_begin() const noexcept {
 					return from();
 				}
 
 				//! Returns one-past-the-end row covered by the iterator in the current chunk.
-				GAIA_NODISCARD uint16_t row_end() const noexcept {
+				GAIA_NODISCARD ChunkRow row_end() const noexcept {
 					return to();
 				}
 
@@ -1949,14 +2117,127 @@ namespace gaia {
 						return idx;
 				}
 
+			protected:
+				template <uint32_t Width>
+				GAIA_NODISCARD uint32_t simd_from() const {
+					static_assert(core::is_pow2(Width) && Width <= ChunkHeader::SIMD_ROW_GRANULE);
+					return (uint32_t)from() & ~(Width - 1);
+				}
+
+				template <uint32_t Width>
+				GAIA_NODISCARD uint32_t simd_to() const {
+					static_assert(core::is_pow2(Width) && Width <= ChunkHeader::SIMD_ROW_GRANULE);
+					const auto row = ((uint32_t)to() + Width - 1) & ~(Width - 1);
+					// Chunk capacities are multiples of the vector width unless the chunk holds very few rows
+					GAIA_ASSERT(row <= m_pChunk->capacity());
+					return row;
+				}
+
+				template <typename T>
+				GAIA_NODISCARD uint32_t simd_comp_idx() const {
+					const auto compIdx = m_pChunk->comp_idx(m_pChunk->template comp_entity<T>());
+					GAIA_ASSERT(compIdx != BadIndex);
+					return compIdx;
+				}
+
+				template <typename U>
+				static void simd_check_type() {
+					static_assert(!std::is_same_v<U, Entity>, "SIMD views are not available for entities");
+					static_assert(std::is_trivially_copyable_v<U>, "SIMD views require trivially copyable components");
+				}
+
+				template <typename T, uint32_t Width>
+				GAIA_NODISCARD auto simd_view_inter(uint32_t compIdx) const {
+					using U = typename actual_type_t<T>::Type;
+					simd_check_type<U>();
+					GAIA_ASSERT(compIdx < m_pChunk->comp_rec_view().size());
+
+					const auto rowFrom = simd_from<Width>();
+					const auto cnt = simd_to<Width>() - rowFrom;
+					if constexpr (mem::is_soa_layout_v<U>)
+						return SoATermViewGetPointer<U>{m_pChunk->comp_ptr(compIdx), m_pChunk->capacity(), rowFrom, cnt};
+					else
+						return EntityTermViewGetPointer<U>{reinterpret_cast<const U*>(m_pChunk->comp_ptr(compIdx)) + rowFrom, cnt};
+				}
+
+				template <typename T, uint32_t Width>
+				GAIA_NODISCARD auto simd_view_mut_inter(uint32_t compIdx) {
+					using U = typename actual_type_t<T>::Type;
+					simd_check_type<U>();
+					GAIA_ASSERT(compIdx < m_pChunk->comp_rec_view().size());
+					GAIA_ASSERT(m_pSimd != nullptr && "Mutable SIMD views are only available inside each_simd");
+
+					const auto rowFrom = simd_from<Width>();
+					const auto rowTo = simd_to<Width>();
+					auto* pColumn = m_pChunk->comp_ptr_mut(compIdx);
+					const auto capacity = (uint32_t)m_pChunk->capacity();
+
+					// Padding lanes may hold live entities outside of the iterated range. Save them so the callback
+					// can write to whole vectors freely.
+					const auto size = (uint32_t)m_pChunk->size();
+					simd_save_rows<U>(pColumn, capacity, rowFrom, from());
+					if (to() < size)
+						simd_save_rows<U>(pColumn, capacity, to(), core::get_min(rowTo, size));
+
+					// Only the iterated rows are reported as changed
+					touch_comp_idx((uint8_t)compIdx);
+					if (m_writeIm)
+						m_pChunk->update_world_version(compIdx, from(), to());
+
+					if constexpr (mem::is_soa_layout_v<U>)
+						return SoATermViewSetPointer<U>{pColumn, capacity, rowFrom, rowTo - rowFrom};
+					else
+						return EntityTermViewSetPointer<U>{reinterpret_cast<U*>(pColumn) + rowFrom, rowTo - rowFrom};
+				}
+
+				template <typename U>
+				void simd_save_rows(uint8_t* pColumn, uint32_t capacity, uint32_t rowFrom, uint32_t rowTo) {
+					if (rowFrom >= rowTo)
+						return;
+
+					const auto cnt = rowTo - rowFrom;
+					auto& bytes = m_pSimd->bytes;
+					const auto offset = (uint32_t)bytes.size();
+					bytes.resize(offset + cnt * (uint32_t)sizeof(U));
+					auto* pSaved = bytes.data() + offset;
+					if constexpr (mem::is_soa_layout_v<U>) {
+						using view_policy = mem::data_view_policy_soa<U::gaia_Data_Layout, U>;
+						const std::span<const uint8_t> column{pColumn, capacity};
+						GAIA_FOR(cnt) {
+							const U value = view_policy::get(column, rowFrom + i);
+							memcpy((void*)(pSaved + i * sizeof(U)), (const void*)&value, sizeof(U));
+						}
+					} else {
+						memcpy((void*)pSaved, (const void*)(pColumn + rowFrom * sizeof(U)), cnt * sizeof(U));
+					}
+
+					m_pSimd->rows.push_back({&simd_restore_rows<U>, pColumn, capacity, rowFrom, cnt, offset});
+				}
+
+				template <typename U>
+				static void
+				simd_restore_rows(uint8_t* pColumn, uint32_t capacity, uint32_t row, uint32_t cnt, const uint8_t* pSaved) {
+					if constexpr (mem::is_soa_layout_v<U>) {
+						using view_policy = mem::data_view_policy_soa<U::gaia_Data_Layout, U>;
+						const std::span<uint8_t> column{pColumn, capacity};
+						GAIA_FOR(cnt) {
+							U value;
+							memcpy((void*)&value, (const void*)(pSaved + i * sizeof(U)), sizeof(U));
+							view_policy::set(column, row + i) = value;
+						}
+					} else {
+						memcpy((void*)(pColumn + row * sizeof(U)), (const void*)pSaved, cnt * sizeof(U));
+					}
+				}
+
 			protected:
 				//! Returns the starting index of the iterator
-				GAIA_NODISCARD uint16_t from() const noexcept {
+				GAIA_NODISCARD ChunkRow from() const noexcept {
 					return m_from;
 				}
 
 				//! Returns the ending index of the iterator (one past the last valid index)
-				GAIA_NODISCARD uint16_t to() const noexcept {
+				GAIA_NODISCARD ChunkRow to() const noexcept {
 					return m_to;
 				}
 			};
@@ -1979,34 +2260,34 @@ namespace gaia {
 			//! Returns the first enabled row in a chunk.
 			//! \param pChunk Chunk whose enabled range is inspected.
 			//! \return Index of the first enabled row.
-			GAIA_NODISCARD static uint16_t start_index(Chunk* pChunk) noexcept {
+			GAIA_NODISCARD static ChunkRow start_index(Chunk* pChunk) noexcept {
 				return detail::ChunkIterImpl::start_index(pChunk, ConstraintMode);
 			}
 
 			//! Returns the end of the enabled row range in a chunk.
 			//! \param pChunk Chunk whose enabled range is inspected.
 			//! \return One-past-the-last enabled row index.
-			GAIA_NODISCARD static uint16_t end_index(Chunk* pChunk) noexcept {
+			GAIA_NODISCARD static ChunkRow end_index(Chunk* pChunk) noexcept {
 				return detail::ChunkIterImpl::end_index(pChunk, ConstraintMode);
 			}
 
 			//! Returns the number of enabled rows in a chunk.
 			//! \param pChunk Chunk whose enabled range is inspected.
 			//! \return Number of enabled rows.
-			GAIA_NODISCARD static uint16_t size(Chunk* pChunk) noexcept {
+			GAIA_NODISCARD static ChunkRow size(Chunk* pChunk) noexcept {
 				return detail::ChunkIterImpl::size(pChunk, ConstraintMode);
 			}
 
 			//! Returns the number of enabled entities accessible via the iterator.
 			//! \return Number of enabled entities in the current chunk.
-			GAIA_NODISCARD uint16_t size_enabled() const noexcept {
+			GAIA_NODISCARD ChunkRow size_enabled() const noexcept {
 				return m_pChunk->size_enabled();
 			}
 
 			//! Returns the number of disabled entities accessible via the iterator.
 			//! Can be read also as "the index of the first enabled entity".
 			//! \return Number of disabled entities in the current chunk.
-			GAIA_NODISCARD uint16_t size_disabled() const noexcept {
+			GAIA_NODISCARD ChunkRow size_disabled() const noexcept {
 				return m_pChunk->size_disabled();
 			}
 		};
@@ -2024,9 +2305,9 @@ namespace gaia {
 			//! Chunk currently associated with the iterator
 			Chunk* m_pChunk = nullptr;
 			//! Row of the first entity we iterate from
-			uint16_t m_from;
+			ChunkRow m_from;
 			//! The number of entities accessible via the iterator
-			uint16_t m_cnt;
+			ChunkRow m_cnt;
 
 		public:
 			CopyIter() = default;
@@ -2039,7 +2320,7 @@ namespace gaia {
 			//! Sets the iterator's range.
 			//! \param from Row of the first entity we want to iterate from
 			//! \param cnt Number of entities we are going to iterate
-			void set_range(uint16_t from, uint16_t cnt) {
+			void set_range(ChunkRow from, ChunkRow cnt) {
 				GAIA_ASSERT(from < m_pChunk->size());
 				GAIA_ASSERT(from + cnt <= m_pChunk->size());
 				m_from = from;
@@ -2175,7 +2456,7 @@ namespace gaia {
 			//! \param index Iterator-relative entity index.
 			//! \return True it the entity is enabled. False otherwise.
 			GAIA_NODISCARD bool enabled(uint32_t index) const {
-				const auto row = (uint16_t)(from() + index);
+				const auto row = (ChunkRow)(from() + index);
 				return m_pChunk->enabled(row);
 			}
 
@@ -2203,18 +2484,18 @@ namespace gaia {
 
 			//! Returns the number of entities accessible via the iterator.
 			//! \return Number of rows in the configured copy range.
-			GAIA_NODISCARD uint16_t size() const noexcept {
+			GAIA_NODISCARD ChunkRow size() const noexcept {
 				return m_cnt;
 			}
 
 		private:
 			//! Returns the starting index of the iterator
-			GAIA_NODISCARD uint16_t from() const noexcept {
+			GAIA_NODISCARD ChunkRow from() const noexcept {
 				return m_from;
 			}
 
 			//! Returns the ending index of the iterator (one past the last valid index)
-			GAIA_NODISCARD uint16_t to() const noexcept {
+			GAIA_NODISCARD ChunkRow to() const noexcept {
 				return m_from + m_cnt;
 			}
 		};
@@ -213,12 +213,12 @@ namespace gaia {
 
 				if constexpr (mem::is_soa_layout_v<U>) {
 					if (self.m_writeIm)
-						self.m_pChunk->update_world_version(compIdx);
+						self.m_pChunk->update_world_version(compIdx, self.from(), self.to());
 					return SoATermViewSetPointer<U>{
 							self.m_pChunk->comp_ptr_mut(compIdx), self.m_pChunk->capacity(), self.from(), self.size()};
 				} else {
 					if (self.m_writeIm)
-						self.m_pChunk->update_world_version(compIdx);
+						self.m_pChunk->update_world_version(compIdx, self.from(), self.to());
 					auto* pData = reinterpret_cast<U*>(self.m_pChunk->comp_ptr_mut(compIdx, self.from()));
 					return EntityTermViewSetPointer<U>{pData, self.size()};
 				}
@@ -241,7 +241,7 @@ namespace gaia {
 					GAIA_ASSERT(compIdx < self.m_pChunk->comp_rec_view().size());
 					self.touch_comp_idx(compIdx);
 					if (self.m_writeIm)
-						self.m_pChunk->update_world_version(compIdx);
+						self.m_pChunk->update_world_version(compIdx, self.from(), self.to());
 					return SoATermViewSet<U>{
 							self.m_pChunk->comp_ptr_mut(compIdx),
 							self.m_pChunk->capacity(),
@@ -278,7 +278,7 @@ namespace gaia {
 
 					self.touch_comp_idx(compIdx);
 					if (self.m_writeIm)
-						self.m_pChunk->update_world_version(compIdx);
+						self.m_pChunk->update_world_version(compIdx, self.from(), self.to());
 
 					auto* pData = reinterpret_cast<U*>(self.m_pChunk->comp_ptr_mut(compIdx, self.from()));
 					return EntityTermViewSet<U>::pointer(pData, self.size());
@@ -19,7 +19,11 @@ namespace gaia {
 		using ComponentVersion = uint32_t;
 		using ChunkDataVersionOffset = uint8_t;
 		using CompOffsetMappingIndex = uint8_t;
+#if GAIA_ECS_WIDE_CHUNKS
+		using ChunkDataOffset = uint32_t;
+#else
 		using ChunkDataOffset = uint16_t;
+#endif
 		using ComponentLookupHash = core::direct_hash_key<uint64_t>;
 		using EntitySpan = std::span<const Entity>;
 		using EntitySpanMut = std::span<Entity>;
@@ -41,6 +45,12 @@ namespace gaia {
 			return component.size() != 0U && component.storage_type() == DataStorageType::Sparse && component.soa() == 0U;
 		}
 
+		//! True when the component payload is stored in a side block next to the chunk instead of inline.
+		//! Such components still use table storage. Only their column lives elsewhere.
+		GAIA_NODISCARD constexpr bool component_uses_cold_storage(Component component) noexcept {
+			return component.size() != 0U && component.storage_type() == DataStorageType::Cold;
+		}
+
 		//! \cond INTERNAL
 		namespace detail {
 			template <typename, typename = void>
@@ -59,6 +69,42 @@ namespace gaia {
 		template <typename T>
 		inline constexpr DataStorageType auto_storage_policy_v = detail::auto_storage_policy_inter<T>::data_storage_type;
 
+		//! \cond INTERNAL
+		namespace detail {
+			template <typename, typename = void>
+			struct auto_chunk_size_inter {
+				static constexpr ChunkSizeHint chunk_size = ChunkSizeHint::Default;
+			};
+			template <typename T>
+			struct auto_chunk_size_inter<T, std::void_t<decltype(T::gaia_Chunk_Size)>> {
+				static constexpr ChunkSizeHint chunk_size = T::gaia_Chunk_Size;
+			};
+		} // namespace detail
+		//! \endcond
+
+		//! Returns the chunk size hint requested by a C++ component type.
+		//! \tparam T Component payload type.
+		template <typename T>
+		inline constexpr ChunkSizeHint auto_chunk_size_v = detail::auto_chunk_size_inter<T>::chunk_size;
+
+		//! \cond INTERNAL
+		namespace detail {
+			template <typename, typename = void>
+			struct auto_change_tracking_inter {
+				static constexpr ChangeTracking change_tracking = ChangeTracking::Chunk;
+			};
+			template <typename T>
+			struct auto_change_tracking_inter<T, std::void_t<decltype(T::gaia_Change_Tracking)>> {
+				static constexpr ChangeTracking change_tracking = T::gaia_Change_Tracking;
+			};
+		} // namespace detail
+		//! \endcond
+
+		//! Returns the change tracking granularity requested by a C++ component type.
+		//! \tparam T Component payload type.
+		template <typename T>
+		inline constexpr ChangeTracking auto_change_tracking_v = detail::auto_change_tracking_inter<T>::change_tracking;
+
 		//----------------------------------------------------------------------
 		// Component verification
 		//----------------------------------------------------------------------
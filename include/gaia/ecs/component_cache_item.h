@@ -82,6 +82,10 @@ namespace gaia {
 			ComponentLookupHash hashLookup;
 			//! Per-element byte sizes for SoA components. Unused for AoS components.
 			uint8_t soaSizes[meta::StructToTupleMaxTypes];
+			//! Chunk size preferred by archetypes containing the component.
+			ChunkSizeHint chunkSize = ChunkSizeHint::Default;
+			//! Granularity of change tracking of the component.
+			ChangeTracking changeTracking = ChangeTracking::Chunk;
 
 			//! Registered component symbol.
 			SymbolLookupKey name;
@@ -242,6 +246,31 @@ namespace gaia {
 				memmove((void*)pD, (const void*)pS, comp.size());
 			}
 
+			//! Move-constructs a contiguous range of component values from another storage block.
+			//! \param pDst Destination component storage base pointer.
+			//! \param pSrc Source component storage base pointer. Must not overlap the destination range.
+			//! \param idxDst First destination value index.
+			//! \param idxSrc First source value index.
+			//! \param cnt Number of values to move.
+			//! \param sizeDst Destination storage capacity.
+			//! \param sizeSrc Source storage capacity.
+			void ctor_move_n(
+					void* pDst, void* pSrc, uint32_t idxDst, uint32_t idxSrc, uint32_t cnt, uint32_t sizeDst,
+					uint32_t sizeSrc) const {
+				GAIA_ASSERT(pSrc != nullptr && pDst != nullptr);
+				GAIA_ASSERT(pSrc != pDst);
+				if (func_move_ctor != nullptr || comp.soa() != 0) {
+					GAIA_FOR(cnt) ctor_move(pDst, pSrc, idxDst + i, idxSrc + i, sizeDst, sizeSrc);
+					return;
+				}
+				if (comp.size() == 0)
+					return;
+
+				auto* pD = (uint8_t*)pDst + ((uintptr_t)comp.size() * idxDst);
+				auto* pS = (uint8_t*)pSrc + ((uintptr_t)comp.size() * idxSrc);
+				memcpy((void*)pD, (const void*)pS, (size_t)comp.size() * cnt);
+			}
+
 			//! Copy-constructs one component value from another value.
 			//! \param pDst Destination component storage base pointer.
 			//! \param pSrc Source component storage base pointer.
@@ -277,6 +306,14 @@ namespace gaia {
 					func_dtor(pSrc, 1);
 			}
 
+			//! Destroys a contiguous range of component values when a destructor callback is registered.
+			//! \param pSrc Pointer to the first component value.
+			//! \param cnt Number of values to destroy.
+			void dtor_n(void* pSrc, uint32_t cnt) const {
+				if (func_dtor != nullptr)
+					func_dtor(pSrc, cnt);
+			}
+
 			//! Copies one existing component value into another value.
 			//! \param pDst Destination component storage base pointer.
 			//! \param pSrc Source component storage base pointer.
@@ -790,6 +827,8 @@ namespace gaia {
 				cci->func_cmp = desc.funcCmp;
 				cci->func_save = desc.funcSave;
 				cci->func_load = desc.funcLoad;
+				cci->chunkSize = desc.chunkSize;
+				cci->changeTracking = desc.soa == 0 ? desc.changeTracking : ChangeTracking::Chunk;
 				cci->typeKind = desc.typeKind;
 				cci->underlyingType = desc.underlyingType;
 				cci->elementType = desc.elementType;
@@ -186,6 +186,10 @@ namespace gaia {
 			uint32_t alig = 0;
 			//! Component storage mode.
 			DataStorageType storageType = DataStorageType::Table;
+			//! Chunk size preferred by archetypes containing the component.
+			ChunkSizeHint chunkSize = ChunkSizeHint::Default;
+			//! Granularity of change tracking. Row tracking is ignored for SoA and non-generic components.
+			ChangeTracking changeTracking = ChangeTracking::Chunk;
 			//! Number of SoA elements, 0 means AoS.
 			uint32_t soa = 0;
 			//! Per-element SoA sizes when \a soa is non-zero. The array must contain \a soa non-zero entries and
@@ -306,7 +310,8 @@ namespace gaia {
 				static constexpr DataStorageType storage_type() {
 					constexpr auto storageType = auto_storage_policy_v<U>;
 					static_assert(
-							storageType == DataStorageType::Table || storageType == DataStorageType::Sparse,
+							storageType == DataStorageType::Table || storageType == DataStorageType::Sparse ||
+									storageType == DataStorageType::Cold,
 							"Unsupported component storage type");
 					static_assert(
 							storageType != DataStorageType::Sparse || CT::Kind == EntityKind::EK_Gen,
@@ -317,9 +322,44 @@ namespace gaia {
 					static_assert(
 							storageType != DataStorageType::Sparse || !mem::is_soa_layout_v<U>,
 							"GAIA_STORAGE(Sparse) is not compatible with SoA layouts");
+					static_assert(
+							storageType != DataStorageType::Cold || CT::Kind == EntityKind::EK_Gen,
+							"GAIA_STORAGE(Cold) supports only generic components");
+					static_assert(
+							storageType != DataStorageType::Cold || !std::is_empty_v<U>,
+							"GAIA_STORAGE(Cold) requires a non-empty component payload");
+					static_assert(
+							storageType != DataStorageType::Cold || !mem::is_soa_layout_v<U>,
+							"GAIA_STORAGE(Cold) is not compatible with SoA layouts");
+					static_assert(
+							storageType != DataStorageType::Cold || alignof(U) <= 64,
+							"GAIA_STORAGE(Cold) supports only components aligned to at most 64 bytes");
 					return storageType;
 				}
 
+				//! Returns the compile-time chunk size hint requested for the component payload.
+				//! \return Chunk size hint.
+				static constexpr ChunkSizeHint chunk_size() {
+					constexpr auto chunkSize = auto_chunk_size_v<U>;
+					static_assert(
+							chunkSize == ChunkSizeHint::Default || CT::Kind == EntityKind::EK_Gen,
+							"GAIA_CHUNK_SIZE supports only generic components");
+					return chunkSize;
+				}
+
+				//! Returns the compile-time change tracking granularity requested for the component payload.
+				//! \return Change tracking granularity.
+				static constexpr ChangeTracking change_tracking() {
+					constexpr auto changeTracking = auto_change_tracking_v<U>;
+					static_assert(
+							changeTracking == ChangeTracking::Chunk || CT::Kind == EntityKind::EK_Gen,
+							"GAIA_CHANGE_TRACKING(Row) supports only generic components");
+					static_assert(
+							changeTracking == ChangeTracking::Chunk || !mem::is_soa_layout_v<U>,
+							"GAIA_CHANGE_TRACKING(Row) is not compatible with SoA layouts");
+					return changeTracking;
+				}
+
 				//! Builds the optional constructor callback for typed AoS payloads.
 				//! \return Constructor callback, or nullptr when construction is trivial or SoA-managed.
 				static constexpr auto func_ctor() {
@@ -538,6 +578,8 @@ namespace gaia {
 					desc.size = size();
 					desc.alig = alig();
 					desc.storageType = storage_type();
+					desc.chunkSize = chunk_size();
+					desc.changeTracking = change_tracking();
 					desc.soa = soa(soaSizes);
 					desc.pSoaSizes = soaSizes.data();
 					desc.hashLookup = hash_lookup();
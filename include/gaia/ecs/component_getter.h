@@ -21,14 +21,14 @@ namespace gaia {
 			//! Entity whose components are accessed.
 			Entity m_entity;
 			//! Entity row within the chunk.
-			uint16_t m_row;
+			ChunkRow m_row;
 
 			//! Creates an accessor for one entity row.
 			//! \param world World that owns the entity.
 			//! \param pChunk Chunk containing the entity row.
 			//! \param entity Entity being accessed.
 			//! \param row Entity row within \p pChunk.
-			ComponentGetter(const World& world, const Chunk* pChunk, Entity entity, uint16_t row):
+			ComponentGetter(const World& world, const Chunk* pChunk, Entity entity, ChunkRow row):
 					m_pWorld(&world), m_pChunk(pChunk), m_entity(entity), m_row(row) {}
 
 			//! Returns the value stored in the component \a T on entity.
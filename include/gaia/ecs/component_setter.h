@@ -30,7 +30,7 @@ namespace gaia {
 				GAIA_ASSERT(m_pWorld != nullptr);
 				GAIA_ASSERT(m_entity != EntityBad);
 				GAIA_ASSERT(m_pChunk != nullptr);
-				const auto row = (uint16_t)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
+				const auto row = (ChunkRow)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
 				return const_cast<Chunk*>(m_pChunk)->template sset<T>(row);
 			}
 
@@ -46,7 +46,8 @@ namespace gaia {
 				smut<T>() = GAIA_FWD(value);
 				auto& chunk = *const_cast<Chunk*>(m_pChunk);
 				chunk.template modify<T, true>();
-				world_notify_on_set(chunk.world(), chunk.template comp_entity<T>(), chunk, m_row, (uint16_t)(m_row + 1));
+				chunk.template mark_dirty_rows<T>(m_row, (ChunkRow)(m_row + 1));
+				world_notify_on_set(chunk.world(), chunk.template comp_entity<T>(), chunk, m_row, (ChunkRow)(m_row + 1));
 				return *this;
 			}
 
@@ -74,7 +75,7 @@ namespace gaia {
 				GAIA_ASSERT(m_pWorld != nullptr);
 				GAIA_ASSERT(m_entity != EntityBad);
 				GAIA_ASSERT(m_pChunk != nullptr);
-				const auto row = (uint16_t)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
+				const auto row = (ChunkRow)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
 				return const_cast<Chunk*>(m_pChunk)->template sset<T>(row);
 			}
 
@@ -19,9 +19,9 @@ namespace gaia {
 				//! Destination chunk for the pending range.
 				Chunk* pChunk = nullptr;
 				//! First destination row in \a pChunk.
-				uint16_t startRow = 0;
+				ChunkRow startRow = 0;
 				//! Number of contiguous rows in the pending range.
-				uint16_t count = 0;
+				ChunkRow count = 0;
 			};
 
 			//! Prefab child edge discovered while building an instantiation or synchronization plan.
@@ -92,7 +92,7 @@ namespace gaia {
 			///////////////////////////////////////////////////////////////////
 
 			//! Row at which the entity is stored in the chunk
-			uint16_t row;
+			ChunkRow row;
 			//! Flags
 			uint16_t flags = 0;
 
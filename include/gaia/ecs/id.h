@@ -24,15 +24,55 @@ namespace gaia {
 			Table,
 			//! Data stored in sparse storage
 			Sparse,
+			//! Data stored in a side block allocated for each chunk. Rows stay aligned with the chunk.
+			//! Meant for large rarely accessed components which would otherwise reduce the chunk capacity.
+			Cold,
 
 			//! Number of supported storage modes.
-			Count = 2
+			Count = 3
 		};
 
 //! Declares the storage mode used when registering a typed C++ component.
-//! \param storage_name `DataStorageType` enumerator name such as `Table` or `Sparse`.
+//! \param storage_name `DataStorageType` enumerator name such as `Table`, `Sparse` or `Cold`.
 #define GAIA_STORAGE(storage_name) static constexpr auto gaia_Data_Storage = ::gaia::ecs::DataStorageType::storage_name
 
+		enum class ChunkSizeHint : uint32_t {
+			//! Regular chunks sized for the archetype's row width
+			Default,
+			//! Wide chunks holding tens of thousands of rows. Requires GAIA_ECS_WIDE_CHUNKS.
+			Wide,
+
+			//! Number of supported size hints.
+			Count = 2
+		};
+
+//! Declares the chunk size preferred by archetypes containing a typed C++ component.
+//! \param size_name `ChunkSizeHint` enumerator name such as `Default` or `Wide`.
+#define GAIA_CHUNK_SIZE(size_name) static constexpr auto gaia_Chunk_Size = ::gaia::ecs::ChunkSizeHint::size_name
+
+		enum class ChangeTracking : uint32_t {
+			//! Writes are tracked per chunk via component versions
+			Chunk,
+			//! Writes are additionally tracked per row via a dirty bitset stored in the chunk
+			Row,
+
+			//! Number of supported change tracking modes.
+			Count = 2
+		};
+
+//! Declares the granularity of change tracking used by a typed C++ component.
+//! \param tracking_name `ChangeTracking` enumerator name such as `Chunk` or `Row`.
+#define GAIA_CHANGE_TRACKING(tracking_name)                                                                            \
+	static constexpr auto gaia_Change_Tracking = ::gaia::ecs::ChangeTracking::tracking_name
+
+#if GAIA_ECS_WIDE_CHUNKS
+		//! Row index inside a chunk
+		using ChunkRow = uint32_t;
+#else
+		//! Row index inside a chunk
+		using ChunkRow = uint16_t;
+#endif
+
 		// ------------------------------------------------------------------------------------
 		// Component
 		// ------------------------------------------------------------------------------------
@@ -51,12 +91,10 @@ namespace gaia {
 				IdentifierData size : MaxComponentSize_Bits;
 				//! Component alignment
 				IdentifierData alig : MaxAlignment_Bits;
-				//! Component storage kind. 0 = table, 1 = sparse.
-				IdentifierData storage : 1;
+				//! Component storage kind. 0 = table, 1 = sparse, 2 = cold.
+				IdentifierData storage : 2;
 				//! Component is SoA
 				IdentifierData soa : meta::StructToTupleMaxTypes_Bits;
-				//! Unused part
-				IdentifierData unused : 1;
 			};
 			static_assert(sizeof(InternalData) == sizeof(Identifier));
 
@@ -73,7 +111,6 @@ namespace gaia {
 				data.size = size;
 				data.alig = alig;
 				data.storage = (IdentifierData)storage;
-				data.unused = 0;
 			}
 
 			GAIA_NODISCARD constexpr auto id() const noexcept {
@@ -96,7 +96,7 @@ namespace gaia {
 				}
 
 				iter.set_archetype(ec.pArchetype);
-				iter.set_chunk(ec.pChunk, ec.row, (uint16_t)(ec.row + 1));
+				iter.set_chunk(ec.pChunk, ec.row, (ChunkRow)(ec.row + 1));
 				iter.set_comp_indices(cachedIndices);
 				iter.set_term_ids(termIds.data());
 				iter.set_write_im(false);
@@ -110,8 +110,8 @@ namespace gaia {
 			const auto& rightData = right.data;
 			if (leftData.idsCnt != rightData.idsCnt || leftData.changedCnt != rightData.changedCnt ||
 					leftData.readWriteMask != rightData.readWriteMask || leftData.cacheSrcTrav != rightData.cacheSrcTrav ||
-					leftData.sortBy != rightData.sortBy || leftData.sortByFunc != rightData.sortByFunc ||
-					leftData.groupBy != rightData.groupBy || leftData.groupByFunc != rightData.groupByFunc)
+					!leftData.sort_payload_equal(rightData) || leftData.groupBy != rightData.groupBy ||
+					leftData.groupByFunc != rightData.groupByFunc)
 				return false;
 
 			GAIA_FOR(leftData.idsCnt) {
@@ -1,11 +1,13 @@
 #pragma once
 #include "gaia/config/config.h"
 
+#include <chrono>
 #include <cstdarg>
 #include <cstdint>
 #include <type_traits>
 
 #include "gaia/cnt/darray.h"
+#include "gaia/cnt/darray_soa.h"
 #include "gaia/cnt/map.h"
 #include "gaia/cnt/sarray_ext.h"
 #include "gaia/config/profiler.h"
@@ -89,6 +91,14 @@ namespace gaia {
 			Shared
 		};
 
+		//! Selects which cached queries World::warm_query_caches() matches.
+		enum class QueryWarmScope : uint8_t {
+			//! Warm every cached query. Queries used by systems of the first scheduled phase are matched first.
+			All,
+			//! Warm only the queries used by systems of the first scheduled phase. The rest stay lazy.
+			FirstPhase
+		};
+
 		//! Result of validating a query shape against the requested QueryCacheKind.
 		enum class QueryKindRes : uint8_t {
 			//! The requested kind is satisfied.
@@ -124,6 +134,55 @@ namespace gaia {
 			ReversePreorder = ReverseDown
 		};
 
+		namespace detail {
+			class QueryImpl;
+		}
+
+		//! Resumable position within the results of a query. See Query::next().
+		//! The cursor survives structural changes made between calls. When the archetype, chunk or rows it points at
+		//! moved in the meantime, iteration continues from the nearest valid position and stale() starts returning
+		//! true because some results may have been skipped or returned twice.
+		class QueryCursor {
+			friend class detail::QueryImpl;
+
+			//! Index of the current archetype in the query cache, or of the current slice for sorted queries
+			uint32_t m_cacheIdx = 0;
+			//! Index of the current chunk within the archetype
+			uint32_t m_chunkIdx = 0;
+			//! First row not returned yet. For sorted queries this is an offset into the slice.
+			//! For queries evaluated per entity it is the number of entities returned so far.
+			uint32_t m_row = 0;
+			//! Archetype the position points at
+			ArchetypeId m_archetypeId = ArchetypeIdBad;
+			//! Chunk the position points at
+			const Chunk* m_pChunk = nullptr;
+			//! World version when the cursor was last advanced
+			uint32_t m_worldVersion = 0;
+			//! Version of the sorted cache slices the position refers to
+			uint32_t m_sortVersion = 0;
+			//! True when all results were returned
+			bool m_done = false;
+			//! True when the position had to be repaired after a structural change
+			bool m_stale = false;
+
+		public:
+			//! Rewinds the cursor to the beginning of the results.
+			void reset() {
+				*this = {};
+			}
+
+			//! Returns true when all results were returned.
+			GAIA_NODISCARD bool done() const {
+				return m_done;
+			}
+
+			//! Returns true when a structural change moved the data the cursor pointed at.
+			//! Results returned since then may miss some entities or contain some twice.
+			GAIA_NODISCARD bool stale() const {
+				return m_stale;
+			}
+		};
+
 		//! Cache policy selected for a prepared query.
 		using QueryCachePolicy = QueryCtx::CachePolicy;
 		struct TypedQueryExecState;
@@ -139,7 +198,7 @@ namespace gaia {
 					std::is_invocable_v<Func, Entity>;
 
 			//! Query command types
-			enum QueryCmdType : uint8_t { ADD_ITEM, ADD_FILTER, SORT_BY, GROUP_BY, GROUP_DEP, MATCH_PREFAB };
+			enum QueryCmdType : uint8_t { ADD_ITEM, ADD_FILTER, SORT_BY, GROUP_BY, GROUP_DEP, MATCH_PREFAB, SORT_BY_KEY };
 
 			struct QueryCmd_AddItem {
 				static constexpr QueryCmdType Id = QueryCmdType::ADD_ITEM;
@@ -239,6 +298,52 @@ namespace gaia {
 					ctxData.sortBy = sortBy;
 					GAIA_ASSERT(func != nullptr);
 					ctxData.sortByFunc = func;
+					ctxData.sortByKeyCnt = 0;
+					ctxData.sortByKeyFunc = nullptr;
+					ctxData.sortByKeyProj = nullptr;
+				}
+			};
+
+			template <typename... Keys, typename TProj, size_t... Is>
+			void sort_by_key_extract_inter(
+					TProj proj, const void* const* ppData, uint32_t from, uint32_t cnt, uint64_t* pKeys,
+					std::index_sequence<Is...> /*no_name*/) {
+				GAIA_FOR(cnt) {
+					const auto row = from + i;
+					pKeys[i] = core::radix_key_pack(proj(((const Keys*)ppData[Is])[row]...));
+				}
+			}
+
+			//! Key extractor instantiated for each sort_by<Keys...>(projection) signature.
+			//! \tparam TRet Return type of the projection
+			//! \tparam Keys Types of the columns passed to the projection
+			template <typename TRet, typename... Keys>
+			void sort_by_key_extract(
+					TSortByKeyProj proj, const void* const* ppData, uint32_t from, uint32_t cnt, uint64_t* pKeys) {
+				using TProj = TRet (*)(const Keys&...);
+				sort_by_key_extract_inter<Keys...>(
+						reinterpret_cast<TProj>(proj), ppData, from, cnt, pKeys, std::index_sequence_for<Keys...>{});
+			}
+
+			struct QueryCmd_SortByKey {
+				static constexpr QueryCmdType Id = QueryCmdType::SORT_BY_KEY;
+				static constexpr bool InvalidatesHash = true;
+
+				QuerySortKeyArray keys;
+				uint8_t keyCnt;
+				TSortByKeyFunc func;
+				TSortByKeyProj proj;
+
+				void exec(QueryCtx& ctx) const {
+					auto& ctxData = ctx.data;
+					ctxData.sortBy = EntityBad;
+					ctxData.sortByFunc = nullptr;
+					GAIA_ASSERT(keyCnt > 0 && keyCnt <= MAX_SORT_KEYS_IN_QUERY);
+					GAIA_ASSERT(func != nullptr && proj != nullptr);
+					ctxData.sortByKeys = keys;
+					ctxData.sortByKeyCnt = keyCnt;
+					ctxData.sortByKeyFunc = func;
+					ctxData.sortByKeyProj = proj;
 				}
 			};
 
@@ -511,8 +616,8 @@ namespace gaia {
 					const uint8_t* pCompIndices;
 					InheritedTermDataView inheritedData;
 					GroupId groupId;
-					uint16_t from;
-					uint16_t to;
+					ChunkRow from;
+					ChunkRow to;
 				};
 
 				using ChunkSpan = std::span<const Chunk*>;
@@ -529,6 +634,87 @@ namespace gaia {
 					uint32_t seenVersion = 1;
 				};
 
+				//! Prefetches chunks ahead of a dense runner walking the archetype cache chunk by chunk.
+				//! The header and component records of the chunk GAIA_QUERY_PREFETCH_DISTANCE + 1 steps ahead are prefetched
+				//! first. One step later, when they are likely cached, the first cache lines of its queried columns follow.
+				//! The lookahead crosses archetype boundaries so many small archetypes benefit as much as a few large ones.
+				class DenseChunkPrefetcher {
+					static constexpr uint32_t Distance = GAIA_QUERY_PREFETCH_DISTANCE;
+					static constexpr bool Enabled = GAIA_USE_PREFETCH && Distance > 0;
+
+					const QueryInfo& m_queryInfo;
+					std::span<const Archetype*> m_archetypes;
+					//! One-past-the-end archetype index of the walked range
+					uint32_t m_archTo;
+					//! Archetype index of the chunk whose header was prefetched last
+					uint32_t m_archIdx;
+					//! Index of the chunk whose header was prefetched last
+					uint32_t m_chunkIdx;
+
+					GAIA_NODISCARD bool valid() const {
+						return m_archIdx < m_archTo;
+					}
+
+					//! Moves the cursor to the next chunk in the range and prefetches its header.
+					void advance() {
+						++m_chunkIdx;
+						while (m_archIdx < m_archTo && m_chunkIdx >= m_archetypes[m_archIdx]->chunks().size()) {
+							++m_archIdx;
+							m_chunkIdx = 0;
+						}
+						if (!valid())
+							return;
+
+						const auto* pArchetype = m_archetypes[m_archIdx];
+						pArchetype->chunks()[m_chunkIdx]->prefetch_header(
+								pArchetype->data_offsets().firstByte_Records, pArchetype->props().cntEntities);
+					}
+
+					//! Moves the cursor  steps chunks ahead of the chunk at  archIdx and  chunkIdx.
+					void reset(uint32_t archIdx, uint32_t chunkIdx, uint32_t steps) {
+						m_archIdx = archIdx;
+						m_chunkIdx = chunkIdx;
+						GAIA_FOR(steps) advance();
+					}
+
+				public:
+					DenseChunkPrefetcher(const QueryInfo& queryInfo, uint32_t idxFrom, uint32_t idxTo):
+							m_queryInfo(queryInfo), m_archetypes(queryInfo.cache_archetype_view()), m_archTo(idxTo),
+							m_archIdx(idxFrom), m_chunkIdx(0) {
+						if constexpr (Enabled) {
+							// Start with the cursor right before the first chunk
+							m_chunkIdx = (uint32_t)-1;
+							advance();
+							reset(m_archIdx, m_chunkIdx, Distance);
+						}
+					}
+
+					//! Issues prefetches for the chunks ahead of the chunk the runner is about to process.
+					//! Needs to be called for every chunk of the range in order, including those the runner skips.
+					//! \param archIdx Archetype cache index of the chunk about to be processed
+					//! \param chunkIdx Index of the chunk about to be processed within its archetype
+					GAIA_FORCEINLINE void step(uint32_t archIdx, uint32_t chunkIdx) {
+						if constexpr (Enabled) {
+							if (!valid())
+								return;
+
+							// The runner skipped ahead of the cursor (e.g. whole archetypes filtered out). Catch up
+							// without prefetching columns whose headers were never prefetched.
+							if (m_archIdx < archIdx || (m_archIdx == archIdx && m_chunkIdx <= chunkIdx)) {
+								reset(archIdx, chunkIdx, Distance + 1);
+								return;
+							}
+
+							const auto indices = m_queryInfo.indices_mapping_view(m_archIdx);
+							m_archetypes[m_archIdx]->chunks()[m_chunkIdx]->prefetch_data(indices.data(), MAX_ITEMS_IN_QUERY);
+							advance();
+						} else {
+							(void)archIdx;
+							(void)chunkIdx;
+						}
+					}
+				};
+
 			private:
 				GAIA_NODISCARD bool uses_query_cache_storage() const {
 					return m_cacheKind != QueryCacheKind::None;
@@ -613,6 +799,12 @@ namespace gaia {
 							QueryCmd_MatchPrefab cmd;
 							ser::load(buffer, cmd);
 							cmd.exec(ctx);
+						},
+						// SortByKey
+						[](QuerySerBuffer& buffer, QueryCtx& ctx) {
+							QueryCmd_SortByKey cmd;
+							ser::load(buffer, cmd);
+							cmd.exec(ctx);
 						} //
 				}; // namespace detail
 
@@ -640,6 +832,8 @@ namespace gaia {
 				GroupId m_groupIdSet = 0;
 				//! World version seen by this query instance for changed() filters.
 				uint32_t m_changedWorldVersion = 0;
+				//! Value of m_changedWorldVersion used by the last gather(). Lets scatter() visit the same rows.
+				uint32_t m_gatherChangedWorldVersion = 0;
 				//! Batches used for parallel query processing
 				//! TODO: This is just temporary until a smarter system is introduced
 				cnt::darray<ChunkBatch> m_batches;
@@ -856,6 +1050,16 @@ namespace gaia {
 							return true;
 					}
 
+					return custom_conflicts_one_way(leftAccess, rightData, rightAccess);
+				}
+
+				//! Checks explicit reads()/writes() declarations of one query against another query's effective access.
+				//! \param leftAccess Explicit access set for the left query.
+				//! \param rightData Compiled query data for the right query.
+				//! \param rightAccess Explicit access set for the right query.
+				//! \return True when any explicit access on the left conflicts with the right query.
+				GAIA_NODISCARD static bool custom_conflicts_one_way(
+						const QueryAccessSet& leftAccess, const QueryCtx::Data& rightData, const QueryAccessSet& rightAccess) {
 					for (const auto id: leftAccess.reads_view()) {
 						if (access_conflicts(QueryAccess::Read, effective_access(rightData, rightAccess, id)))
 							return true;
@@ -948,6 +1152,11 @@ namespace gaia {
 				//! Matches the query against all relevant archetypes.
 				//! \param queryInfo Query info
 				void match_all(QueryInfo& queryInfo) {
+					auto* pProfile = m_profile.get();
+					if (pProfile != nullptr)
+						++pProfile->matchCnt;
+					ProfileTimer timer(pProfile != nullptr ? &pProfile->matchNs : nullptr);
+
 					const auto kindError = validate_kind(queryInfo.ctx());
 					if (kindError != QueryKindRes::OK) {
 						GAIA_ASSERT2(SilenceInvalidCacheKindAssertions, kind_error_str(kindError));
@@ -1174,6 +1383,22 @@ namespace gaia {
 				GAIA_NODISCARD bool can_run_parallel(QueryImpl& other) {
 					return !m_mainThread && !other.m_mainThread && !conflicts_with(other);
 				}
+
+				//! Returns whether this query can share a fused chunk pass with another query.
+				//!
+				//! A fused pass runs the callbacks back to back on each chunk in their scheduled order, so every row still
+				//! sees the writes of the earlier callbacks. Conflicts between positive query terms are therefore allowed.
+				//! Explicit reads()/writes() declarations describe data accessed outside the iterated chunk and must not
+				//! conflict.
+				//! \param other Query to compare against.
+				//! \return True when the explicit access declarations of the two queries do not conflict.
+				//! \see World::phase_fusion(Entity, bool)
+				GAIA_NODISCARD bool can_fuse_with(QueryImpl& other) {
+					const auto& leftData = fetch().ctx().data;
+					const auto& rightData = other.fetch().ctx().data;
+					return !custom_conflicts_one_way(m_access, rightData, other.m_access) &&
+								 !custom_conflicts_one_way(other.m_access, leftData, m_access);
+				}
 				//! \}
 
 				//! Sets the hard cache-kind requirement for the query.
@@ -1366,6 +1591,7 @@ namespace gaia {
 				//! Resets changed-filter bookkeeping for this query instance.
 				void reset_changed_filter_state() {
 					m_changedWorldVersion = 0;
+					m_gatherChangedWorldVersion = 0;
 				}
 
 				//! Returns the last allocated archetype id in the world.
@@ -1932,8 +2158,8 @@ namespace gaia {
 				//! \param from Receives the first row to process.
 				//! \param to Receives the one-past-the-end row to process.
 				static void chunk_effective_range(
-						Chunk* pChunk, Constraints constraints, bool needsBarrierCache, bool barrierPasses, uint16_t& from,
-						uint16_t& to) noexcept {
+						Chunk* pChunk, Constraints constraints, bool needsBarrierCache, bool barrierPasses, ChunkRow& from,
+						ChunkRow& to) noexcept {
 					if (needsBarrierCache && constraints == Constraints::DisabledOnly && !barrierPasses) {
 						from = 0;
 						to = pChunk->size();
@@ -2036,11 +2262,11 @@ namespace gaia {
 				}
 
 				static void finish_typed_chunk_writes_runtime(
-						World& world, Chunk* pChunk, uint16_t from, uint16_t to, const Entity* pArgIds, const bool* pWriteFlags,
+						World& world, Chunk* pChunk, ChunkRow from, ChunkRow to, const Entity* pArgIds, const bool* pWriteFlags,
 						uint32_t argCnt, uint32_t firstWriteArg, void* const* pSparseStores = nullptr);
 
 				template <typename... T>
-				static void finish_typed_chunk_writes(World& world, Chunk* pChunk, uint16_t from, uint16_t to);
+				static void finish_typed_chunk_writes(World& world, Chunk* pChunk, ChunkRow from, ChunkRow to);
 
 				static void finish_typed_iter_writes_runtime(
 						Iter& it, const Entity* pArgIds, const bool* pWriteFlags, uint32_t argCnt, uint32_t firstWriteArg);
@@ -2142,6 +2368,145 @@ namespace gaia {
 					bool valid = true;
 				};
 
+				//! Runtime statistics collected by a query after profile(true). Times are cumulative.
+				struct QueryProfile final {
+					//! Time spent matching archetypes against the query, in nanoseconds.
+					uint64_t matchNs = 0;
+					//! Time spent selecting execution plans, in nanoseconds.
+					uint64_t planNs = 0;
+					//! Time spent iterating and running callbacks, in nanoseconds.
+					uint64_t iterNs = 0;
+					//! Number of times archetype matching was requested.
+					uint32_t matchCnt = 0;
+					//! Number of profiled iteration calls (each, each_arch, arr).
+					uint32_t runCnt = 0;
+					//! Number of non-empty chunks skipped by changed() filters.
+					uint32_t filteredChunkCnt = 0;
+					//! Runner family selected by the most recent plan.
+					QueryPlanMode lastPlanMode = QueryPlanMode::General;
+					//! QueryPlanFlags of the most recent plan.
+					uint8_t lastPlanFlags = QueryPlanFlag_None;
+				};
+
+				//! Describes how a query executes. Returned by explain().
+				struct QueryExplain final {
+					//! Runner family selected for Iter callbacks with Constraints::EnabledOnly.
+					QueryPlanMode planMode = QueryPlanMode::General;
+					//! QueryPlanFlags of the selected plan.
+					uint8_t planFlags = QueryPlanFlag_None;
+					//! True when the term layout allows direct chunk iteration.
+					//! A General plan with no blocking flags usually means this is false.
+					bool directIterable = false;
+					//! Number of matched archetypes that can be processed.
+					uint32_t archetypeCnt = 0;
+					//! Number of non-empty chunks in the matched archetypes.
+					uint32_t chunkCnt = 0;
+					//! Number of entities in the matched archetypes.
+					uint32_t entityCnt = 0;
+					//! True when runtime profiling is enabled. The profile is zeroed otherwise.
+					bool profiling = false;
+					//! Runtime statistics collected so far.
+					QueryProfile profile{};
+				};
+
+			private:
+				//! Runtime statistics, allocated only while profiling is enabled.
+				OnDemandDataHolder<QueryProfile> m_profile;
+
+				//! Returns the nanoseconds elapsed since \a start.
+				GAIA_NODISCARD static uint64_t profile_elapsed_ns(std::chrono::steady_clock::time_point start) {
+					const auto elapsed = std::chrono::steady_clock::now() - start;
+					return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+				}
+
+				//! Adds the time elapsed during its lifetime to a profile counter, if any.
+				class ProfileTimer final {
+					uint64_t* m_pNs;
+					std::chrono::steady_clock::time_point m_start;
+
+				public:
+					explicit ProfileTimer(uint64_t* pNs): m_pNs(pNs) {
+						if (m_pNs != nullptr)
+							m_start = std::chrono::steady_clock::now();
+					}
+					~ProfileTimer() {
+						if (m_pNs != nullptr)
+							*m_pNs += profile_elapsed_ns(m_start);
+					}
+					ProfileTimer(const ProfileTimer&) = delete;
+					ProfileTimer& operator=(const ProfileTimer&) = delete;
+				};
+
+				//! Profiles one public iteration call. Time not spent in matching or planning counts as iteration.
+				class ProfileRun final {
+					QueryProfile* m_pProfile;
+					uint64_t m_nestedNs = 0;
+					std::chrono::steady_clock::time_point m_start;
+
+				public:
+					explicit ProfileRun(QueryImpl& query): m_pProfile(query.m_profile.get()) {
+						if (m_pProfile == nullptr)
+							return;
+						m_nestedNs = m_pProfile->matchNs + m_pProfile->planNs;
+						m_start = std::chrono::steady_clock::now();
+					}
+					~ProfileRun() {
+						if (m_pProfile == nullptr)
+							return;
+						const auto elapsedNs = profile_elapsed_ns(m_start);
+						const auto nestedNs = m_pProfile->matchNs + m_pProfile->planNs - m_nestedNs;
+						m_pProfile->iterNs += elapsedNs > nestedNs ? elapsedNs - nestedNs : 0;
+						++m_pProfile->runCnt;
+					}
+					ProfileRun(const ProfileRun&) = delete;
+					ProfileRun& operator=(const ProfileRun&) = delete;
+				};
+
+				//! Counts non-empty chunks in the plan range that the changed() filters would skip.
+				//! \param queryInfo Prepared query cache and execution metadata.
+				//! \param plan Prepared plan with QueryPlanFlag_Filtered set.
+				//! \return Number of filtered chunks.
+				GAIA_NODISCARD uint32_t count_filtered_chunks(const QueryInfo& queryInfo, const QueryPlan& plan) const {
+					uint32_t cnt = 0;
+					const auto cacheView = queryInfo.cache_archetype_view();
+					for (uint32_t i = plan.idxFrom; i < plan.idxTo; ++i) {
+						const auto* pArchetype = cacheView[i];
+						if (!can_process_archetype(queryInfo, *pArchetype))
+							continue;
+
+						for (const auto* pChunk: pArchetype->chunks()) {
+							if (!pChunk->empty() && !match_filters(*pChunk, queryInfo, m_changedWorldVersion))
+								++cnt;
+						}
+					}
+					return cnt;
+				}
+
+				//! Selects the execution plan and records it in the runtime profile when profiling is enabled.
+				//! 	param TPlanArg Constraints or TypedQueryExecState forwarded to prepare_query_plan.
+				//! \param queryInfo Prepared query cache and execution metadata.
+				//! \param arg Plan selection input.
+				//! \return Query execution plan.
+				template <typename TPlanArg>
+				GAIA_NODISCARD QueryPlan prepare_query_plan_prof(const QueryInfo& queryInfo, const TPlanArg& arg) {
+					auto* pProfile = m_profile.get();
+					if GAIA_LIKELY (pProfile == nullptr)
+						return prepare_query_plan(queryInfo, arg);
+
+					QueryPlan plan;
+					{
+						ProfileTimer timer(&pProfile->planNs);
+						plan = prepare_query_plan(queryInfo, arg);
+					}
+					pProfile->lastPlanMode = plan.mode;
+					pProfile->lastPlanFlags = plan.flags;
+					if ((plan.flags & QueryPlanFlag_Filtered) != 0 && plan.mode != QueryPlanMode::Empty)
+						pProfile->filteredChunkCnt += count_filtered_chunks(queryInfo, plan);
+					return plan;
+				}
+
+			public:
+
 				//! Tag selecting enabled-only row constraints for prepared query iteration.
 				struct IterModeEnabled final {};
 				//! Tag selecting disabled-only row constraints for prepared query iteration.
@@ -2212,6 +2577,31 @@ namespace gaia {
 				//! \param pWorld World owning the chunk batches.
 				//! \param func Callback invoked once per initialized chunk iterator.
 				//! \param batches Prepared chunk batches to iterate.
+				//! Prefetches the queried columns of the chunk GAIA_QUERY_PREFETCH_DISTANCE batches ahead of \a batchIdx
+				//! and the header of the chunk one batch further. Batches may be processed on a different thread than
+				//! the one that built them so the headers can not be assumed to be cached.
+				//! \param batches Batches being processed
+				//! \param batchIdx Index of the batch about to be processed
+				static GAIA_FORCEINLINE void prefetch_batch_ahead(std::span<ChunkBatch> batches, uint32_t batchIdx) {
+#if GAIA_USE_PREFETCH && GAIA_QUERY_PREFETCH_DISTANCE > 0
+					const auto aheadIdx = batchIdx + (uint32_t)GAIA_QUERY_PREFETCH_DISTANCE;
+					if (aheadIdx >= batches.size())
+						return;
+
+					if (aheadIdx + 1 < batches.size()) {
+						const auto& next = batches[aheadIdx + 1];
+						next.pChunk->prefetch_header(
+								next.pArchetype->data_offsets().firstByte_Records, next.pArchetype->props().cntEntities);
+					}
+
+					const auto& batch = batches[aheadIdx];
+					batch.pChunk->prefetch_data(batch.pCompIndices, MAX_ITEMS_IN_QUERY);
+#else
+					(void)batches;
+					(void)batchIdx;
+#endif
+				}
+
 				//! \see run_query_func(World*, Func, ChunkBatch&)
 				template <typename Func, typename TMode>
 				static void run_query_func(World* pWorld, Func func, std::span<ChunkBatch> batches) {
@@ -2255,30 +2645,13 @@ namespace gaia {
 						it.clear_touched_writes();
 					};
 
-					// We only have one chunk to process.
-					if GAIA_UNLIKELY (chunkCnt == 1) {
-						apply_batch(batches[0]);
-						return;
-					}
-
-					// We have many chunks to process.
 					// Chunks might be located at different memory locations. Not even in the same memory page.
 					// Therefore, to make it easier for the CPU we give it a hint that we want to prefetch data
-					// for the next chunk explicitly so we do not end up stalling later.
-					// Note, this is a micro optimization and on average it brings no performance benefit. It only
-					// helps with edge cases.
-					// Let us be conservative for now and go with T2. That means we will try to keep our data at
-					// least in L3 cache or higher.
-					gaia::prefetch(batches[1].pChunk, PrefetchHint::PREFETCH_HINT_T2);
-					apply_batch(batches[0]);
-
-					uint32_t chunkIdx = 1;
-					for (; chunkIdx < chunkCnt - 1; ++chunkIdx) {
-						gaia::prefetch(batches[chunkIdx + 1].pChunk, PrefetchHint::PREFETCH_HINT_T2);
-						apply_batch(batches[chunkIdx]);
+					// of the chunks ahead explicitly so we do not end up stalling later.
+					GAIA_FOR(chunkCnt) {
+						prefetch_batch_ahead(batches, i);
+						apply_batch(batches[i]);
 					}
-
-					apply_batch(batches[chunkIdx]);
 				}
 
 				//------------------------------------------------
@@ -2377,6 +2750,7 @@ namespace gaia {
 					}
 
 					auto* pWorld = m_storage.world();
+					group_batches_by_numa_node(m_batches);
 					lock(*pWorld);
 
 					auto* pCtx = new QueryJobCtx<Func, TMode>{this, pWorld, {}, GAIA_MOV(func)};
@@ -2393,10 +2767,42 @@ namespace gaia {
 						auto& ctx = *reinterpret_cast<QueryJobCtx<Func, TMode>*>(pInvokeCtx);
 						run_query_func<Func, TMode>(ctx.pWorld, ctx.func, std::span(&ctx.batches[idxStart], idxEnd - idxStart));
 					};
+					desc.numa_node = [](void* pInvokeCtx, uint32_t idx) {
+						auto& ctx = *reinterpret_cast<QueryJobCtx<Func, TMode>*>(pInvokeCtx);
+						return (uint8_t)ctx.batches[idx].pArchetype->numa_node();
+					};
 
 					return sched_add_par(world_sched(*pWorld), desc, pCtx, &cleanup_query_job<Func, TMode>);
 				}
 
+				//! Reorders \a batches so batches of chunks placed on the same NUMA node are next to each other.
+				//! Together with the node hints passed to the scheduler this keeps every job on a single node.
+				//! \param batches Batches to reorder
+				static void group_batches_by_numa_node([[maybe_unused]] cnt::darray<ChunkBatch>& batches) {
+#if GAIA_USE_NUMA
+					const auto nodeCnt = mt::numa_node_cnt();
+					if (nodeCnt < 2 || batches.size() < 2)
+						return;
+
+					// Counting sort by node keeps the original order of batches within each node
+					uint32_t offsets[mt::MaxNumaNodes + 1]{};
+					for (const auto& batch: batches)
+						++offsets[batch.pArchetype->numa_node() + 1];
+					// Nothing to reorder when all batches live on the same node
+					GAIA_FOR(nodeCnt) {
+						if (offsets[i + 1] == batches.size())
+							return;
+					}
+					GAIA_FOR2(1, nodeCnt + 1) offsets[i] += offsets[i - 1];
+
+					cnt::darray<ChunkBatch> grouped;
+					grouped.resize(batches.size());
+					for (const auto& batch: batches)
+						grouped[offsets[batch.pArchetype->numa_node()]++] = batch;
+					batches = GAIA_MOV(grouped);
+#endif
+				}
+
 				template <bool HasFilters>
 				void
 				collect_runtime_parallel_batches(const QueryInfo& queryInfo, const QueryPlan& plan, Constraints constraints) {
@@ -2418,13 +2824,14 @@ namespace gaia {
 								continue;
 
 							const auto viewFrom = view.startRow;
-							const auto viewTo = (uint16_t)(view.startRow + view.count);
-							uint16_t minStartRow = 0;
-							uint16_t minEndRow = 0;
+							const auto viewTo = (ChunkRow)(view.startRow + view.count);
+							ChunkRow minStartRow = 0;
+							ChunkRow minEndRow = 0;
 							chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
 							const auto startRow = core::get_max(minStartRow, viewFrom);
 							const auto endRow = core::get_min(minEndRow, viewTo);
-							if (endRow == startRow)
+							// Slices made only of rows outside of the effective range are skipped
+							if (endRow <= startRow)
 								continue;
 
 							if constexpr (HasFilters) {
@@ -2452,8 +2859,8 @@ namespace gaia {
 								hasInheritedData ? queryInfo.inherited_data_view(i) : InheritedTermDataView{};
 						const auto& chunks = pArchetype->chunks();
 						for (auto* pChunk: chunks) {
-							uint16_t from = 0;
-							uint16_t to = 0;
+							ChunkRow from = 0;
+							ChunkRow to = 0;
 							chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 							if GAIA_UNLIKELY (from == to)
 								continue;
@@ -2542,14 +2949,14 @@ namespace gaia {
 								continue;
 
 							const auto viewFrom = view.startRow;
-							const auto viewTo = (uint16_t)(view.startRow + view.count);
-							uint16_t minStartRow = 0;
-							uint16_t minEndRow = 0;
+							const auto viewTo = (ChunkRow)(view.startRow + view.count);
+							ChunkRow minStartRow = 0;
+							ChunkRow minEndRow = 0;
 							chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
 							const auto startRow = core::get_max(minStartRow, viewFrom);
 							const auto endRow = core::get_min(minEndRow, viewTo);
-							const auto totalRows = endRow - startRow;
-							if (totalRows == 0)
+							// Slices made only of rows outside of the effective range are skipped
+							if (endRow <= startRow)
 								continue;
 
 							if constexpr (HasFilters) {
@@ -2588,8 +2995,8 @@ namespace gaia {
 
 								ChunkSpanMut chunkSpan((Chunk**)&chunks[chunkOffset], batchSize);
 								for (auto* pChunk: chunkSpan) {
-									uint16_t from = 0;
-									uint16_t to = 0;
+									ChunkRow from = 0;
+									ChunkRow to = 0;
 									chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 									if GAIA_UNLIKELY (from == to)
 										continue;
@@ -2651,14 +3058,14 @@ namespace gaia {
 								continue;
 
 							const auto viewFrom = view.startRow;
-							const auto viewTo = (uint16_t)(view.startRow + view.count);
-							uint16_t minStartRow = 0;
-							uint16_t minEndRow = 0;
+							const auto viewTo = (ChunkRow)(view.startRow + view.count);
+							ChunkRow minStartRow = 0;
+							ChunkRow minEndRow = 0;
 							chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
 							const auto startRow = core::get_max(minStartRow, viewFrom);
 							const auto endRow = core::get_min(minEndRow, viewTo);
-							const auto totalRows = endRow - startRow;
-							if (totalRows == 0)
+							// Slices made only of rows outside of the effective range are skipped
+							if (endRow <= startRow)
 								continue;
 
 							if constexpr (HasFilters) {
@@ -2685,8 +3092,8 @@ namespace gaia {
 									hasInheritedData ? queryInfo.inherited_data_view(i) : InheritedTermDataView{};
 							const auto& chunks = pArchetype->chunks();
 							for (auto* pChunk: chunks) {
-								uint16_t from = 0;
-								uint16_t to = 0;
+								ChunkRow from = 0;
+								ChunkRow to = 0;
 								chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 								if GAIA_UNLIKELY (from == to)
 									continue;
@@ -2704,6 +3111,7 @@ namespace gaia {
 					if (m_batches.empty())
 						return;
 
+					group_batches_by_numa_node(m_batches);
 					lock(*m_storage.world());
 
 					struct ParallelQueryBatchCtx {
@@ -2722,6 +3130,10 @@ namespace gaia {
 								ctx.pSelf->m_storage.world(), *ctx.pFunc,
 								std::span(&ctx.pSelf->m_batches[idxStart], idxEnd - idxStart));
 					};
+					desc.numa_node = [](void* pCtx, uint32_t idx) {
+						auto& ctx = *reinterpret_cast<ParallelQueryBatchCtx*>(pCtx);
+						return (uint8_t)ctx.pSelf->m_batches[idx].pArchetype->numa_node();
+					};
 
 					const auto& sched = world_sched(*m_storage.world());
 					const auto token = sched_par(sched, desc);
@@ -2782,8 +3194,8 @@ namespace gaia {
 
 							ChunkSpanMut chunkSpan((Chunk**)&chunks[chunkOffset], batchSize);
 							for (auto* pChunk: chunkSpan) {
-								uint16_t from = 0;
-								uint16_t to = 0;
+								ChunkRow from = 0;
+								ChunkRow to = 0;
 								chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 								if GAIA_UNLIKELY (from == to)
 									continue;
@@ -2862,8 +3274,8 @@ namespace gaia {
 						const auto groupId = queryInfo.group_id(i);
 						const auto& chunks = pArchetype->chunks();
 						for (auto* pChunk: chunks) {
-							uint16_t from = 0;
-							uint16_t to = 0;
+							ChunkRow from = 0;
+							ChunkRow to = 0;
 							chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 							if GAIA_UNLIKELY (from == to)
 								continue;
@@ -2880,6 +3292,7 @@ namespace gaia {
 					if (m_batches.empty())
 						return;
 
+					group_batches_by_numa_node(m_batches);
 					lock(*m_storage.world());
 
 					struct ParallelQueryBatchCtx {
@@ -2898,6 +3311,10 @@ namespace gaia {
 								ctx.pSelf->m_storage.world(), *ctx.pFunc,
 								std::span(&ctx.pSelf->m_batches[idxStart], idxEnd - idxStart));
 					};
+					desc.numa_node = [](void* pCtx, uint32_t idx) {
+						auto& ctx = *reinterpret_cast<ParallelQueryBatchCtx*>(pCtx);
+						return (uint8_t)ctx.pSelf->m_batches[idx].pArchetype->numa_node();
+					};
 
 					const auto& sched = world_sched(*m_storage.world());
 					const auto token = sched_par(sched, desc);
@@ -3051,21 +3468,10 @@ namespace gaia {
 						it.clear_touched_writes();
 					};
 
-					if GAIA_UNLIKELY (chunkCnt == 1) {
-						apply_batch(batches[0]);
-						return;
-					}
-
-					gaia::prefetch(batches[1].pChunk, PrefetchHint::PREFETCH_HINT_T2);
-					apply_batch(batches[0]);
-
-					uint32_t chunkIdx = 1;
-					for (; chunkIdx < chunkCnt - 1; ++chunkIdx) {
-						gaia::prefetch(batches[chunkIdx + 1].pChunk, PrefetchHint::PREFETCH_HINT_T2);
-						apply_batch(batches[chunkIdx]);
+					GAIA_FOR(chunkCnt) {
+						prefetch_batch_ahead(batches, i);
+						apply_batch(batches[i]);
 					}
-
-					apply_batch(batches[chunkIdx]);
 				}
 
 				template <bool HasFilters, typename Func>
@@ -3094,14 +3500,14 @@ namespace gaia {
 								continue;
 
 							const auto viewFrom = view.startRow;
-							const auto viewTo = (uint16_t)(view.startRow + view.count);
-							uint16_t minStartRow = 0;
-							uint16_t minEndRow = 0;
+							const auto viewTo = (ChunkRow)(view.startRow + view.count);
+							ChunkRow minStartRow = 0;
+							ChunkRow minEndRow = 0;
 							chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
 							const auto startRow = core::get_max(minStartRow, viewFrom);
 							const auto endRow = core::get_min(minEndRow, viewTo);
-							const auto totalRows = endRow - startRow;
-							if (totalRows == 0)
+							// Slices made only of rows outside of the effective range are skipped
+							if (endRow <= startRow)
 								continue;
 
 							if constexpr (HasFilters) {
@@ -3141,8 +3547,8 @@ namespace gaia {
 
 								ChunkSpanMut chunkSpan((Chunk**)&chunks[chunkOffset], batchSize);
 								for (auto* pChunk: chunkSpan) {
-									uint16_t from = 0;
-									uint16_t to = 0;
+									ChunkRow from = 0;
+									ChunkRow to = 0;
 									chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 									if GAIA_UNLIKELY (from == to)
 										continue;
@@ -3199,14 +3605,14 @@ namespace gaia {
 								continue;
 
 							const auto viewFrom = view.startRow;
-							const auto viewTo = (uint16_t)(view.startRow + view.count);
-							uint16_t minStartRow = 0;
-							uint16_t minEndRow = 0;
+							const auto viewTo = (ChunkRow)(view.startRow + view.count);
+							ChunkRow minStartRow = 0;
+							ChunkRow minEndRow = 0;
 							chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
 							const auto startRow = core::get_max(minStartRow, viewFrom);
 							const auto endRow = core::get_min(minEndRow, viewTo);
-							const auto totalRows = endRow - startRow;
-							if (totalRows == 0)
+							// Slices made only of rows outside of the effective range are skipped
+							if (endRow <= startRow)
 								continue;
 
 							if constexpr (HasFilters) {
@@ -3233,8 +3639,8 @@ namespace gaia {
 									hasInheritedData ? queryInfo.inherited_data_view(i) : InheritedTermDataView{};
 							const auto& chunks = pArchetype->chunks();
 							for (auto* pChunk: chunks) {
-								uint16_t from = 0;
-								uint16_t to = 0;
+								ChunkRow from = 0;
+								ChunkRow to = 0;
 								chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 								if GAIA_UNLIKELY (from == to)
 									continue;
@@ -3252,6 +3658,7 @@ namespace gaia {
 					if (m_batches.empty())
 						return;
 
+					group_batches_by_numa_node(m_batches);
 					lock(*m_storage.world());
 
 					struct ParallelQueryBatchCtx {
@@ -3271,6 +3678,10 @@ namespace gaia {
 								ctx.pSelf->m_storage.world(), *ctx.pFunc, std::span(&ctx.pSelf->m_batches[idxStart], idxEnd - idxStart),
 								ctx.constraints);
 					};
+					desc.numa_node = [](void* pCtx, uint32_t idx) {
+						auto& ctx = *reinterpret_cast<ParallelQueryBatchCtx*>(pCtx);
+						return (uint8_t)ctx.pSelf->m_batches[idx].pArchetype->numa_node();
+					};
 
 					const auto& sched = world_sched(*m_storage.world());
 					const auto token = sched_par(sched, desc);
@@ -3317,8 +3728,8 @@ namespace gaia {
 
 							ChunkSpanMut chunkSpan((Chunk**)&chunks[chunkOffset], batchSize);
 							for (auto* pChunk: chunkSpan) {
-								uint16_t from = 0;
-								uint16_t to = 0;
+								ChunkRow from = 0;
+								ChunkRow to = 0;
 								chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 								if GAIA_UNLIKELY (from == to)
 									continue;
@@ -3375,8 +3786,8 @@ namespace gaia {
 						const auto groupId = queryInfo.group_id(i);
 						const auto& chunks = pArchetype->chunks();
 						for (auto* pChunk: chunks) {
-							uint16_t from = 0;
-							uint16_t to = 0;
+							ChunkRow from = 0;
+							ChunkRow to = 0;
 							chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 							if GAIA_UNLIKELY (from == to)
 								continue;
@@ -3393,6 +3804,7 @@ namespace gaia {
 					if (m_batches.empty())
 						return;
 
+					group_batches_by_numa_node(m_batches);
 					lock(*m_storage.world());
 
 					struct ParallelQueryBatchCtx {
@@ -3412,6 +3824,10 @@ namespace gaia {
 								ctx.pSelf->m_storage.world(), *ctx.pFunc, std::span(&ctx.pSelf->m_batches[idxStart], idxEnd - idxStart),
 								ctx.constraints);
 					};
+					desc.numa_node = [](void* pCtx, uint32_t idx) {
+						auto& ctx = *reinterpret_cast<ParallelQueryBatchCtx*>(pCtx);
+						return (uint8_t)ctx.pSelf->m_batches[idx].pArchetype->numa_node();
+					};
 
 					const auto& sched = world_sched(*m_storage.world());
 					const auto token = sched_par(sched, desc);
@@ -3473,7 +3889,7 @@ namespace gaia {
 				//! semantics.
 				GAIA_NODISCARD bool can_use_direct_chunk_iteration_fastpath(const QueryInfo& queryInfo) const {
 					const auto& data = queryInfo.ctx().data;
-					return data.sortByFunc == nullptr &&
+					return !data.has_sort() &&
 								 (!has_depth_order_hierarchy_enabled_barrier(queryInfo) || !queryInfo.barrier_may_prune());
 				}
 
@@ -3670,6 +4086,7 @@ namespace gaia {
 					const bool canSkipProcessCheck =
 							!queryInfo.result_cache_may_need_prefab_filter() && (plan.flags & QueryPlanFlag_BarrierCache) == 0;
 
+					DenseChunkPrefetcher prefetcher(queryInfo, plan.idxFrom, plan.idxTo);
 					for (uint32_t i = plan.idxFrom; i < plan.idxTo; ++i) {
 						auto* pArchetype = const_cast<Archetype*>(cacheView[i]);
 						if (canSkipProcessCheck) {
@@ -3682,7 +4099,10 @@ namespace gaia {
 						const auto* pIndices = indicesView.data();
 						const auto groupId = HasGroups ? queryInfo.group_id(i) : GroupId(0);
 						const auto& chunks = pArchetype->chunks();
-						for (auto* pChunk: chunks) {
+						GAIA_EACH_(chunks, j) {
+							auto* pChunk = chunks[j];
+							prefetcher.step(i, j);
+
 							const auto from = detail::ChunkIterImpl::start_index(pChunk, constraints);
 							const auto to = detail::ChunkIterImpl::end_index(pChunk, constraints);
 							if GAIA_UNLIKELY (from == to)
@@ -3718,10 +4138,11 @@ namespace gaia {
 				//! \param constraints Entity-row subset exposed to the callback.
 				template <QueryExecType ExecType, typename Func>
 				void each_runtime_inter(Func func, Constraints constraints = Constraints::EnabledOnly) {
+					ProfileRun profileRun(*this);
 					if constexpr (ExecType == QueryExecType::Default) {
 						auto& queryInfo = fetch();
 						match_all(queryInfo);
-						const auto plan = prepare_query_plan(queryInfo, constraints);
+						const auto plan = prepare_query_plan_prof(queryInfo, constraints);
 						if (plan.mode == QueryPlanMode::DirectDense) {
 							const bool hasGroups = (plan.flags & QueryPlanFlag_Grouped) != 0;
 							if ((plan.flags & QueryPlanFlag_Filtered) != 0) {
@@ -3821,7 +4242,7 @@ namespace gaia {
 						QueryExecType execType, void* pFunc, void (*invoke)(void*, Iter&), Constraints constraints) {
 					auto& queryInfo = fetch();
 					match_all(queryInfo);
-					const auto plan = prepare_query_plan(queryInfo, constraints);
+					const auto plan = prepare_query_plan_prof(queryInfo, constraints);
 					each_runtime_erased(queryInfo, plan, execType, pFunc, invoke, constraints);
 				}
 
@@ -3860,6 +4281,150 @@ namespace gaia {
 
 				//------------------------------------------------
 
+				//! One member of a fused multi-query chunk pass.
+				//! \see each_fused(World&, std::span<const FusedRun>)
+				struct FusedRun {
+					//! Query whose matches are visited.
+					QueryImpl* pQuery;
+					//! Opaque callback payload forwarded to \a invoke.
+					void* pCtx;
+					//! Callback run for each matching chunk of \a pQuery.
+					void (*invoke)(void*, Iter&);
+				};
+
+				//! Returns whether the query can take part in a fused chunk pass.
+				//! Fusion walks plain cached chunks with enabled rows only. Queries with entity filters, source or variable
+				//! terms, inherited payloads, grouping, sorting, hierarchy barriers or direct entity seeding are rejected.
+				//! \return True when each_fused() can run this query.
+				GAIA_NODISCARD bool can_fuse() {
+					auto& queryInfo = fetch();
+					match_all(queryInfo);
+
+					const auto& data = queryInfo.ctx().data;
+					if ((data.flags & (QueryCtx::QueryFlags::HasVariableTerms | QueryCtx::QueryFlags::HasSourceTerms)) != 0)
+						return false;
+
+					const auto plan = prepare_query_plan(queryInfo, Constraints::EnabledOnly);
+					if (plan.mode != QueryPlanMode::Empty && plan.mode != QueryPlanMode::DirectDense)
+						return false;
+
+					constexpr uint8_t RejectedFlags = QueryPlanFlag_EntityFilter | QueryPlanFlag_InheritedPayload |
+																						QueryPlanFlag_Grouped | QueryPlanFlag_Sorted | QueryPlanFlag_BarrierCache;
+					return (plan.flags & RejectedFlags) == 0;
+				}
+
+				//! Runs several queries in one shared pass over their matched chunks.
+				//!
+				//! Archetypes are visited in the order the runs first match them. For each chunk, the callbacks of all runs
+				//! matching the chunk are invoked back to back in \a runs order while the chunk data is still hot in cache.
+				//! Changed filters are evaluated per run against each query's own last-run version. Deferred structural
+				//! changes are committed once after the whole pass.
+				//! \param world World owning the queries.
+				//! \param runs Queries and callbacks to run. Every query must satisfy can_fuse().
+				static void each_fused(World& world, std::span<const FusedRun> runs) {
+					GAIA_PROF_SCOPE(query::each_fused);
+					if (runs.empty())
+						return;
+
+					struct FusedEntry {
+						uint32_t runIdx;
+						uint32_t cacheIdx;
+						uint32_t next;
+					};
+
+					cnt::darray<QueryInfo*> queryInfos;
+					cnt::darray<const Archetype*> archetypes;
+					cnt::darray<uint32_t> firstEntries;
+					cnt::darray<uint32_t> lastEntries;
+					cnt::darray<FusedEntry> entries;
+					cnt::map<const Archetype*, uint32_t> archetypeLookup;
+					queryInfos.reserve((uint32_t)runs.size());
+
+					// Build the union of matched archetypes. Each archetype keeps a list of the runs matching it
+					// in the order of the runs.
+					GAIA_FOR((uint32_t)runs.size()) {
+						auto& query = *runs[i].pQuery;
+						auto& queryInfo = query.fetch();
+						query.match_all(queryInfo);
+						GAIA_ASSERT(query.can_fuse());
+						queryInfos.push_back(&queryInfo);
+
+						const auto plan = query.prepare_query_plan(queryInfo, Constraints::EnabledOnly);
+						if (plan.mode == QueryPlanMode::Empty)
+							continue;
+
+						auto cacheView = queryInfo.cache_archetype_view();
+						for (uint32_t j = plan.idxFrom; j < plan.idxTo; ++j) {
+							const auto* pArchetype = cacheView[j];
+							if (!query.can_process_archetype_inter(queryInfo, *pArchetype, Constraints::EnabledOnly))
+								continue;
+
+							const auto entryIdx = (uint32_t)entries.size();
+							entries.push_back({i, j, UINT32_MAX});
+
+							const auto ret = archetypeLookup.try_emplace(pArchetype, (uint32_t)archetypes.size());
+							if (ret.second) {
+								archetypes.push_back(pArchetype);
+								firstEntries.push_back(entryIdx);
+								lastEntries.push_back(entryIdx);
+							} else {
+								const auto archetypeIdx = ret.first->second;
+								entries[lastEntries[archetypeIdx]].next = entryIdx;
+								lastEntries[archetypeIdx] = entryIdx;
+							}
+						}
+					}
+
+					::gaia::ecs::update_version(*runs[0].pQuery->m_worldVersion);
+					lock(world);
+
+					Iter it;
+					it.init_query_state(&world, Constraints::EnabledOnly, false);
+
+					GAIA_EACH(archetypes) {
+						auto* pArchetype = const_cast<Archetype*>(archetypes[i]);
+						const auto& chunks = pArchetype->chunks();
+						GAIA_EACH_(chunks, j) {
+							auto* pChunk = chunks[j];
+							for (uint32_t e = firstEntries[i]; e != UINT32_MAX; e = entries[e].next) {
+								const auto& entry = entries[e];
+								const auto& run = runs[entry.runIdx];
+								auto& query = *run.pQuery;
+								const auto& queryInfo = *queryInfos[entry.runIdx];
+
+								// Earlier callbacks may have toggled rows so the range is refreshed for every run
+								const auto from = detail::ChunkIterImpl::start_index(pChunk, Constraints::EnabledOnly);
+								const auto to = detail::ChunkIterImpl::end_index(pChunk, Constraints::EnabledOnly);
+								if GAIA_UNLIKELY (from == to)
+									continue;
+
+								auto indicesView = queryInfo.indices_mapping_view(entry.cacheIdx);
+								if (queryInfo.has_filters() &&
+										!match_filters(*pChunk, queryInfo, query.m_changedWorldVersion, indicesView))
+									continue;
+
+								it.set_query_chunk(pArchetype, indicesView.data(), pChunk, from, to);
+								it.ctx(query.m_ctx);
+								{
+									GAIA_PROF_SCOPE(query_func);
+									run.invoke(run.pCtx, it);
+								}
+								finish_iter_writes(it);
+								it.clear_touched_writes();
+							}
+						}
+					}
+
+					unlock(world);
+					commit_cmd_buffer_st(world);
+					commit_cmd_buffer_mt(world);
+
+					for (const auto& run: runs)
+						run.pQuery->m_changedWorldVersion = *run.pQuery->m_worldVersion;
+				}
+
+				//------------------------------------------------
+
 				//! Returns whether a direct term is backed by non-fragmenting storage and must be evaluated per entity.
 				//! \param world World
 				//! \param term Query term
@@ -4016,17 +4581,17 @@ namespace gaia {
 				static void
 				add_chunk_run(cnt::darray<detail::BfsChunkRun>& runs, const EntityContainer& ec, uint32_t entityOffset) {
 					if (runs.empty()) {
-						runs.push_back({ec.pArchetype, ec.pChunk, ec.row, (uint16_t)(ec.row + 1), entityOffset});
+						runs.push_back({ec.pArchetype, ec.pChunk, ec.row, (ChunkRow)(ec.row + 1), entityOffset});
 						return;
 					}
 
 					auto& run = runs.back();
 					if (ec.pChunk == run.pChunk && ec.row == run.to) {
-						run.to = (uint16_t)(run.to + 1);
+						run.to = (ChunkRow)(run.to + 1);
 						return;
 					}
 
-					runs.push_back({ec.pArchetype, ec.pChunk, ec.row, (uint16_t)(ec.row + 1), entityOffset});
+					runs.push_back({ec.pArchetype, ec.pChunk, ec.row, (ChunkRow)(ec.row + 1), entityOffset});
 				}
 
 				struct DirectEntitySeedInfo {
@@ -4656,8 +5221,8 @@ namespace gaia {
 
 						if (!hasEntityFilters) {
 							for (auto* pChunk: chunks) {
-								uint16_t from = 0;
-								uint16_t to = 0;
+								ChunkRow from = 0;
+								ChunkRow to = 0;
 								chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 								if (from == to)
 									continue;
@@ -4672,8 +5237,8 @@ namespace gaia {
 						}
 
 						const bool isNotEmpty = core::has_if(chunks, [&](Chunk* pChunk) {
-							uint16_t from = 0;
-							uint16_t to = 0;
+							ChunkRow from = 0;
+							ChunkRow to = 0;
 							chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 							if (from == to)
 								return false;
@@ -4811,6 +5376,15 @@ namespace gaia {
 					return false;
 				}
 
+				//! Checks whether count() and empty() results of the query can be remembered between calls.
+				//! Entity filters and per-entity evaluation read non-fragmenting data the cache key does not track.
+				//! \param queryInfo Prepared query cache and execution metadata.
+				//! \return True when the results depend only on the rows of the matched archetypes.
+				GAIA_NODISCARD bool can_cache_count(const QueryInfo& queryInfo) const {
+					return uses_query_cache_storage() && !queryInfo.has_entity_filter_terms() &&
+								 !can_use_direct_entity_seed_eval(queryInfo);
+				}
+
 				//! Fast count() path for direct non-fragmenting queries that can seed from non-fragmenting term indices.
 				//! \tparam UseFilters True when changed/per-chunk filters must be evaluated.
 				//! \param queryInfo Prepared query cache and execution metadata.
@@ -4871,10 +5445,10 @@ namespace gaia {
 
 						if (!hasEntityFilters) {
 							for (auto* pChunk: chunks) {
-								uint16_t from = 0;
-								uint16_t to = 0;
+								ChunkRow from = 0;
+								ChunkRow to = 0;
 								chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
-								const uint16_t entityCnt = to - from;
+								const ChunkRow entityCnt = to - from;
 								if (entityCnt == 0)
 									continue;
 								it.set_chunk(pChunk, from, to);
@@ -4889,10 +5463,10 @@ namespace gaia {
 							continue;
 						}
 						for (auto* pChunk: chunks) {
-							uint16_t from = 0;
-							uint16_t to = 0;
+							ChunkRow from = 0;
+							ChunkRow to = 0;
 							chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
-							const uint16_t entityCnt = to - from;
+							const ChunkRow entityCnt = to - from;
 							if (entityCnt == 0)
 								continue;
 							it.set_chunk(pChunk, from, to);
@@ -4971,7 +5545,7 @@ namespace gaia {
 						pLastArchetype = ec.pArchetype;
 					}
 
-					it.set_chunk(ec.pChunk, ec.row, (uint16_t)(ec.row + 1));
+					it.set_chunk(ec.pChunk, ec.row, (ChunkRow)(ec.row + 1));
 					it.set_group_id(0);
 				}
 
@@ -5202,6 +5776,16 @@ namespace gaia {
 				//! \cond INTERNAL
 				template <bool UseFilters, typename ContainerOut>
 				void arr_inter(QueryInfo& queryInfo, ContainerOut& outArray, Constraints constraints);
+
+				//! Moves \a cursor back onto the archetype and chunk it pointed at before structural changes.
+				//! \param queryInfo Query info
+				//! \param cursor Cursor to repair
+				static void cursor_revalidate(const QueryInfo& queryInfo, QueryCursor& cursor);
+
+				template <bool UseFilters, typename ContainerOut>
+				void next_inter(
+						QueryInfo& queryInfo, QueryCursor& cursor, ContainerOut& outArray, uint32_t maxRows,
+						Constraints constraints);
 				//! \endcond
 
 			public:
@@ -5854,6 +6438,26 @@ namespace gaia {
 				template <typename Rel, typename Tgt>
 				QueryImpl& sort_by(TSortByFunc func);
 
+				//! Sorts the query by a key projected from one or more components.
+				//! The projection receives the components and returns an integer, floating-point or enum value, or
+				//! a std::tuple / std::pair of them to sort by several criteria at once. Tuples are compared element by
+				//! element. The key is packed into 64 bits and rows are radix-sorted by it, so the projection runs once
+				//! per row on each resort and no comparator is called.
+				//! \code
+				//! q.sort_by<Layer, Position>([](const Layer& l, const Position& p) {
+				//! 	return std::make_tuple(l.value, p.z);
+				//! });
+				//! \endcode
+				//! \tparam Keys Components passed to the projection, at most MAX_SORT_KEYS_IN_QUERY. Use ecs::Entity to pass
+				//!              the entity itself. Components are registered if they haven't been registered yet.
+				//! \tparam Projection Captureless lambda or function taking `const Keys&...`.
+				//! \param projection Key projection
+				//! \return Self reference.
+				template <
+						typename... Keys, typename Projection,
+						typename = std::enable_if_t<(sizeof...(Keys) > 0) && std::is_invocable_v<Projection, const Keys&...>>>
+				QueryImpl& sort_by(Projection projection);
+
 				//------------------------------------------------
 
 				//! Lightweight view that executes a query in deterministic relation traversal order.
@@ -6157,6 +6761,7 @@ namespace gaia {
 				//! \see Iter::ctx() const
 				template <typename Func>
 				void each_arch(Func func, Constraints constraints = Constraints::EnabledOnly) {
+					ProfileRun profileRun(*this);
 					auto& queryInfo = fetch();
 					match_all(queryInfo);
 					run_query_on_archetypes<QueryExecType::Default>(
@@ -6169,15 +6774,37 @@ namespace gaia {
 							constraints);
 				}
 
+				//! Iterates query matches like each(Func) with an `Iter&` callback. Inside \a func, components can be accessed
+				//! through Iter::simd_view() and Iter::simd_view_mut(). Those views cover whole vectors of \a Width rows
+				//! so kernels need no scalar tail loops. Writes to padding lanes are neither reported as changed nor
+				//! visible to entities outside of the iterated range.
+				//! \tparam Width Number of lanes in a vector. A power of two no larger than ChunkHeader::SIMD_ROW_GRANULE.
+				//! \tparam Func Iterator callback type invocable with `Iter&`.
+				//! \param func Callable invoked for each match.
+				//! \param constraints Entity-row subset exposed to the callback.
+				template <uint32_t Width, typename Func>
+				void each_simd(Func func, Constraints constraints = Constraints::EnabledOnly) {
+					static_assert(core::is_pow2(Width) && Width <= ChunkHeader::SIMD_ROW_GRANULE);
+
+					detail::SimdIterState simdState;
+					each(
+							[&](Iter& it) {
+								it.simd_begin(&simdState);
+								func(it);
+								it.simd_end();
+							},
+							constraints);
+				}
+
 				//------------------------------------------------
 
 				//!	Returns true or false depending on whether there are any entities matching the query.
 				//!	\warning Only use if you only care if there are any entities matching the query.
-				//!					 The result is not cached and repeated calls to the function might be slow.
 				//!					 If you already called arr(), checking if it is empty is preferred.
 				//!					 Use empty() instead of calling count()==0.
 				//! \note For changed() queries this is a non-consuming probe. It does not advance the
 				//!       query's changed-reporting state. Iteration APIs such as each()/arr() do consume it.
+				//! \note Results of unfiltered cached queries are remembered until the world changes.
 				//!	\return True if there are any entities matching the query. False otherwise.
 				//! \param constraints Entity-row subset included in the probe.
 				bool empty(Constraints constraints = Constraints::EnabledOnly) {
@@ -6189,17 +6816,26 @@ namespace gaia {
 					match_all(queryInfo);
 
 					const bool hasFilters = queryInfo.has_filters();
-					if (hasFilters) {
+					if (hasFilters)
 						return empty_inter<true>(queryInfo, constraints);
-					} else {
+					if (!can_cache_count(queryInfo))
 						return empty_inter<false>(queryInfo, constraints);
-					}
+
+					const auto cacheRange = selected_query_cache_range(queryInfo);
+					if (const auto* pEntry = queryInfo.try_cached_count(constraints, cacheRange.idxFrom, cacheRange.idxTo))
+						return pEntry->cnt == 0;
+
+					const bool isEmpty = empty_inter<false>(queryInfo, constraints);
+					queryInfo.cache_count(constraints, cacheRange.idxFrom, cacheRange.idxTo, isEmpty ? 0 : 1, isEmpty);
+					return isEmpty;
 				}
 
 				//! Calculates the number of entities matching the query
 				//! \warning Only use if you only care about the number of entities matching the query.
-				//!          The result is not cached and repeated calls to the function might be slow.If you already called
-				//!          arr(), use the size provided by the array.Use empty() instead of calling count() == 0.
+				//!          If you already called arr(), use the size provided by the array.
+				//!          Use empty() instead of calling count() == 0.
+				//! \note Results of unfiltered cached queries are remembered until the world changes.
+				//!       Repeated calls are cheap then.
 				//! \note For changed() queries this is a non-consuming probe. It does not advance the
 				//!       query's changed-reporting state. Iteration APIs such as each()/arr() do consume it.
 				//! \return The number of matching entities
@@ -6213,7 +6849,19 @@ namespace gaia {
 					match_all(queryInfo);
 
 					const bool hasFilters = queryInfo.has_filters();
-					return hasFilters ? count_inter<true>(queryInfo, constraints) : count_inter<false>(queryInfo, constraints);
+					if (hasFilters)
+						return count_inter<true>(queryInfo, constraints);
+					if (!can_cache_count(queryInfo))
+						return count_inter<false>(queryInfo, constraints);
+
+					const auto cacheRange = selected_query_cache_range(queryInfo);
+					const auto* pEntry = queryInfo.try_cached_count(constraints, cacheRange.idxFrom, cacheRange.idxTo);
+					if (pEntry != nullptr && pEntry->exact)
+						return pEntry->cnt;
+
+					const auto cnt = count_inter<false>(queryInfo, constraints);
+					queryInfo.cache_count(constraints, cacheRange.idxFrom, cacheRange.idxTo, cnt, true);
+					return cnt;
 				}
 
 				//! Iterates matching enabled entities through a non-template erased callback.
@@ -6404,6 +7052,414 @@ namespace gaia {
 				template <typename Container>
 				void arr(Container& outArray, Constraints constraints = Constraints::EnabledOnly);
 
+				//! Appends up to \a maxRows components or entities matching the query to the output array,
+				//! continuing from where the previous call with the same \a cursor stopped.
+				//! Unlike arr(), the results can be walked in bounded slices spread over several frames.
+				//! \tparam Container Container type
+				//! \param cursor Position within the results. Use a default-constructed cursor to start from the beginning.
+				//! \param[out] outArray Container storing entities or components
+				//! \param maxRows Maximum number of items appended
+				//! \param constraints QueryImpl constraints
+				//! \return Number of items appended. Zero once the cursor is done.
+				template <typename Container>
+				uint32_t next(
+						QueryCursor& cursor, Container& outArray, uint32_t maxRows,
+						Constraints constraints = Constraints::EnabledOnly);
+
+			private:
+				//! Contiguous run of chunk rows copied by gather() and scatter().
+				struct GatherBatch {
+					//! Chunk holding the rows
+					Chunk* pChunk;
+					//! First row of the run
+					ChunkRow from;
+					//! One past the last row of the run
+					ChunkRow to;
+					//! Index of the first row in the gathered buffers
+					uint32_t dstOffset;
+				};
+
+				//! Collects the chunk row runs matched by the query in iteration order.
+				//! \tparam UseFilters True when changed() filters are evaluated
+				//! \param queryInfo Query info
+				//! \param changedWorldVersion World version changed() filters compare against
+				//! \param[out] batches Collected row runs
+				//! \return Total number of collected rows
+				template <bool UseFilters>
+				uint32_t
+				gather_batches(QueryInfo& queryInfo, uint32_t changedWorldVersion, cnt::darray<GatherBatch>& batches) {
+					constexpr auto constraints = Constraints::EnabledOnly;
+					const auto cacheRange = selected_query_cache_range(queryInfo);
+					if (!cacheRange.valid)
+						return 0;
+
+					const auto cacheView = queryInfo.cache_archetype_view();
+					const bool needsBarrierCache = needs_depth_order_hierarchy_barrier_cache(queryInfo, constraints);
+					const bool hasSortedArrayPayload = queryInfo.has_sorted_payload() || needsBarrierCache;
+					const auto sortView =
+							hasSortedArrayPayload ? queryInfo.cache_sort_view() : decltype(queryInfo.cache_sort_view()){};
+					if (needsBarrierCache)
+						queryInfo.ensure_depth_order_hierarchy_barrier_cache();
+					const bool hasEntityFilters = queryInfo.has_entity_filter_terms();
+					const auto& world = *queryInfo.world();
+
+					uint32_t rowCnt = 0;
+					const auto push_run = [&](Chunk* pChunk, ChunkRow from, ChunkRow to) {
+						batches.push_back({pChunk, from, to, rowCnt});
+						rowCnt += (uint32_t)(to - from);
+					};
+					const auto add_rows = [&](Chunk* pChunk, ChunkRow from, ChunkRow to) {
+						if (from >= to)
+							return;
+						if constexpr (UseFilters) {
+							if (!match_filters(*pChunk, queryInfo, changedWorldVersion))
+								return;
+						}
+						if (!hasEntityFilters) {
+							push_run(pChunk, from, to);
+							return;
+						}
+
+						// Rows rejected by entity filters split the range into several runs
+						const auto entities = pChunk->entity_view();
+						auto runFrom = from;
+						for (auto row = from; row < to; ++row) {
+							if (match_entity_filters(world, entities[row], queryInfo))
+								continue;
+							if (runFrom < row)
+								push_run(pChunk, runFrom, row);
+							runFrom = (ChunkRow)(row + 1);
+						}
+						if (runFrom < to)
+							push_run(pChunk, runFrom, to);
+					};
+
+					if (!sortView.empty()) {
+						for (const auto& view: sortView) {
+							if (view.archetypeIdx < cacheRange.idxFrom || view.archetypeIdx >= cacheRange.idxTo)
+								continue;
+
+							const bool barrierPasses = !needsBarrierCache || queryInfo.barrier_passes(view.archetypeIdx);
+							if GAIA_UNLIKELY (!can_process_archetype_inter(
+																		queryInfo, *cacheView[view.archetypeIdx], constraints, barrierPasses))
+								continue;
+
+							ChunkRow minStartRow = 0;
+							ChunkRow minEndRow = 0;
+							chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
+							add_rows(
+									view.pChunk, core::get_max(minStartRow, view.startRow),
+									core::get_min(minEndRow, (ChunkRow)(view.startRow + view.count)));
+						}
+						return rowCnt;
+					}
+
+					for (uint32_t i = cacheRange.idxFrom; i < cacheRange.idxTo; ++i) {
+						const auto* pArchetype = cacheView[i];
+						const bool barrierPasses = !needsBarrierCache || queryInfo.barrier_passes(i);
+						if GAIA_UNLIKELY (!can_process_archetype_inter(queryInfo, *pArchetype, constraints, barrierPasses))
+							continue;
+
+						for (auto* pChunk: pArchetype->chunks()) {
+							ChunkRow from = 0;
+							ChunkRow to = 0;
+							chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
+							add_rows(pChunk, from, to);
+						}
+					}
+
+					return rowCnt;
+				}
+
+				//! Collects the row runs gather() or scatter() copies.
+				//! \param queryInfo Query info
+				//! \param changedWorldVersion World version changed() filters compare against
+				//! \param[out] batches Collected row runs
+				//! \return Total number of collected rows
+				uint32_t
+				gather_batches(QueryInfo& queryInfo, uint32_t changedWorldVersion, cnt::darray<GatherBatch>& batches) {
+					batches.clear();
+					if (queryInfo.has_filters())
+						return gather_batches<true>(queryInfo, changedWorldVersion, batches);
+					return gather_batches<false>(queryInfo, changedWorldVersion, batches);
+				}
+
+				//! Checks the type of a gathered column at compile time.
+				template <typename T>
+				static constexpr void gather_verify_column() {
+					static_assert(std::is_same_v<T, core::raw_t<T>>, "gather/scatter columns must be raw types");
+					static_assert(!is_pair<T>::value, "gather/scatter does not support pairs");
+					static_assert(!std::is_empty_v<T>, "gather/scatter does not support tag components");
+					static_assert(!mem::is_soa_layout_v<T>, "gather/scatter does not support SoA components");
+				}
+
+				//! Returns the index of the chunk column storing \a id.
+				//! \param chunk Chunk
+				//! \param id Component id
+				//! \return Column index
+				GAIA_NODISCARD static uint32_t gather_comp_idx(const Chunk& chunk, Entity id) {
+					const auto compIdx = core::get_index(chunk.ids_view(), id);
+					GAIA_ASSERT(compIdx != BadIndex && "gather/scatter needs components stored in the matched chunks");
+					return compIdx;
+				}
+
+				//! Copies rows [from, to) of one chunk column to \a pDst.
+				template <typename T>
+				static void gather_column(const Chunk& chunk, Entity id, ChunkRow from, ChunkRow to, T* pDst) {
+					const auto cnt = (uint32_t)(to - from);
+					const T* pSrc = nullptr;
+					if constexpr (std::is_same_v<T, Entity>) {
+						(void)id;
+						pSrc = chunk.entity_view().data() + from;
+					} else
+						pSrc = (const T*)chunk.comp_ptr(gather_comp_idx(chunk, id), from);
+
+					if constexpr (std::is_trivially_copyable_v<T>)
+						memcpy((void*)pDst, (const void*)pSrc, sizeof(T) * cnt);
+					else {
+						GAIA_FOR(cnt) pDst[i] = pSrc[i];
+					}
+				}
+
+				//! Copies \a pSrc to rows [from, to) of one chunk column.
+				//! Entity columns are identities rather than data. They are only checked against the chunk.
+				template <typename T>
+				static void scatter_column(Chunk& chunk, Entity id, ChunkRow from, ChunkRow to, const T* pSrc) {
+					const auto cnt = (uint32_t)(to - from);
+					if constexpr (std::is_same_v<T, Entity>) {
+						(void)id;
+#if GAIA_ASSERT_ENABLED
+						const auto entities = chunk.entity_view();
+						GAIA_FOR(cnt) {
+							GAIA_ASSERT(entities[from + i] == pSrc[i] && "scatter rows no longer match the gathered entities");
+						}
+#else
+						(void)chunk;
+						(void)cnt;
+						(void)pSrc;
+#endif
+					} else {
+						auto* pDst = (T*)chunk.comp_ptr_mut(gather_comp_idx(chunk, id), from);
+						if constexpr (std::is_trivially_copyable_v<T>)
+							memcpy((void*)pDst, (const void*)pSrc, sizeof(T) * cnt);
+						else {
+							GAIA_FOR(cnt) pDst[i] = pSrc[i];
+						}
+					}
+				}
+
+				//! Runs \a func for every batch. Parallel execution types spread the batches over the scheduler.
+				template <typename Func>
+				void gather_run(QueryExecType execType, std::span<const GatherBatch> batches, Func& func) {
+					if (execType == QueryExecType::Serial || batches.size() < 2) {
+						for (const auto& batch: batches)
+							func(batch);
+						return;
+					}
+
+					struct GatherCtx {
+						const GatherBatch* pBatches;
+						Func* pFunc;
+					};
+					GatherCtx ctx{batches.data(), &func};
+					SchedParDesc desc{};
+					desc.pCtx = &ctx;
+					desc.itemCount = (uint32_t)batches.size();
+					desc.groupSize = 0;
+					desc.execType = execType;
+					desc.invoke = [](void* pCtx, uint32_t idxStart, uint32_t idxEnd) {
+						auto& ctx = *reinterpret_cast<GatherCtx*>(pCtx);
+						for (uint32_t i = idxStart; i < idxEnd; ++i)
+							(*ctx.pFunc)(ctx.pBatches[i]);
+					};
+
+					const auto& sched = world_sched(*m_storage.world());
+					const auto token = sched_par(sched, desc);
+					sched_wait(sched, token);
+					sched_del(sched, token);
+				}
+
+				//! Returns the id of the column gathered for \a T. Entity columns come from the chunk entity array.
+				template <typename T>
+				GAIA_NODISCARD Entity gather_column_id() {
+					if constexpr (std::is_same_v<T, Entity>)
+						return EntityBad;
+					else
+						return access_entity_inter<T>();
+				}
+
+				//! Collects the rows gather() copies and consumes the changed() state of the query.
+				//! \param[out] batches Collected row runs
+				//! \return Number of rows to gather
+				uint32_t gather_prepare(cnt::darray<GatherBatch>& batches) {
+					auto& queryInfo = fetch();
+					match_all(queryInfo);
+					::gaia::ecs::update_version(*m_worldVersion);
+
+					// Remember the filter version so scatter() visits the same rows
+					m_gatherChangedWorldVersion = m_changedWorldVersion;
+					const auto rowCnt = gather_batches(queryInfo, m_changedWorldVersion, batches);
+					m_changedWorldVersion = *m_worldVersion;
+					return rowCnt;
+				}
+
+				template <typename... T>
+				void gather_copy(QueryExecType execType, std::span<const GatherBatch> batches, T*... pOut) {
+					(gather_verify_column<T>(), ...);
+					if (batches.empty())
+						return;
+
+					const Entity ids[] = {gather_column_id<T>()...};
+					auto copy = [&](const GatherBatch& batch) {
+						uint32_t i = 0;
+						(gather_column<T>(*batch.pChunk, ids[i++], batch.from, batch.to, pOut + batch.dstOffset), ...);
+					};
+
+					auto& world = *m_storage.world();
+					lock(world);
+					gather_run(execType, batches, copy);
+					unlock(world);
+				}
+
+				template <typename... T>
+				uint32_t scatter_inter(QueryExecType execType, uint32_t cnt, const T*... pIn) {
+					(gather_verify_column<T>(), ...);
+					ProfileRun profileRun(*this);
+
+					auto& queryInfo = fetch();
+					match_all(queryInfo);
+					::gaia::ecs::update_version(*m_worldVersion);
+
+					cnt::darray<GatherBatch> batches;
+					const auto rowCnt = gather_batches(queryInfo, m_gatherChangedWorldVersion, batches);
+					GAIA_ASSERT(rowCnt == cnt && "scatter input does not match the rows of the last gather");
+					if (rowCnt != cnt || rowCnt == 0)
+						return 0;
+
+					const Entity ids[] = {gather_column_id<T>()...};
+					auto copy = [&](const GatherBatch& batch) {
+						uint32_t i = 0;
+						(scatter_column<T>(*batch.pChunk, ids[i++], batch.from, batch.to, pIn + batch.dstOffset), ...);
+					};
+
+					auto& world = *m_storage.world();
+					lock(world);
+					gather_run(execType, batches, copy);
+					// Versions, set hooks and OnSet observers are handled on the calling thread once all data is written
+					for (const auto& batch: batches) {
+						const auto finish = [&](Entity id, bool isEntity) {
+							if (!isEntity)
+								batch.pChunk->finish_write(gather_comp_idx(*batch.pChunk, id), batch.from, batch.to);
+						};
+						uint32_t i = 0;
+						(finish(ids[i++], std::is_same_v<T, Entity>), ...);
+					}
+					unlock(world);
+					commit_cmd_buffer_st(world);
+					commit_cmd_buffer_mt(world);
+					return rowCnt;
+				}
+
+				template <typename TItem, size_t... Ids>
+				uint32_t gather_soa(QueryExecType execType, cnt::darr_soa<TItem>& out, std::index_sequence<Ids...>) {
+					using Policy = typename cnt::darr_soa<TItem>::view_policy;
+					ProfileRun profileRun(*this);
+
+					cnt::darray<GatherBatch> batches;
+					const auto rowCnt = gather_prepare(batches);
+					out.resize(rowCnt);
+					gather_copy<typename Policy::template value_type<Ids>...>(
+							execType, batches, out.template view_mut<Ids>().data()...);
+					return rowCnt;
+				}
+
+				template <typename TItem, size_t... Ids>
+				uint32_t
+				scatter_soa(QueryExecType execType, const cnt::darr_soa<TItem>& in, std::index_sequence<Ids...>) {
+					using Policy = typename cnt::darr_soa<TItem>::view_policy;
+					return scatter_inter<typename Policy::template value_type<Ids>...>(
+							execType, (uint32_t)in.size(), in.template view<Ids>().data()...);
+				}
+
+			public:
+				//! Copies the columns of all matched entities into one contiguous structure-of-arrays buffer.
+				//! Every member of \a TItem selects a column. Entity members receive the entity ids, members of any
+				//! other type receive the component of that type. Rows come in the order each() visits them and
+				//! whole chunk runs are copied at once. Parallel execution types split the copy over the scheduler.
+				//! \tparam TItem Item type with the SoA data layout
+				//! \param[out] out Output buffer. Resized to the number of gathered rows.
+				//! \param execType Execution type
+				//! \return Number of gathered rows.
+				//! \warning Components must be stored in the matched chunks: no pairs, tags, sparse or inherited data.
+				template <typename TItem>
+				uint32_t gather(cnt::darr_soa<TItem>& out, QueryExecType execType = QueryExecType::Default) {
+					using Policy = typename cnt::darr_soa<TItem>::view_policy;
+					return gather_soa(execType, out, std::make_index_sequence<Policy::TTupleItems>());
+				}
+
+				//! Copies the columns of all matched entities into caller-provided buffers, one per column.
+				//! Works like gather(cnt::darr_soa&) with the columns selected by the span types.
+				//! \param execType Execution type
+				//! \param[out] out Output buffers. Each must hold at least count() items.
+				//! \return Number of gathered rows. Zero if the buffers were too small.
+				template <typename... T>
+				uint32_t gather(QueryExecType execType, std::span<T>... out) {
+					static_assert(sizeof...(T) > 0);
+					ProfileRun profileRun(*this);
+
+					cnt::darray<GatherBatch> batches;
+					const auto rowCnt = gather_prepare(batches);
+					const bool fits = ((out.size() >= rowCnt) && ...);
+					GAIA_ASSERT(fits && "gather output buffers are too small");
+					if (!fits)
+						return 0;
+
+					gather_copy<T...>(execType, batches, out.data()...);
+					return rowCnt;
+				}
+
+				//! Copies the columns of all matched entities into caller-provided buffers, one per column.
+				//! \param[out] out Output buffers. Each must hold at least count() items.
+				//! \return Number of gathered rows. Zero if the buffers were too small.
+				template <typename... T>
+				uint32_t gather(std::span<T>... out) {
+					return gather(QueryExecType::Default, out...);
+				}
+
+				//! Writes buffers filled by gather() back to the matched entities. Entity columns are not written.
+				//! Rows go back to the same entities they were gathered from, so nothing may add, remove or move
+				//! the matched entities in between. Written columns get their change versions bumped and run their
+				//! set hooks and OnSet observers once per chunk run, just like a mutable each() would.
+				//! \tparam TItem Item type with the SoA data layout
+				//! \param in Buffer previously filled by gather()
+				//! \param execType Execution type
+				//! \return Number of written rows. Zero if \a in does not match the gathered rows.
+				template <typename TItem>
+				uint32_t scatter(const cnt::darr_soa<TItem>& in, QueryExecType execType = QueryExecType::Default) {
+					using Policy = typename cnt::darr_soa<TItem>::view_policy;
+					return scatter_soa(execType, in, std::make_index_sequence<Policy::TTupleItems>());
+				}
+
+				//! Writes per-column buffers filled by gather() back to the matched entities.
+				//! \param execType Execution type
+				//! \param in Buffers previously filled by gather()
+				//! \return Number of written rows. Zero if the buffers do not match the gathered rows.
+				template <typename... T>
+				uint32_t scatter(QueryExecType execType, std::span<T>... in) {
+					static_assert(sizeof...(T) > 0);
+					const auto cnt = (uint32_t)std::get<0>(std::make_tuple(in.size()...));
+					GAIA_ASSERT(((in.size() == cnt) && ...) && "scatter buffers must have the same size");
+					return scatter_inter<std::remove_const_t<T>...>(execType, cnt, in.data()...);
+				}
+
+				//! Writes per-column buffers filled by gather() back to the matched entities.
+				//! \param in Buffers previously filled by gather()
+				//! \return Number of written rows. Zero if the buffers do not match the gathered rows.
+				template <typename... T>
+				uint32_t scatter(std::span<T>... in) {
+					return scatter(QueryExecType::Default, in...);
+				}
+
 				//! Builds and caches relation traversal order for the current query result.
 				//! \param queryInfo Query info
 				//! \param relation Dependency relation used for traversal.
@@ -6710,15 +7766,15 @@ namespace gaia {
 							for (uint32_t i = 0; i < orderedCnt; ++i) {
 								const auto& ec = ::gaia::ecs::fetch(world, ordered[i]);
 								if (walkData.cachedRuns.empty()) {
-									walkData.cachedRuns.push_back({ec.pArchetype, ec.pChunk, ec.row, (uint16_t)(ec.row + 1), i});
+									walkData.cachedRuns.push_back({ec.pArchetype, ec.pChunk, ec.row, (ChunkRow)(ec.row + 1), i});
 									continue;
 								}
 
 								auto& run = walkData.cachedRuns.back();
 								if (ec.pChunk == run.pChunk && ec.row == run.to) {
-									run.to = (uint16_t)(run.to + 1);
+									run.to = (ChunkRow)(run.to + 1);
 								} else {
-									walkData.cachedRuns.push_back({ec.pArchetype, ec.pChunk, ec.row, (uint16_t)(ec.row + 1), i});
+									walkData.cachedRuns.push_back({ec.pArchetype, ec.pChunk, ec.row, (ChunkRow)(ec.row + 1), i});
 								}
 							}
 						}
@@ -6818,6 +7874,125 @@ namespace gaia {
 					GAIA_LOG_N("%.*s", (int)dump.size(), dump.data());
 					GAIA_LOG_N("END DIAG Query");
 				}
+
+				//! Enables or disables collecting runtime statistics for this query instance.
+				//! While enabled, iteration calls record the time spent in matching, planning and iteration,
+				//! the selected plan and the number of chunks skipped by changed() filters.
+				//! Disabling discards the statistics collected so far.
+				//! \param enable True to collect statistics.
+				//! \return Self reference.
+				QueryImpl& profile(bool enable = true) {
+					if (enable)
+						(void)m_profile.ensure();
+					else
+						m_profile.reset();
+					return *this;
+				}
+
+				//! Returns whether runtime statistics are collected. See profile().
+				GAIA_NODISCARD bool profiling() const {
+					return m_profile.get() != nullptr;
+				}
+
+				//! Returns the runtime statistics collected since profiling was enabled or last reset.
+				//! \return Statistics, or zeroed statistics when profiling is disabled.
+				GAIA_NODISCARD QueryProfile profile_stats() const {
+					const auto* pProfile = m_profile.get();
+					return pProfile != nullptr ? *pProfile : QueryProfile{};
+				}
+
+				//! Zeroes the collected runtime statistics. Profiling stays enabled.
+				void reset_profile() {
+					if (auto* pProfile = m_profile.get())
+						*pProfile = {};
+				}
+
+				//! Describes how the query executes right now. Matches the query if needed.
+				//! The plan reported is the one used by Iter callbacks over enabled entities. Typed callbacks may pick
+				//! a specialized variant of it, see QueryProfile::lastPlanMode.
+				//! \return Plan, match statistics and the runtime profile.
+				GAIA_NODISCARD QueryExplain explain() {
+					// Snapshot the profile first so matching done on behalf of explain() is not reported
+					QueryExplain ex{};
+					ex.profiling = profiling();
+					ex.profile = profile_stats();
+
+					auto& queryInfo = fetch();
+					match_all(queryInfo);
+
+					const auto plan = prepare_query_plan(queryInfo, Constraints::EnabledOnly);
+					ex.planMode = plan.mode;
+					ex.planFlags = plan.flags;
+					ex.directIterable = can_use_direct_chunk_iteration_fastpath(queryInfo);
+
+					const auto cacheView = queryInfo.cache_archetype_view();
+					const auto cacheRange = selected_query_cache_range(queryInfo);
+					for (uint32_t i = cacheRange.idxFrom; cacheRange.valid && i < cacheRange.idxTo; ++i) {
+						const auto* pArchetype = cacheView[i];
+						if (!can_process_archetype(queryInfo, *pArchetype))
+							continue;
+
+						++ex.archetypeCnt;
+						for (const auto* pChunk: pArchetype->chunks()) {
+							if (pChunk->empty())
+								continue;
+							++ex.chunkCnt;
+							ex.entityCnt += pChunk->size();
+						}
+					}
+
+					return ex;
+				}
+
+				//! Returns a human-readable name of a plan mode.
+				//! \param mode Plan mode.
+				//! \return Plan mode name.
+				GAIA_NODISCARD static const char* plan_mode_str(QueryPlanMode mode) {
+					switch (mode) {
+						case QueryPlanMode::Empty:
+							return "Empty";
+						case QueryPlanMode::General:
+							return "General";
+						case QueryPlanMode::EntitySeed:
+							return "EntitySeed";
+						case QueryPlanMode::DirectDense:
+							return "DirectDense";
+						case QueryPlanMode::MappedDense:
+							return "MappedDense";
+						case QueryPlanMode::SparseDense:
+							return "SparseDense";
+						case QueryPlanMode::Sorted:
+							return "Sorted";
+						case QueryPlanMode::Traversal:
+							return "Traversal";
+					}
+					return "?";
+				}
+
+				//! Prints the result of explain().
+				void diag_explain() {
+					const auto ex = explain();
+					if (uses_shared_cache_layer())
+						GAIA_LOG_N("BEG DIAG Query Explain %u.%u [S]", id(), gen());
+					else if (uses_query_cache_storage())
+						GAIA_LOG_N("BEG DIAG Query Explain %u.%u [L]", id(), gen());
+					else
+						GAIA_LOG_N("BEG DIAG Query Explain [U]");
+					GAIA_LOG_N(
+							"  plan: %s, flags: 0x%02x, direct iterable: %d", plan_mode_str(ex.planMode), (uint32_t)ex.planFlags,
+							(int)ex.directIterable);
+					GAIA_LOG_N("  archetypes: %u, chunks: %u, entities: %u", ex.archetypeCnt, ex.chunkCnt, ex.entityCnt);
+					if (ex.profiling) {
+						const auto& p = ex.profile;
+						GAIA_LOG_N(
+								"  runs: %u, matches: %u, filtered chunks: %u, last plan: %s", p.runCnt, p.matchCnt, p.filteredChunkCnt,
+								plan_mode_str(p.lastPlanMode));
+						GAIA_LOG_N(
+								"  match: %.3f ms, plan: %.3f ms, iter: %.3f ms", (double)p.matchNs * 1e-6, (double)p.planNs * 1e-6,
+								(double)p.iterNs * 1e-6);
+					}
+					GAIA_LOG_N("END DIAG Query");
+				}
 			};
 		} // namespace detail
 
@@ -106,6 +106,36 @@ namespace gaia {
 				return sort_by(typed_query_pair_entity<Rel, Tgt>(*m_storage.world()), func);
 			}
 
+			template <typename... Keys, typename Projection, typename>
+			inline QueryImpl& QueryImpl::sort_by(Projection projection) {
+				static_assert(sizeof...(Keys) <= MAX_SORT_KEYS_IN_QUERY, "Too many sort keys");
+				static_assert((core::is_raw_v<Keys> && ...), "Use raw types only");
+				static_assert((!mem::is_soa_layout_v<Keys> && ...), "SoA components can't be sorted by a projection");
+
+				using TRet = std::decay_t<std::invoke_result_t<Projection, const Keys&...>>;
+				using TProj = TRet (*)(const Keys&...);
+				static_assert(
+						std::is_convertible_v<Projection, TProj>,
+						"The projection needs to be a captureless lambda or a function taking const Keys&...");
+				const TProj pProj = projection;
+
+				QueryCmd_SortByKey cmd{};
+				uint32_t keyIdx = 0;
+				(
+						[&]() {
+							if constexpr (std::is_same_v<Keys, Entity>)
+								cmd.keys[keyIdx++] = EntityBad;
+							else
+								cmd.keys[keyIdx++] = typed_query_raw_entity<Keys>(*m_storage.world());
+						}(),
+						...);
+				cmd.keyCnt = (uint8_t)sizeof...(Keys);
+				cmd.func = &sort_by_key_extract<TRet, Keys...>;
+				cmd.proj = reinterpret_cast<TSortByKeyProj>(pProj);
+				add_cmd(cmd);
+				return *this;
+			}
+
 			template <typename Rel>
 			inline QueryImpl& QueryImpl::depth_order() {
 				return depth_order(typed_query_raw_entity<Rel>(*m_storage.world()));
@@ -9,6 +9,7 @@
 #include "gaia/ecs/id.h"
 #include "gaia/ecs/query_common.h"
 #include "gaia/ecs/query_info.h"
+#include "gaia/ecs/query_plan_store.h"
 
 //! \cond INTERNAL
 namespace gaia {
@@ -78,6 +79,7 @@ namespace gaia {
 				add_sort_to_query_pairs(info.ctx(), handle);
 				add_sorted_query(info.ctx(), handle);
 				add_create_to_query_pairs(info.ctx(), handle);
+				add_create_all_row(info.ctx(), handle);
 
 				return info;
 			}
@@ -130,6 +132,23 @@ namespace gaia {
 			uint32_t m_createQueryHandleStamp = 1;
 			//! Counts of cached create selectors by pair shape so archetype registration can skip miss-only buckets.
 			uint32_t m_createQuerySelectorCnt[(size_t)CreateSelectorKind::Count] = {};
+			//! Dense bit index of ids used by ALL terms of immediate plain-id queries.
+			cnt::map<EntityLookupKey, uint32_t> m_createAllBitIdx;
+			//! Number of queries referencing each dense bit. Unreferenced bits are recycled.
+			cnt::darray<uint32_t> m_createAllBitRefs;
+			//! Dense bits free for reuse.
+			cnt::darray<uint32_t> m_createAllBitsFree;
+			//! ALL term bitsets indexed by query handle id, m_createAllWords words per query.
+			//! Candidates of a new archetype are rejected in one pass over these rows before any query is evaluated.
+			cnt::darray<uint64_t> m_createAllRows;
+			//! Number of 64-bit words per row of m_createAllRows.
+			uint32_t m_createAllWords = 0;
+			//! Scratch bitset of the archetype being registered.
+			cnt::darray<uint64_t> m_createArchetypeBitsScratch;
+			//! Scratch ALL prefilter results for create candidates. Non-zero when a candidate may match.
+			cnt::darray<uint8_t> m_createAllPassScratch;
+			//! Precompiled plans consulted before a newly registered query is compiled.
+			QueryPlanStore m_planStore;
 
 		public:
 			QueryCache() {
@@ -169,6 +188,13 @@ namespace gaia {
 				m_createQueryHandleStamp = 1;
 				for (auto& cnt: m_createQuerySelectorCnt)
 					cnt = 0;
+				m_createAllBitIdx.clear();
+				m_createAllBitRefs.clear();
+				m_createAllBitsFree.clear();
+				m_createAllRows.clear();
+				m_createAllWords = 0;
+				m_createArchetypeBitsScratch.clear();
+				m_createAllPassScratch.clear();
 			}
 
 			//! Clears only the reverse indices that keep raw archetype pointers alive.
@@ -303,6 +329,7 @@ namespace gaia {
 				creationCtx.pQueryCtx = &ctx;
 				creationCtx.pEntityToArchetypeMap = &entityToArchetypeMap;
 				creationCtx.allArchetypes = allArchetypes;
+				creationCtx.pPlanStore = &m_planStore;
 				auto handle = m_queryArr.alloc(&creationCtx);
 
 				// We are moving the rvalue to "ctx". As a result, the pointer stored in m_pCache.emplace above is no longer
@@ -325,6 +352,7 @@ namespace gaia {
 				creationCtx.pQueryCtx = &ctx;
 				creationCtx.pEntityToArchetypeMap = &entityToArchetypeMap;
 				creationCtx.allArchetypes = allArchetypes;
+				creationCtx.pPlanStore = &m_planStore;
 				auto handle = m_queryArr.alloc(&creationCtx);
 
 				auto& info = get(handle);
@@ -357,11 +385,32 @@ namespace gaia {
 				del_sort_to_query_pairs(pInfo->ctx(), handle);
 				del_sorted_query(pInfo->ctx(), handle);
 				del_create_to_query_pairs(pInfo->ctx(), handle);
+				del_create_all_row(pInfo->ctx(), handle);
 				m_queryArr.free(handle);
 
 				return true;
 			}
 
+			//! Returns the store of precompiled plans consulted when queries are registered.
+			//! \return Plan store.
+			QueryPlanStore& plan_store() {
+				return m_planStore;
+			}
+
+			//! Returns the store of precompiled plans consulted when queries are registered.
+			//! \return Plan store.
+			const QueryPlanStore& plan_store() const {
+				return m_planStore;
+			}
+
+			//! Copies the compiled plans of all live queries into the plan store.
+			void store_plans() {
+				for (const auto& info: m_queryArr) {
+					if (info.refs() != 0)
+						info.save_plan(m_planStore);
+				}
+			}
+
 			auto begin() {
 				return m_queryArr.begin();
 			}
@@ -527,11 +576,18 @@ namespace gaia {
 				if (hasAnyPair && needsAnyPairWildcardSelectors)
 					add_create_query_handles(Pair(All, All), handles);
 
-				for (const auto& candidate: handles) {
+				filter_create_query_handles(*pArchetype, handles);
+
+				GAIA_EACH(handles) {
+					const auto& candidate = handles[i];
 					auto* pInfo = try_get(candidate.handle);
 					if (pInfo == nullptr || pInfo->refs() == 0)
 						continue;
 
+					// Rows are built from exact ids. They can only reject queries whose plan still matches exact ids.
+					if (m_createAllPassScratch[i] == 0 && pInfo->can_prefilter_create_archetype_by_all_ids())
+						continue;
+
 					if (!pInfo->register_archetype(*pArchetype, candidate.matchedSelector, true))
 						continue;
 
@@ -701,34 +757,47 @@ namespace gaia {
 					return;
 
 				auto& handles = it->second;
-				core::swap_erase(handles, core::get_index(handles, handle));
+				// The same entity can be listed by several sort keys
+				const auto idx = core::get_index(handles, handle);
+				if (idx == BadIndex)
+					return;
+
+				core::swap_erase(handles, idx);
 				if (handles.empty())
 					m_sortEntityToQuery.erase(it);
 			}
 
 			void add_sort_to_query_pairs(const QueryCtx& ctx, QueryHandle handle) {
-				if (ctx.data.sortByFunc == nullptr || ctx.data.sortBy == EntityBad)
-					return;
+				if (ctx.data.sortByFunc != nullptr && ctx.data.sortBy != EntityBad)
+					add_sort_to_query_pair(ctx.data.sortBy, handle);
 
-				add_sort_to_query_pair(ctx.data.sortBy, handle);
+				GAIA_FOR(ctx.data.sortByKeyCnt) {
+					const auto key = ctx.data.sortByKeys[i];
+					if (key != EntityBad)
+						add_sort_to_query_pair(key, handle);
+				}
 			}
 
 			void del_sort_to_query_pairs(const QueryCtx& ctx, QueryHandle handle) {
-				if (ctx.data.sortByFunc == nullptr || ctx.data.sortBy == EntityBad)
-					return;
+				if (ctx.data.sortByFunc != nullptr && ctx.data.sortBy != EntityBad)
+					del_sort_to_query_pair(ctx.data.sortBy, handle);
 
-				del_sort_to_query_pair(ctx.data.sortBy, handle);
+				GAIA_FOR(ctx.data.sortByKeyCnt) {
+					const auto key = ctx.data.sortByKeys[i];
+					if (key != EntityBad)
+						del_sort_to_query_pair(key, handle);
+				}
 			}
 
 			void add_sorted_query(const QueryCtx& ctx, QueryHandle handle) {
-				if (ctx.data.sortByFunc == nullptr)
+				if (!ctx.data.has_sort())
 					return;
 
 				m_sortedQueries.push_back(handle);
 			}
 
 			void del_sorted_query(const QueryCtx& ctx, QueryHandle handle) {
-				if (ctx.data.sortByFunc == nullptr)
+				if (!ctx.data.has_sort())
 					return;
 
 				const auto idx = core::get_index(m_sortedQueries, handle);
@@ -768,6 +837,142 @@ namespace gaia {
 					del_create_to_query_pair(entity, handle);
 			}
 
+			GAIA_NODISCARD static bool uses_create_all_row(const QueryCtx& ctx) {
+				return ctx.data.cachePolicy == QueryCtx::CachePolicy::Immediate &&
+							 ctx.data.createArchetypeMatchKind == QueryCtx::CreateArchetypeMatchKind::SortedIds;
+			}
+
+			GAIA_NODISCARD static EntitySpan create_all_ids(const QueryCtx& ctx) {
+				return ctx.data.ids_view().subspan(0, ctx.data.firstOr);
+			}
+
+			//! Widens all rows by one word so another 64 dense bits fit.
+			void grow_create_all_words() {
+				const uint32_t wordsOld = m_createAllWords;
+				const uint32_t wordsNew = wordsOld + 1;
+				const uint32_t rowCnt = wordsOld == 0 ? 0 : (uint32_t)m_createAllRows.size() / wordsOld;
+
+				cnt::darray<uint64_t> rows;
+				rows.resize(rowCnt * wordsNew, 0);
+				GAIA_FOR(rowCnt) {
+					GAIA_FOR_(wordsOld, j) rows[i * wordsNew + j] = m_createAllRows[i * wordsOld + j];
+				}
+				m_createAllRows = GAIA_MOV(rows);
+				m_createAllWords = wordsNew;
+			}
+
+			//! Returns the dense bit assigned to \a entity. A new bit is assigned if there is none yet.
+			GAIA_NODISCARD uint32_t create_all_bit(Entity entity) {
+				const auto key = EntityLookupKey(entity);
+				const auto it = m_createAllBitIdx.find(key);
+				if (it != m_createAllBitIdx.end())
+					return it->second;
+
+				uint32_t bit = 0;
+				if (!m_createAllBitsFree.empty()) {
+					bit = m_createAllBitsFree.back();
+					m_createAllBitsFree.pop_back();
+				} else {
+					bit = (uint32_t)m_createAllBitRefs.size();
+					m_createAllBitRefs.push_back(0);
+					if (bit >= m_createAllWords * 64)
+						grow_create_all_words();
+				}
+
+				m_createAllBitIdx.try_emplace(key, bit);
+				return bit;
+			}
+
+			//! Encodes the ALL terms of an immediate plain-id query as a bitset over dense bits.
+			void add_create_all_row(const QueryCtx& ctx, QueryHandle handle) {
+				if (!uses_create_all_row(ctx))
+					return;
+
+				for (const auto entity: create_all_ids(ctx)) {
+					const auto bit = create_all_bit(entity);
+					const auto rowCnt = (uint32_t)handle.id() + 1;
+					if (m_createAllRows.size() < rowCnt * m_createAllWords)
+						m_createAllRows.resize(rowCnt * m_createAllWords, 0);
+
+					auto& word = m_createAllRows[handle.id() * m_createAllWords + bit / 64];
+					const auto mask = (uint64_t)1 << (bit % 64);
+					if ((word & mask) != 0)
+						continue;
+
+					word |= mask;
+					++m_createAllBitRefs[bit];
+				}
+			}
+
+			//! Clears the ALL row of a query and releases the dense bits nobody else references.
+			//! Runs regardless of the current query shape so a recycled handle id always starts with an empty row.
+			void del_create_all_row(const QueryCtx& ctx, QueryHandle handle) {
+				if (m_createAllWords == 0 || (handle.id() + 1) * m_createAllWords > m_createAllRows.size())
+					return;
+
+				for (const auto entity: create_all_ids(ctx)) {
+					const auto it = m_createAllBitIdx.find(EntityLookupKey(entity));
+					if (it == m_createAllBitIdx.end())
+						continue;
+
+					const auto bit = it->second;
+					auto& word = m_createAllRows[handle.id() * m_createAllWords + bit / 64];
+					const auto mask = (uint64_t)1 << (bit % 64);
+					if ((word & mask) == 0)
+						continue;
+
+					word &= ~mask;
+					GAIA_ASSERT(m_createAllBitRefs[bit] != 0);
+					if (--m_createAllBitRefs[bit] == 0) {
+						m_createAllBitIdx.erase(it);
+						m_createAllBitsFree.push_back(bit);
+					}
+				}
+			}
+
+			//! Evaluates the ALL rows of all create candidates against \a archetype in one pass.
+			//! Results are written to m_createAllPassScratch, one entry per candidate.
+			//! \param archetype Newly created archetype
+			//! \param handles Create candidates
+			void filter_create_query_handles(const Archetype& archetype, const cnt::darray<CreateQueryCandidate>& handles) {
+				auto& pass = m_createAllPassScratch;
+				pass.resize((uint32_t)handles.size());
+
+				const uint32_t words = m_createAllWords;
+				if (words == 0) {
+					GAIA_EACH(handles) pass[i] = 1;
+					return;
+				}
+
+				auto& bits = m_createArchetypeBitsScratch;
+				bits.resize(words);
+				GAIA_FOR(words) bits[i] = 0;
+				for (const auto entity: archetype.ids_view()) {
+					const auto it = m_createAllBitIdx.find(EntityLookupKey(entity));
+					if (it == m_createAllBitIdx.end())
+						continue;
+
+					const auto bit = it->second;
+					bits[bit / 64] |= (uint64_t)1 << (bit % 64);
+				}
+
+				const auto rowCnt = (uint32_t)m_createAllRows.size() / words;
+				const uint64_t* pBits = bits.data();
+				GAIA_EACH(handles) {
+					const auto rowIdx = (uint32_t)handles[i].handle.id();
+					if (rowIdx >= rowCnt) {
+						pass[i] = 1;
+						continue;
+					}
+
+					// A query can match only if none of its ALL bits is missing in the archetype
+					const uint64_t* pRow = &m_createAllRows[rowIdx * words];
+					uint64_t missing = 0;
+					GAIA_FOR_(words, j) missing |= pRow[j] & ~pBits[j];
+					pass[i] = missing == 0 ? 1 : 0;
+				}
+			}
+
 			void add_create_query_handles(Entity selector, cnt::darray<CreateQueryCandidate>& handles) {
 				const auto it = m_entityToCreateQuery.find(EntityLookupKey(selector));
 				if (it == m_entityToCreateQuery.end())
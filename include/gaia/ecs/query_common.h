@@ -69,9 +69,13 @@ namespace gaia {
 		GAIA_NODISCARD decltype(auto) world_query_entity_arg_by_id_raw(World& world, Entity entity, Entity id);
 		//! Returns the per-entity archetype version used for targeted source-query freshness checks.
 		GAIA_NODISCARD uint32_t world_entity_archetype_version(const World& world, Entity entity);
+		//! Returns a version bumped whenever any tracked per-entity archetype version changes.
+		GAIA_NODISCARD uint32_t world_src_entity_change_version(const World& world);
 
 		//! Number of items that can be a part of Query
 		static constexpr uint32_t MAX_ITEMS_IN_QUERY = 12U;
+		//! Maximum number of components a key-based sort can project its key from.
+		static constexpr uint32_t MAX_SORT_KEYS_IN_QUERY = 4U;
 		//! Maximum traversal depth.
 		static constexpr uint32_t MAX_TRAV_DEPTH = 128U;
 
@@ -152,6 +156,7 @@ namespace gaia {
 		using QueryLookupHash = core::direct_hash_key<uint64_t>;
 		//! Fixed-capacity entity storage used by compiled query metadata.
 		using QueryEntityArray = cnt::sarray<Entity, MAX_ITEMS_IN_QUERY>;
+		using QuerySortKeyArray = cnt::sarray<Entity, MAX_SORT_KEYS_IN_QUERY>;
 		//! Per-query serialization buffers indexed by query identifier.
 		using QuerySerMap = cnt::map<QueryId, QuerySerBuffer>;
 
@@ -932,6 +937,9 @@ namespace gaia {
 				Vm,
 				//! Evaluates a small immediate ALL, OR, and NOT query directly on the archetype.
 				DirectStructuralTerms,
+				//! Like DirectStructuralTerms, but the query has plain ids only (no wildcards, no Is).
+				//! Terms are matched by merging the sorted query ids with the sorted archetype ids.
+				SortedIds,
 			};
 
 			//! Dynamic-cache dependency shape derived from compiled query metadata.
@@ -947,7 +955,10 @@ namespace gaia {
 				//! Dynamic cache tracks runtime variable bindings only.
 				Variable,
 				//! Dynamic cache tracks more than one dependency family.
-				Mixed
+				Mixed,
+				//! Dynamic cache tracks the targets of one fragmenting relation that bind variable sources.
+				//! Only archetypes below a target that changed are matched again.
+				VariableSource
 			};
 
 			//! Specialized evaluation shape for concrete target entities.
@@ -1127,6 +1138,14 @@ namespace gaia {
 				Entity sortBy;
 				//! Function to use to perform sorting
 				TSortByFunc sortByFunc;
+				//! Components the sort key is projected from. EntityBad stands for the entity itself.
+				QuerySortKeyArray sortByKeys;
+				//! Number of valid entries in sortByKeys.
+				uint8_t sortByKeyCnt = 0;
+				//! Function extracting packed sort keys. nullptr unless sorting by projected keys.
+				TSortByKeyFunc sortByKeyFunc;
+				//! Projection called by sortByKeyFunc
+				TSortByKeyProj sortByKeyProj;
 				//! Entity to group the archetypes by. EntityBad for no grouping.
 				Entity groupBy;
 				//! Function to use to perform the grouping
@@ -1296,6 +1315,52 @@ namespace gaia {
 					return DynamicCacheKind::None;
 				}
 
+				//! Returns whether variable sources are bound only through targets of a single fragmenting relation.
+				//! Each archetype then depends just on its own ids and the archetypes of its relation targets and their
+				//! ancestors, so the dynamic cache can be maintained per subtree.
+				//! \param world World used to resolve relation storage.
+				//! \return True when the query can use DynamicCacheKind::VariableSource.
+				GAIA_NODISCARD bool calc_can_track_var_src(const World& world) const {
+					constexpr uint16_t Required = DependencyHasSourceTerms | DependencyHasVariableTerms;
+					constexpr uint16_t Unsupported = DependencyHasWildcardTerms | DependencyHasEntityFilterTerms;
+					if ((deps.flags & Required) != Required || (deps.flags & Unsupported) != 0)
+						return false;
+					if (deps.relationCnt != 1 || deps.sourceEntityCnt != 0 || as_mask_0 != 0 || as_mask_1 != 0)
+						return false;
+
+					const auto relation = deps.relations[0];
+					if (relation.id() == Is.id() || world_relation_uses_non_fragmenting_storage(world, relation))
+						return false;
+
+					uint32_t boundVars = 0;
+					uint32_t srcVars = 0;
+					for (const auto& term: terms_view()) {
+						const auto id = term.id;
+						if (term.src == EntityBad) {
+							if (!term_has_variables(term))
+								continue;
+
+							// Variables may only be bound by required (relation, VarN) pairs of the archetype itself.
+							if (term.op != QueryOpKind::All || term.entTrav != EntityBad || !id.pair() ||
+									id.id() != relation.id() || !is_variable((EntityId)id.gen()))
+								return false;
+							boundVars |= 1U << (id.gen() - Var0.id());
+							continue;
+						}
+
+						// Sources are variables that walk up the same relation at most.
+						if (!is_variable(term.src) || is_wildcard(id) || is_variable((EntityId)id.id()) ||
+								(id.pair() && is_variable((EntityId)id.gen())))
+							return false;
+						if (term.entTrav != EntityBad &&
+								(term.entTrav.id() != relation.id() || query_trav_has(term.travKind, QueryTravKind::Down)))
+							return false;
+						srcVars |= 1U << (term.src.id() - Var0.id());
+					}
+
+					return srcVars != 0 && (srcVars & ~boundVars) == 0;
+				}
+
 				//! Returns whether reusable dynamic-cache checks use direct source entity archetype versions.
 				//! \return True when direct source entity archetype versions validate this dynamic cache.
 				GAIA_NODISCARD bool uses_direct_src_version_tracking() const {
@@ -1308,6 +1373,12 @@ namespace gaia {
 					return canReuseDynamicCache && dynamicCacheKind == DynamicCacheKind::TraversedSource;
 				}
 
+				//! Returns whether reusable dynamic-cache checks maintain variable-source subtrees.
+				//! \return True when relation-target archetype versions validate this dynamic cache.
+				GAIA_NODISCARD bool uses_var_src_tracking() const {
+					return canReuseDynamicCache && dynamicCacheKind == DynamicCacheKind::VariableSource;
+				}
+
 				//! Returns whether the current query shape can reuse dynamic-cache results.
 				//! \return True when tracked runtime inputs are sufficient to validate the dynamic cache.
 				GAIA_NODISCARD bool calc_can_reuse_dynamic_cache() const {
@@ -1319,6 +1390,7 @@ namespace gaia {
 							return false;
 						case DynamicCacheKind::RelationOnly:
 						case DynamicCacheKind::Variable:
+						case DynamicCacheKind::VariableSource:
 							return true;
 						case DynamicCacheKind::DirectSource:
 							return deps.can_reuse_src_cache();
@@ -1448,21 +1520,41 @@ namespace gaia {
 				//! \param other Compiled payload to compare.
 				//! \return True when sorting entity and callback match.
 				GAIA_NODISCARD bool sort_payload_equal(const Data& other) const {
-					return sortBy == other.sortBy && sortByFunc == other.sortByFunc;
+					if (sortBy != other.sortBy || sortByFunc != other.sortByFunc)
+						return false;
+					if (sortByKeyFunc != other.sortByKeyFunc || sortByKeyProj != other.sortByKeyProj ||
+							sortByKeyCnt != other.sortByKeyCnt)
+						return false;
+					GAIA_FOR(sortByKeyCnt) {
+						if (sortByKeys[i] != other.sortByKeys[i])
+							return false;
+					}
+					return true;
 				}
 
 				//! Returns true when sort identity payload is active.
 				//! \return True when either a sort entity or callback is configured.
 				GAIA_NODISCARD bool has_sort_payload() const {
-					return sortBy != EntityBad || sortByFunc != nullptr;
+					return sortBy != EntityBad || sortByFunc != nullptr || sortByKeyFunc != nullptr;
+				}
+
+				//! Returns true when matched entities are sorted, either by a comparator or by projected keys.
+				//! \return True when a sorting callback or a key projection is configured.
+				GAIA_NODISCARD bool has_sort() const {
+					return sortByFunc != nullptr || sortByKeyFunc != nullptr;
 				}
 
 				//! Returns the hash contribution from sort identity payload.
-				//! \return Combined hash of the sort entity and callback.
+				//! \return Combined hash of the sort entity, sort keys and callbacks.
 				GAIA_NODISCARD QueryLookupHash::Type hash_sort_payload() const {
 					QueryLookupHash::Type hash = 0;
 					hash = core::hash_combine(hash, (QueryLookupHash::Type)sortBy.value());
 					hash = core::hash_combine(hash, (QueryLookupHash::Type)sortByFunc);
+					GAIA_FOR(sortByKeyCnt) {
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)sortByKeys[i].value());
+					}
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)sortByKeyFunc);
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)sortByKeyProj);
 					return hash;
 				}
 
@@ -1511,6 +1603,31 @@ namespace gaia {
 				GAIA_NODISCARD QueryLookupHash calc_lookup_hash() const {
 					return {core::calculate_hash64(hash_identity_payload())};
 				}
+
+				//! Returns the hash of everything VM compilation reads from the query.
+				//! Unlike calc_lookup_hash it ignores filters and callbacks so it stays stable across runs.
+				//! \return Direct-hash key identifying the compiled plan of this query shape.
+				GAIA_NODISCARD QueryLookupHash calc_plan_hash() const {
+					QueryLookupHash::Type hash = 0;
+					for (const auto& term: terms_view()) {
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)term.op);
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)term.id.value());
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)term.src.value());
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)term.entTrav.value());
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)(uint8_t)term.travKind);
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)term.travDepth);
+						hash = core::hash_combine(hash, (QueryLookupHash::Type)(uint8_t)term.matchKind);
+					}
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)firstOr);
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)firstNot);
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)firstAny);
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)((flags & QueryFlags::Complex) != 0));
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)as_mask_0);
+					hash = core::hash_combine(hash, (QueryLookupHash::Type)as_mask_1);
+					hash = core::hash_combine(
+							hash, (QueryLookupHash::Type)deps.has_dep_flag(DependencyHasEntityFilterTerms));
+					return {core::calculate_hash64(hash)};
+				}
 			} data{}; //!< Compiled query payload.
 			// Make sure that MAX_ITEMS_IN_QUERY can fit into data.readWriteMask
 			static_assert(MAX_ITEMS_IN_QUERY < 16);
@@ -1573,7 +1690,7 @@ namespace gaia {
 					data.deps.clear();
 					data.directTargetEvalKind = DirectTargetEvalKind::Generic;
 					data.directTargetEvalId = EntityBad;
-					if (data.sortByFunc != nullptr)
+					if (data.has_sort())
 						data.deps.set_dep_flag(DependencyHasSort);
 					if (data.groupBy != EntityBad)
 						data.add_group_deps();
@@ -1755,7 +1872,7 @@ namespace gaia {
 					}
 					data.canDirectTargetEval = canDirectTargetEval && hasDirectTargetEvalPositiveTerms;
 					data.canDirectEntitySeedEvalShape =
-							data.canDirectTargetEval && data.sortByFunc == nullptr && data.groupBy == EntityBad;
+							data.canDirectTargetEval && !data.has_sort() && data.groupBy == EntityBad;
 					data.hasOnlyDirectOrTerms = hasOnlyDirectOrTerms && hasOrTerms;
 
 					// Update the mask
@@ -1813,7 +1930,7 @@ namespace gaia {
 					if (hasSourceTerms || hasVariableTerms)
 						data.cachePolicy = CachePolicy::Dynamic;
 					else if (
-							!hasEntityFilterTerms && data.sortByFunc == nullptr && data.groupBy == EntityBad && hasCreateSelector)
+							!hasEntityFilterTerms && !data.has_sort() && data.groupBy == EntityBad && hasCreateSelector)
 						data.cachePolicy = CachePolicy::Immediate;
 					else
 						data.cachePolicy = CachePolicy::Lazy;
@@ -1822,6 +1939,8 @@ namespace gaia {
 																							? CreateArchetypeMatchKind::DirectStructuralTerms
 																							: CreateArchetypeMatchKind::Vm;
 					data.dynamicCacheKind = data.calc_dynamic_cache_kind();
+					if (data.dynamicCacheKind == DynamicCacheKind::Mixed && data.calc_can_track_var_src(*w))
+						data.dynamicCacheKind = DynamicCacheKind::VariableSource;
 
 					// Traversed-source snapshot caching is only effective for traversed source terms.
 					if (!data.deps.has_dep_flag(DependencyHasSourceTerms) || !data.deps.has_dep_flag(DependencyHasTraversalTerms))
@@ -1838,6 +1957,10 @@ namespace gaia {
 						data.queryMask = build_entity_mask(EntitySpan{idsNoSrc.data(), idsNoSrcCnt});
 						data.flags &= ~QueryCtx::QueryFlags::Complex;
 					}
+
+					// Plain ids need no semantic evaluation. New archetypes can be matched with a merge pass.
+					if (!isComplex && data.createArchetypeMatchKind == CreateArchetypeMatchKind::DirectStructuralTerms)
+						data.createArchetypeMatchKind = CreateArchetypeMatchKind::SortedIds;
 				}
 
 				// Request recompilation of the query if the mask has changed
@@ -20,6 +20,12 @@ namespace gaia {
 
 		//! Comparator callback used to order query rows by component values.
 		using TSortByFunc = int (*)(const World&, const void*, const void*);
+		//! Type-erased key projection used by key-based query sorting.
+		using TSortByKeyProj = void (*)();
+		//! Callback extracting packed radix keys of \a cnt rows starting at row \a from.
+		//! \a ppData holds the column base pointer of each sort key.
+		using TSortByKeyFunc =
+				void (*)(TSortByKeyProj proj, const void* const* ppData, uint32_t from, uint32_t cnt, uint64_t* pKeys);
 		//! Callback used to assign an archetype entity to a query group.
 		using TGroupByFunc = GroupId (*)(const World&, const Archetype&, Entity);
 	} // namespace ecs
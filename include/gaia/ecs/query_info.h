@@ -16,6 +16,7 @@
 #include "gaia/ecs/id.h"
 #include "gaia/ecs/query_common.h"
 #include "gaia/ecs/query_match_stamps.h"
+#include "gaia/ecs/query_plan_store.h"
 #include "gaia/ecs/vm.h"
 #include "gaia/mem/mem_utils.h"
 #include "gaia/mem/smallblock_allocator.h"
@@ -57,9 +58,9 @@ namespace gaia {
 			//! Offset into ExecPayload::directChunkData for this entry, or UINT32_MAX when no pointers are cached.
 			uint32_t dataOffset = UINT32_MAX;
 			//! First enabled row in pChunk processed by direct-dense iteration.
-			uint16_t rowFrom = 0;
+			ChunkRow rowFrom = 0;
 			//! One-past-the-end enabled row in pChunk processed by direct-dense iteration.
-			uint16_t rowTo = 0;
+			ChunkRow rowTo = 0;
 		};
 
 		//! Temporary VM matching buffer meant to be owned by an ECS World.
@@ -125,6 +126,8 @@ namespace gaia {
 			const EntityToArchetypeMap* pEntityToArchetypeMap;
 			//! Archetypes present in the world when the query is compiled.
 			std::span<const Archetype*> allArchetypes;
+			//! Optional precompiled plans tried before the query is compiled.
+			QueryPlanStore* pPlanStore = nullptr;
 		};
 
 		//! Compiled query plan and its incrementally maintained result caches.
@@ -155,8 +158,8 @@ namespace gaia {
 			struct SortData {
 				Chunk* pChunk;
 				uint32_t archetypeIdx;
-				uint16_t startRow;
-				uint16_t count;
+				ChunkRow startRow;
+				ChunkRow count;
 			};
 
 			struct GroupData {
@@ -242,6 +245,26 @@ namespace gaia {
 					}
 				};
 
+				//! Result of count() or empty() remembered for one row constraint.
+				struct CountCacheEntry {
+					//! World version captured when the entry was stored.
+					uint32_t worldVersion = UINT32_MAX;
+					//! Enabled hierarchy version captured when the entry was stored.
+					uint32_t enabledVersion = UINT32_MAX;
+					//! Archetype deletion-request version captured when the entry was stored.
+					uint32_t deleteVersion = UINT32_MAX;
+					//! Result membership revision captured when the entry was stored.
+					uint32_t resultRevision = 0;
+					//! First result-cache archetype index the entry covers.
+					uint32_t idxFrom = UINT32_MAX;
+					//! One-past-the-end result-cache archetype index the entry covers.
+					uint32_t idxTo = UINT32_MAX;
+					//! Number of matching entities. Only meaningful as zero / non-zero when exact is false.
+					uint32_t cnt = 0;
+					//! True when cnt is the exact count. False when only emptiness was probed.
+					bool exact = false;
+				};
+
 				//! Component mappings and flattened chunks prepared for query iteration.
 				struct ExecPayload {
 					//! Cached component-index mapping for each matched archetype.
@@ -270,6 +293,8 @@ namespace gaia {
 					uint32_t directChunksDataFieldCount = 0;
 					//! Component-index mapping storage captured by DirectChunkEntry::pCompIndices pointers.
 					const void* directChunksCompIndicesData = nullptr;
+					//! Cached count()/empty() results indexed by Constraints.
+					CountCacheEntry countCache[3];
 					//! True when archetype membership is populated but component-index metadata
 					//! still needs to be built on demand.
 					bool compIndicesPending = false;
@@ -291,6 +316,8 @@ namespace gaia {
 						directChunksIdxTo = UINT32_MAX;
 						directChunksDataFieldCount = 0;
 						directChunksCompIndicesData = nullptr;
+						for (auto& entry: countCache)
+							entry = {};
 						compIndicesPending = false;
 						inheritedDataPending = false;
 					}
@@ -309,6 +336,8 @@ namespace gaia {
 						directChunksIdxTo = UINT32_MAX;
 						directChunksDataFieldCount = 0;
 						directChunksCompIndicesData = nullptr;
+						for (auto& entry: countCache)
+							entry = {};
 						compIndicesPending = false;
 						inheritedDataPending = false;
 					}
@@ -538,6 +567,23 @@ namespace gaia {
 						}
 					};
 
+					//! Variable-source payload for reusable dynamic caches bound through relation targets.
+					struct VariableSourcePayload {
+						//! Relation targets known at the last update together with their archetype versions.
+						cnt::darray<SrcTravSnapshotItem> targets;
+						//! World source-entity change version captured with targets.
+						uint32_t changeVersion = UINT32_MAX;
+						//! Entity enable-state version captured with targets.
+						uint32_t enabledVersion = UINT32_MAX;
+
+						//! Clears variable-source snapshot state.
+						void clear() {
+							targets.clear();
+							changeVersion = UINT32_MAX;
+							enabledVersion = UINT32_MAX;
+						}
+					};
+
 					//! Relation-version payload.
 					RelationPayload relation;
 					//! Direct concrete-source payload.
@@ -546,11 +592,14 @@ namespace gaia {
 					TraversedSourcePayload traversedSource;
 					//! Runtime variable-binding payload.
 					VariablePayload variable;
+					//! Variable-source relation target payload.
+					VariableSourcePayload varSource;
 
 					//! Clears transient dynamic input snapshot state while preserving fixed-size version snapshots.
 					void clear_input_snapshots() {
 						traversedSource.clear();
 						variable.clear();
+						varSource.clear();
 					}
 				};
 
@@ -646,6 +695,8 @@ namespace gaia {
 #if GAIA_ECS_TEST_HOOKS
 			//! Persistent VM match-pass count used only by query-cache reuse tests.
 			uint32_t m_testMatchPassCount = 0;
+			//! Variable-source subtree match-pass count used only by query-cache reuse tests.
+			uint32_t m_testSubtreeMatchPassCount = 0;
 #endif
 
 			QueryPlan m_plan;
@@ -813,6 +864,34 @@ namespace gaia {
 				return traversed_src_inputs_changed(relationVersionsChanged);
 			}
 
+			//! Variable-source queries maintain their dynamic cache per relation subtree.
+			GAIA_NODISCARD bool uses_var_src_tracking() const {
+				return m_plan.ctx.data.uses_var_src_tracking();
+			}
+
+			//! Checks variable-source inputs that can only be handled by a full match pass.
+			//! Changes of relation target archetypes are not included. match() handles them per subtree.
+			GAIA_NODISCARD bool var_src_cache_stale(
+					const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings, uint8_t runtimeVarBindingMask) const {
+				return m_state.dynamic.varSource.enabledVersion != world_enabled_hierarchy_version(*world()) ||
+							 dyn_var_bindings_changed(runtimeVarBindings, runtimeVarBindingMask);
+			}
+
+			//! Checks whether any relation target captured by the variable-source cache changed archetype.
+			GAIA_NODISCARD bool var_src_targets_changed() const {
+				const auto& w = *world();
+				const auto& payload = m_state.dynamic.varSource;
+				if (payload.changeVersion == world_src_entity_change_version(w))
+					return false;
+
+				for (const auto& item: payload.targets) {
+					if (item.sourceVersion != world_entity_archetype_version(w, item.entity))
+						return true;
+				}
+
+				return false;
+			}
+
 			//! Checks whether any tracked runtime input invalidates the reusable dynamic cache.
 			GAIA_NODISCARD bool
 			dyn_inputs_changed(const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings, uint8_t runtimeVarBindingMask) {
@@ -832,6 +911,8 @@ namespace gaia {
 						return dyn_var_bindings_changed(runtimeVarBindings, runtimeVarBindingMask);
 					case QueryCtx::DynamicCacheKind::Mixed:
 						return mixed_dyn_inputs_changed(runtimeVarBindings, runtimeVarBindingMask);
+					case QueryCtx::DynamicCacheKind::VariableSource:
+						return var_src_cache_stale(runtimeVarBindings, runtimeVarBindingMask) || var_src_targets_changed();
 				}
 
 				GAIA_ASSERT(false);
@@ -900,10 +981,168 @@ namespace gaia {
 							snapshot_dyn_var_inputs(runtimeVarBindings, runtimeVarBindingMask);
 						return;
 					}
+					case QueryCtx::DynamicCacheKind::VariableSource:
+						// Relation targets are captured by match() which owns the archetype lookup.
+						snapshot_dyn_var_inputs(runtimeVarBindings, runtimeVarBindingMask);
+						return;
 				}
 
 				GAIA_ASSERT(false);
 			}
+
+			//! Captures the relation targets whose archetypes decide variable-source matches.
+			//! \param entityToArchetypeMap World reverse index used to find archetypes with relation pairs.
+			void snapshot_var_src_targets(const EntityToArchetypeMap& entityToArchetypeMap) {
+				auto& w = *world();
+				auto& payload = m_state.dynamic.varSource;
+				payload.targets.clear();
+
+				const auto relation = m_plan.ctx.data.deps.relations_view()[0];
+				const auto it = entityToArchetypeMap.find(EntityLookupKey(Pair(relation, All)));
+				if (it != entityToArchetypeMap.end()) {
+					cnt::set<EntityLookupKey> seen;
+					for (const auto& entry: it->second) {
+						for (const auto id: entry.pArchetype->ids_view()) {
+							if (!id.pair() || id.id() != relation.id())
+								continue;
+
+							const auto target = pair_tgt(w, id);
+							if (target == EntityBad || !seen.insert(EntityLookupKey(target)).second)
+								continue;
+
+							payload.targets.push_back({target, world_entity_archetype_version(w, target)});
+						}
+					}
+				}
+
+				payload.changeVersion = world_src_entity_change_version(w);
+				payload.enabledVersion = world_enabled_hierarchy_version(w);
+			}
+
+			//! Brings a variable-source cache up to date after relation targets changed archetype.
+			//! An archetype depends only on its own ids and on the archetypes of its relation targets and their
+			//! ancestors. Therefore, only archetypes holding a (relation, target) pair where the target is a changed
+			//! entity or lies below one are matched again. Archetypes created since the last pass are left to the
+			//! regular incremental pass.
+			//! \param entityToArchetypeMap World reverse index used to walk the relation downwards.
+			//! \param runtimeVarBindings Runtime variable bindings for dynamic queries
+			//! \param runtimeVarBindingMask Mask indicating which runtime variables are bound
+			void update_var_src_cache(
+					const EntityToArchetypeMap& entityToArchetypeMap, const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings,
+					uint8_t runtimeVarBindingMask) {
+				auto& w = *world();
+				auto& payload = m_state.dynamic.varSource;
+				const auto changeVersion = world_src_entity_change_version(w);
+				if (payload.changeVersion == changeVersion)
+					return;
+
+				cnt::darray<Entity> subtree;
+				cnt::set<EntityLookupKey> visited;
+				for (const auto& item: payload.targets) {
+					if (item.sourceVersion == world_entity_archetype_version(w, item.entity))
+						continue;
+
+					subtree.push_back(item.entity);
+					visited.insert(EntityLookupKey(item.entity));
+				}
+				if (subtree.empty()) {
+					payload.changeVersion = changeVersion;
+					return;
+				}
+
+				GAIA_PROF_SCOPE(queryinfo::match_subtree);
+
+				const auto relation = m_plan.ctx.data.deps.relations_view()[0];
+				cnt::darray<const Archetype*> archetypes;
+				cnt::set<const Archetype*> pending;
+				for (uint32_t i = 0; i < subtree.size(); ++i) {
+					const auto it = entityToArchetypeMap.find(EntityLookupKey(Pair(relation, subtree[i])));
+					if (it == entityToArchetypeMap.end())
+						continue;
+
+					for (const auto& entry: it->second) {
+						const auto* pArchetype = entry.pArchetype;
+						if (pArchetype->id() > m_state.lastArchetypeId || !pending.insert(pArchetype).second)
+							continue;
+
+						archetypes.push_back(pArchetype);
+						for (const auto* pChunk: pArchetype->chunks()) {
+							for (const auto entity: pChunk->entity_view()) {
+								if (visited.insert(EntityLookupKey(entity)).second)
+									subtree.push_back(entity);
+							}
+						}
+					}
+				}
+
+				if (!archetypes.empty()) {
+					// Structural candidates come from the affected archetypes only. Variable sources are still looked up
+					// in the whole world because they usually live above the subtree.
+					EntityToArchetypeMap subtreeLookup;
+					for (const auto* pArchetype: archetypes) {
+						auto addLookup = [&](Entity key, uint16_t compIdx) {
+							auto& records = subtreeLookup[EntityLookupKey(key)];
+							if (!records.empty() && records.back().pArchetype == pArchetype) {
+								++records.back().matchCount;
+								return;
+							}
+							records.push_back(ComponentIndexEntry{const_cast<Archetype*>(pArchetype), compIdx, 1});
+						};
+
+						const auto ids = pArchetype->ids_view();
+						GAIA_FOR((uint32_t)ids.size()) {
+							const auto entity = ids[i];
+							addLookup(entity, (uint16_t)i);
+							if (!entity.pair())
+								continue;
+
+							const auto relKind = entity.entity() ? EntityKind::EK_Uni : EntityKind::EK_Gen;
+							const auto rel = Entity((EntityId)entity.id(), 0, false, false, relKind);
+							const auto tgt = Entity((EntityId)entity.gen(), 0, false, false, entity.kind());
+							addLookup(Pair(All, tgt), ComponentIndexBad);
+							addLookup(Pair(rel, All), ComponentIndexBad);
+							addLookup(Pair(All, All), ComponentIndexBad);
+						}
+					}
+
+					auto& matchScratch = query_match_scratch_acquire(w);
+					CleanUpTmpArchetypeMatches autoCleanup(w, true);
+
+					vm::MatchingCtx ctx{};
+					ctx.pWorld = &w;
+					ctx.allArchetypes = std::span(archetypes.data(), archetypes.size());
+					ctx.archetypeLookup = vm::make_archetype_lookup_view(subtreeLookup);
+					ctx.srcLookup = vm::make_archetype_lookup_view(entityToArchetypeMap);
+					ctx.pMatchesArr = &matchScratch.matchesArr;
+					ctx.pMatchesStampByArchetypeId = &matchScratch.matchStamps;
+					ctx.matchesVersion = matchScratch.next_match_version();
+					ctx.pLastMatchedArchetypeIdx_All = nullptr;
+					ctx.pLastMatchedArchetypeIdx_Or = nullptr;
+					ctx.pLastMatchedArchetypeIdx_Not = nullptr;
+					ctx.queryMask = m_plan.ctx.data.queryMask;
+					ctx.as_mask_0 = m_plan.ctx.data.as_mask_0;
+					ctx.as_mask_1 = m_plan.ctx.data.as_mask_1;
+					ctx.flags = m_plan.ctx.data.flags;
+					ctx.varBindings = runtimeVarBindings;
+					ctx.varBindingMask = runtimeVarBindingMask;
+
+#if GAIA_ECS_TEST_HOOKS
+					++m_testSubtreeMatchPassCount;
+#endif
+					m_plan.vm.exec(ctx);
+
+					for (const auto* pArchetype: *ctx.pMatchesArr) {
+						add_archetype_to_cache(pArchetype, true, false);
+						pending.erase(pArchetype);
+					}
+					for (const auto* pArchetype: archetypes) {
+						if (pending.contains(pArchetype))
+							(void)del_archetype_from_cache(pArchetype);
+					}
+				}
+
+				snapshot_var_src_targets(entityToArchetypeMap);
+			}
 			//! Returns whether a compiled query contains a term with the requested access mode.
 			//! \tparam TType Component or Entity argument type to check.
 			//! \param op Query operation kind to match.
@@ -1010,7 +1249,7 @@ namespace gaia {
 
 			//! Marks the cached sorted slices dirty without invalidating query membership.
 			void invalidate_sort() {
-				if (m_plan.ctx.data.sortByFunc != nullptr)
+				if (m_plan.ctx.data.has_sort())
 					m_plan.ctx.data.flags |= QueryCtx::QueryFlags::SortEntities;
 			}
 
@@ -1059,8 +1298,10 @@ namespace gaia {
 				info.m_plan.ctx = GAIA_MOV(queryCtx);
 				info.m_plan.ctx.q.handle = {idx, gen};
 
-				// Compile the query
-				info.compile(entityToArchetypeMap, pCreationCtx->allArchetypes);
+				// Compile the query unless a matching precompiled plan is available
+				auto* pPlanStore = pCreationCtx->pPlanStore;
+				if (pPlanStore == nullptr || pPlanStore->empty() || !info.load_plan(*pPlanStore))
+					info.compile(entityToArchetypeMap, pCreationCtx->allArchetypes);
 
 				return info;
 			}
@@ -1082,6 +1323,77 @@ namespace gaia {
 				m_plan.vm.compile(entityToArchetypeMap, allArchetypes, m_plan.ctx);
 			}
 
+			//! Returns true when compiling the query costs more than restoring a stored plan.
+			//! Plain id terms compile into a handful of opcodes, which is as fast as validating a stored plan.
+			//! Source and variable terms additionally need search programs and cost estimates built.
+			GAIA_NODISCARD bool uses_stored_plans() const {
+				return (m_plan.ctx.data.flags &
+								(QueryCtx::QueryFlags::HasSourceTerms | QueryCtx::QueryFlags::HasVariableTerms)) != 0;
+			}
+
+			//! Stores the compiled plan of the query in \a store so a later run can skip compiling it.
+			//! Queries waiting for recompilation are skipped because their program is out of date.
+			//! \param store Plan store receiving the plan.
+			void save_plan(QueryPlanStore& store) const {
+				if (!uses_stored_plans() || (m_plan.ctx.data.flags & QueryCtx::QueryFlags::Recompile) != 0)
+					return;
+
+				auto& s = store.write(m_plan.ctx.data.calc_plan_hash());
+				s.save(plan_fingerprint());
+				m_plan.vm.save_program(s, m_plan.ctx);
+			}
+
+			//! Restores the compiled plan of the query from \a store.
+			//! \param store Plan store to search.
+			//! \return True when a valid plan was found and the query does not need compiling. False otherwise.
+			GAIA_NODISCARD bool load_plan(QueryPlanStore& store) {
+				GAIA_PROF_SCOPE(queryinfo::load_plan);
+
+				if (!uses_stored_plans())
+					return false;
+
+				auto* pPlan = store.find(m_plan.ctx.data.calc_plan_hash());
+				if (pPlan == nullptr)
+					return false;
+
+				// Components referenced by the terms changed since the plan was stored
+				uint64_t fingerprint = 0;
+				pPlan->load(fingerprint);
+				if (fingerprint != plan_fingerprint())
+					return false;
+
+				if (!m_plan.vm.load_program(*pPlan, m_plan.ctx))
+					return false;
+
+				store.add_hit();
+				return true;
+			}
+
+			//! Hashes the component registry records of all ids referenced by the query terms.
+			//! Stored plans are rejected when a referenced component changed its type, size or storage.
+			//! \return Fingerprint of the registry records the compiled plan depends on.
+			GAIA_NODISCARD uint64_t plan_fingerprint() const {
+				GAIA_ASSERT(m_plan.ctx.cc != nullptr);
+				const auto& cc = *m_plan.ctx.cc;
+
+				uint64_t hash = 0;
+				auto addEntity = [&](uint32_t entityId) {
+					const auto* pItem = cc.find(Entity((EntityId)entityId, 0));
+					if (pItem == nullptr) {
+						hash = core::hash_combine(hash, (uint64_t)0);
+						return;
+					}
+					hash = core::hash_combine(hash, (uint64_t)pItem->hashLookup.hash);
+					hash = core::hash_combine(hash, (uint64_t)pItem->comp.value());
+				};
+				for (const auto& term: m_plan.ctx.data.terms_view()) {
+					addEntity(term.id.id());
+					if (term.id.pair())
+						addEntity(term.id.gen());
+				}
+				return hash;
+			}
+
 			//! Recompile the query
 			void recompile() {
 				GAIA_PROF_SCOPE(queryinfo::recompile);
@@ -1121,9 +1433,9 @@ namespace gaia {
 			}
 
 			//! Returns true when sorted-query payloads are active for this query.
-			//! \return True when an entity sorting callback is configured.
+			//! \return True when an entity sorting callback or a key projection is configured.
 			GAIA_NODISCARD bool has_sorted_payload() const {
-				return m_plan.ctx.data.sortByFunc != nullptr;
+				return m_plan.ctx.data.has_sort();
 			}
 
 			//! Returns the result membership revision used by reverse-index cache users.
@@ -1149,7 +1461,32 @@ namespace gaia {
 			//! Returns whether create-time matching should bypass the temporary one-archetype VM path.
 			//! \return True when direct structural matching was selected during compilation.
 			GAIA_NODISCARD bool can_use_direct_create_archetype_match() const {
-				return m_plan.ctx.data.createArchetypeMatchKind == QueryCtx::CreateArchetypeMatchKind::DirectStructuralTerms;
+				const auto kind = m_plan.ctx.data.createArchetypeMatchKind;
+				return kind == QueryCtx::CreateArchetypeMatchKind::DirectStructuralTerms ||
+							 kind == QueryCtx::CreateArchetypeMatchKind::SortedIds;
+			}
+
+			//! Returns whether create-time matching can use the fused sorted-id matcher.
+			//! \return True when the compiled query consists of plain ALL, OR and NOT ids only.
+			GAIA_NODISCARD bool can_use_sorted_ids_create_archetype_match() const {
+				return m_plan.ctx.data.createArchetypeMatchKind == QueryCtx::CreateArchetypeMatchKind::SortedIds;
+			}
+
+			//! Returns whether the full match may run on a worker thread with caller-owned scratch storage.
+			//! Plain structural queries only read the world while matching and write to their own cache state.
+			//! Dynamic, grouped and sorted queries call back into the world and have to stay on the main thread.
+			//! \return True when the compiled plan is up to date and the query has no such dependencies.
+			GAIA_NODISCARD bool can_match_in_parallel() const {
+				const auto& ctxData = m_plan.ctx.data;
+				return (ctxData.flags & (QueryCtx::QueryFlags::Recompile | QueryCtx::QueryFlags::Complex)) == 0 &&
+							 !has_dyn_terms() && ctxData.groupBy == EntityBad && !ctxData.has_sort();
+			}
+
+			//! Returns whether create-time matching may reject archetypes that lack any of the exact ALL ids.
+			//! \return True when the compiled plan is up to date and uses the sorted-id matcher.
+			GAIA_NODISCARD bool can_prefilter_create_archetype_by_all_ids() const {
+				return (m_plan.ctx.data.flags & QueryCtx::QueryFlags::Recompile) == 0 &&
+							 can_use_sorted_ids_create_archetype_match();
 			}
 
 			//! Returns whether direct create-time matching needs Is-aware id checks.
@@ -1179,18 +1516,23 @@ namespace gaia {
 				World& world;
 				//! True to retain allocated dedup-stamp pages while releasing the frame.
 				bool keepStamps;
+				//! False when the caller supplied its own scratch and no world frame was acquired.
+				bool active;
 
 				//! Creates a guard for an already acquired matching frame.
 				//! \param world World owning the frame.
 				//! \param keepStamps Whether allocated dedup-stamp pages remain reusable.
-				explicit CleanUpTmpArchetypeMatches(World& world, bool keepStamps): world(world), keepStamps(keepStamps) {}
+				//! \param active Whether a world frame was acquired and has to be released.
+				explicit CleanUpTmpArchetypeMatches(World& world, bool keepStamps, bool active = true):
+						world(world), keepStamps(keepStamps), active(active) {}
 				CleanUpTmpArchetypeMatches(const CleanUpTmpArchetypeMatches&) = delete;
 				CleanUpTmpArchetypeMatches(CleanUpTmpArchetypeMatches&&) = delete;
 				CleanUpTmpArchetypeMatches& operator=(const CleanUpTmpArchetypeMatches&) = delete;
 				CleanUpTmpArchetypeMatches& operator=(CleanUpTmpArchetypeMatches&&) = delete;
 
 				~CleanUpTmpArchetypeMatches() {
-					query_match_scratch_release(world, keepStamps);
+					if (active)
+						query_match_scratch_release(world, keepStamps);
 				}
 			};
 
@@ -1202,13 +1544,16 @@ namespace gaia {
 			//! \param archetypeLastId Last recorded archetype id
 			//! \param runtimeVarBindings Runtime variable bindings for dynamic queries
 			//! \param runtimeVarBindingMask Mask indicating which runtime variables are bound
+			//! \param pCallerScratch Optional caller-owned scratch used instead of the world scratch stack
 			//! \tparam ArchetypeLookup Archetype lookup container/view type used by the query cache.
-			//! \warning Not thread safe. No two threads can call this at the same time.
+			//! \warning Not thread safe. No two threads can call this at the same time unless each passes its own
+			//!          \a pCallerScratch and the query satisfies can_match_in_parallel().
 			template <typename ArchetypeLookup>
 			void match(
 					const ArchetypeLookup& entityToArchetypeMap, std::span<const Archetype*> allArchetypes,
 					const EntityToArchetypeVersionMap* pEntityToArchetypeMapVersions, ArchetypeId archetypeLastId,
-					const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings, uint8_t runtimeVarBindingMask) {
+					const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings, uint8_t runtimeVarBindingMask,
+					QueryMatchScratch* pCallerScratch = nullptr) {
 				auto& ctxData = m_plan.ctx.data;
 
 				// Recompile if necessary
@@ -1221,13 +1566,20 @@ namespace gaia {
 
 				const bool hasDynamicTerms = has_dyn_terms();
 				const bool canReuseDynamicCache = can_reuse_dyn_cache();
+				bool updateVarSrcCache = false;
+				if constexpr (std::is_same_v<ArchetypeLookup, EntityToArchetypeMap>) {
+					updateVarSrcCache = hasDynamicTerms && uses_var_src_tracking() && !m_state.seed_dirty() &&
+															!var_src_cache_stale(runtimeVarBindings, runtimeVarBindingMask);
+				}
 				const bool refreshDynamicCache =
-						hasDynamicTerms && (!canReuseDynamicCache || m_state.needs_refresh() ||
-																dyn_inputs_changed(runtimeVarBindings, runtimeVarBindingMask));
+						hasDynamicTerms && !updateVarSrcCache &&
+						(!canReuseDynamicCache || m_state.needs_refresh() ||
+						 dyn_inputs_changed(runtimeVarBindings, runtimeVarBindingMask));
 				bool compareDynamicMembership = false;
 				QueryMatchScratch* pMatchScratch = nullptr;
 
 				if (refreshDynamicCache) {
+					GAIA_ASSERT(pCallerScratch == nullptr);
 					compareDynamicMembership = !m_state.archetypeCache.empty();
 					if (compareDynamicMembership) {
 						auto& w = *world();
@@ -1236,6 +1588,16 @@ namespace gaia {
 					}
 					// Dynamic queries keep their cached result as long as tracked runtime inputs stay stable.
 					reset_matching_cache(!compareDynamicMembership);
+				} else if (updateVarSrcCache) {
+					// Relation changes only reach archetypes below the targets that moved. The rest of the cache stays.
+					if constexpr (std::is_same_v<ArchetypeLookup, EntityToArchetypeMap>)
+						update_var_src_cache(entityToArchetypeMap, runtimeVarBindings, runtimeVarBindingMask);
+					m_state.clear_dirty();
+					if (m_state.lastArchetypeId == archetypeLastId) {
+						sort_entities();
+						sort_cache_groups();
+						return;
+					}
 				} else if (m_state.seed_dirty()) {
 					reset_matching_cache(true);
 				} else if (m_state.result_dirty()) {
@@ -1262,8 +1624,13 @@ namespace gaia {
 				GAIA_PROF_SCOPE(queryinfo::match);
 
 				auto& w = *world();
-				auto& matchScratch = pMatchScratch != nullptr ? *pMatchScratch : query_match_scratch_acquire(w);
-				CleanUpTmpArchetypeMatches autoCleanup(w, true);
+				if (pCallerScratch != nullptr) {
+					pMatchScratch = pCallerScratch;
+					pMatchScratch->clear_temporary_matches_keep_stamps();
+				} else if (pMatchScratch == nullptr)
+					pMatchScratch = &query_match_scratch_acquire(w);
+				auto& matchScratch = *pMatchScratch;
+				CleanUpTmpArchetypeMatches autoCleanup(w, true, pCallerScratch == nullptr);
 
 				// Prepare the context
 				vm::MatchingCtx ctx{};
@@ -1318,6 +1685,10 @@ namespace gaia {
 				// Sort cache groups if necessary
 				sort_cache_groups();
 				snapshot_dyn_inputs(runtimeVarBindings, runtimeVarBindingMask);
+				if constexpr (std::is_same_v<ArchetypeLookup, EntityToArchetypeMap>) {
+					if (uses_var_src_tracking())
+						snapshot_var_src_targets(entityToArchetypeMap);
+				}
 				m_state.clear_dirty();
 			}
 
@@ -1407,13 +1778,15 @@ namespace gaia {
 			//! \param archetypeLastId Greatest world-local archetype id currently allocated.
 			//! \param runtimeVarBindings Runtime values for query variable slots.
 			//! \param runtimeVarBindingMask Bitmask selecting bound slots in \a runtimeVarBindings.
+			//! \param pCallerScratch Optional caller-owned scratch. Required when matching off the main thread.
 			void ensure_matches(
 					const EntityToArchetypeMap& entityToArchetypeMap, std::span<const Archetype*> allArchetypes,
 					const EntityToArchetypeVersionMap& entityToArchetypeMapVersions, ArchetypeId archetypeLastId,
-					const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings, uint8_t runtimeVarBindingMask) {
+					const cnt::sarray<Entity, MaxVarCnt>& runtimeVarBindings, uint8_t runtimeVarBindingMask,
+					QueryMatchScratch* pCallerScratch = nullptr) {
 				match(
 						entityToArchetypeMap, allArchetypes, &entityToArchetypeMapVersions, archetypeLastId, runtimeVarBindings,
-						runtimeVarBindingMask);
+						runtimeVarBindingMask, pCallerScratch);
 			}
 
 			//! Rebuilds transient result membership without retaining persistent seed-cache state.
@@ -1552,6 +1925,21 @@ namespace gaia {
 					return false;
 
 				const bool hadMatchBefore = !assumeNew && m_state.archetypeSet.contains(&archetype);
+				if (can_use_sorted_ids_create_archetype_match()) {
+					// Terms are sorted by operation and id so each operation is a sorted sub-range of ids.
+					const auto ids = ctxData.ids_view();
+					const uint32_t firstOr = ctxData.firstOr;
+					const uint32_t firstNot = ctxData.firstNot;
+					const uint32_t firstAny = ctxData.firstAny;
+					const bool matched = vm::detail::match_sorted_ids(
+							archetype.ids_view(), ids.subspan(0, firstOr), ids.subspan(firstOr, firstNot - firstOr),
+							ids.subspan(firstNot, firstAny - firstNot));
+					if (!matched || hadMatchBefore)
+						return false;
+
+					add_created_archetype_to_caches(archetype, assumeNew);
+					return true;
+				}
 				if (can_use_direct_create_archetype_match()) {
 					const bool usesIs = direct_create_archetype_match_uses_is();
 					bool hasOrTerms = false;
@@ -1582,12 +1970,7 @@ namespace gaia {
 					if (hadMatchBefore)
 						return false;
 
-					if (assumeNew)
-						add_new_archetype_to_immediate_caches(&archetype, true);
-					else {
-						add_archetype_to_seed_cache(&archetype, false);
-						add_archetype_to_cache(&archetype, true, false);
-					}
+					add_created_archetype_to_caches(archetype, assumeNew);
 					return true;
 				}
 
@@ -1656,13 +2039,43 @@ namespace gaia {
 				return true;
 			}
 
+			//! Read position of calculate_sort_data() inside one cached archetype.
+			struct SortCursor {
+				//! Index of the chunk within the archetype
+				uint32_t chunkIdx = 0;
+				//! Row within the chunk
+				ChunkRow row = 0;
+				//! Number of rows stored in the archetype's chunks before this chunk
+				uint32_t chunkOffset = 0;
+
+				//! Row within the archetype when all of its chunks are laid out one after another
+				GAIA_NODISCARD uint32_t flat_row() const {
+					return chunkOffset + row;
+				}
+			};
+
 			//! Calculates the sort data for the archetypes in the cache.
 			//! This allows us to iterate entites in the order they are sorted across all archetypes.
-			void calculate_sort_data() {
+			//! Disabled rows are merged first, enabled rows after them, so each group forms an ordered sequence
+			//! the same way Archetype::sort_entities() orders them.
+			//! \tparam TLessFunc bool lessFunc(uint32_t archetypeIdx, const SortCursor& cursor,
+			//!                                  uint32_t archetypeIdxMin, const SortCursor& cursorMin)
+			//! \param lessFunc Returns true when the row under the first cursor goes before the one under the second
+			template <typename TLessFunc>
+			void calculate_sort_data(TLessFunc lessFunc) {
 				GAIA_PROF_SCOPE(queryinfo::calc_sort_data);
 
 				m_state.nonTrivial.archetypeSortData.clear();
+				calculate_sort_data_inter<false>(lessFunc);
+				calculate_sort_data_inter<true>(lessFunc);
+			}
 
+			//! Merges enabled or disabled rows of all cached archetypes into sorted chunk slices.
+			//! \tparam Enabled True to merge enabled rows, false to merge disabled rows
+			//! \tparam TLessFunc See calculate_sort_data()
+			//! \param lessFunc Returns true when the row under the first cursor goes before the one under the second
+			template <bool Enabled, typename TLessFunc>
+			void calculate_sort_data_inter(TLessFunc& lessFunc) {
 				// The function doesn't do any moves and expects that all chunks have their data sorted already.
 				// We use a min-heap / priority queue - like structure during query iteration to merge sorted tables:
 				// - we hold a cursor into each sorted chunk
@@ -1678,64 +2091,48 @@ namespace gaia {
 				// performance and memory usage. We could also sort the data in-place across all chunks, but that
 				// would generated too many data moves (entities + all of their components).
 
-				struct Cursor {
-					uint32_t chunkIdx = 0;
-					uint16_t row = 0;
+				const auto row_from = [](const Chunk* pChunk) {
+					return Enabled ? (ChunkRow)pChunk->size_disabled() : (ChunkRow)0;
+				};
+				const auto row_to = [](const Chunk* pChunk) {
+					return Enabled ? (ChunkRow)pChunk->size() : (ChunkRow)pChunk->size_disabled();
 				};
 
 				auto& archetypes = m_state.archetypeCache;
 
 				// Initialize cursors. We will need as many as there are archetypes.
-				cnt::sarray_ext<Cursor, 128> cursors(archetypes.size());
+				cnt::sarray_ext<SortCursor, 128> cursors(archetypes.size());
+				for (uint32_t t = 0; t < archetypes.size(); ++t) {
+					const auto& chunks = archetypes[t]->chunks();
+					if (!chunks.empty())
+						cursors[t].row = row_from(chunks[0]);
+				}
 
 				uint32_t currArchetypeIdx = (uint32_t)-1;
 				Chunk* pCurrentChunk = nullptr;
-				uint16_t currentStartRow = 0;
-				uint16_t currentRow = 0;
-
-				const void* pDataMin = nullptr;
-				const void* pDataCurr = nullptr;
+				ChunkRow currentStartRow = 0;
+				ChunkRow currentRow = 0;
 
 				while (true) {
 					uint32_t minArchetypeIdx = (uint32_t)-1;
-					Entity minEntity = EntityBad;
 
 					// Find the next entity across all tables/chunks
 					for (uint32_t t = 0; t < archetypes.size(); ++t) {
-						const auto* pArchetype = archetypes[t];
-						const auto& chunks = pArchetype->chunks();
+						const auto& chunks = archetypes[t]->chunks();
 						auto& cur = cursors[t];
 
-						while (cur.chunkIdx < chunks.size() && cur.row >= chunks[cur.chunkIdx]->size()) {
+						while (cur.chunkIdx < chunks.size() && cur.row >= row_to(chunks[cur.chunkIdx])) {
+							cur.chunkOffset += chunks[cur.chunkIdx]->size();
 							++cur.chunkIdx;
-							cur.row = 0;
+							if (cur.chunkIdx < chunks.size())
+								cur.row = row_from(chunks[cur.chunkIdx]);
 						}
 
 						if (cur.chunkIdx >= chunks.size())
 							continue;
 
-						const auto* pChunk = pArchetype->chunks()[cur.chunkIdx];
-						auto entity = pChunk->entity_view()[cur.row];
-
-						if (m_plan.ctx.data.sortBy != ecs::EntityBad) {
-							auto compIdx = world_component_index_comp_idx(*m_plan.ctx.w, *pArchetype, m_plan.ctx.data.sortBy);
-							if (compIdx == BadIndex)
-								compIdx = pChunk->comp_idx(m_plan.ctx.data.sortBy);
-							pDataCurr = pChunk->comp_ptr(compIdx, cur.row);
-						} else
-							pDataCurr = &pChunk->entity_view()[cur.row];
-
-						if (minEntity == EntityBad) {
-							minEntity = entity;
+						if (minArchetypeIdx == (uint32_t)-1 || lessFunc(t, cur, minArchetypeIdx, cursors[minArchetypeIdx]))
 							minArchetypeIdx = t;
-							pDataMin = pDataCurr;
-							continue;
-						}
-
-						if (m_plan.ctx.data.sortByFunc(*m_plan.ctx.w, pDataCurr, pDataMin) < 0) {
-							minEntity = entity;
-							minArchetypeIdx = t;
-						}
 					}
 
 					// No more results found, we can stop
@@ -1752,7 +2149,7 @@ namespace gaia {
 						// End previous slice
 						if (pCurrentChunk != nullptr) {
 							m_state.nonTrivial.archetypeSortData.push_back(
-									{pCurrentChunk, currArchetypeIdx, currentStartRow, (uint16_t)(currentRow - currentStartRow)});
+									{pCurrentChunk, currArchetypeIdx, currentStartRow, (ChunkRow)(currentRow - currentStartRow)});
 						}
 
 						// Start a new slice
@@ -1767,25 +2164,126 @@ namespace gaia {
 
 				if (pCurrentChunk != nullptr) {
 					m_state.nonTrivial.archetypeSortData.push_back(
-							{pCurrentChunk, currArchetypeIdx, currentStartRow, (uint16_t)(currentRow - currentStartRow)});
+							{pCurrentChunk, currArchetypeIdx, currentStartRow, (ChunkRow)(currentRow - currentStartRow)});
 				}
 			}
 
+			//! Calculates the sort data of a query sorted by a comparator.
+			void calculate_sort_data_by_func() {
+				const auto& ctxData = m_plan.ctx.data;
+				const auto& archetypes = m_state.archetypeCache;
+
+				auto data_ptr = [&](uint32_t archetypeIdx, const SortCursor& cursor) -> const void* {
+					const auto* pArchetype = archetypes[archetypeIdx];
+					const auto* pChunk = pArchetype->chunks()[cursor.chunkIdx];
+					if (ctxData.sortBy == ecs::EntityBad)
+						return &pChunk->entity_view()[cursor.row];
+
+					auto compIdx = world_component_index_comp_idx(*m_plan.ctx.w, *pArchetype, ctxData.sortBy);
+					if (compIdx == BadIndex)
+						compIdx = pChunk->comp_idx(ctxData.sortBy);
+					return pChunk->comp_ptr(compIdx, cursor.row);
+				};
+
+				calculate_sort_data([&](uint32_t archetypeIdx, const SortCursor& cursor, uint32_t archetypeIdxMin,
+																const SortCursor& cursorMin) {
+					return ctxData.sortByFunc(
+										 *m_plan.ctx.w, data_ptr(archetypeIdx, cursor), data_ptr(archetypeIdxMin, cursorMin)) < 0;
+				});
+			}
+
+			//! Extracts packed sort keys of \a cnt rows of a chunk starting at row \a from.
+			//! Columns of the sort keys are resolved once for the whole run.
+			//! \param archetype Archetype owning the chunk
+			//! \param chunk Chunk to read
+			//! \param from First row
+			//! \param cnt Number of rows
+			//! \param[out] pKeys Receives \a cnt keys
+			void
+			sort_keys(const Archetype& archetype, const Chunk& chunk, uint32_t from, uint32_t cnt, uint64_t* pKeys) const {
+				const auto& ctxData = m_plan.ctx.data;
+
+				const void* ppData[MAX_SORT_KEYS_IN_QUERY];
+				GAIA_FOR(ctxData.sortByKeyCnt) {
+					const auto key = ctxData.sortByKeys[i];
+					if (key == EntityBad) {
+						ppData[i] = chunk.entity_view().data();
+						continue;
+					}
+
+					auto compIdx = world_component_index_comp_idx(*m_plan.ctx.w, archetype, key);
+					if (compIdx == BadIndex)
+						compIdx = chunk.comp_idx(key);
+					GAIA_ASSERT(compIdx != BadIndex);
+					ppData[i] = chunk.comp_ptr(compIdx);
+				}
+
+				ctxData.sortByKeyFunc(ctxData.sortByKeyProj, ppData, from, cnt, pKeys);
+			}
+
+			//! Calculates the sort data of a query sorted by projected keys.
+			//! Keys of every cached row are extracted once up front and the merge compares plain integers.
+			void calculate_sort_data_by_keys() {
+				const auto& archetypes = m_state.archetypeCache;
+
+				// A single archetype is already in order, there is nothing to merge
+				if (archetypes.size() <= 1) {
+					calculate_sort_data([](uint32_t, const SortCursor&, uint32_t, const SortCursor&) {
+						return false;
+					});
+					return;
+				}
+
+				cnt::darray<uint64_t> keys;
+				cnt::sarray_ext<uint32_t, 128> keyOffsets(archetypes.size());
+				for (uint32_t t = 0; t < archetypes.size(); ++t) {
+					const auto* pArchetype = archetypes[t];
+					keyOffsets[t] = (uint32_t)keys.size();
+					for (const auto* pChunk: pArchetype->chunks()) {
+						const auto size = (uint32_t)pChunk->size();
+						if (size == 0)
+							continue;
+
+						const auto offset = (uint32_t)keys.size();
+						keys.resize(offset + size);
+						sort_keys(*pArchetype, *pChunk, 0, size, keys.data() + offset);
+					}
+				}
+
+				calculate_sort_data([&](uint32_t archetypeIdx, const SortCursor& cursor, uint32_t archetypeIdxMin,
+																const SortCursor& cursorMin) {
+					return keys[keyOffsets[archetypeIdx] + cursor.flat_row()] <
+								 keys[keyOffsets[archetypeIdxMin] + cursorMin.flat_row()];
+				});
+			}
+
 			//! Applies query entity sorting and rebuilds sorted chunk slices when needed.
 			void sort_entities() {
-				if (m_plan.ctx.data.sortByFunc == nullptr)
+				const auto& ctxData = m_plan.ctx.data;
+				if (!ctxData.has_sort())
 					return;
 
-				if ((m_plan.ctx.data.flags & QueryCtx::QueryFlags::SortEntities) == 0 && m_state.nonTrivial.sortVersion != 0)
+				if ((ctxData.flags & QueryCtx::QueryFlags::SortEntities) == 0 && m_state.nonTrivial.sortVersion != 0)
 					return;
 				m_plan.ctx.data.flags &= ~QueryCtx::QueryFlags::SortEntities;
 
-				// First, sort entities in archetypes
-				for (const auto* pArchetype: m_state.archetypeCache)
-					const_cast<Archetype*>(pArchetype)->sort_entities(m_plan.ctx.data.sortBy, m_plan.ctx.data.sortByFunc);
+				// First, sort entities in archetypes. Now that entites are sorted, we can start creating slices.
+				if (ctxData.sortByKeyFunc != nullptr) {
+					for (const auto* pArchetype: m_state.archetypeCache) {
+						const_cast<Archetype*>(pArchetype)->sort_entities_by_keys(
+								[&](const Chunk& chunk, uint32_t from, uint32_t cnt, uint64_t* pKeys) {
+									sort_keys(*pArchetype, chunk, from, cnt, pKeys);
+								});
+					}
+
+					calculate_sort_data_by_keys();
+				} else {
+					for (const auto* pArchetype: m_state.archetypeCache)
+						const_cast<Archetype*>(pArchetype)->sort_entities(ctxData.sortBy, ctxData.sortByFunc);
+
+					calculate_sort_data_by_func();
+				}
 
-				// Now that entites are sorted, we can start creating slices
-				calculate_sort_data();
 				m_state.nonTrivial.sortVersion = ::gaia::ecs::world_version(*world());
 			}
 
@@ -1846,6 +2344,44 @@ namespace gaia {
 				m_state.exec.compIndicesPending = false;
 			}
 
+			//! Returns the count()/empty() result stored for \a constraints when nothing it depends on changed since.
+			//! Rows only enter, leave or change their enabled state together with a world version bump, so the world
+			//! version, the enabled hierarchy version, pending archetype deletions and the result membership revision
+			//! together identify the matched rows.
+			//! \param constraints Entity-row subset of the request.
+			//! \param idxFrom First result-cache archetype index covered by the request.
+			//! \param idxTo One-past-the-end result-cache archetype index covered by the request.
+			//! \return Cached entry or nullptr when it is missing or outdated.
+			GAIA_NODISCARD const QueryState::CountCacheEntry*
+			try_cached_count(Constraints constraints, uint32_t idxFrom, uint32_t idxTo) const {
+				const auto& entry = m_state.exec.countCache[(uint32_t)constraints];
+				if (entry.worldVersion != ::gaia::ecs::world_version(*world()) ||
+						entry.enabledVersion != world_enabled_hierarchy_version(*world()) ||
+						entry.deleteVersion != world_archetype_delete_version(*world()) ||
+						entry.resultRevision != m_state.resultCacheRevision || entry.idxFrom != idxFrom || entry.idxTo != idxTo)
+					return nullptr;
+
+				return &entry;
+			}
+
+			//! Stores a count()/empty() result for \a constraints.
+			//! \param constraints Entity-row subset of the request.
+			//! \param idxFrom First result-cache archetype index covered by the request.
+			//! \param idxTo One-past-the-end result-cache archetype index covered by the request.
+			//! \param cnt Number of matching entities, or any non-zero value when only emptiness is known.
+			//! \param exact True when \a cnt is the exact count.
+			void cache_count(Constraints constraints, uint32_t idxFrom, uint32_t idxTo, uint32_t cnt, bool exact) {
+				auto& entry = m_state.exec.countCache[(uint32_t)constraints];
+				entry.worldVersion = ::gaia::ecs::world_version(*world());
+				entry.enabledVersion = world_enabled_hierarchy_version(*world());
+				entry.deleteVersion = world_archetype_delete_version(*world());
+				entry.resultRevision = m_state.resultCacheRevision;
+				entry.idxFrom = idxFrom;
+				entry.idxTo = idxTo;
+				entry.cnt = cnt;
+				entry.exact = exact;
+			}
+
 			//! Rebuilds flattened direct chunk cache when result membership, world structure, selected rows,
 			//! component-index mapping storage, or cached callback fields changed.
 			//!
@@ -2180,12 +2716,24 @@ namespace gaia {
 				m_state.seedArchetypeCache.push_back(pArchetype);
 			}
 
+			//! Adds an archetype matched at create time to the seed and result caches.
+			//! \param archetype Matched archetype.
+			//! \param assumeNew True when the caller knows the archetype is not present in the caches.
+			void add_created_archetype_to_caches(const Archetype& archetype, bool assumeNew) {
+				if (assumeNew)
+					add_new_archetype_to_immediate_caches(&archetype, true);
+				else {
+					add_archetype_to_seed_cache(&archetype, false);
+					add_archetype_to_cache(&archetype, true, false);
+				}
+			}
+
 			//! Adds a newly matched archetype to both immediate caches while reusing one computed index mapping.
 			//! \param pArchetype Newly matched archetype to cache.
 			//! \param trackMembershipChange True to bump result membership revision after insertion.
 			void add_new_archetype_to_immediate_caches(const Archetype* pArchetype, bool trackMembershipChange) {
 				GAIA_ASSERT(m_plan.ctx.data.groupBy == EntityBad);
-				GAIA_ASSERT(m_plan.ctx.data.sortByFunc == nullptr);
+				GAIA_ASSERT(!m_plan.ctx.data.has_sort());
 				GAIA_ASSERT(!m_state.seedArchetypeSet.contains(pArchetype));
 				GAIA_ASSERT(!m_state.archetypeSet.contains(pArchetype));
 
@@ -2236,7 +2784,7 @@ namespace gaia {
 			//! \param trackMembershipChange True to bump result membership revision after insertion.
 			//! \param assumeAbsent True when the caller already proved the archetype is not cached.
 			void add_archetype_to_cache(const Archetype* pArchetype, bool trackMembershipChange, bool assumeAbsent) {
-				if (m_plan.ctx.data.sortByFunc != nullptr)
+				if (m_plan.ctx.data.has_sort())
 					m_plan.ctx.data.flags |= QueryCtx::QueryFlags::SortEntities;
 
 				if (m_plan.ctx.data.groupBy != EntityBad)
@@ -2352,7 +2900,7 @@ namespace gaia {
 				if (archetypeIdx == BadIndex)
 					return true;
 
-				if (m_plan.ctx.data.sortByFunc != nullptr)
+				if (m_plan.ctx.data.has_sort())
 					m_plan.ctx.data.flags |= QueryCtx::QueryFlags::SortEntities;
 
 				core::swap_erase(m_state.archetypeCache, archetypeIdx);
@@ -2659,6 +3207,11 @@ namespace gaia {
 				return std::span{m_state.nonTrivial.archetypeSortData.data(), m_state.nonTrivial.archetypeSortData.size()};
 			}
 
+			//! Returns the world version at which the sorted chunk slices were last rebuilt.
+			GAIA_NODISCARD uint32_t sort_version() const {
+				return m_state.nonTrivial.sortVersion;
+			}
+
 			//! Returns cached group ranges, rebuilding grouped data when needed.
 			GAIA_NODISCARD std::span<const GroupData> group_data_view() const {
 				const_cast<QueryInfo*>(this)->ensure_group_data(true);
@@ -2691,6 +3244,11 @@ namespace gaia {
 				return m_testMatchPassCount;
 			}
 
+			//! Returns the number of variable-source subtree match passes executed by this query info.
+			GAIA_NODISCARD uint32_t test_subtree_match_pass_count() const {
+				return m_testSubtreeMatchPassCount;
+			}
+
 			//! Returns the current QueryInfo footprint for layout baseline tests.
 			GAIA_NODISCARD static constexpr uint32_t test_query_info_size() {
 				return (uint32_t)sizeof(QueryInfo);
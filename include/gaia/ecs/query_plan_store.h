@@ -0,0 +1,138 @@
+#pragma once
+#include "gaia/config/config.h"
+
+#include <cstdint>
+
+#include "gaia/cnt/darray.h"
+#include "gaia/cnt/map.h"
+#include "gaia/ecs/id.h"
+#include "gaia/ecs/query_common.h"
+#include "gaia/ser/ser_buffer_binary.h"
+#include "gaia/ser/ser_rt.h"
+#include "gaia/util/logging.h"
+
+//! \cond INTERNAL
+namespace gaia {
+	namespace ecs {
+		//! Compiled query plans carried over from a previous run, keyed by QueryCtx::Data::calc_plan_hash.
+		//! Each plan is an opaque blob written by QueryInfo::save_plan and consumed by QueryInfo::load_plan.
+		class QueryPlanStore {
+			static constexpr uint32_t Version = 1;
+
+			//! Serialized plans keyed by query-shape hash
+			cnt::map<QueryLookupHash, ser::ser_buffer_binary_dyn> m_plans;
+			//! Number of queries that were created from a stored plan
+			uint32_t m_hits = 0;
+
+			//! Identifies the layout of plans stored by this runtime.
+			GAIA_NODISCARD static uint32_t runtime_tag() {
+				return (uint32_t)MAX_ITEMS_IN_QUERY | (GAIA_ID(LastCoreComponent).id() << 8U);
+			}
+
+		public:
+			QueryPlanStore() = default;
+			QueryPlanStore(const QueryPlanStore&) = delete;
+			QueryPlanStore& operator=(const QueryPlanStore&) = delete;
+
+			//! Removes all stored plans.
+			void clear() {
+				m_plans.clear();
+				m_hits = 0;
+			}
+
+			//! Returns true when no plans are stored.
+			GAIA_NODISCARD bool empty() const {
+				return m_plans.empty();
+			}
+
+			//! Returns the number of stored plans.
+			GAIA_NODISCARD uint32_t size() const {
+				return (uint32_t)m_plans.size();
+			}
+
+			//! Returns the number of queries created from a stored plan since the plans were loaded.
+			GAIA_NODISCARD uint32_t hits() const {
+				return m_hits;
+			}
+
+			//! Records that a stored plan was used instead of compiling a query.
+			void add_hit() {
+				++m_hits;
+			}
+
+			//! Returns the plan stored under \a hash rewound to its beginning.
+			//! \param hash Plan hash.
+			//! \return Plan buffer, or nullptr if no plan is stored.
+			GAIA_NODISCARD ser::ser_buffer_binary_dyn* find(QueryLookupHash hash) {
+				const auto it = m_plans.find(hash);
+				if (it == m_plans.end())
+					return nullptr;
+
+				it->second.seek(0);
+				return &it->second;
+			}
+
+			//! Returns an empty plan buffer stored under \a hash, replacing any previous plan.
+			//! \param hash Plan hash.
+			//! \return Plan buffer to write to.
+			GAIA_NODISCARD ser::ser_buffer_binary_dyn& write(QueryLookupHash hash) {
+				auto& plan = m_plans[hash];
+				plan.reset();
+				return plan;
+			}
+
+			//! Writes all stored plans to \a s.
+			//! \param s Output serializer.
+			void save(ser::serializer& s) const {
+				s.save(Version);
+				s.save(runtime_tag());
+				s.save((uint32_t)m_plans.size());
+				for (const auto& it: m_plans) {
+					s.save(it.first.hash);
+					s.save(it.second.bytes());
+					s.save_raw(it.second.data(), it.second.bytes(), ser::serialization_type_id::u8);
+				}
+			}
+
+			//! Replaces the stored plans with the ones read from \a s.
+			//! \param s Input serializer positioned at data written by save().
+			//! \return False when the plans were written by an incompatible runtime. No plans are stored then.
+			bool load(ser::serializer& s) {
+				clear();
+
+				uint32_t version = 0;
+				s.load(version);
+				if (version != Version) {
+					GAIA_LOG_W("Query plans version %u is not supported. Expected %u.", version, Version);
+					return false;
+				}
+
+				uint32_t tag = 0;
+				s.load(tag);
+				if (tag != runtime_tag()) {
+					GAIA_LOG_W("Query plans were created by an incompatible runtime and are ignored.");
+					return false;
+				}
+
+				uint32_t cnt = 0;
+				s.load(cnt);
+				m_plans.reserve(cnt);
+				cnt::darray<uint8_t> bytes;
+				GAIA_FOR(cnt) {
+					QueryLookupHash::Type hash = 0;
+					s.load(hash);
+					uint32_t size = 0;
+					s.load(size);
+					bytes.resize(size);
+					s.load_raw(bytes.data(), size, ser::serialization_type_id::u8);
+
+					auto& plan = m_plans[{hash}];
+					plan.reset();
+					plan.save_raw(bytes.data(), size, ser::serialization_type_id::u8);
+				}
+				return true;
+			}
+		};
+	} // namespace ecs
+} // namespace gaia
+//! \endcond
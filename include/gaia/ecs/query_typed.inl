@@ -60,7 +60,7 @@ namespace gaia {
 #endif
 
 			inline void finish_typed_chunk_state(
-					World& world, Chunk* pChunk, uint16_t from, uint16_t to, const TypedQueryExecState& state);
+					World& world, Chunk* pChunk, ChunkRow from, ChunkRow to, const TypedQueryExecState& state);
 
 			inline void finish_typed_iter_state(QueryImpl& query, Iter& it, const TypedQueryExecState& state);
 
@@ -93,7 +93,7 @@ namespace gaia {
 
 			template <typename Func, typename... T>
 			inline void run_typed_sparse_chunk_rows(
-					Chunk* pChunk, uint16_t from, uint16_t to, Func& func, const TypedQueryExecState& state,
+					Chunk* pChunk, ChunkRow from, ChunkRow to, Func& func, const TypedQueryExecState& state,
 					core::func_type_list<T...> types);
 
 			template <typename Func, typename... T>
@@ -271,7 +271,7 @@ namespace gaia {
 							&queryInfo, it, &func, false,
 							[&](uint32_t row) {
 								finish_typed_chunk_state(
-										world, pChunk, (uint16_t)(it.row_begin() + row), (uint16_t)(it.row_begin() + row + 1), state);
+										world, pChunk, (ChunkRow)(it.row_begin() + row), (ChunkRow)(it.row_begin() + row + 1), state);
 							},
 							&invoke_typed_query_row_erased<
 									Func, std::tuple<decltype(std::declval<Iter&>().template sview_auto<T>())...>, T...>,
@@ -370,7 +370,7 @@ namespace gaia {
 			}
 
 			inline void finish_typed_chunk_state(
-					World& world, Chunk* pChunk, uint16_t from, uint16_t to, const TypedQueryExecState& state) {
+					World& world, Chunk* pChunk, ChunkRow from, ChunkRow to, const TypedQueryExecState& state) {
 				QueryImpl::finish_typed_chunk_writes_runtime(
 						world, pChunk, from, to, state.argIds, state.writeFlags, state.argCount, state.firstWriteArg,
 						state.sparseStores);
@@ -479,7 +479,7 @@ namespace gaia {
 			template <bool UseFilters, typename ContainerOut>
 			inline void run_typed_arr_rows(
 					QueryImpl& query, const QueryInfo& queryInfo, Iter& it, ContainerOut& outArray, uint32_t changedWorldVersion,
-					uint32_t archetypeIdx, const Archetype* pArchetype, Chunk* pChunk, uint16_t from, uint16_t to,
+					uint32_t archetypeIdx, const Archetype* pArchetype, Chunk* pChunk, ChunkRow from, ChunkRow to,
 					bool needsBarrierCache, bool canUseDirectChunkEval) {
 				using ContainerItemType = typename ContainerOut::value_type;
 				const bool barrierPasses = !needsBarrierCache || queryInfo.barrier_passes(archetypeIdx);
@@ -534,7 +534,7 @@ namespace gaia {
 			}
 
 			inline void QueryImpl::finish_typed_chunk_writes_runtime(
-					World& world, Chunk* pChunk, uint16_t from, uint16_t to, const Entity* pArgIds, const bool* pWriteFlags,
+					World& world, Chunk* pChunk, ChunkRow from, ChunkRow to, const Entity* pArgIds, const bool* pWriteFlags,
 					uint32_t argCnt, uint32_t firstWriteArg, void* const* pSparseStores) {
 				if (firstWriteArg >= argCnt || from >= to)
 					return;
@@ -550,7 +550,7 @@ namespace gaia {
 
 					seenTerms[seenCnt++] = term;
 					if (sparseStoreBound) {
-						for (uint16_t row = from; row < to; ++row)
+						for (ChunkRow row = from; row < to; ++row)
 							world_notify_on_set_entity(world, term, entities[row]);
 						return;
 					}
@@ -562,7 +562,7 @@ namespace gaia {
 						}
 					}
 
-					for (uint16_t row = from; row < to; ++row)
+					for (ChunkRow row = from; row < to; ++row)
 						world_finish_write(world, term, entities[row]);
 				};
 
@@ -576,7 +576,7 @@ namespace gaia {
 			}
 
 			template <typename... T>
-			inline void QueryImpl::finish_typed_chunk_writes(World& world, Chunk* pChunk, uint16_t from, uint16_t to) {
+			inline void QueryImpl::finish_typed_chunk_writes(World& world, Chunk* pChunk, ChunkRow from, ChunkRow to) {
 				TypedQueryArgMeta metas[MAX_ITEMS_IN_QUERY]{};
 				const auto argCount = init_typed_query_arg_metas(metas, world, core::func_type_list<T...>{});
 				Entity argIds[MAX_ITEMS_IN_QUERY]{};
@@ -653,7 +653,7 @@ namespace gaia {
 			//! \see run_typed_direct_chunk_rows(const TypedDirectChunkRun&, Func&, const TypedQueryExecState&,
 			//! core::func_type_list<T...>)
 			template <typename T, typename View>
-			GAIA_NODISCARD inline decltype(auto) typed_direct_chunk_arg_at(View& view, uint32_t row, uint16_t from) {
+			GAIA_NODISCARD inline decltype(auto) typed_direct_chunk_arg_at(View& view, uint32_t row, ChunkRow from) {
 				using U = typename actual_type_t<T>::Type;
 				if constexpr (mem::is_soa_layout_v<U>)
 					return view[from + row];
@@ -670,10 +670,10 @@ namespace gaia {
 			//! \param views Prepared direct chunk views.
 			//! \param row Row relative to the current chunk range.
 			//! \param from Absolute row offset of the current chunk range.
-			//! \see typed_direct_chunk_arg_at(View&, uint32_t, uint16_t)
+			//! \see typed_direct_chunk_arg_at(View&, uint32_t, ChunkRow)
 			template <typename Func, typename ViewsTuple, typename... T, size_t... I>
 			inline void invoke_typed_direct_chunk_row(
-					Func& func, ViewsTuple& views, uint32_t row, uint16_t from, core::func_type_list<T...>,
+					Func& func, ViewsTuple& views, uint32_t row, ChunkRow from, core::func_type_list<T...>,
 					std::index_sequence<I...>) {
 				func(typed_direct_chunk_arg_at<T>(std::get<I>(views), row, from)...);
 			}
@@ -688,9 +688,9 @@ namespace gaia {
 				//! Cached base data pointers for selected callback fields, or null when unavailable.
 				const void* const* pData = nullptr;
 				//! First absolute row to process.
-				uint16_t from = 0;
+				ChunkRow from = 0;
 				//! One-past-the-end absolute row to process.
-				uint16_t to = 0;
+				ChunkRow to = 0;
 			};
 
 			//! Runs a single typed argument over a direct chunk range without constructing a view tuple.
@@ -822,7 +822,7 @@ namespace gaia {
 
 			template <typename T>
 			GAIA_NODISCARD inline auto typed_sparse_chunk_view(
-					Chunk* pChunk, uint16_t from, uint16_t to, const TypedQueryExecState& state, uint32_t argIdx) {
+					Chunk* pChunk, ChunkRow from, ChunkRow to, const TypedQueryExecState& state, uint32_t argIdx) {
 				using U = typename actual_type_t<T>::Type;
 				if constexpr (auto_storage_policy_v<U> == DataStorageType::Sparse)
 					return TypedSparseQueryView<T>{pChunk->entity_view().data() + from, state.sparseStores[argIdx]};
@@ -831,7 +831,7 @@ namespace gaia {
 			}
 
 			template <typename T, typename View>
-			GAIA_NODISCARD inline decltype(auto) typed_sparse_chunk_arg_at(View& view, uint32_t row, uint16_t from) {
+			GAIA_NODISCARD inline decltype(auto) typed_sparse_chunk_arg_at(View& view, uint32_t row, ChunkRow from) {
 				using U = typename actual_type_t<T>::Type;
 				if constexpr (auto_storage_policy_v<U> == DataStorageType::Sparse)
 					return view[row];
@@ -841,7 +841,7 @@ namespace gaia {
 
 			template <typename Func, typename... T, size_t... I>
 			inline void run_typed_sparse_chunk_rows_impl(
-					Chunk* pChunk, uint16_t from, uint16_t to, Func& func, const TypedQueryExecState& state,
+					Chunk* pChunk, ChunkRow from, ChunkRow to, Func& func, const TypedQueryExecState& state,
 					core::func_type_list<T...>, std::index_sequence<I...>) {
 				auto views = std::make_tuple(typed_sparse_chunk_view<T>(pChunk, from, to, state, (uint32_t)I)...);
 				const auto cnt = (uint32_t)(to - from);
@@ -851,7 +851,7 @@ namespace gaia {
 
 			template <typename Func, typename... T>
 			inline void run_typed_sparse_chunk_rows(
-					Chunk* pChunk, uint16_t from, uint16_t to, Func& func, const TypedQueryExecState& state,
+					Chunk* pChunk, ChunkRow from, ChunkRow to, Func& func, const TypedQueryExecState& state,
 					core::func_type_list<T...> types) {
 				run_typed_sparse_chunk_rows_impl(pChunk, from, to, func, state, types, std::index_sequence_for<T...>{});
 			}
@@ -1182,6 +1182,7 @@ namespace gaia {
 					}
 				}
 
+				DenseChunkPrefetcher prefetcher(queryInfo, plan.idxFrom, plan.idxTo);
 				for (uint32_t i = plan.idxFrom; i < plan.idxTo; ++i) {
 					const auto* pArchetype = cacheView[i];
 					if (canSkipProcessCheck) {
@@ -1195,7 +1196,10 @@ namespace gaia {
 						indicesView = queryInfo.indices_mapping_view(i);
 
 					const auto& chunks = pArchetype->chunks();
-					for (auto* pChunk: chunks) {
+					GAIA_EACH_(chunks, j) {
+						auto* pChunk = chunks[j];
+						prefetcher.step(i, j);
+
 						const auto from = Iter::start_index(pChunk);
 						const auto to = Iter::end_index(pChunk);
 						if GAIA_UNLIKELY (from == to)
@@ -1236,13 +1240,17 @@ namespace gaia {
 				Iter it;
 				it.init_query_state(queryInfo.world(), Constraints::EnabledOnly, false);
 				const Archetype* pLastArchetype = nullptr;
+				DenseChunkPrefetcher prefetcher(queryInfo, plan.idxFrom, plan.idxTo);
 				for (uint32_t i = plan.idxFrom; i < plan.idxTo; ++i) {
 					const auto* pArchetype = cacheView[i];
 					if GAIA_UNLIKELY (!can_process_archetype_inter(queryInfo, *pArchetype, Constraints::EnabledOnly))
 						continue;
 
 					const auto& chunks = pArchetype->chunks();
-					for (auto* pChunk: chunks) {
+					GAIA_EACH_(chunks, j) {
+						auto* pChunk = chunks[j];
+						prefetcher.step(i, j);
+
 						const auto from = Iter::start_index(pChunk);
 						const auto to = Iter::end_index(pChunk);
 						if GAIA_UNLIKELY (from == to)
@@ -1286,6 +1294,7 @@ namespace gaia {
 				it.init_query_state(queryInfo.world(), Constraints::EnabledOnly, false);
 				const Archetype* pLastArchetype = nullptr;
 
+				DenseChunkPrefetcher prefetcher(queryInfo, plan.idxFrom, plan.idxTo);
 				for (uint32_t i = plan.idxFrom; i < plan.idxTo; ++i) {
 					const auto* pArchetype = cacheView[i];
 					if GAIA_UNLIKELY (!can_process_archetype_inter(queryInfo, *pArchetype, Constraints::EnabledOnly))
@@ -1296,7 +1305,10 @@ namespace gaia {
 						indicesView = queryInfo.indices_mapping_view(i);
 
 					const auto& chunks = pArchetype->chunks();
-					for (auto* pChunk: chunks) {
+					GAIA_EACH_(chunks, j) {
+						auto* pChunk = chunks[j];
+						prefetcher.step(i, j);
+
 						const auto from = Iter::start_index(pChunk);
 						const auto to = Iter::end_index(pChunk);
 						if GAIA_UNLIKELY (from == to)
@@ -1367,7 +1379,7 @@ namespace gaia {
 				TypedQueryArgMeta metas[MAX_ITEMS_IN_QUERY]{};
 				const auto argCount = init_typed_query_arg_metas(metas, world, InputArgs{});
 				const auto state = build_typed_query_exec_state(world, queryInfo, metas, argCount);
-				const auto plan = prepare_query_plan(queryInfo, state);
+				const auto plan = prepare_query_plan_prof(queryInfo, state);
 				if constexpr (ExecType == QueryExecType::Default) {
 					if constexpr (typed_query_arg_list_uses_sparse_storage_v<InputArgs>) {
 						if (plan.mode == QueryPlanMode::EntitySeed) {
@@ -1402,9 +1414,10 @@ namespace gaia {
 
 			inline void QueryImpl::each_typed_erased(
 					QueryExecType execType, void* pFunc, const TypedQueryExecState& state, const TypedQueryErasedOps& ops) {
+				ProfileRun profileRun(*this);
 				auto& queryInfo = fetch();
 				match_all(queryInfo);
-				const auto plan = prepare_query_plan(queryInfo, state);
+				const auto plan = prepare_query_plan_prof(queryInfo, state);
 				if (execType == QueryExecType::Default && ops.runSparsePlan != nullptr &&
 						(plan.mode == QueryPlanMode::SparseDense || plan.mode == QueryPlanMode::EntitySeed)) {
 					ops.runSparsePlan(*this, queryInfo, plan, pFunc, state);
@@ -1434,6 +1447,7 @@ namespace gaia {
 
 			template <typename Func, std::enable_if_t<!detail::is_query_iter_callback_v<Func>, int>>
 			inline void QueryImpl::each(Func func, QueryExecType execType) {
+				ProfileRun profileRun(*this);
 				auto& queryInfo = fetch();
 				match_all(queryInfo);
 
@@ -1482,9 +1496,10 @@ namespace gaia {
 					QueryExecType execType, void* pFunc, const TypedQueryExecState& state,
 					void (*runDirectFastChunk)(QueryImpl&, Iter&, void*, const TypedQueryExecState&),
 					void (*runMappedChunk)(QueryImpl&, const QueryInfo&, Iter&, void*, const TypedQueryExecState&)) {
+				ProfileRun profileRun(*this);
 				auto& queryInfo = fetch();
 				match_all(queryInfo);
-				const auto plan = prepare_query_plan(queryInfo, state);
+				const auto plan = prepare_query_plan_prof(queryInfo, state);
 
 				switch (execType) {
 					case QueryExecType::Parallel:
@@ -1718,9 +1733,9 @@ namespace gaia {
 							continue;
 
 						const auto viewFrom = view.startRow;
-						const auto viewTo = (uint16_t)(view.startRow + view.count);
-						uint16_t minStartRow = 0;
-						uint16_t minEndRow = 0;
+						const auto viewTo = (ChunkRow)(view.startRow + view.count);
+						ChunkRow minStartRow = 0;
+						ChunkRow minEndRow = 0;
 						chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
 						const auto startRow = core::get_max(minStartRow, viewFrom);
 						const auto endRow = core::get_min(minEndRow, viewTo);
@@ -1742,8 +1757,8 @@ namespace gaia {
 
 					const auto& chunks = pArchetype->chunks();
 					for (auto* pChunk: chunks) {
-						uint16_t from = 0;
-						uint16_t to = 0;
+						ChunkRow from = 0;
+						ChunkRow to = 0;
 						chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
 						run_typed_arr_rows<UseFilters>(
 								*this, queryInfo, it, outArray, m_changedWorldVersion, i, pArchetype, pChunk, from, to,
@@ -1754,6 +1769,7 @@ namespace gaia {
 
 			template <typename Container>
 			inline void QueryImpl::arr(Container& outArray, Constraints constraints) {
+				ProfileRun profileRun(*this);
 				const auto entCnt = count(constraints);
 				if (entCnt == 0)
 					return;
@@ -1769,6 +1785,229 @@ namespace gaia {
 					arr_inter<false>(queryInfo, outArray, constraints);
 				}
 			}
+
+			inline void QueryImpl::cursor_revalidate(const QueryInfo& queryInfo, QueryCursor& cursor) {
+				if (cursor.m_archetypeId == ArchetypeIdBad)
+					return;
+
+				const auto cacheView = queryInfo.cache_archetype_view();
+				const auto cacheCnt = (uint32_t)cacheView.size();
+				if (cursor.m_cacheIdx >= cacheCnt || cacheView[cursor.m_cacheIdx]->id() != cursor.m_archetypeId) {
+					// The cache was reordered or the archetype left it. Look it up by id.
+					uint32_t idx = 0;
+					for (; idx < cacheCnt; ++idx) {
+						if (cacheView[idx]->id() == cursor.m_archetypeId)
+							break;
+					}
+
+					if (idx == cacheCnt) {
+						// The archetype is gone. Whatever took its place is iterated from the start.
+						cursor.m_chunkIdx = 0;
+						cursor.m_row = 0;
+						cursor.m_archetypeId = ArchetypeIdBad;
+						cursor.m_pChunk = nullptr;
+						cursor.m_stale = true;
+						return;
+					}
+
+					cursor.m_cacheIdx = idx;
+				}
+
+				const auto& chunks = cacheView[cursor.m_cacheIdx]->chunks();
+				const auto chunkCnt = (uint32_t)chunks.size();
+				if (cursor.m_chunkIdx >= chunkCnt || chunks[cursor.m_chunkIdx] != cursor.m_pChunk) {
+					uint32_t idx = 0;
+					for (; idx < chunkCnt; ++idx) {
+						if (chunks[idx] == cursor.m_pChunk)
+							break;
+					}
+
+					if (idx == chunkCnt) {
+						cursor.m_row = 0;
+						cursor.m_pChunk = nullptr;
+						cursor.m_stale = true;
+						return;
+					}
+
+					cursor.m_chunkIdx = idx;
+				}
+
+				// Rows were added, removed or reordered since the last call. Keep the row index, it is the best guess.
+				if (cursor.m_row != 0 && cursor.m_pChunk->entity_order_changed(cursor.m_worldVersion))
+					cursor.m_stale = true;
+			}
+
+			template <bool UseFilters, typename ContainerOut>
+			inline void QueryImpl::next_inter(
+					QueryInfo& queryInfo, QueryCursor& cursor, ContainerOut& outArray, uint32_t maxRows,
+					Constraints constraints) {
+				using ContainerItemType = typename ContainerOut::value_type;
+				const auto sizeBefore = (uint32_t)outArray.size();
+				const auto added = [&]() {
+					return (uint32_t)outArray.size() - sizeBefore;
+				};
+
+				const auto cacheRange = selected_query_cache_range(queryInfo);
+				if (!cacheRange.valid) {
+					cursor.m_done = true;
+					return;
+				}
+
+				if constexpr (!UseFilters) {
+					if (!cacheRange.hasSelectedGroup && can_use_direct_entity_seed_eval(queryInfo)) {
+						// Entities are not visited in chunk order here, so the position is the number of entities
+						// returned so far and the seed is walked from its beginning.
+						auto& world = *queryInfo.world();
+						const auto plan = direct_entity_seed_plan(world, queryInfo);
+						const auto skipCnt = cursor.m_row;
+						uint32_t seenCnt = 0;
+						bool hasMore = false;
+						const auto push = [&](Entity entity) {
+							if (seenCnt++ < skipCnt)
+								return true;
+							if (added() == maxRows) {
+								hasMore = true;
+								return false;
+							}
+							typed_arr_push(world, entity, outArray);
+							return true;
+						};
+
+						if (plan.preferOrSeed) {
+							for_each_direct_or_union(world, queryInfo, constraints, [&](Entity entity) {
+								(void)push(entity);
+							});
+						} else {
+							(void)for_each_direct_all_seed(world, queryInfo, plan, constraints, push);
+						}
+
+						cursor.m_row += added();
+						cursor.m_done = !hasMore;
+						return;
+					}
+				}
+
+				auto& world = *queryInfo.world();
+				const auto meta = typed_query_arg_meta<ContainerItemType>(world);
+				const DirectChunkArgEvalDesc desc{meta.termId, meta.isEntity, meta.isPair, meta.usesSparseStorage};
+				Iter it;
+				it.init_query_state(queryInfo.world(), constraints, false);
+				const bool canUseDirectChunkEval = !UseFilters && !queryInfo.has_entity_filter_terms() &&
+																					 can_use_direct_chunk_term_eval_descs(world, queryInfo, &desc, 1) &&
+																					 can_use_direct_chunk_iteration_fastpath(queryInfo);
+				const auto cacheView = queryInfo.cache_archetype_view();
+				const bool needsBarrierCache = needs_depth_order_hierarchy_barrier_cache(queryInfo, constraints);
+				const bool hasSortedArrayPayload = queryInfo.has_sorted_payload() || needsBarrierCache;
+				const auto sortView =
+						hasSortedArrayPayload ? queryInfo.cache_sort_view() : decltype(queryInfo.cache_sort_view()){};
+				if (needsBarrierCache)
+					queryInfo.ensure_depth_order_hierarchy_barrier_cache();
+				const auto idxFrom = cacheRange.idxFrom;
+				const auto idxTo = cacheRange.idxTo;
+
+				// Appends rows [row, to) of a chunk until the output is full.
+				// Returns false when the output filled up before reaching the end of the range.
+				const auto push_rows = [&](uint32_t archetypeIdx, Chunk* pChunk, uint32_t& row, uint32_t to) {
+					while (row < to) {
+						if (added() == maxRows)
+							return false;
+
+						const auto cnt = core::get_min(to - row, maxRows - added());
+						run_typed_arr_rows<UseFilters>(
+								*this, queryInfo, it, outArray, m_changedWorldVersion, archetypeIdx, cacheView[archetypeIdx], pChunk,
+								(ChunkRow)row, (ChunkRow)(row + cnt), needsBarrierCache, canUseDirectChunkEval);
+						row += cnt;
+					}
+					return true;
+				};
+
+				if (!sortView.empty()) {
+					if (cursor.m_sortVersion != queryInfo.sort_version()) {
+						// The slices were rebuilt. The position is kept but it now points at different entities.
+						if (cursor.m_cacheIdx != 0 || cursor.m_row != 0)
+							cursor.m_stale = true;
+						cursor.m_sortVersion = queryInfo.sort_version();
+					}
+
+					const auto viewCnt = (uint32_t)sortView.size();
+					for (; cursor.m_cacheIdx < viewCnt; ++cursor.m_cacheIdx, cursor.m_row = 0) {
+						const auto& view = sortView[cursor.m_cacheIdx];
+						if (view.archetypeIdx < idxFrom || view.archetypeIdx >= idxTo)
+							continue;
+
+						const bool barrierPasses = !needsBarrierCache || queryInfo.barrier_passes(view.archetypeIdx);
+						if GAIA_UNLIKELY (!can_process_archetype_inter(
+																	queryInfo, *cacheView[view.archetypeIdx], constraints, barrierPasses))
+							continue;
+
+						ChunkRow minStartRow = 0;
+						ChunkRow minEndRow = 0;
+						chunk_effective_range(view.pChunk, constraints, needsBarrierCache, barrierPasses, minStartRow, minEndRow);
+						uint32_t row = core::get_max((uint32_t)minStartRow, (uint32_t)view.startRow + cursor.m_row);
+						const uint32_t endRow = core::get_min((uint32_t)minEndRow, (uint32_t)(view.startRow + view.count));
+						if (!push_rows(view.archetypeIdx, view.pChunk, row, endRow)) {
+							cursor.m_row = row - view.startRow;
+							return;
+						}
+					}
+
+					cursor.m_done = true;
+					return;
+				}
+
+				cursor_revalidate(queryInfo, cursor);
+				if (cursor.m_cacheIdx < idxFrom) {
+					cursor.m_cacheIdx = idxFrom;
+					cursor.m_chunkIdx = 0;
+					cursor.m_row = 0;
+				}
+
+				for (; cursor.m_cacheIdx < idxTo; ++cursor.m_cacheIdx, cursor.m_chunkIdx = 0, cursor.m_row = 0) {
+					const auto* pArchetype = cacheView[cursor.m_cacheIdx];
+					const bool barrierPasses = !needsBarrierCache || queryInfo.barrier_passes(cursor.m_cacheIdx);
+					if GAIA_UNLIKELY (!can_process_archetype_inter(queryInfo, *pArchetype, constraints, barrierPasses))
+						continue;
+
+					const auto& chunks = pArchetype->chunks();
+					const auto chunkCnt = (uint32_t)chunks.size();
+					for (; cursor.m_chunkIdx < chunkCnt; ++cursor.m_chunkIdx, cursor.m_row = 0) {
+						auto* pChunk = chunks[cursor.m_chunkIdx];
+						ChunkRow from = 0;
+						ChunkRow to = 0;
+						chunk_effective_range(pChunk, constraints, needsBarrierCache, barrierPasses, from, to);
+						uint32_t row = core::get_max((uint32_t)from, cursor.m_row);
+						if (!push_rows(cursor.m_cacheIdx, pChunk, row, to)) {
+							cursor.m_row = row;
+							cursor.m_archetypeId = pArchetype->id();
+							cursor.m_pChunk = pChunk;
+							return;
+						}
+					}
+				}
+
+				cursor.m_done = true;
+			}
+
+			template <typename Container>
+			inline uint32_t QueryImpl::next(QueryCursor& cursor, Container& outArray, uint32_t maxRows, Constraints constraints) {
+				if (cursor.m_done || maxRows == 0)
+					return 0;
+
+				auto& queryInfo = fetch();
+				match_all(queryInfo);
+
+				const auto sizeBefore = (uint32_t)outArray.size();
+				if (queryInfo.has_filters())
+					next_inter<true>(queryInfo, cursor, outArray, maxRows, constraints);
+				else
+					next_inter<false>(queryInfo, cursor, outArray, maxRows, constraints);
+
+				// Bump the world version so chunks reordered after this call report a newer entity-order version
+				// than the one remembered by the cursor.
+				cursor.m_worldVersion = *m_worldVersion;
+				::gaia::ecs::update_version(*m_worldVersion);
+				return (uint32_t)outArray.size() - sizeBefore;
+			}
 			//! \endcond
 		} // namespace detail
 	} // namespace ecs
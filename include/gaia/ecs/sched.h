@@ -63,6 +63,10 @@ namespace gaia {
 			QueryExecType execType{};
 			//! Scheduler flags describing non-default execution requirements.
 			SchedFlags flags = SchedFlags::Default;
+			//! Optional NUMA node hint of an item. Items of the same node are expected to be stored next to each other.
+			//! When set, the default scheduler never groups items of different nodes into one job and prefers
+			//! running each job on a worker of its items' node. Custom schedulers are free to ignore it.
+			uint8_t (*numa_node)(void* pCtx, uint32_t idx) = nullptr;
 		};
 
 		//! Scheduler descriptor used by ECS runtime code.
@@ -309,22 +313,46 @@ namespace gaia {
 						groupSize = 1;
 				}
 
-				const auto jobs = (pDesc->itemCount + groupSize - 1) / groupSize;
+				// With NUMA hints, a job never spans items of different nodes
+				const bool useNuma = pDesc->numa_node != nullptr && mt::numa_node_cnt() > 1;
+				auto group_end = [&](uint32_t idxStart) {
+					const uint32_t idxEnd = core::get_min(idxStart + groupSize, pDesc->itemCount);
+					if (!useNuma)
+						return idxEnd;
+
+					const auto node = pDesc->numa_node(pDesc->pCtx, idxStart);
+					for (uint32_t i = idxStart + 1; i < idxEnd; ++i) {
+						if (pDesc->numa_node(pDesc->pCtx, i) != node)
+							return i;
+					}
+					return idxEnd;
+				};
+
+				uint32_t jobs = (pDesc->itemCount + groupSize - 1) / groupSize;
+				if (useNuma) {
+					jobs = 0;
+					for (uint32_t idxStart = 0; idxStart < pDesc->itemCount; idxStart = group_end(idxStart))
+						++jobs;
+				}
+
 				auto* pData = new SchedTokenDefData();
 				pData->kind = SchedTokenKind::Parallel;
 				pData->handles.resize(jobs + 1);
 
+				uint32_t idxStart = 0;
 				for (uint32_t jobIndex = 0; jobIndex < jobs; ++jobIndex) {
-					const uint32_t idxStart = jobIndex * groupSize;
-					const uint32_t idxEnd = core::get_min(idxStart + groupSize, pDesc->itemCount);
+					const uint32_t idxEnd = group_end(idxStart);
 
 					mt::Job job;
 					job.priority = prio;
 					job.flags = job_creation_flags(pDesc->flags);
+					if (useNuma)
+						job.numaNode = pDesc->numa_node(pDesc->pCtx, idxStart);
 					job.func = [desc = *pDesc, idxStart, idxEnd]() {
 						desc.invoke(desc.pCtx, idxStart, idxEnd);
 					};
 					pData->handles[jobIndex] = tp.add(GAIA_MOV(job));
+					idxStart = idxEnd;
 				}
 				{
 					mt::Job syncJob;
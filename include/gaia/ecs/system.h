@@ -2,6 +2,7 @@
 #include "gaia/config/config.h"
 
 #include "gaia/cnt/map.h"
+#include "gaia/cnt/set.h"
 #include "gaia/ecs/id.h"
 #include "gaia/ecs/query.h"
 #include "gaia/util/move_func.h"
@@ -21,22 +22,28 @@ namespace gaia {
 				//! Run the system immediately and return an empty scheduler job.
 				Immediate,
 				//! Prepare scheduler work and return it without submitting it.
-				DeferredJob
+				DeferredJob,
+				//! Run the callback on the single chunk already prepared in the passed iterator.
+				//! Used by fused phase execution. Only valid when SystemRuntimeData::chunk_runnable is set.
+				Chunk
 			};
 
 			//! Type-erased callback used for immediate and deferred system execution.
 			//!
 			//! The callback receives the system's underlying query, execution mode, and requested run mode. Immediate runs
 			//! execute the stored query callback directly and return an empty SchedJob. Deferred runs add a
-			//! scheduler-agnostic job wrapper from the same stored callback object. Per-system user context is stored on the
-			//! query itself and is visible to iterator callbacks through Iter::ctx().
+			//! scheduler-agnostic job wrapper from the same stored callback object. Chunk runs invoke the callback on the
+			//! iterator passed as the last argument, which is null for the other run modes. Per-system user context is
+			//! stored on the query itself and is visible to iterator callbacks through Iter::ctx().
 			//! \see QueryImpl::ctx(void*)
 			//! \see QueryImpl::job(Func, QueryExecType)
 			//! \see Iter::ctx() const
-			using TSystemRunFunc = util::MoveFunc<SchedJob(Query&, QueryExecType, RunMode)>;
+			using TSystemRunFunc = util::MoveFunc<SchedJob(Query&, QueryExecType, RunMode, Iter*)>;
 
 			//! Called when the system runs immediately or is added as deferred scheduler work.
 			TSystemRunFunc on_each_func;
+			//! True when on_each_func supports RunMode::Chunk and the system can take part in fused phase execution.
+			bool chunk_runnable = false;
 		};
 
 		//! Runtime storage for system callbacks kept outside ECS component storage.
@@ -46,6 +53,8 @@ namespace gaia {
 		//! \see SystemRuntimeData
 		class SystemRegistry {
 			cnt::map<EntityLookupKey, SystemRuntimeData> m_system_data;
+			//! Phases whose serial systems run fused chunk passes.
+			cnt::set<EntityLookupKey> m_fused_phases;
 
 		public:
 			//! Clears all registered system callbacks.
@@ -58,6 +67,7 @@ namespace gaia {
 				}
 
 				m_system_data = {};
+				m_fused_phases = {};
 			}
 
 			//! Creates or returns runtime data for a system entity.
@@ -107,6 +117,24 @@ namespace gaia {
 				return *pData;
 			}
 
+			//! Enables or disables fused execution for a phase.
+			//! \param phase Phase entity.
+			//! \param enable True to fuse the phase's serial systems.
+			//! \see World::phase_fusion(Entity, bool)
+			void phase_fusion(Entity phase, bool enable) {
+				if (enable)
+					m_fused_phases.insert(EntityLookupKey(phase));
+				else
+					m_fused_phases.erase(EntityLookupKey(phase));
+			}
+
+			//! Returns whether fused execution is enabled for a phase.
+			//! \param phase Phase entity.
+			//! \return True when the phase's serial systems run fused chunk passes.
+			GAIA_NODISCARD bool phase_fusion(Entity phase) const {
+				return !m_fused_phases.empty() && m_fused_phases.contains(EntityLookupKey(phase));
+			}
+
 			//! Deletes runtime data for a system entity.
 			//! \param system Entity carrying the System_ component.
 			//!
@@ -70,7 +70,7 @@ namespace gaia {
 				if (pRuntime == nullptr || !pRuntime->on_each_func)
 					return;
 
-				static_cast<void>(pRuntime->on_each_func(query, execType, SystemRuntimeData::RunMode::Immediate));
+				static_cast<void>(pRuntime->on_each_func(query, execType, SystemRuntimeData::RunMode::Immediate, nullptr));
 			}
 
 			//! Returns the job handle associated with the system.
@@ -108,7 +108,7 @@ namespace gaia {
 				if (pRuntime == nullptr || !pRuntime->on_each_func)
 					return {};
 
-				return pRuntime->on_each_func(query, execType, SystemRuntimeData::RunMode::DeferredJob);
+				return pRuntime->on_each_func(query, execType, SystemRuntimeData::RunMode::DeferredJob, nullptr);
 			}
 
 			//! Disables automatic System_ serialization.
@@ -608,15 +608,21 @@ namespace gaia {
 				validate();
 
 				auto& runtime = runtime_data();
-				runtime.on_each_func = [func](Query& query, QueryExecType execType, SystemRuntimeData::RunMode mode) mutable {
+				runtime.on_each_func = [func](
+																	 Query& query, QueryExecType execType, SystemRuntimeData::RunMode mode, Iter* pIt) mutable {
 					if (mode == SystemRuntimeData::RunMode::DeferredJob)
 						return query.job(func, execType);
+					if (mode == SystemRuntimeData::RunMode::Chunk) {
+						func(*pIt);
+						return SchedJob{};
+					}
 
 					query.each_runtime_erased(
 							execType, static_cast<void*>(&func), &detail::QueryImpl::template invoke_runtime_iter<Func, Iter>,
 							Constraints::EnabledOnly);
 					return SchedJob{};
 				};
+				runtime.chunk_runnable = true;
 
 				return (SystemBuilder&)*this;
 			}
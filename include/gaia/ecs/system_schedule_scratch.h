@@ -121,6 +121,8 @@ namespace gaia {
 				World* pWorld = nullptr;
 				//! Pending scheduler jobs in the current phase/system-dependency batch.
 				cnt::darray<PendingSystemJob>* pPending = nullptr;
+				//! Serial systems waiting for one fused chunk pass in the current batch.
+				cnt::darray<Entity>* pFused = nullptr;
 				//! Current scheduling batch key.
 				SystemScheduleItem current{};
 				//! True once \a current has been initialized.
@@ -182,23 +182,32 @@ namespace gaia {
 			const bool needsTypedEntityAccess =
 					execState.hasInheritedTerms || typed_query_arg_list_uses_sparse_storage_v<InputArgs>;
 			if (needsTypedEntityAccess) {
-				runtime.on_each_func = [func, execState,
-																ops](Query& query, QueryExecType execType, SystemRuntimeData::RunMode mode) mutable {
+				// Inherited and sparse arguments are resolved per entity, so these systems cannot run chunk by chunk
+				runtime.on_each_func = [func, execState, ops](
+																	 Query& query, QueryExecType execType, SystemRuntimeData::RunMode mode, Iter* pIt) mutable {
+					GAIA_ASSERT(mode != SystemRuntimeData::RunMode::Chunk);
+					(void)pIt;
 					if (mode == SystemRuntimeData::RunMode::DeferredJob)
 						return query.job(func, execType);
 
 					query.each_typed_erased(execType, &func, execState, ops);
 					return SchedJob{};
 				};
+				runtime.chunk_runnable = false;
 			} else {
 				runtime.on_each_func = [func, execState, runDirectFastChunk, runMappedChunk](
-																	 Query& query, QueryExecType execType, SystemRuntimeData::RunMode mode) mutable {
+																	 Query& query, QueryExecType execType, SystemRuntimeData::RunMode mode, Iter* pIt) mutable {
 					if (mode == SystemRuntimeData::RunMode::DeferredJob)
 						return query.job(func, execType);
+					if (mode == SystemRuntimeData::RunMode::Chunk) {
+						query.each_iter_erased(*pIt, &func, execState, runDirectFastChunk, runMappedChunk);
+						return SchedJob{};
+					}
 
 					query.each_iter_erased(execType, &func, execState, runDirectFastChunk, runMappedChunk);
 					return SchedJob{};
 				};
+				runtime.chunk_runnable = true;
 			}
 
 			return *this;
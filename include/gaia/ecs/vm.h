@@ -19,6 +19,7 @@
 #include "gaia/ecs/query_mask.h"
 #include "gaia/ecs/query_match_stamps.h"
 #include "gaia/ser/ser_binary.h"
+#include "gaia/ser/ser_buffer_binary.h"
 #include "gaia/util/str.h"
 
 namespace gaia {
@@ -95,6 +96,8 @@ namespace gaia {
 				EntitySpan targetEntities;
 				//! entity -> archetypes lookup used to seed structural candidate archetypes
 				ArchetypeLookupView archetypeLookup;
+				//! entity -> archetypes lookup used to find variable sources. Falls back to archetypeLookup when empty.
+				ArchetypeLookupView srcLookup;
 				//! Array of all archetypes in the world
 				std::span<const Archetype*> allArchetypes;
 				//! Array of already matches archetypes. Reset before each exec().
@@ -194,6 +197,10 @@ namespace gaia {
 				return ArchetypeLookupView{&map, &versions, fetch_archetypes_for_select_from_map};
 			}
 
+			inline ArchetypeLookupView make_archetype_lookup_view(const EntityToArchetypeMap& map) {
+				return ArchetypeLookupView{&map, nullptr, fetch_archetypes_for_select_from_map};
+			}
+
 			inline ArchetypeLookupView make_archetype_lookup_view(const SingleArchetypeLookup& map) {
 				return ArchetypeLookupView{&map, nullptr, fetch_archetypes_for_select_from_single};
 			}
@@ -477,6 +484,33 @@ namespace gaia {
 					}
 				}
 
+				//! Writes the matching-relevant fields of \a term. Entities are stored as raw ids without load remapping.
+				inline void save_query_term(ser::ser_buffer_binary_dyn& s, const QueryTerm& term) {
+					s.save(term.id.value());
+					s.save(term.src.value());
+					s.save(term.entTrav.value());
+					s.save(term.travKind);
+					s.save(term.travDepth);
+					s.save(term.matchKind);
+					s.save(term.op);
+				}
+
+				//! Reads a term written by save_query_term().
+				inline void load_query_term(ser::ser_buffer_binary_dyn& s, QueryTerm& term) {
+					Identifier value = IdentifierBad;
+					s.load(value);
+					term.id = Entity(value);
+					s.load(value);
+					term.src = Entity(value);
+					s.load(value);
+					term.entTrav = Entity(value);
+					s.load(term.travKind);
+					s.load(term.travDepth);
+					s.load(term.matchKind);
+					s.load(term.op);
+					term.srcArchetype = nullptr;
+				}
+
 				template <typename SourceTermsArray>
 				inline void sort_src_terms_by_cost(SourceTermsArray& terms) {
 					const auto cnt = (uint32_t)terms.size();
@@ -917,6 +951,63 @@ namespace gaia {
 					return match_res<OpOr>(archetype, EntitySpan{ids, 1});
 				}
 
+				//! Checks whether all ids in \a queryIds are present in \a archetypeIds.
+				//! Both spans need to be sorted by SortComponentCond. Matching is a single merge pass.
+				//! \param archetypeIds Sorted archetype ids
+				//! \param queryIds Sorted query ids
+				//! \return True if every query id is present in the archetype.
+				GAIA_NODISCARD inline bool match_sorted_ids_all(EntitySpan archetypeIds, EntitySpan queryIds) {
+					const auto cntArchetype = (uint32_t)archetypeIds.size();
+					uint32_t j = 0;
+					for (const auto id: queryIds) {
+						while (j < cntArchetype && SortComponentCond{}(archetypeIds[j], id))
+							++j;
+						if (j == cntArchetype || archetypeIds[j] != id)
+							return false;
+					}
+					return true;
+				}
+
+				//! Checks whether at least one id in \a queryIds is present in \a archetypeIds.
+				//! Both spans need to be sorted by SortComponentCond. Matching is a single merge pass.
+				//! \param archetypeIds Sorted archetype ids
+				//! \param queryIds Sorted query ids
+				//! \return True on the first shared id, false otherwise.
+				GAIA_NODISCARD inline bool match_sorted_ids_any(EntitySpan archetypeIds, EntitySpan queryIds) {
+					const auto cntArchetype = (uint32_t)archetypeIds.size();
+					const auto cntQuery = (uint32_t)queryIds.size();
+					uint32_t i = 0;
+					uint32_t j = 0;
+					while (i < cntQuery && j < cntArchetype) {
+						const auto idQuery = queryIds[i];
+						const auto idArchetype = archetypeIds[j];
+						if (idQuery == idArchetype)
+							return true;
+						if (SortComponentCond{}(idQuery, idArchetype))
+							++i;
+						else
+							++j;
+					}
+					return false;
+				}
+
+				//! Fused matcher for queries made of plain ALL, OR and NOT ids. Exact pairs are supported,
+				//! wildcards and Is semantics are not. Evaluates the terms directly on the sorted archetype ids
+				//! without going through the opcode dispatch of the virtual machine.
+				//! \param archetypeIds Sorted archetype ids
+				//! \param idsAll Sorted ids of ALL terms
+				//! \param idsOr Sorted ids of OR terms
+				//! \param idsNot Sorted ids of NOT terms
+				//! \return True if the archetype satisfies the terms.
+				GAIA_NODISCARD inline bool
+				match_sorted_ids(EntitySpan archetypeIds, EntitySpan idsAll, EntitySpan idsOr, EntitySpan idsNot) {
+					if (!match_sorted_ids_all(archetypeIds, idsAll))
+						return false;
+					if (!idsOr.empty() && !match_sorted_ids_any(archetypeIds, idsOr))
+						return false;
+					return !match_sorted_ids_any(archetypeIds, idsNot);
+				}
+
 				GAIA_NODISCARD inline EOpcode src_opcode_from_term(const QueryTerm& term) {
 					const bool includeSelf = query_trav_has(term.travKind, QueryTravKind::Self);
 					const bool includeUp = query_trav_has(term.travKind, QueryTravKind::Up) && term.entTrav != EntityBad;
@@ -1667,9 +1758,10 @@ namespace gaia {
 						return false;
 					};
 
-					if (!ctx.archetypeLookup.empty()) {
+					const auto& srcLookup = ctx.srcLookup.empty() ? ctx.archetypeLookup : ctx.srcLookup;
+					if (!srcLookup.empty()) {
 						const auto sourceArchetypes =
-								ctx.archetypeLookup.fetch(ctx.allArchetypes, termOp.term.id, EntityLookupKey(termOp.term.id));
+								srcLookup.fetch(ctx.allArchetypes, termOp.term.id, EntityLookupKey(termOp.term.id));
 						if (adv_matches(sourceArchetypes, true))
 							return true;
 					} else if (adv_matches_all(ctx.allArchetypes))
@@ -1778,9 +1870,10 @@ namespace gaia {
 						return false;
 					};
 
-					if (!ctx.archetypeLookup.empty()) {
+					const auto& srcLookup = ctx.srcLookup.empty() ? ctx.archetypeLookup : ctx.srcLookup;
+					if (!srcLookup.empty()) {
 						const auto sourceArchetypes =
-								ctx.archetypeLookup.fetch(ctx.allArchetypes, termOp.term.id, EntityLookupKey(termOp.term.id));
+								srcLookup.fetch(ctx.allArchetypes, termOp.term.id, EntityLookupKey(termOp.term.id));
 						if (adv_matches(sourceArchetypes, true))
 							return true;
 					} else if (adv_matches_all(ctx.allArchetypes))
@@ -2655,6 +2748,31 @@ namespace gaia {
 					return vars;
 				}
 
+				//! Returns true for plain terms whose id is stored outside archetypes and so is not compiled into opcodes.
+				GAIA_NODISCARD static bool is_non_fragmenting_direct_term(const World& world, const QueryTerm& term) {
+					if (term.src != EntityBad || term.entTrav != EntityBad || term_has_variables(term))
+						return false;
+
+					const auto id = term.id;
+					return (id.pair() && world_relation_uses_non_fragmenting_storage(world, pair_rel(world, id))) ||
+								 (!id.pair() && world_component_is_non_fragmenting(world, id));
+				}
+
+				//! Returns a bitmask of terms of \a queryCtx skipped by compilation due to non-fragmenting storage.
+				GAIA_NODISCARD static uint32_t non_fragmenting_term_mask(const QueryCtx& queryCtx) {
+					static_assert(MAX_ITEMS_IN_QUERY <= 32, "non_fragmenting_term_mask needs a wider mask");
+					GAIA_ASSERT(queryCtx.w != nullptr);
+
+					uint32_t mask = 0;
+					const auto terms = queryCtx.data.terms_view();
+					const auto cnt = (uint32_t)terms.size();
+					GAIA_FOR(cnt) {
+						if (is_non_fragmenting_direct_term(*queryCtx.w, terms[i]))
+							mask |= (1U << i);
+					}
+					return mask;
+				}
+
 				GAIA_NODISCARD static uint8_t
 				term_unbound_var_mask(const World& world, const QueryTerm& term, const detail::VarBindings& vars) {
 					uint8_t mask = 0;
@@ -3699,14 +3817,6 @@ namespace gaia {
 					GAIA_ASSERT(queryCtx.w != nullptr);
 					const auto& world = *queryCtx.w;
 					const bool hasEntityFilterTerms = data.deps.has_dep_flag(QueryCtx::DependencyHasEntityFilterTerms);
-					auto isNonFragmentingDirectTerm = [&](const QueryTerm& term) {
-						if (term.src != EntityBad || term.entTrav != EntityBad || term_has_variables(term))
-							return false;
-
-						const auto id = term.id;
-						return (id.pair() && world_relation_uses_non_fragmenting_storage(world, pair_rel(world, id))) ||
-									 (!id.pair() && world_component_is_non_fragmenting(world, id));
-					};
 
 					QueryTermSpan terms = data.terms_view_mut();
 					QueryTermSpan terms_all = terms.subspan(0, data.firstOr);
@@ -3721,7 +3831,7 @@ namespace gaia {
 						const auto cnt = terms_all.size();
 						GAIA_FOR(cnt) {
 							auto& p = terms_all[i];
-							if (isNonFragmentingDirectTerm(p))
+							if (is_non_fragmenting_direct_term(world, p))
 								continue;
 							if (term_has_variables(p)) {
 								const auto varMask = term_unbound_var_mask(world, p, detail::VarBindings{});
@@ -3768,7 +3878,7 @@ namespace gaia {
 						const auto cnt = terms_not.size();
 						GAIA_FOR(cnt) {
 							auto& p = terms_not[i];
-							if (isNonFragmentingDirectTerm(p))
+							if (is_non_fragmenting_direct_term(world, p))
 								continue;
 							if (term_has_variables(p)) {
 								const auto varMask = term_unbound_var_mask(world, p, detail::VarBindings{});
@@ -4155,6 +4265,163 @@ namespace gaia {
 					return hash;
 				}
 
+				//! Writes the compiled program so a later run can restore it via load_program() instead of compiling.
+				//! The term layout it was compiled from is stored along with it so mismatching plans can be rejected.
+				//! \param s Output serializer.
+				//! \param queryCtx Query context the program was compiled from.
+				void save_program(ser::ser_buffer_binary_dyn& s, const QueryCtx& queryCtx) const {
+					const auto& data = queryCtx.data;
+					const auto terms = data.terms_view();
+					s.save((uint8_t)terms.size());
+					s.save(data.firstOr);
+					s.save(data.firstNot);
+					s.save(data.firstAny);
+					for (const auto& term: terms)
+						detail::save_query_term(s, term);
+					s.save(non_fragmenting_term_mask(queryCtx));
+
+					auto saveSrcTerms = [&](const auto& arr) {
+						s.save((uint8_t)arr.size());
+						for (const auto& termOp: arr) {
+							s.save(termOp.opcode);
+							detail::save_query_term(s, termOp.term);
+						}
+					};
+					auto saveVarTerms = [&](const auto& arr) {
+						s.save((uint8_t)arr.size());
+						for (const auto& termOp: arr) {
+							s.save(termOp.sourceOpcode);
+							s.save(termOp.varMask);
+							detail::save_query_term(s, termOp.term);
+						}
+					};
+					auto saveIds = [&](const auto& arr) {
+						s.save((uint8_t)arr.size());
+						for (auto id: arr)
+							s.save(id.value());
+					};
+
+					s.save((uint32_t)m_compCtx.ops.size());
+					s.save_raw(
+							m_compCtx.ops.data(), (uint32_t)(m_compCtx.ops.size() * sizeof(detail::CompiledOp)),
+							ser::serialization_type_id::trivial_wrapper);
+					s.save(m_compCtx.mainOpsCount);
+					saveIds(m_compCtx.ids_all);
+					saveIds(m_compCtx.ids_or);
+					saveIds(m_compCtx.ids_not);
+					saveSrcTerms(m_compCtx.terms_all_src);
+					saveSrcTerms(m_compCtx.terms_or_src);
+					saveSrcTerms(m_compCtx.terms_not_src);
+					saveVarTerms(m_compCtx.terms_all_var);
+					saveVarTerms(m_compCtx.terms_or_var);
+					saveVarTerms(m_compCtx.terms_not_var);
+					saveVarTerms(m_compCtx.terms_any_var);
+					s.save((uint8_t)m_compCtx.var_programs.size());
+					for (const auto& step: m_compCtx.var_programs)
+						s.save(step);
+					s.save(m_compCtx.varMaskAll);
+					s.save(m_compCtx.varMaskOr);
+					s.save(m_compCtx.varMaskNot);
+					s.save(m_compCtx.varMaskAny);
+				}
+
+				//! Restores a program written by save_program() and marks \a queryCtx as compiled.
+				//! \param s Input serializer positioned at the start of the program.
+				//! \param queryCtx Query context to restore the program for.
+				//! \return False when the stored term layout or the storage of its terms no longer matches \a queryCtx.
+				//!         The virtual machine is left untouched in that case and the query has to be compiled.
+				GAIA_NODISCARD bool load_program(ser::ser_buffer_binary_dyn& s, QueryCtx& queryCtx) {
+					GAIA_PROF_SCOPE(vm::load_program);
+
+					const auto& data = queryCtx.data;
+					const auto terms = data.terms_view();
+
+					uint8_t termCnt = 0;
+					uint8_t firstOr = 0;
+					uint8_t firstNot = 0;
+					uint8_t firstAny = 0;
+					s.load(termCnt);
+					s.load(firstOr);
+					s.load(firstNot);
+					s.load(firstAny);
+					if (termCnt != terms.size() || firstOr != data.firstOr || firstNot != data.firstNot ||
+							firstAny != data.firstAny)
+						return false;
+					for (const auto& term: terms) {
+						QueryTerm storedTerm{};
+						detail::load_query_term(s, storedTerm);
+						if (storedTerm != term)
+							return false;
+					}
+					uint32_t nonFragmentingMask = 0;
+					s.load(nonFragmentingMask);
+					if (nonFragmentingMask != non_fragmenting_term_mask(queryCtx))
+						return false;
+
+					// Terms are validated, anything below is the program itself
+					auto loadCnt = [&]() {
+						uint8_t cnt = 0;
+						s.load(cnt);
+						GAIA_ASSERT(cnt <= MAX_ITEMS_IN_QUERY);
+						return (uint32_t)cnt;
+					};
+					auto loadSrcTerms = [&](auto& arr) {
+						arr.resize(loadCnt());
+						for (auto& termOp: arr) {
+							s.load(termOp.opcode);
+							detail::load_query_term(s, termOp.term);
+						}
+					};
+					auto loadVarTerms = [&](auto& arr) {
+						arr.resize(loadCnt());
+						for (auto& termOp: arr) {
+							s.load(termOp.sourceOpcode);
+							s.load(termOp.varMask);
+							detail::load_query_term(s, termOp.term);
+						}
+					};
+					auto loadIds = [&](auto& arr) {
+						arr.resize(loadCnt());
+						for (auto& id: arr) {
+							Identifier value = IdentifierBad;
+							s.load(value);
+							id = Entity(value);
+						}
+					};
+
+					uint32_t opsCnt = 0;
+					s.load(opsCnt);
+					m_compCtx.ops.resize(opsCnt);
+					s.load_raw(
+							m_compCtx.ops.data(), opsCnt * (uint32_t)sizeof(detail::CompiledOp),
+							ser::serialization_type_id::trivial_wrapper);
+					s.load(m_compCtx.mainOpsCount);
+					loadIds(m_compCtx.ids_all);
+					loadIds(m_compCtx.ids_or);
+					loadIds(m_compCtx.ids_not);
+					loadSrcTerms(m_compCtx.terms_all_src);
+					loadSrcTerms(m_compCtx.terms_or_src);
+					loadSrcTerms(m_compCtx.terms_not_src);
+					loadVarTerms(m_compCtx.terms_all_var);
+					loadVarTerms(m_compCtx.terms_or_var);
+					loadVarTerms(m_compCtx.terms_not_var);
+					loadVarTerms(m_compCtx.terms_any_var);
+					uint8_t programCnt = 0;
+					s.load(programCnt);
+					GAIA_ASSERT(programCnt <= MaxVarCnt);
+					m_compCtx.var_programs.resize(programCnt);
+					for (auto& step: m_compCtx.var_programs)
+						s.load(step);
+					s.load(m_compCtx.varMaskAll);
+					s.load(m_compCtx.varMaskOr);
+					s.load(m_compCtx.varMaskNot);
+					s.load(m_compCtx.varMaskAny);
+
+					// Mark as compiled
+					queryCtx.data.flags &= ~QueryCtx::QueryFlags::Recompile;
+					return true;
+				}
+
 				//! Executes compiled query-matching opcodes.
 				//! \param ctx Matching state updated with the resulting archetypes.
 				void exec(MatchingCtx& ctx) {
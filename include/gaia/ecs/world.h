@@ -2,6 +2,7 @@
 #include "gaia/config/config.h"
 
 #include <cctype>
+#include <chrono>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
@@ -74,6 +75,18 @@ namespace gaia {
 		template <typename T>
 		decltype(auto) world_query_entity_arg_by_id_raw(World& world, Entity entity, Entity id);
 
+		//! Result of a chunk compaction run
+		struct ChunkCompactStats {
+			//! Number of chunks released
+			uint32_t chunksFreed;
+			//! Number of entities moved to a different chunk
+			uint32_t entitiesMoved;
+			//! Number of bytes returned to the chunk allocator
+			uint64_t bytesReclaimed;
+			//! True if the run was cut short by its time budget
+			bool budgetExhausted;
+		};
+
 		//! Owns entities, components, archetypes, queries, observers, and systems.
 		class GAIA_API World final {
 		public:
@@ -453,7 +466,7 @@ namespace gaia {
 				}
 
 				const auto& ec = fetch(entity);
-				const auto row = uint16_t(ec.row * (1U - (uint32_t)term.kind()));
+				const auto row = ChunkRow(ec.row * (1U - (uint32_t)term.kind()));
 				(void)ec.pChunk->comp_ptr_mut_gen<true>(compIdx, row);
 				world_notify_on_set_entity(*this, term, entity);
 			}
@@ -470,7 +483,7 @@ namespace gaia {
 				}
 
 				const auto& ec = fetch(entity);
-				const auto row = uint16_t(ec.row * (1U - (uint32_t)term.kind()));
+				const auto row = ChunkRow(ec.row * (1U - (uint32_t)term.kind()));
 				ComponentSetter{*this, ec.pChunk, entity, row}.sset<TApi>(value);
 				finish_write(entity, term);
 			}
@@ -488,7 +501,7 @@ namespace gaia {
 				}
 
 				const auto& ec = fetch(entity);
-				const auto row = uint16_t(ec.row * (1U - (uint32_t)term.kind()));
+				const auto row = ChunkRow(ec.row * (1U - (uint32_t)term.kind()));
 				ComponentSetter{*this, ec.pChunk, entity, row}.template smut<TValue>(term) = value;
 				finish_write(entity, term);
 			}
@@ -584,6 +597,8 @@ namespace gaia {
 			//! Sparse archetype-membership versions tracked only for entities used by source-cached queries.
 			//! Entries are created lazily on first snapshot to avoid any global per-entity tax.
 			mutable cnt::map<EntityLookupKey, uint32_t> m_srcEntityVersions;
+			//! Bumped whenever any entry of m_srcEntityVersions changes or is removed.
+			uint32_t m_srcEntityChangeVersion = 0;
 
 			enum class SparseStorageMode : uint8_t { None, Fragmenting, NonFragmenting };
 
@@ -663,10 +678,20 @@ namespace gaia {
 			cnt::darray<ArchetypeChunkPair> m_chunksToDel;
 			//! Array of archetypes to delete
 			ArchetypeDArray m_archetypesToDel;
+			//! Array of archetypes whose chunks are to be switched between the tiny and regular size
+			ArchetypeDArray m_archetypesToResize;
+			//! If true, newly created archetypes start with a tiny chunk
+			bool m_tinyChunks = false;
 			//! Index of the last defragmented archetype in the archetype list
 			uint32_t m_defragLastArchetypeIdx = 0;
 			//! Maximum number of entities to defragment per world tick
 			uint32_t m_defragEntitiesPerTick = 100;
+			//! Time budget of chunk compaction per world tick in microseconds. Zero disables it.
+			uint32_t m_compactBudgetPerTick = 0;
+			//! Result of the last chunk compaction run
+			ChunkCompactStats m_compactStats{};
+			//! Compaction candidate chunks ordered by occupancy
+			cnt::darray<Chunk*> m_compactChunks;
 
 			//! With every structural change world version changes
 			uint32_t m_worldVersion = 0;
@@ -753,6 +778,149 @@ namespace gaia {
 
 			//----------------------------------------------------------------------
 
+			//! Matches cached queries against the current archetype set ahead of their first use.
+			//!
+			//! After load() or when a level is streamed in, each cached query would otherwise rebuild its cache lazily on
+			//! the main thread the first time it runs. Every query cache is independent, so plain structural queries are
+			//! matched in parallel through the world scheduler, each job with its own matching scratch. Queries that call
+			//! back into the world while matching (grouped or sorted ones) are matched serially. Dynamic queries depend on
+			//! runtime variable bindings owned by their Query objects and keep refreshing on first use.
+			//! Queries used by systems of the first scheduled phase are warmed in an earlier batch than the rest.
+			//! \param execType Execution type of the parallel part. QueryExecType::Serial matches on the caller thread.
+			//! \param scope Which queries to warm.
+			//! \return Number of queries matched.
+			//! \warning The world must not be modified until this call returns.
+			uint32_t warm_query_caches(
+					QueryExecType execType = QueryExecType::Parallel, QueryWarmScope scope = QueryWarmScope::All) {
+				GAIA_PROF_SCOPE(World::warm_query_caches);
+
+				cnt::darray<QueryInfo*> queries;
+				cnt::set<const QueryInfo*> seen;
+#if GAIA_SYSTEMS_ENABLED
+				systems_first_phase_queries(queries, seen);
+#endif
+				const auto priorityCnt = (uint32_t)queries.size();
+				if (scope == QueryWarmScope::All) {
+					for (auto& queryInfo: m_queryCache) {
+						if (queryInfo.refs() == 0 || !seen.emplace(&queryInfo).second)
+							continue;
+						queries.push_back(&queryInfo);
+					}
+				}
+
+				const auto cnt = (uint32_t)queries.size();
+				const std::span<QueryInfo*> all{queries.data(), cnt};
+				return warm_query_batch(all.subspan(0, priorityCnt), execType) +
+							 warm_query_batch(all.subspan(priorityCnt), execType);
+			}
+
+			//! Writes the compiled plans of all cached queries to \a outputSerializer.
+			//!
+			//! Compiling queries into VM opcodes is a noticeable part of startup for worlds with many queries. Plans saved
+			//! here can be passed to load_query_plans() on the next start so cached queries restore their programs instead.
+			//! Plans loaded earlier that were not used by this run are written again as well.
+			//! \param outputSerializer Serializer to write to. Writing starts at its current position.
+			void save_query_plans(ser::serializer outputSerializer) {
+				GAIA_ASSERT(outputSerializer.valid());
+
+				m_queryCache.store_plans();
+				m_queryCache.plan_store().save(outputSerializer);
+			}
+
+			//! Loads plans written by save_query_plans(). Cached queries created afterwards reuse a stored plan when
+			//! their shape matches and the components referenced by their terms did not change since it was saved.
+			//! Queries that already exist are not affected.
+			//! \param inputSerializer Serializer to read from. Reading starts at its current position.
+			//! \return False when the plans were written by an incompatible runtime. No plans are used then.
+			bool load_query_plans(ser::serializer inputSerializer) {
+				GAIA_ASSERT(inputSerializer.valid());
+
+				return m_queryCache.plan_store().load(inputSerializer);
+			}
+
+			//! Returns how many cached queries were created from a stored plan since load_query_plans().
+			//! \return Number of queries that skipped compilation.
+			GAIA_NODISCARD uint32_t query_plan_hits() const {
+				return m_queryCache.plan_store().hits();
+			}
+
+		private:
+			//! Matches one batch of cached queries. Used by warm_query_caches().
+			//! \param batch Cached queries to match. Each query appears at most once.
+			//! \param execType Execution type of the parallel part.
+			//! \return Number of queries matched.
+			uint32_t warm_query_batch(std::span<QueryInfo*> batch, QueryExecType execType) {
+				if (batch.empty())
+					return 0;
+
+				const cnt::sarray<Entity, MaxVarCnt> noVarBindings{};
+				const auto archetypeLastId = m_nextArchetypeId - 1;
+				const std::span<const Archetype*> allArchetypes{(const Archetype**)m_archetypes.data(), m_archetypes.size()};
+
+				// Compile on the main thread first. Compilation reads component metadata and may register
+				// create-time selectors, neither of which is safe to do from a worker.
+				cnt::darray<QueryInfo*> parQueries;
+				uint32_t matched = 0;
+				for (auto* pInfo: batch) {
+					if ((pInfo->ctx().data.flags & QueryCtx::QueryFlags::Recompile) != 0)
+						pInfo->recompile();
+
+					if (pInfo->can_match_in_parallel()) {
+						parQueries.push_back(pInfo);
+						++matched;
+					} else if (pInfo->ctx().data.cachePolicy != QueryCtx::CachePolicy::Dynamic) {
+						pInfo->ensure_matches(
+								m_entityToArchetypeMap, allArchetypes, m_entityToArchetypeMapVersions, archetypeLastId, noVarBindings,
+								0);
+						++matched;
+					}
+				}
+
+				struct WarmQueryCtx {
+					World* pWorld;
+					QueryInfo** ppQueries;
+					std::span<const Archetype*> allArchetypes;
+					ArchetypeId archetypeLastId;
+				};
+				WarmQueryCtx ctx{this, parQueries.data(), allArchetypes, archetypeLastId};
+				auto warm_range = [](void* pCtx, uint32_t idxStart, uint32_t idxEnd) {
+					auto& ctx = *reinterpret_cast<WarmQueryCtx*>(pCtx);
+					const cnt::sarray<Entity, MaxVarCnt> varBindings{};
+					QueryMatchScratch scratch;
+					for (uint32_t i = idxStart; i < idxEnd; ++i) {
+						ctx.ppQueries[i]->ensure_matches(
+								ctx.pWorld->m_entityToArchetypeMap, ctx.allArchetypes, ctx.pWorld->m_entityToArchetypeMapVersions,
+								ctx.archetypeLastId, varBindings, 0, &scratch);
+					}
+				};
+
+				const auto parCnt = (uint32_t)parQueries.size();
+				if (execType == QueryExecType::Serial || parCnt < 2) {
+					if (parCnt != 0)
+						warm_range(&ctx, 0, parCnt);
+				} else {
+					SchedParDesc desc{};
+					desc.pCtx = &ctx;
+					desc.invoke = warm_range;
+					desc.itemCount = parCnt;
+					desc.execType = execType;
+
+					const auto& s = sched();
+					const auto token = sched_par(s, desc);
+					sched_wait(s, token);
+					sched_del(s, token);
+				}
+
+				// Archetype reverse-index bookkeeping is shared by all queries so it is synced on the main thread
+				for (auto* pInfo: batch)
+					m_queryCache.sync_archetype_cache(*pInfo);
+
+				return matched;
+			}
+
+		public:
+			//----------------------------------------------------------------------
+
 			//! Returns the internal record for \a entity.
 			//! \param entity Entity or exact pair record.
 			//! \return Mutable entity container record.
@@ -3676,7 +3844,7 @@ namespace gaia {
 
 				const auto& ec = fetch(entity);
 				// Make sure the idx is 0 for unique entities
-				const auto idx = uint16_t(ec.row * (1U - (uint32_t)object.kind()));
+				const auto idx = ChunkRow(ec.row * (1U - (uint32_t)object.kind()));
 				ComponentSetter{*this, ec.pChunk, entity, idx}.sset(object, GAIA_FWD(value));
 				notify_add_single(entity, object);
 #if GAIA_OBSERVERS_ENABLED
@@ -3714,7 +3882,7 @@ namespace gaia {
 
 				const auto& ec = m_recs.entities[entity.id()];
 				// Make sure the idx is 0 for unique payload storage.
-				const auto idx = uint16_t(ec.row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
+				const auto idx = ChunkRow(ec.row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
 				ComponentSetter{*this, ec.pChunk, entity, idx}.sset<T>(GAIA_FWD(value));
 				notify_add_single(entity, object);
 #if GAIA_OBSERVERS_ENABLED
@@ -3947,7 +4115,7 @@ namespace gaia {
 					it.set_world(this);
 					it.set_archetype(pDstArchetype);
 					it.set_chunk(pDstChunk);
-					it.set_range((uint16_t)originalChunkSize, (uint16_t)toCreate);
+					it.set_range((ChunkRow)originalChunkSize, (ChunkRow)toCreate);
 					func(it);
 				} else {
 					auto entities = pDstChunk->entity_view();
@@ -3974,7 +4142,7 @@ namespace gaia {
 				const auto& ec = fetch(instance);
 
 				if (group.count != 0 && ec.pArchetype == group.pArchetype && ec.pChunk == group.pChunk &&
-						ec.row == uint16_t(group.startRow + group.count)) {
+						ec.row == ChunkRow(group.startRow + group.count)) {
 					++group.count;
 					return;
 				}
@@ -4245,7 +4413,7 @@ namespace gaia {
 
 				uint32_t left = count;
 				do {
-					auto* pDstChunk = pDstArchetype->foc_free_chunk();
+					auto* pDstChunk = foc_free_chunk(*pDstArchetype);
 					const uint32_t originalChunkSize = pDstChunk->size();
 					const uint32_t freeSlotsInChunk = pDstChunk->capacity() - originalChunkSize;
 					const uint32_t toCreate = core::get_min(freeSlotsInChunk, left);
@@ -4615,8 +4783,8 @@ namespace gaia {
 				const auto compIdxSrc = ecSrc.pChunk->comp_idx(object);
 				GAIA_ASSERT(compIdxDst != BadIndex && compIdxSrc != BadIndex);
 
-				const auto idxDst = uint16_t(ecDst.row * (1U - (uint32_t)object.kind()));
-				const auto idxSrc = uint16_t(ecSrc.row * (1U - (uint32_t)object.kind()));
+				const auto idxDst = ChunkRow(ecDst.row * (1U - (uint32_t)object.kind()));
+				const auto idxSrc = ChunkRow(ecSrc.row * (1U - (uint32_t)object.kind()));
 				void* pDst = ecDst.pChunk->comp_ptr_mut(compIdxDst);
 				const void* pSrc = ecSrc.pChunk->comp_ptr(compIdxSrc);
 				item.copy(pDst, pSrc, idxDst, idxSrc, ecDst.pChunk->capacity(), ecSrc.pChunk->capacity());
@@ -4776,7 +4944,7 @@ namespace gaia {
 				EntityContainerCtx ctx{true, false, prefabEntity.kind()};
 				const auto instance = m_recs.entities.alloc(&ctx);
 				auto& ecDst = m_recs.entities[instance.id()];
-				auto* pDstChunk = pDstArchetype->foc_free_chunk();
+				auto* pDstChunk = foc_free_chunk(*pDstArchetype);
 				store_entity(ecDst, instance, pDstArchetype, pDstChunk);
 				pDstArchetype->try_update_free_chunk_idx();
 				Chunk::copy_foreign_entity_data(ecSrc.pChunk, ecSrc.row, pDstChunk, ecDst.row);
@@ -4878,7 +5046,7 @@ namespace gaia {
 
 				uint32_t left = count;
 				do {
-					auto* pDstChunk = pDstArchetype->foc_free_chunk();
+					auto* pDstChunk = foc_free_chunk(*pDstArchetype);
 					const uint32_t originalChunkSize = pDstChunk->size();
 					const uint32_t freeSlotsInChunk = pDstChunk->capacity() - originalChunkSize;
 					const uint32_t toCreate = core::get_min(freeSlotsInChunk, left);
@@ -5517,6 +5685,7 @@ namespace gaia {
 						TriggerSetEffects
 #endif
 						>();
+				ec.pChunk->template mark_dirty_rows<T>(ec.row, (ChunkRow)(ec.row + 1));
 
 #if GAIA_OBSERVERS_ENABLED
 				if constexpr (TriggerSetEffects) {
@@ -5528,7 +5697,7 @@ namespace gaia {
 					} else
 						term = comp_cache().template get<T>().entity;
 
-					world_notify_on_set(*this, term, *ec.pChunk, ec.row, (uint16_t)(ec.row + 1));
+					world_notify_on_set(*this, term, *ec.pChunk, ec.row, (ChunkRow)(ec.row + 1));
 				}
 #endif
 			}
@@ -5577,9 +5746,9 @@ namespace gaia {
 				GAIA_ASSERT(compIdx != ComponentIndexBad);
 
 				if constexpr (TriggerSetEffects)
-					ec.pChunk->finish_write(compIdx, ec.row, (uint16_t)(ec.row + 1));
+					ec.pChunk->finish_write(compIdx, ec.row, (ChunkRow)(ec.row + 1));
 				else
-					ec.pChunk->update_world_version(compIdx);
+					ec.pChunk->update_world_version(compIdx, ec.row, (ChunkRow)(ec.row + 1));
 			}
 
 			//----------------------------------------------------------------------
@@ -7810,9 +7979,12 @@ namespace gaia {
 			//! are prepared as scheduler jobs when the active scheduler supports deferred add/dep/submit/wait/del operations.
 			//! jobs in the same phase/dependency batch receive dependency edges when their query access metadata conflicts.
 			//!
+			//! Serial systems of phases enabled with phase_fusion(Entity, bool) share one chunk pass per batch.
+			//!
 			//! \warning Parallel systems must not structurally mutate the world while other scheduler jobs are pending unless
 			//! they synchronize externally or opt into main_thread().
 			//! \see SystemBuilder::mode(QueryExecType)
+			//! \see phase_fusion(Entity, bool)
 			//! \see QueryImpl::can_run_parallel(const QueryImpl&) const
 			//! \see Sched
 			void systems_run();
@@ -7821,6 +7993,11 @@ namespace gaia {
 			//! \return System builder bound to the new system entity.
 			SystemBuilder system();
 
+			//! Collects the cached queries used by systems of the first scheduled phase.
+			//! \param[out] out Receives each cached query once, in system schedule order.
+			//! \param[in,out] seen Queries already collected. Updated with the newly collected ones.
+			void systems_first_phase_queries(cnt::darray<QueryInfo*>& out, cnt::set<const QueryInfo*>& seen);
+
 			//! Returns the system runtime registry owned by the world.
 			SystemRegistry& systems() {
 				return m_systems;
@@ -7831,6 +8008,30 @@ namespace gaia {
 				return m_systems;
 			}
 
+			//! Enables or disables fused execution for a phase.
+			//!
+			//! When enabled, consecutive serial systems of the phase that share a scheduler batch run in a single pass over
+			//! the union of their matched chunks. On each chunk, their callbacks are invoked back to back in schedule order
+			//! while the chunk data is still in cache, instead of each system walking all of its chunks separately.
+			//! Systems are fused only when their callbacks can run chunk by chunk, their queries satisfy
+			//! QueryImpl::can_fuse() and their explicit access declarations allow QueryImpl::can_fuse_with(). Other systems
+			//! run as usual and split the fused group.
+			//!
+			//! \param phase Phase entity used with SystemBuilder::phase(Entity).
+			//! \param enable True to fuse the phase's systems, false to restore regular execution.
+			//! \warning Callbacks of fused systems must only touch the rows of the iterated chunk. Deferred structural
+			//! changes made by the fused systems are committed once after the whole pass.
+			void phase_fusion(Entity phase, bool enable) {
+				m_systems.phase_fusion(phase, enable);
+			}
+
+			//! Returns whether fused execution is enabled for a phase.
+			//! \param phase Phase entity.
+			//! \return True when the phase's systems run fused chunk passes.
+			GAIA_NODISCARD bool phase_fusion(Entity phase) const {
+				return m_systems.phase_fusion(phase);
+			}
+
 #endif
 
 #if GAIA_OBSERVERS_ENABLED
@@ -8013,6 +8214,7 @@ namespace gaia {
 			friend uint32_t world_version(const World& world);
 			friend uint32_t world_archetype_delete_version(const World& world);
 			friend uint32_t world_entity_archetype_version(const World& world, Entity entity);
+			friend uint32_t world_src_entity_change_version(const World& world);
 
 			//! Updates a tracked source-entity version after the entity changes archetype membership.
 			//! \param entity Source entity whose existing tracked version is incremented.
@@ -8023,12 +8225,14 @@ namespace gaia {
 					return;
 
 				update_version(it->second);
+				update_version(m_srcEntityChangeVersion);
 			}
 
 			//! Removes sparse source-version state for an entity that is being destroyed.
 			//! \param entity Source entity whose tracked version entry is removed.
 			void remove_src_entity_version(Entity entity) {
-				m_srcEntityVersions.erase(EntityLookupKey(entity));
+				if (m_srcEntityVersions.erase(EntityLookupKey(entity)) != 0)
+					update_version(m_srcEntityChangeVersion);
 			}
 
 			//! Sets maximal lifespan of an archetype \a entity belongs to.
@@ -8172,6 +8376,67 @@ namespace gaia {
 				m_defragEntitiesPerTick = value;
 			}
 
+			//! Sets the time budget of chunk compaction run by the garbage collector every world tick.
+			//! When non-zero, compaction replaces the default entity-count based defragmentation.
+			//! \param budgetUs Time budget in microseconds. Zero disables compaction.
+			//! \see compact_chunks()
+			void compact_budget_per_tick(uint32_t budgetUs) {
+				m_compactBudgetPerTick = budgetUs;
+			}
+
+			//! Returns the result of the last chunk compaction run
+			GAIA_NODISCARD const ChunkCompactStats& compact_stats() const {
+				return m_compactStats;
+			}
+
+			//! Merges sparsely populated chunks into fuller chunks of the same archetype and releases
+			//! the emptied chunks to the chunk allocator right away.
+			//! Archetypes are only touched when their entities fit into fewer chunks than they occupy.
+			//! The emptiest chunks are drained first, into the fullest chunks which still have room,
+			//! moving rows in bulk. A run cut short by its budget resumes with the same archetype next time.
+			//! \param budgetUs Time budget in microseconds. Zero means no limit.
+			//! \return Result of the run.
+			//! \warning The world must not be locked.
+			ChunkCompactStats compact_chunks(uint32_t budgetUs) {
+				GAIA_PROF_SCOPE(World::compact_chunks);
+				GAIA_ASSERT(!locked());
+
+				ChunkCompactStats stats{};
+
+				const auto archetypeCnt = (uint32_t)m_archetypes.size();
+				const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budgetUs);
+				GAIA_FOR(archetypeCnt) {
+					const auto idx = (m_defragLastArchetypeIdx + i) % archetypeCnt;
+					if (!compact_archetype(*m_archetypes[idx], budgetUs != 0, deadline, stats)) {
+						m_defragLastArchetypeIdx = idx;
+						stats.budgetExhausted = true;
+						break;
+					}
+				}
+
+				if (stats.entitiesMoved > 0)
+					update_version(m_worldVersion);
+
+				m_compactStats = stats;
+				return stats;
+			}
+
+			//! Clears the dirty state of all rows of all components tracking changes per row.
+			//! Typically called once all consumers of the per-row changes are done with the current frame.
+			//! \see GAIA_CHANGE_TRACKING
+			void clear_dirty_rows() {
+				GAIA_PROF_SCOPE(World::clear_dirty_rows);
+
+				for (auto* pArchetype: m_archetypes) {
+					const auto& props = pArchetype->props();
+					if (props.dirtyRowsOffset == 0 && props.tinyDirtyRowsOffset == 0)
+						continue;
+
+					for (auto* pChunk: pArchetype->chunks())
+						pChunk->clear_dirty_rows();
+				}
+			}
+
 			//--------------------------------------------------------------------------------
 
 			//! Performs diagnostics on archetypes. Prints basic info about them and the chunks they contain.
@@ -8235,6 +8500,7 @@ namespace gaia {
 #endif
 					m_chunksToDel = {};
 					m_archetypesToDel = {};
+					m_archetypesToResize = {};
 				}
 
 				// Clear entities
@@ -8271,6 +8537,7 @@ namespace gaia {
 					m_lastRelationVersionRelation = EntityBad;
 					m_pLastRelationVersion = nullptr;
 					m_srcEntityVersions = {};
+					update_version(m_srcEntityChangeVersion);
 
 					m_archetypes = {};
 					m_archetypesById = {};
@@ -8803,6 +9070,29 @@ namespace gaia {
 					s.load(m_recs.entities.m_freeItems);
 				}
 
+				// Serialized chunks might not fit into tiny chunks. Entities living in tiny chunks are moved
+				// to regular chunks first and the tiny chunks are released.
+				for (auto* pArchetype: m_archetypes) {
+					if (pArchetype->tiny_chunk_cnt() == 0)
+						continue;
+
+					promote_tiny_chunks(*pArchetype);
+
+					// Only empty tiny chunks waiting for deletion can be left at this point
+					const auto& chunks = pArchetype->chunks();
+					for (uint32_t i = 0; i < chunks.size();) {
+						auto* pChunk = chunks[i];
+						if (!pArchetype->is_tiny(*pChunk)) {
+							++i;
+							continue;
+						}
+
+						if (pChunk->queued_for_deletion())
+							remove_chunk_from_delete_queue(pChunk->delete_queue_index());
+						remove_chunk(*pArchetype, *pChunk);
+					}
+				}
+
 				// World
 				{
 					uint32_t archetypesSize = 0;
@@ -9073,9 +9363,22 @@ namespace gaia {
 			//! \param archetype Archetype we remove the entity from
 			//! \param chunk Chunk we remove the entity from
 			//! \param row Index of entity within its chunk
-			void remove_entity(Archetype& archetype, Chunk& chunk, uint16_t row) {
+			void remove_entity(Archetype& archetype, Chunk& chunk, ChunkRow row) {
 				archetype.remove_entity(chunk, row, m_recs);
 				try_enqueue_chunk_for_deletion(archetype, chunk);
+				if (archetype.needs_demotion())
+					try_enqueue_archetype_for_resize(archetype);
+			}
+
+			//! Finds a chunk with space for a new entity in \a archetype. If there is none, a new chunk is created.
+			//! \param archetype Archetype to search
+			//! \return Chunk with space for at least one entity.
+			//! \warning Always used in tandem with try_update_free_chunk_idx() or remove_entity()
+			GAIA_NODISCARD Chunk* foc_free_chunk(Archetype& archetype) {
+				auto* pChunk = archetype.foc_free_chunk();
+				if (archetype.needs_promotion())
+					try_enqueue_archetype_for_resize(archetype);
+				return pChunk;
 			}
 
 			//! Delete all chunks which are empty (have no entities) and have not been used in a while
@@ -9114,6 +9417,12 @@ namespace gaia {
 				GAIA_ASSERT(pArchetype->empty() || pArchetype->is_req_del());
 				GAIA_ASSERT(!pArchetype->dying() || pArchetype->is_req_del());
 
+				if (pArchetype->resize_queued()) {
+					const auto idx = core::get_index(m_archetypesToResize, pArchetype);
+					GAIA_ASSERT(idx != BadIndex);
+					core::swap_erase(m_archetypesToResize, idx);
+				}
+
 				unreg_archetype(pArchetype);
 				for (auto& ec: m_recs.entities) {
 					if (ec.pArchetype != pArchetype)
@@ -9239,6 +9548,88 @@ namespace gaia {
 				m_archetypesToDel.push_back(&archetype);
 			}
 
+			void try_enqueue_archetype_for_resize(Archetype& archetype) {
+				if (archetype.resize_queued())
+					return;
+
+				// Resizing moves entities between chunks. This can't happen while entities are being added
+				// or removed so it is postponed until world::gc() is called.
+				archetype.resize_queued(true);
+				m_archetypesToResize.push_back(&archetype);
+			}
+
+			//! Moves entities of queued archetypes between tiny and regular chunks.
+			//! Archetypes which outgrew their tiny chunk have it merged into regular chunks.
+			//! Archetypes which shrank enough have their only regular chunk replaced with a tiny one.
+			void resize_chunks() {
+				GAIA_PROF_SCOPE(World::resize_chunks);
+
+				for (auto* pArchetype: m_archetypesToResize) {
+					auto& archetype = *pArchetype;
+					archetype.resize_queued(false);
+					if (archetype.dying())
+						continue;
+
+					if (archetype.needs_promotion())
+						promote_tiny_chunks(archetype);
+					else if (archetype.needs_demotion())
+						demote_to_tiny_chunk(archetype);
+				}
+				m_archetypesToResize.clear();
+			}
+
+			//! Moves all entities of tiny chunks of \a archetype into regular chunks and frees the tiny chunks.
+			//! \param archetype Archetype to promote
+			void promote_tiny_chunks(Archetype& archetype) {
+				const auto& chunks = archetype.chunks();
+				for (auto* pChunk: chunks) {
+					// Empty tiny chunks are already waiting for deletion
+					if (archetype.is_tiny(*pChunk) && !pChunk->empty())
+						m_compactChunks.push_back(pChunk);
+				}
+
+				uint32_t dstIdx = 0;
+				for (auto* pSrcChunk: m_compactChunks) {
+					while (!pSrcChunk->empty()) {
+						// Find a regular chunk with space left. Create a new one if there is none.
+						while (dstIdx < chunks.size() &&
+									 (archetype.is_tiny(*chunks[dstIdx]) || chunks[dstIdx]->full()))
+							++dstIdx;
+						auto* pDstChunk = dstIdx < chunks.size() ? chunks[dstIdx] : archetype.add_chunk(false);
+
+						const uint32_t toMove =
+								core::get_min((uint32_t)pSrcChunk->size(), (uint32_t)(pDstChunk->capacity() - pDstChunk->size()));
+						Chunk::move_last_rows(pSrcChunk, pDstChunk, toMove, m_recs);
+						pDstChunk->update_world_version();
+						pDstChunk->update_entity_order_version();
+					}
+
+					remove_chunk(archetype, *pSrcChunk);
+					// Removing a chunk reorders the chunk array. Start searching from the beginning again.
+					dstIdx = 0;
+				}
+
+				if (!m_compactChunks.empty()) {
+					archetype.reset_free_chunk_idx();
+					update_version(m_worldVersion);
+				}
+				m_compactChunks.clear();
+			}
+
+			//! Moves all entities of the only chunk of \a archetype into a new tiny chunk and frees the original.
+			//! \param archetype Archetype to demote
+			void demote_to_tiny_chunk(Archetype& archetype) {
+				auto* pSrcChunk = archetype.chunks()[0];
+				auto* pDstChunk = archetype.add_chunk(true);
+				Chunk::move_last_rows(pSrcChunk, pDstChunk, pSrcChunk->size(), m_recs);
+				pDstChunk->update_world_version();
+				pDstChunk->update_entity_order_version();
+
+				remove_chunk(archetype, *pSrcChunk);
+				archetype.reset_free_chunk_idx();
+				update_version(m_worldVersion);
+			}
+
 			//! Defragments chunks.
 			//! \param maxEntities Maximum number of entities moved per call
 			void defrag_chunks(uint32_t maxEntities) {
@@ -9368,7 +9759,7 @@ namespace gaia {
 
 						// Bring the entity container record up-to-date
 						ec.pChunk = pDstChunk;
-						ec.row = (uint16_t)dstRow;
+						ec.row = (ChunkRow)dstRow;
 						ec.pEntity = &pDstChunk->entity_view()[dstRow];
 
 						// Transfer the original enabled state to the new chunk
@@ -9404,6 +9795,105 @@ namespace gaia {
 				}
 			}
 
+			//! Compacts chunks of an archetype. See compact_chunks().
+			//! \param archetype Archetype to compact
+			//! \param useDeadline If true, \a deadline is respected
+			//! \param deadline Point in time at which the compaction stops
+			//! \param[in,out] stats Compaction statistics
+			//! \return False if the deadline was hit. True otherwise.
+			bool compact_archetype(
+					Archetype& archetype, bool useDeadline, std::chrono::steady_clock::time_point deadline,
+					ChunkCompactStats& stats) {
+				const auto& chunks = archetype.chunks();
+				if (chunks.size() < 2 || archetype.dying())
+					return true;
+
+				// Entities belonging to chunks with uni components are locked to their chunk.
+				// Those are left to defrag_chunks() which compares the uni values.
+				const auto& props = archetype.props();
+				if (props.cntEntities > props.genEntities)
+					return true;
+
+				// Nothing to reclaim unless the entities fit into fewer chunks
+				const auto hist = archetype.fill_histogram();
+				const uint32_t capacity = props.capacity;
+				const uint32_t chunksNeeded = (hist.entities + capacity - 1) / capacity;
+				if (chunksNeeded >= hist.chunk_cnt())
+					return true;
+
+				// Order partially filled chunks from the emptiest to the fullest.
+				// Sorting by histogram bucket is precise enough and takes linear time.
+				uint32_t bucketOffs[ChunkFillHistogram::Buckets];
+				uint32_t candidateCnt = 0;
+				GAIA_FOR(ChunkFillHistogram::Buckets) {
+					bucketOffs[i] = candidateCnt;
+					candidateCnt += hist.chunks[i];
+				}
+				if (candidateCnt < 2)
+					return true;
+
+				m_compactChunks.resize(candidateCnt);
+				for (auto* pChunk: chunks) {
+					const uint32_t size = pChunk->size();
+					if (size == 0 || pChunk->full())
+						continue;
+
+					m_compactChunks[bucketOffs[ChunkFillHistogram::bucket(size, pChunk->capacity())]++] = pChunk;
+				}
+
+				// Free space in the chunks we can move rows into
+				uint32_t lo = 0;
+				uint32_t hi = candidateCnt - 1;
+				uint32_t room = 0;
+				for (uint32_t i = 1; i < candidateCnt; ++i)
+					room += m_compactChunks[i]->capacity() - m_compactChunks[i]->size();
+
+				bool inTime = true;
+				while (lo < hi) {
+					auto* pSrcChunk = m_compactChunks[lo];
+
+					// Only drain chunks which can be emptied completely. Otherwise, rows would move around
+					// without any memory being reclaimed.
+					const uint32_t srcSize = pSrcChunk->size();
+					if (srcSize > room)
+						break;
+					room -= srcSize;
+
+					while (!pSrcChunk->empty()) {
+						GAIA_ASSERT(lo < hi);
+						auto* pDstChunk = m_compactChunks[hi];
+						const uint32_t toMove =
+								core::get_min((uint32_t)pSrcChunk->size(), (uint32_t)(pDstChunk->capacity() - pDstChunk->size()));
+						Chunk::move_last_rows(pSrcChunk, pDstChunk, toMove, m_recs);
+						stats.entitiesMoved += toMove;
+
+						// Nothing changed structurally but chunk-bound caches need to notice the new rows
+						pDstChunk->update_world_version();
+						pDstChunk->update_entity_order_version();
+
+						if (pDstChunk->full())
+							--hi;
+					}
+
+					// Release the emptied chunk right away instead of waiting for its lifespan to run out
+					stats.bytesReclaimed += archetype.chunk_block_bytes(*pSrcChunk);
+					remove_chunk(archetype, *pSrcChunk);
+					++stats.chunksFreed;
+
+					// The next source no longer offers its free space
+					if (++lo < hi)
+						room -= m_compactChunks[lo]->capacity() - m_compactChunks[lo]->size();
+
+					if (useDeadline && std::chrono::steady_clock::now() >= deadline) {
+						inTime = false;
+						break;
+					}
+				}
+
+				m_compactChunks.clear();
+				return inTime;
+			}
+
 			//! Searches for archetype with a given set of components
 			//! \param hashLookup Archetype lookup hash
 			//! \param ids Archetype entities/components
@@ -9679,7 +10169,7 @@ namespace gaia {
 			//! \return Pointer to the new archetype.
 			GAIA_NODISCARD Archetype* create_archetype(EntitySpan entities) {
 				GAIA_ASSERT(m_nextArchetypeId < (decltype(m_nextArchetypeId))-1);
-				auto* pArchetype = Archetype::create(*this, m_nextArchetypeId++, m_worldVersion, entities);
+				auto* pArchetype = Archetype::create(*this, m_nextArchetypeId++, m_worldVersion, entities, m_tinyChunks);
 
 				const auto entityCnt = (uint32_t)entities.size();
 				GAIA_FOR(entityCnt) {
@@ -10278,7 +10768,7 @@ namespace gaia {
 
 					uint32_t i = (uint32_t)srcEnts.size();
 					while (i != 0) {
-						auto* pDstChunk = dstArchetype.foc_free_chunk();
+						auto* pDstChunk = foc_free_chunk(dstArchetype);
 						const uint32_t dstSpaceLeft = pDstChunk->capacity() - pDstChunk->size();
 						const uint32_t cnt = core::get_min(dstSpaceLeft, i);
 						for (uint32_t j = 0; j < cnt; ++j) {
@@ -11540,7 +12030,7 @@ namespace gaia {
 				// Bring the entity container record up-to-date
 				ec.pArchetype = &dstArchetype;
 				ec.pChunk = pDstChunk;
-				ec.row = (uint16_t)dstRow;
+				ec.row = (ChunkRow)dstRow;
 				ec.pEntity = &pDstChunk->entity_view()[dstRow];
 				if (archetypeChanged)
 					update_src_entity_version(entity);
@@ -11564,7 +12054,7 @@ namespace gaia {
 				ec.pChunk->update_world_version();
 				ec.pChunk->update_entity_order_version();
 
-				auto* pDstChunk = dstArchetype.foc_free_chunk();
+				auto* pDstChunk = foc_free_chunk(dstArchetype);
 				move_entity(entity, ec, dstArchetype, *pDstChunk);
 
 				// Update world versions
@@ -11586,7 +12076,7 @@ namespace gaia {
 				ec.pChunk->update_world_version();
 				ec.pChunk->update_entity_order_version();
 
-				auto* pDstChunk = dstArchetype.foc_free_chunk();
+				auto* pDstChunk = foc_free_chunk(dstArchetype);
 				move_entity(entity, ec, dstArchetype, *pDstChunk);
 
 				// Update world versions
@@ -11660,7 +12150,7 @@ namespace gaia {
 				GAIA_ASSERT(pChunk != nullptr);
 
 				const auto entities = pChunk->entity_view();
-				for (uint16_t row = 0; row < entities.size(); ++row) {
+				for (ChunkRow row = 0; row < entities.size(); ++row) {
 					const auto entity = entities[row];
 					const EntityContainer* pEc = nullptr;
 					if (entity.pair()) {
@@ -11823,7 +12313,7 @@ namespace gaia {
 			void assign_entity(Entity entity, Archetype& archetype) {
 				GAIA_ASSERT(!entity.pair());
 
-				auto* pChunk = archetype.foc_free_chunk();
+				auto* pChunk = foc_free_chunk(archetype);
 				store_entity(m_recs.entities[entity.id()], entity, &archetype, pChunk);
 				pChunk->update_versions();
 				archetype.try_update_free_chunk_idx();
@@ -11860,7 +12350,7 @@ namespace gaia {
 				ec.data.ent = 1;
 				ec.data.kind = EntityKind::EK_Gen;
 
-				auto* pChunk = archetype.foc_free_chunk();
+				auto* pChunk = foc_free_chunk(archetype);
 				store_entity(ec, entity, &archetype, pChunk);
 				pChunk->update_versions();
 				archetype.try_update_free_chunk_idx();
@@ -11923,7 +12413,7 @@ namespace gaia {
 
 				uint32_t left = count;
 				do {
-					auto* pChunk = archetype.foc_free_chunk();
+					auto* pChunk = foc_free_chunk(archetype);
 					const uint32_t originalChunkSize = pChunk->size();
 					const uint32_t freeSlotsInChunk = pChunk->capacity() - originalChunkSize;
 					const uint32_t toCreate = core::get_min(freeSlotsInChunk, left);
@@ -11977,7 +12467,11 @@ namespace gaia {
 				GAIA_PROF_SCOPE(World::gc);
 
 				del_empty_chunks();
-				defrag_chunks(m_defragEntitiesPerTick);
+				resize_chunks();
+				if (m_compactBudgetPerTick != 0)
+					(void)compact_chunks(m_compactBudgetPerTick);
+				else
+					defrag_chunks(m_defragEntitiesPerTick);
 				del_empty_archetypes();
 			}
 
@@ -12247,6 +12741,8 @@ namespace gaia {
 namespace gaia {
 	namespace ecs {
 		inline void World::init() {
+			m_tinyChunks = false;
+
 			// Use the default serializer
 			set_serializer(nullptr);
 
@@ -12570,6 +13066,10 @@ namespace gaia {
 			// Initialize the systems query
 			systems_init();
 #endif
+
+			// Archetypes of built-in entities are populated right away and their layout has to be the same
+			// in every world for serialization to work. Only archetypes created from now on use tiny chunks.
+			m_tinyChunks = true;
 		}
 
 		//! Groups an archetype by the target of its first pair using a requested relation.
@@ -13384,6 +13884,77 @@ namespace gaia {
 							 type == QueryExecType::ParallelEff;
 			}
 
+			//! Per-system payload of a fused chunk pass.
+			struct FusedSystemCtx {
+				//! Query of the system.
+				Query* pQuery;
+				//! Runtime callback storage of the system.
+				SystemRuntimeData* pRuntime;
+			};
+
+			//! Runs one fused system callback on the chunk prepared in \a it.
+			//! \param pCtx Pointer to FusedSystemCtx.
+			//! \param it Iterator positioned on the current chunk.
+			inline void run_fused_system_chunk(void* pCtx, Iter& it) {
+				auto& sysCtx = *static_cast<FusedSystemCtx*>(pCtx);
+				static_cast<void>(sysCtx.pRuntime->on_each_func(
+						*sysCtx.pQuery, QueryExecType::Default, SystemRuntimeData::RunMode::Chunk, &it));
+			}
+
+			//! Runs the serial systems collected for fused execution and clears the group.
+			//! A single system runs through the regular path. Larger groups share one chunk pass via QueryImpl::each_fused.
+			//! \param ctx System run context holding the fused group.
+			inline void flush_fused_systems(SystemRunCtx& ctx) {
+				if (ctx.pFused == nullptr || ctx.pFused->empty())
+					return;
+
+				auto& fused = *ctx.pFused;
+
+				auto& world = *ctx.pWorld;
+				if (fused.size() == 1) {
+					auto ss = world.acc_mut(fused[0]);
+					ss.smut<ecs::System_>().exec(world);
+					fused.clear();
+					return;
+				}
+
+				cnt::darray<FusedSystemCtx> sysCtxs;
+				cnt::darray<Query::FusedRun> runs;
+				sysCtxs.reserve(fused.size());
+				runs.reserve(fused.size());
+				for (auto systemEntity: fused) {
+					auto ss = world.acc_mut(systemEntity);
+					auto& sys = ss.smut<ecs::System_>();
+					auto* pRuntime = world.systems().data_try(systemEntity);
+					if (pRuntime == nullptr || !pRuntime->on_each_func)
+						continue;
+
+					sysCtxs.push_back({&sys.query, pRuntime});
+					runs.push_back({&sys.query, &sysCtxs.back(), run_fused_system_chunk});
+				}
+				fused.clear();
+
+				Query::each_fused(world, {runs.data(), runs.size()});
+			}
+
+			//! Returns whether a serial system can join the fused group of its batch.
+			//! \param world World owning the system.
+			//! \param item Scheduling key of the system.
+			//! \param sys System component of the system.
+			//! \return True when the system's phase opted into fusion and its callback and query can run chunk by chunk.
+			GAIA_NODISCARD inline bool system_fusable(World& world, const SystemScheduleItem& item, System_& sys) {
+				if (!item.hasPhase || !world.systems().phase_fusion(item.phase))
+					return false;
+				if (system_exec_uses_scheduler(sys.execType))
+					return false;
+
+				const auto* pRuntime = world.systems().data_try(item.entity);
+				if (pRuntime == nullptr || !pRuntime->chunk_runnable)
+					return false;
+
+				return sys.query.can_fuse();
+			}
+
 			//! Runs or prepares a system entity from the erased system-query callback path.
 			//! \param pCtx Pointer to SystemRunCtx.
 			//! \param item Precomputed scheduling key for the system entity to run or prepare.
@@ -13406,6 +13977,7 @@ namespace gaia {
 					ctx.current = item;
 					ctx.hasCurrent = true;
 				} else if (system_schedule_batch_changed(ctx.current, item)) {
+					flush_fused_systems(ctx);
 					flush_pending_system_jobs(pending);
 					ctx.current = item;
 				}
@@ -13414,10 +13986,26 @@ namespace gaia {
 				auto& sys = ss.smut<ecs::System_>();
 				if (!ctx.canScheduleSystems || !system_exec_uses_scheduler(sys.execType) || sys.query.main_thread_required()) {
 					flush_pending_system_jobs(pending);
+
+					if (ctx.pFused != nullptr && system_fusable(world, item, sys)) {
+						// Start a new group when the system's explicit access conflicts with a waiting one
+						for (auto fusedEntity: *ctx.pFused) {
+							auto fusedSs = world.acc_mut(fusedEntity);
+							if (!fusedSs.smut<ecs::System_>().query.can_fuse_with(sys.query)) {
+								flush_fused_systems(ctx);
+								break;
+							}
+						}
+						ctx.pFused->push_back(systemEntity);
+						return;
+					}
+
+					flush_fused_systems(ctx);
 					sys.exec(world);
 					return;
 				}
 
+				flush_fused_systems(ctx);
 				auto job = sys.job(world);
 				if (!job.valid())
 					return;
@@ -13472,16 +14060,54 @@ namespace gaia {
 			detail::order_system_schedule_items(*this, items, m_systemScheduleScratch);
 
 			cnt::darray<detail::PendingSystemJob> pending;
+			cnt::darray<Entity> fused;
 			detail::SystemRunCtx ctx{};
 			ctx.pWorld = this;
 			ctx.pPending = &pending;
+			ctx.pFused = &fused;
 			ctx.canScheduleSystems = detail::sched_supports_deferred_system_jobs(world_sched(*this));
 
 			for (auto& item: items)
 				detail::run_system_entity_erased(&ctx, item);
+			detail::flush_fused_systems(ctx);
 			detail::flush_pending_system_jobs(pending);
 		}
 
+		inline void World::systems_first_phase_queries(
+				cnt::darray<QueryInfo*>& out, cnt::set<const QueryInfo*>& seen) {
+			if GAIA_UNLIKELY (tearing_down())
+				return;
+
+			auto& items = m_systemScheduleScratch.items;
+			items.clear();
+
+			detail::SystemCollectCtx collectCtx{};
+			collectCtx.pWorld = this;
+			collectCtx.pItems = &items;
+			m_systemsQuery.each_entity_enabled(&collectCtx, detail::collect_system_schedule_item_erased);
+			if (items.empty())
+				return;
+			detail::order_system_schedule_items(*this, items, m_systemScheduleScratch);
+
+			const auto first = items[0];
+			for (const auto& item: items) {
+				if (!detail::system_schedule_same_group(first, item))
+					break;
+				if (!enabled_hierarchy(item.entity, ChildOf))
+					continue;
+
+				auto ss = acc_mut(item.entity);
+				auto& sys = ss.smut<ecs::System_>();
+				auto& queryInfo = sys.query.fetch();
+				// Uncached system queries own their QueryInfo and have nothing to warm
+				if (m_queryCache.try_get(QueryInfo::handle(queryInfo)) != &queryInfo)
+					continue;
+				if (!seen.emplace(&queryInfo).second)
+					continue;
+				out.push_back(&queryInfo);
+			}
+		}
+
 		inline void World::systems_done() {
 			cnt::darray<Entity> tmpEntities;
 			m_systemsQuery.each_entity_enabled(&tmpEntities, detail::collect_system_entity_erased);
@@ -14235,7 +14861,7 @@ namespace gaia {
 		//! \param chunk Chunk containing the written rows.
 		//! \param from First row index, inclusive.
 		//! \param to Last row index, exclusive.
-		inline void world_notify_on_set(World& world, Entity term, Chunk& chunk, uint16_t from, uint16_t to) {
+		inline void world_notify_on_set(World& world, Entity term, Chunk& chunk, ChunkRow from, ChunkRow to) {
 #if GAIA_OBSERVERS_ENABLED
 			if (world.tearing_down())
 				return;
@@ -14246,7 +14872,7 @@ namespace gaia {
 			if (from >= entities.size())
 				return;
 			if (to > entities.size())
-				to = (uint16_t)entities.size();
+				to = (ChunkRow)entities.size();
 			if (from >= to)
 				return;
 
@@ -14318,7 +14944,7 @@ namespace gaia {
 				}
 			}
 
-			const auto row = (uint16_t)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
+			const auto row = (ChunkRow)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
 			return m_pChunk->template get<T>(row, type);
 		}
 
@@ -14339,7 +14965,7 @@ namespace gaia {
 					return world.template sparse_component_mut_value<FT>(type, m_entity);
 			}
 
-			const auto row = (uint16_t)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
+			const auto row = (ChunkRow)(m_row * (actual_type_t<T>::Kind == EntityKind::EK_Gen));
 			return const_cast<Chunk*>(m_pChunk)->template sset<T>(row, type);
 		}
 
@@ -14421,6 +15047,14 @@ namespace gaia {
 			it = world.m_srcEntityVersions.try_emplace(key, 1).first;
 			return it->second;
 		}
+
+		//! Returns a version bumped whenever any tracked source-entity archetype version changes.
+		//! Lets cached queries skip comparing their tracked entities one by one while nothing moved.
+		//! \param world World containing the sparse source-version state.
+		//! \return Change version of the tracked source-entity versions.
+		inline uint32_t world_src_entity_change_version(const World& world) {
+			return world.m_srcEntityChangeVersion;
+		}
 	} // namespace ecs
 } // namespace gaia
 
@@ -10,6 +10,7 @@
 #include "gaia/mem/mem_alloc.h"
 #include "gaia/mt/event.h"
 #include "gaia/mt/jobqueue.h"
+#include "gaia/mt/numa.h"
 #include "gaia/util/small_func.h"
 
 namespace gaia {
@@ -50,6 +51,8 @@ namespace gaia {
 			JobPriority priority = JobPriority::High;
 			//! Creation and lifetime options.
 			JobCreationFlags flags = JobCreationFlags::Default;
+			//! NUMA node whose workers should preferably run the job. NumaNodeAny for no preference.
+			uint8_t numaNode = NumaNodeAny;
 		};
 
 		//! Half-open item range passed to a parallel job callback.
@@ -237,6 +240,8 @@ namespace gaia {
 			bool background = false;
 			//! True when the worker thread has been successfully created.
 			bool threadCreated = false;
+			//! NUMA node the worker is bound to
+			uint8_t numaNode = 0;
 			//! Event signaled when a job is executed
 			Event event;
 			//! Lock-free work stealing queue for the jobs
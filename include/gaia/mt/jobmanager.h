@@ -82,6 +82,8 @@ namespace gaia {
 			JobPriority prio;
 			//! Job flags
 			JobCreationFlags flags;
+			//! Preferred NUMA node of the executing worker
+			uint8_t numaNode = NumaNodeAny;
 			//! Dependency graph
 			JobEdges edges;
 			//! Function to execute when running the job
@@ -97,6 +99,7 @@ namespace gaia {
 				state = other.state.load();
 				prio = other.prio;
 				flags = other.flags;
+				numaNode = other.numaNode;
 				func = GAIA_MOV(other.func);
 
 				// if (edges.depCnt > 0)
@@ -110,6 +113,7 @@ namespace gaia {
 				state = other.state.load();
 				prio = other.prio;
 				flags = other.flags;
+				numaNode = other.numaNode;
 				func = GAIA_MOV(other.func);
 
 				// if (edges.depCnt > 0)
@@ -132,6 +136,7 @@ namespace gaia {
 				jc.idx = index;
 				jc.data.gen = generation;
 				jc.prio = ctx->priority;
+				jc.numaNode = NumaNodeAny;
 
 				return jc;
 			}
@@ -267,6 +272,7 @@ namespace gaia {
 				j.state.store(0);
 				j.func = GAIA_MOV(job.func);
 				j.flags = job.flags;
+				j.numaNode = job.numaNode;
 				return handle;
 			}
 
@@ -288,6 +294,8 @@ namespace gaia {
 			void free_job(JobHandle jobHandle) {
 				auto& jobData = m_jobData.live_unsafe(jobHandle.id());
 				GAIA_ASSERT(done(jobData));
+				// Release the captured state now rather than when the slot is reused
+				jobData.func.reset();
 				jobData.state.store(JobState::Released);
 				m_jobData.free_keep_live(jobHandle);
 			}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "gaia/config/config.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gaia/core/utility.h"
+
+#if GAIA_USE_NUMA && GAIA_PLATFORM_LINUX
+	#include <cstdio>
+	#include <pthread.h>
+	#include <sched.h>
+	#if GAIA_USE_LIBNUMA
+		#include <numa.h>
+	#endif
+#endif
+
+namespace gaia {
+	namespace mt {
+		//! Maximum number of NUMA nodes told apart by the library. Machines with more nodes have the extra nodes
+		//! folded onto the first ones.
+		static constexpr uint32_t MaxNumaNodes = 8;
+		//! Node hint telling the scheduler the work has no node preference.
+		static constexpr uint8_t NumaNodeAny = 0xFF;
+
+		//! \cond INTERNAL
+		namespace detail {
+			//! CPU-to-node map of the machine. Detected once on first use.
+			struct NumaTopology {
+				//! Maximum number of CPUs the map covers. CPUs above the limit are reported as node 0.
+				static constexpr uint32_t MaxCpus = 1024;
+
+				//! Node of each CPU
+				uint8_t cpuNode[MaxCpus]{};
+				//! Number of nodes, at least 1
+				uint32_t nodeCnt = 1;
+				//! True when memory can be bound to a node explicitly. Otherwise, first-touch placement is used.
+				bool canBindMemory = false;
+
+				NumaTopology() {
+#if GAIA_USE_NUMA && GAIA_PLATFORM_LINUX
+	#if GAIA_USE_LIBNUMA
+					if (::numa_available() >= 0) {
+						nodeCnt = (uint32_t)::numa_num_configured_nodes();
+						const auto cpuCnt = (uint32_t)::numa_num_configured_cpus();
+						for (uint32_t cpu = 0; cpu < cpuCnt && cpu < MaxCpus; ++cpu) {
+							const int node = ::numa_node_of_cpu((int)cpu);
+							cpuNode[cpu] = node < 0 ? 0 : (uint8_t)((uint32_t)node % MaxNumaNodes);
+						}
+						canBindMemory = true;
+						clamp_node_cnt();
+						return;
+					}
+	#endif
+					// Without libnuma the topology is read from sysfs. Nodes are numbered contiguously on Linux.
+					nodeCnt = 0;
+					for (uint32_t node = 0; node < MaxNumaNodes; ++node) {
+						char path[64];
+						GAIA_STRFMT(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+						FILE* pFile = fopen(path, "r");
+						if (pFile == nullptr)
+							break;
+
+						parse_cpulist(pFile, (uint8_t)node);
+						fclose(pFile);
+						++nodeCnt;
+					}
+					clamp_node_cnt();
+#endif
+				}
+
+			private:
+				void clamp_node_cnt() {
+					if (nodeCnt == 0)
+						nodeCnt = 1;
+					else if (nodeCnt > MaxNumaNodes)
+						nodeCnt = MaxNumaNodes;
+				}
+
+#if GAIA_USE_NUMA && GAIA_PLATFORM_LINUX
+				//! Parses the "0-3,8,10-11" cpulist format and assigns all listed CPUs to \param node.
+				void parse_cpulist(FILE* pFile, uint8_t node) {
+					unsigned first = 0;
+					while (fscanf(pFile, "%u", &first) == 1) {
+						unsigned last = first;
+						int c = fgetc(pFile);
+						if (c == '-') {
+							if (fscanf(pFile, "%u", &last) != 1)
+								break;
+							c = fgetc(pFile);
+						}
+
+						for (unsigned cpu = first; cpu <= last && cpu < MaxCpus; ++cpu)
+							cpuNode[cpu] = node;
+
+						if (c != ',')
+							break;
+					}
+				}
+#endif
+			};
+
+			GAIA_NODISCARD inline const NumaTopology& numa_topology() {
+				static const NumaTopology topology;
+				return topology;
+			}
+		} // namespace detail
+		//! \endcond
+
+		//! Returns the number of NUMA nodes of the machine.
+		//! \return Number of nodes in the range [1, MaxNumaNodes]. Always 1 when GAIA_USE_NUMA is disabled.
+		GAIA_NODISCARD inline uint32_t numa_node_cnt() {
+#if GAIA_USE_NUMA
+			return detail::numa_topology().nodeCnt;
+#else
+			return 1;
+#endif
+		}
+
+		//! Returns true when memory can be bound to a specific node. When false, memory ends up on the node
+		//! of the thread which touches it first.
+		GAIA_NODISCARD inline bool numa_can_bind_memory() {
+#if GAIA_USE_NUMA
+			return detail::numa_topology().canBindMemory;
+#else
+			return false;
+#endif
+		}
+
+		//! Returns the NUMA node a CPU belongs to.
+		//! \param cpu Logical CPU index
+		//! \return Node index smaller than numa_node_cnt().
+		GAIA_NODISCARD inline uint32_t numa_cpu_node([[maybe_unused]] uint32_t cpu) {
+#if GAIA_USE_NUMA
+			const auto& topology = detail::numa_topology();
+			if (cpu >= detail::NumaTopology::MaxCpus)
+				return 0;
+			return topology.cpuNode[cpu] % topology.nodeCnt;
+#else
+			return 0;
+#endif
+		}
+
+		//! Returns the NUMA node of the CPU the calling thread currently runs on.
+		//! \return Node index smaller than numa_node_cnt().
+		GAIA_NODISCARD inline uint32_t numa_curr_node() {
+#if GAIA_USE_NUMA && GAIA_PLATFORM_LINUX
+			const int cpu = sched_getcpu();
+			return cpu < 0 ? 0 : numa_cpu_node((uint32_t)cpu);
+#else
+			return 0;
+#endif
+		}
+
+		//! Restricts the calling thread to the CPUs of a NUMA node.
+		//! \param node Node index smaller than numa_node_cnt()
+		//! \return True if the affinity was changed. False otherwise.
+		inline bool numa_bind_thread([[maybe_unused]] uint32_t node) {
+#if GAIA_USE_NUMA && GAIA_PLATFORM_LINUX
+			if (numa_node_cnt() < 2)
+				return false;
+
+			const auto& topology = detail::numa_topology();
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			uint32_t cpuCnt = 0;
+			for (uint32_t cpu = 0; cpu < detail::NumaTopology::MaxCpus && cpu < CPU_SETSIZE; ++cpu) {
+				if (topology.cpuNode[cpu] != node)
+					continue;
+				CPU_SET(cpu, &cpuSet);
+				++cpuCnt;
+			}
+			if (cpuCnt == 0)
+				return false;
+
+			return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+			return false;
+#endif
+		}
+
+		//! Asks the OS to place the physical memory of the range on a NUMA node.
+		//! Without libnuma this is a no-op and placement is decided by the first thread touching the memory.
+		//! \param pData Start of the range
+		//! \param bytes Size of the range in bytes
+		//! \param node Node index smaller than numa_node_cnt()
+		inline void numa_bind_mem([[maybe_unused]] void* pData, [[maybe_unused]] size_t bytes, [[maybe_unused]] uint32_t node) {
+#if GAIA_USE_NUMA && GAIA_PLATFORM_LINUX && GAIA_USE_LIBNUMA
+			if (numa_node_cnt() < 2 || !numa_can_bind_memory())
+				return;
+			::numa_tonode_memory(pData, bytes, (int)node);
+#endif
+		}
+	} // namespace mt
+} // namespace gaia
@@ -107,6 +107,10 @@ namespace gaia {
 			MpmcQueue<JobHandle, 1024> m_jobQueue[JobPriorityCnt];
 			//! Global queue for background jobs that may span multiple frames.
 			MpmcQueue<JobHandle, 1024> m_jobQueueBackground;
+#if GAIA_USE_NUMA
+			//! Queues for jobs preferring workers of a specific NUMA node
+			MpmcQueue<JobHandle, 1024> m_jobQueueNuma[JobPriorityCnt][MaxNumaNodes];
+#endif
 			//! The number of spawned frame worker threads.
 			uint32_t m_frameWorkersCnt = 0;
 			//! The number of spawned background worker threads.
@@ -217,6 +221,7 @@ namespace gaia {
 				m_workersCtx[0].tp = this;
 				m_workersCtx[0].workerIdx = 0;
 				m_workersCtx[0].prio = JobPriority::High;
+				m_workersCtx[0].numaNode = (uint8_t)numa_curr_node();
 
 				// Reset the workers
 				for (auto& worker: m_workers)
@@ -314,6 +319,7 @@ namespace gaia {
 				m_workersCtx[0].tp = this;
 				m_workersCtx[0].workerIdx = 0;
 				m_workersCtx[0].prio = JobPriority::High;
+				m_workersCtx[0].numaNode = (uint8_t)numa_curr_node();
 
 				for (auto& worker: m_workers)
 					worker = {};
@@ -969,6 +975,13 @@ namespace gaia {
 				// Set the worker thread priority
 				ctx.tp->set_thread_priority(ctx.workerIdx, ctx.prio);
 
+#if GAIA_USE_NUMA
+				// Keep frame workers on the CPUs of their node so node-local jobs stay local.
+				// Background workers are left to the OS.
+				if (!ctx.background)
+					(void)numa_bind_thread(ctx.numaNode);
+#endif
+
 				// Process jobs
 				ctx.tp->worker_loop(ctx);
 
@@ -981,7 +994,8 @@ namespace gaia {
 			//! \param workerIdx Worker index
 			//! \param prio Priority used for the thread
 			//! \param background True when creating a background worker
-			void create_thread(uint32_t workerIdx, JobPriority prio, bool background) {
+			//! \param numaNode NUMA node the worker is bound to
+			void create_thread(uint32_t workerIdx, JobPriority prio, bool background, uint32_t numaNode) {
 				// Idx 0 is reserved for the main thread
 				GAIA_ASSERT(workerIdx > 0);
 
@@ -991,6 +1005,7 @@ namespace gaia {
 				ctx.prio = prio;
 				ctx.background = background;
 				ctx.threadCreated = false;
+				ctx.numaNode = (uint8_t)numaNode;
 
 #if GAIA_THREAD_PLATFORM == GAIA_THREAD_STD
 				m_workers[workerIdx - 1] = std::thread([&ctx]() {
@@ -1111,13 +1126,15 @@ namespace gaia {
 			}
 
 			void create_worker_threads(uint32_t& workerIdx, JobPriority prio, uint32_t count) {
+				// Workers of each priority class are spread evenly across NUMA nodes
+				const auto nodeCnt = numa_node_cnt();
 				for (uint32_t i = 0; i < count; ++i)
-					create_thread(workerIdx++, prio, false);
+					create_thread(workerIdx++, prio, false, i % nodeCnt);
 			}
 
 			void create_background_worker_threads(uint32_t& workerIdx) {
 				for (uint32_t i = 0; i < m_backgroundWorkersCnt; ++i)
-					create_thread(workerIdx++, JobPriority::Low, true);
+					create_thread(workerIdx++, JobPriority::Low, true, 0);
 			}
 
 			void set_thread_priority([[maybe_unused]] uint32_t workerIdx, [[maybe_unused]] JobPriority priority) {
@@ -1306,10 +1323,29 @@ namespace gaia {
 			//! \param[out] jobHandle Receives the ready job handle when one is available.
 			//! \return True when a valid job was obtained. False otherwise.
 			GAIA_NODISCARD bool try_fetch_prio(ThreadCtx& ctx, JobPriority prio, JobHandle& jobHandle) {
+#if GAIA_USE_NUMA
+				// Jobs preferring our node come first
+				if (m_jobQueueNuma[(uint32_t)prio][ctx.numaNode].try_pop(jobHandle))
+					return true;
+#endif
+
 				if (m_jobQueue[(uint32_t)prio].try_pop(jobHandle))
 					return true;
 
-				return try_steal_job(ctx, prio, jobHandle);
+				if (try_steal_job(ctx, prio, jobHandle))
+					return true;
+
+#if GAIA_USE_NUMA
+				// Nothing local is left. Help other nodes rather than idling.
+				const auto nodeCnt = numa_node_cnt();
+				for (uint32_t i = 1; i < nodeCnt; ++i) {
+					const auto node = (ctx.numaNode + i) % nodeCnt;
+					if (m_jobQueueNuma[(uint32_t)prio][node].try_pop(jobHandle))
+						return true;
+				}
+#endif
+
+				return false;
 			}
 
 			//! Attempts to fetch background work.
@@ -1584,8 +1620,17 @@ namespace gaia {
 						// priority class. Cross-priority releases must go through the matching
 						// global queue so the right workers can pick them up.
 						const bool useLocalQueue = ctx != nullptr && !ctx->background && ctx->workerIdx != 0 && ctx->prio == prio;
+#if GAIA_USE_NUMA
+						// Jobs preferring a node go through the node's queue unless we are a worker of that node already
+						const bool useNumaQueue = jobData.numaNode < numa_node_cnt() &&
+																			(!useLocalQueue || ctx->numaNode != jobData.numaNode);
+						const bool res = useNumaQueue ? m_jobQueueNuma[(uint32_t)prio][jobData.numaNode].try_push(handle)
+														 : useLocalQueue ? ctx->jobQueue.try_push(handle)
+																						 : m_jobQueue[(uint32_t)prio].try_push(handle);
+#else
 						const bool res =
 								useLocalQueue ? ctx->jobQueue.try_push(handle) : m_jobQueue[(uint32_t)prio].try_push(handle);
+#endif
 						if (!res)
 							break;
 
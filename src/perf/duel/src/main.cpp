@@ -1688,6 +1688,99 @@ void BM_ECS_Iter_SoA(picobench::state& state) {
 	}
 }
 
+template <uint32_t Width>
+void BM_ECS_Iter_SoA_Simd(picobench::state& state) {
+	GAIA_PROF_SCOPE(BM_ECS_Iter_SoA_Simd);
+
+	ecs::World w;
+
+	// Padded views cover whole vectors so the loops below need no scalar tail
+	// and compilers can vectorize them with plain loads and stores.
+	auto qPosVel = w.query().all<PositionSoA&>().all<VelocitySoA&>();
+	auto qVel = w.query().all<VelocitySoA&>();
+	auto qHealth = w.query().all<Health>();
+
+	auto run = [&]() {
+		qPosVel.template each_simd<Width>([](ecs::Iter& it) {
+			auto p = it.template simd_view_mut<PositionSoA, Width>(0);
+			auto v = it.template simd_view<VelocitySoA, Width>(1);
+			const float cdt = dt;
+
+			auto ppx = p.template set<0>();
+			auto ppy = p.template set<1>();
+			auto ppz = p.template set<2>();
+
+			auto vvx = v.template get<0>();
+			auto vvy = v.template get<1>();
+			auto vvz = v.template get<2>();
+
+			const auto cnt = it.template simd_size<Width>();
+			GAIA_FOR(cnt) {
+				ppx[i] += vvx[i] * cdt;
+				ppy[i] += vvy[i] * cdt;
+				ppz[i] += vvz[i] * cdt;
+			}
+		});
+
+		qPosVel.template each_simd<Width>([](ecs::Iter& it) {
+			auto p = it.template simd_view_mut<PositionSoA, Width>(0);
+			auto v = it.template simd_view_mut<VelocitySoA, Width>(1);
+
+			auto ppy = p.template set<1>();
+			auto vvy = v.template set<1>();
+
+			const auto cnt = it.template simd_size<Width>();
+			GAIA_FOR(cnt) {
+				const bool below = ppy[i] < 0.0f;
+				ppy[i] = below ? 0.0f : ppy[i];
+				vvy[i] = below ? 0.0f : vvy[i];
+			}
+		});
+
+		qVel.template each_simd<Width>([](ecs::Iter& it) {
+			auto v = it.template simd_view_mut<VelocitySoA, Width>(0);
+			const float cdt = dt;
+
+			auto vvy = v.template set<1>();
+
+			const auto cnt = it.template simd_size<Width>();
+			GAIA_FOR(cnt) {
+				vvy[i] += 9.81f * cdt;
+			}
+		});
+
+		qHealth.each([](ecs::Iter& it) {
+			auto h = it.view<Health>(0);
+			uint32_t aliveUnits = 0;
+
+			const auto cnt = it.size();
+			GAIA_FOR(cnt) {
+				if (h[i].value > 0)
+					++aliveUnits;
+			}
+			gaia::dont_optimize(aliveUnits);
+		});
+	};
+
+	{
+		GAIA_PROF_SCOPE(setup);
+		Register_ESC_Components<true>(w);
+		CreateECSEntities_Static<true>(w, (uint32_t)state.user_data() / 2);
+		CreateECSEntities_Dynamic<true>(w, (uint32_t)state.user_data() / 2);
+
+		/* We want to benchmark the hot-path. In real-world scenarios queries are cached so cache them now */
+		for (uint32_t i = 0; i < 10; ++i)
+			run();
+	}
+
+	srand(0);
+	for (auto _: state) {
+		(void)_;
+		dt = CalculateDelta(state);
+		run();
+	}
+}
+
 void BM_ECS_Iter_SoA_Dir(picobench::state& state) {
 	GAIA_PROF_SCOPE(BM_ECS_Iter_SoA);
 
@@ -2980,6 +3073,9 @@ int main(int argc, char* argv[]) {
 			PICOBENCH_REG(BM_ECS_Iter_SoA).PICO_SETTINGS().user_data(NMany).label("Iter_SoA Many");
 			PICOBENCH_REG(BM_ECS_Iter_SoA_Dir).PICO_SETTINGS().label("Iter_SoA_Dir");
 			PICOBENCH_REG(BM_ECS_Iter_SoA_Dir).PICO_SETTINGS().user_data(NMany).label("Iter_SoA_Dir Many");
+			PICOBENCH_REG(BM_ECS_Iter_SoA_Simd<4>).PICO_SETTINGS().label("Iter_SoA_Simd4");
+			PICOBENCH_REG(BM_ECS_Iter_SoA_Simd<8>).PICO_SETTINGS().label("Iter_SoA_Simd8");
+			PICOBENCH_REG(BM_ECS_Iter_SoA_Simd<8>).PICO_SETTINGS().user_data(NMany).label("Iter_SoA_Simd8 Many");
 			PICOBENCH_REG(BM_ECS_DepthOrder_Iter_EnabledOnly)
 					.PICO_SETTINGS()
 					.user_data(NMany)
@@ -5,6 +5,8 @@ namespace {
 	constexpr uint32_t PingPongOps = 64 * 1024;
 	constexpr uint32_t BatchSize = 4096;
 	constexpr uint32_t BatchRounds = 16;
+	constexpr uint64_t ArenaReserveBytes = 4ull * 1024 * 1024 * 1024;
+	constexpr uint32_t ArenaIterArchetypes = 8;
 
 	template <typename TPrepare, typename TAlloc, typename TFree>
 	void run_ping_pong(picobench::state& state, TPrepare&& prepare, TAlloc&& allocFn, TFree&& freeFn) {
@@ -76,6 +78,17 @@ namespace {
 	}
 
 	void prepare_default([[maybe_unused]] uint32_t bytes) {}
+
+	template <bool UseThreadCaches>
+	void prepare_chunk(uint32_t bytes) {
+		auto& alloc = ecs::ChunkAllocator::get();
+		alloc.set_thread_caches(UseThreadCaches);
+		alloc.flush(true);
+
+		// Warm the size class outside the timed section so the benchmark reports steady-state reuse.
+		void* p = alloc.alloc(bytes);
+		alloc.free(p);
+	}
 } // namespace
 
 void BM_DefaultAllocator_PingPong(picobench::state& state) {
@@ -122,6 +135,85 @@ void BM_SmallBlockAllocator_Batch(picobench::state& state) {
 			});
 }
 
+template <bool UseThreadCaches>
+void BM_ChunkAllocator_PingPong(picobench::state& state) {
+	run_ping_pong(
+			state, prepare_chunk<UseThreadCaches>,
+			[](uint32_t bytes) {
+				return ecs::ChunkAllocator::get().alloc(bytes);
+			},
+			[](void* p) {
+				ecs::ChunkAllocator::get().free(p);
+			});
+	ecs::ChunkAllocator::get().set_thread_caches(false);
+}
+
+template <bool UseThreadCaches>
+void BM_ChunkAllocator_Batch(picobench::state& state) {
+	run_batch(
+			state, prepare_chunk<UseThreadCaches>,
+			[](uint32_t bytes) {
+				return ecs::ChunkAllocator::get().alloc(bytes);
+			},
+			[](void* p) {
+				ecs::ChunkAllocator::get().free(p);
+			});
+	ecs::ChunkAllocator::get().set_thread_caches(false);
+}
+
+template <uint32_t TagId>
+struct ArenaTag {};
+
+template <uint32_t... TagIds>
+void add_arena_iter_entities(ecs::World& w, uint32_t n, std::integer_sequence<uint32_t, TagIds...>) {
+	// Interleave the archetypes so their chunks are spread all over the allocator pages
+	GAIA_FOR(n) {
+		const auto tagIdx = i % ArenaIterArchetypes;
+		auto e = w.add();
+		auto builder = w.build(e);
+		builder.add<Position>().add<Velocity>();
+		((tagIdx == TagIds ? (void)builder.add<ArenaTag<TagIds>>() : (void)0), ...);
+		builder.commit();
+		w.set<Velocity>(e) = {1.0f, (float)tagIdx, 0.0f};
+	}
+}
+
+template <bool UseArena>
+void BM_ChunkAllocator_Iter(picobench::state& state) {
+	const auto n = (uint32_t)state.user_data();
+
+	auto& alloc = ecs::ChunkAllocator::get();
+	alloc.flush(true);
+	if constexpr (UseArena)
+		(void)alloc.set_arena(ArenaReserveBytes);
+
+	{
+		ecs::World w;
+		add_arena_iter_entities(w, n, std::make_integer_sequence<uint32_t, ArenaIterArchetypes>{});
+
+		auto q = w.query().all<Position&>().all<Velocity>();
+		gaia::dont_optimize(q.empty());
+
+		state.stop_timer();
+		for (auto _: state) {
+			(void)_;
+			state.start_timer();
+
+			q.each([](Position& p, const Velocity& v) {
+				p.x += v.x * 0.016f;
+				p.y += v.y * 0.016f;
+				p.z += v.z * 0.016f;
+			});
+
+			state.stop_timer();
+		}
+	}
+
+	alloc.flush(true);
+	if constexpr (UseArena)
+		(void)alloc.set_arena(0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void register_allocators(PerfRunMode mode) {
@@ -161,6 +253,16 @@ void register_allocators(PerfRunMode mode) {
 			PICOBENCH_REG(BM_SmallBlockAllocator_Batch).PICO_SETTINGS().user_data(128).label("smallblock alloc 128");
 			PICOBENCH_REG(BM_DefaultAllocator_Batch).PICO_SETTINGS().user_data(512).label("default alloc 512");
 			PICOBENCH_REG(BM_SmallBlockAllocator_Batch).PICO_SETTINGS().user_data(512).label("smallblock alloc 512");
+
+			PICOBENCH_SUITE_REG("Chunk allocator");
+			PICOBENCH_REG(BM_ChunkAllocator_PingPong<false>).PICO_SETTINGS().user_data(16384).label("pingpong 16K");
+			PICOBENCH_REG(BM_ChunkAllocator_PingPong<true>).PICO_SETTINGS().user_data(16384).label("pingpong 16K tls");
+			PICOBENCH_REG(BM_ChunkAllocator_Batch<false>).PICO_SETTINGS().user_data(16384).label("batch 16K");
+			PICOBENCH_REG(BM_ChunkAllocator_Batch<true>).PICO_SETTINGS().user_data(16384).label("batch 16K tls");
+
+			PICOBENCH_SUITE_REG("Chunk allocator iteration");
+			PICOBENCH_REG(BM_ChunkAllocator_Iter<false>).PICO_SETTINGS().user_data(1'000'000).label("heap pages 1M");
+			PICOBENCH_REG(BM_ChunkAllocator_Iter<true>).PICO_SETTINGS().user_data(1'000'000).label("arena pages 1M");
 			return;
 	}
 }
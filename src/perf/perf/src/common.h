@@ -42,6 +42,13 @@ struct PositionSparse {
 	float z;
 };
 
+struct PositionRowTracked {
+	GAIA_CHANGE_TRACKING(Row);
+	float x;
+	float y;
+	float z;
+};
+
 struct Velocity {
 	float x;
 	float y;
@@ -96,6 +96,35 @@ void BM_Fragmented_QueryEach_Write2(picobench::state& state) {
 	}
 }
 
+void BM_Fragmented_Create(picobench::state& state) {
+	// One entity per archetype. Most of the chunk memory goes to chunks which are nearly empty.
+	constexpr uint32_t Archetypes = 128U;
+
+	auto chunk_mem_used = []() {
+		const auto stats = ecs::ChunkAllocator::get().stats();
+		uint64_t bytes = 0;
+		for (const auto& s: stats.stats)
+			bytes += s.mem_used;
+		return bytes;
+	};
+
+	uint64_t bytesPerEntity = 0;
+	state.stop_timer();
+	for (auto _: state) {
+		(void)_;
+		const auto bytesBefore = chunk_mem_used();
+		ecs::World w;
+		state.start_timer();
+
+		create_fragmented_entities(w, Archetypes, 1U);
+
+		state.stop_timer();
+		bytesPerEntity = (chunk_mem_used() - bytesBefore) / Archetypes;
+	}
+
+	GAIA_LOG_N("fragmented create: %" PRIu64 " B of chunk memory per entity", bytesPerEntity);
+}
+
 void BM_Fragmented_QueryEach_Read1_Cached(picobench::state& state) {
 	BM_Fragmented_QueryEach_Read1<true>(state);
 }
@@ -174,6 +203,7 @@ void register_fragmented(PerfRunMode mode) {
 			PICOBENCH_SUITE_REG("Fragmented archetypes");
 			PICOBENCH_REG(BM_Fragmented_Read).PICO_SETTINGS().label("read");
 			PICOBENCH_REG(BM_Fragmented_Write).PICO_SETTINGS().label("write");
+			PICOBENCH_REG(BM_Fragmented_Create).PICO_SETTINGS_HEAVY().label("create 1 entity/archetype");
 			PICOBENCH_REG(BM_Fragmented_QueryEach_Read1_Cached).PICO_SETTINGS_FOCUS().label("each cached 1c tiny");
 			PICOBENCH_REG(BM_Fragmented_QueryEach_Read1_Uncached).PICO_SETTINGS_FOCUS().label("each uncached 1c tiny");
 			PICOBENCH_REG(BM_Fragmented_QueryEach_Read2_Cached).PICO_SETTINGS_FOCUS().label("each cached 2c tiny");
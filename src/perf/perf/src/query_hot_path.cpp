@@ -66,6 +66,146 @@ void BM_Query_ReadWrite_2Comp(picobench::state& state) {
 	}
 }
 
+struct InventoryInline {
+	uint32_t items[512];
+};
+
+struct InventoryCold {
+	GAIA_STORAGE(Cold);
+	uint32_t items[512];
+};
+
+//! Benchmarks a hot Position/Velocity query over an archetype which also holds a 2 KiB rarely used component.
+//! Stored inline, the component limits chunks to a few dozen rows. Stored cold, it does not affect the chunk capacity.
+template <typename TInventory>
+void BM_Query_ReadWrite_2Comp_WithLargeComp(picobench::state& state) {
+	const uint32_t n = (uint32_t)state.user_data();
+	ecs::World w;
+	GAIA_FOR(n) {
+		auto e = w.add();
+		w.build(e).add<Position>().add<Velocity>().add<TInventory>();
+		w.set<Velocity>(e) = {1.0f, 0.5f, 0.25f};
+	}
+
+	auto q = w.query().all<Position&>().all<Velocity>();
+	dont_optimize(q.empty());
+
+	for (auto _: state) {
+		(void)_;
+		q.each([](Position& p, const Velocity& v) {
+			p.x += v.x * DeltaTime;
+			p.y += v.y * DeltaTime;
+			p.z += v.z * DeltaTime;
+		});
+	}
+}
+
+void BM_Query_ReadWrite_2Comp_WithLargeComp_Inline(picobench::state& state) {
+	BM_Query_ReadWrite_2Comp_WithLargeComp<InventoryInline>(state);
+}
+
+void BM_Query_ReadWrite_2Comp_WithLargeComp_Cold(picobench::state& state) {
+	BM_Query_ReadWrite_2Comp_WithLargeComp<InventoryCold>(state);
+}
+
+//! Benchmarks a hot Position/Velocity query over many archetypes holding only a few entities each.
+//! Every chunk is small and lives somewhere else in memory so the runner keeps jumping to cold chunk headers
+//! and columns. This is the workload the dense runner chunk prefetching (GAIA_QUERY_PREFETCH_DISTANCE) targets.
+template <bool UseIter>
+void BM_Query_ReadWrite_2Comp_ManySmallArchetypes(picobench::state& state) {
+	static constexpr uint32_t TagCnt = 10;
+	static constexpr uint32_t EntitiesPerArchetype = 8;
+	const uint32_t archetypeCnt = (uint32_t)state.user_data();
+	GAIA_ASSERT(archetypeCnt <= (1U << TagCnt));
+
+	ecs::World w;
+	cnt::sarray<ecs::Entity, TagCnt> tags{};
+	GAIA_FOR(TagCnt) tags[i] = w.add();
+
+	GAIA_FOR_(archetypeCnt, a) {
+		GAIA_FOR_(EntitiesPerArchetype, j) {
+			auto e = w.add();
+			auto builder = w.build(e);
+			builder.add<Position>().add<Velocity>();
+			GAIA_FOR(TagCnt) {
+				if ((a & (1U << i)) != 0)
+					builder.add(tags[i]);
+			}
+			builder.commit();
+			w.set<Velocity>(e) = {1.0f, 0.5f, 0.25f};
+		}
+	}
+
+	auto q = w.query().all<Position&>().all<Velocity>();
+	dont_optimize(q.empty());
+
+	for (auto _: state) {
+		(void)_;
+		if constexpr (UseIter) {
+			q.each([](ecs::Iter& it) {
+				auto p = it.view_mut<Position>(0);
+				auto v = it.view<Velocity>(1);
+				GAIA_EACH(it) {
+					p[i].x += v[i].x * DeltaTime;
+					p[i].y += v[i].y * DeltaTime;
+					p[i].z += v[i].z * DeltaTime;
+				}
+			});
+		} else {
+			q.each([](Position& p, const Velocity& v) {
+				p.x += v.x * DeltaTime;
+				p.y += v.y * DeltaTime;
+				p.z += v.z * DeltaTime;
+			});
+		}
+	}
+}
+
+void BM_Query_ReadWrite_2Comp_ManySmallArchetypes_Each(picobench::state& state) {
+	BM_Query_ReadWrite_2Comp_ManySmallArchetypes<false>(state);
+}
+
+void BM_Query_ReadWrite_2Comp_ManySmallArchetypes_Iter(picobench::state& state) {
+	BM_Query_ReadWrite_2Comp_ManySmallArchetypes<true>(state);
+}
+
+//! Benchmarks UI-style polling where count() and empty() are called many times per frame
+//! on a query spread over many archetypes while nothing structural changes in between.
+void BM_Query_Count_Repeated(picobench::state& state) {
+	static constexpr uint32_t TagCnt = 10;
+	static constexpr uint32_t CallsPerFrame = 100;
+	const uint32_t archetypeCnt = (uint32_t)state.user_data();
+	GAIA_ASSERT(archetypeCnt <= (1U << TagCnt));
+
+	ecs::World w;
+	cnt::sarray<ecs::Entity, TagCnt> tags{};
+	GAIA_FOR(TagCnt) tags[i] = w.add();
+
+	GAIA_FOR_(archetypeCnt, a) {
+		auto e = w.add();
+		auto builder = w.build(e);
+		builder.add<Position>();
+		GAIA_FOR(TagCnt) {
+			if ((a & (1U << i)) != 0)
+				builder.add(tags[i]);
+		}
+		builder.commit();
+	}
+
+	auto q = w.query().all<Position>();
+	dont_optimize(q.empty());
+
+	for (auto _: state) {
+		(void)_;
+		uint32_t sum = 0;
+		GAIA_FOR(CallsPerFrame) {
+			sum += q.count();
+			sum += (uint32_t)q.empty();
+		}
+		dont_optimize(sum);
+	}
+}
+
 void BM_Query_ReadWrite_2Comp_Readback(picobench::state& state) {
 	const uint32_t n = (uint32_t)state.user_data();
 	cnt::darray<ecs::Entity> entities;
@@ -88,6 +228,86 @@ void BM_Query_ReadWrite_2Comp_Readback(picobench::state& state) {
 	}
 }
 
+//! Benchmarks reading all matching positions either at once with arr() or in 5K slices with a query cursor.
+//! The cursor variant resumes each slice from the stored position so the total work should stay close to arr().
+template <bool UseCursor>
+void BM_Query_Read_Positions_Paged(picobench::state& state) {
+	static constexpr uint32_t PageSize = 5000;
+	const uint32_t n = (uint32_t)state.user_data();
+	cnt::darray<ecs::Entity> entities;
+	ecs::World w;
+	create_linear_entities<true, false, false, false, false>(w, entities, n);
+
+	auto q = w.query().all<Position>();
+	dont_optimize(q.empty());
+
+	cnt::darray<Position> positions;
+	positions.reserve(n);
+	for (auto _: state) {
+		(void)_;
+		positions.clear();
+		if constexpr (UseCursor) {
+			ecs::QueryCursor cursor;
+			while (q.next(cursor, positions, PageSize) != 0)
+				dont_optimize(positions.back());
+		} else {
+			q.arr(positions);
+		}
+		dont_optimize(positions.size());
+	}
+}
+
+void BM_Query_Read_Positions_Arr(picobench::state& state) {
+	BM_Query_Read_Positions_Paged<false>(state);
+}
+
+void BM_Query_Read_Positions_Cursor(picobench::state& state) {
+	BM_Query_Read_Positions_Paged<true>(state);
+}
+
+struct GatheredBody {
+	GAIA_LAYOUT(SoA);
+	ecs::Entity e;
+	Position p;
+	Velocity v;
+};
+
+//! Benchmarks snapshotting (Entity, Position, Velocity) of all matches into one dense buffer.
+//! The manual variant pushes every row from each(), gather() copies whole chunk columns.
+template <bool UseGather>
+void BM_Query_Gather_Bodies(picobench::state& state) {
+	const uint32_t n = (uint32_t)state.user_data();
+	cnt::darray<ecs::Entity> entities;
+	ecs::World w;
+	create_linear_entities<true, false, false, false, false>(w, entities, n);
+
+	auto q = w.query().all<Position>().all<Velocity>();
+	dont_optimize(q.empty());
+
+	cnt::darr_soa<GatheredBody> bodies;
+	bodies.reserve(n);
+	for (auto _: state) {
+		(void)_;
+		if constexpr (UseGather) {
+			q.gather(bodies);
+		} else {
+			bodies.clear();
+			q.each([&](ecs::Entity e, const Position& p, const Velocity& v) {
+				bodies.push_back({e, p, v});
+			});
+		}
+		dont_optimize(bodies.size());
+	}
+}
+
+void BM_Query_Gather_Bodies_Manual(picobench::state& state) {
+	BM_Query_Gather_Bodies<false>(state);
+}
+
+void BM_Query_Gather_Bodies_Gather(picobench::state& state) {
+	BM_Query_Gather_Bodies<true>(state);
+}
+
 void BM_Query_ReadWrite_2Comp_IterLocalReadback(picobench::state& state) {
 	const uint32_t n = (uint32_t)state.user_data();
 	cnt::darray<ecs::Entity> entities;
@@ -288,6 +508,53 @@ void BM_Query_Variable_Source_Unbound(picobench::state& state) {
 	BM_Query_Variable_Source<false>(state);
 }
 
+//! Benchmarks a variable-source query traversing ChildOf read after each reparent.
+//! Every root owns its own archetype, so the query sees one archetype per parent.
+void BM_Query_Variable_Source_Reparent(picobench::state& state) {
+	constexpr uint32_t ChildrenPerRoot = 10;
+	constexpr uint32_t ReparentsPerFrame = 16;
+	const uint32_t rootCnt = (uint32_t)state.user_data();
+
+	cnt::darray<ecs::Entity> roots;
+	cnt::darray<ecs::Entity> children;
+	roots.reserve(rootCnt);
+	children.reserve(rootCnt * ChildrenPerRoot);
+
+	ecs::World w;
+	GAIA_FOR(rootCnt) {
+		auto root = w.add();
+		if ((i & 1U) == 0U)
+			w.add<Health>(root, {100, 100});
+		roots.push_back(root);
+
+		GAIA_FOR_(ChildrenPerRoot, j) {
+			auto child = w.add();
+			w.add<Position>(child, {(float)j, 0.0f, 0.0f});
+			w.child(child, root);
+			children.push_back(child);
+		}
+	}
+
+	auto q = w.query()
+							 .all<Position>()
+							 .all(ecs::Pair(ecs::ChildOf, ecs::Var0))
+							 .all<Health>(ecs::QueryTermOptions{}.src(ecs::Var0).trav());
+	dont_optimize(q.empty());
+
+	uint32_t frame = 0;
+	for (auto _: state) {
+		(void)_;
+		uint32_t sum = 0;
+		GAIA_FOR(ReparentsPerFrame) {
+			const uint32_t idx = (frame * ReparentsPerFrame + i) % rootCnt;
+			w.child(children[idx * ChildrenPerRoot], roots[(idx * 7U + 1U) % rootCnt]);
+			sum += q.count();
+		}
+		++frame;
+		dont_optimize(sum);
+	}
+}
+
 //! Builds many distinct immediate cached structural queries, all of which should match the same new archetype.
 template <uint32_t TermsPerQuery = 1>
 void create_structural_cache_queries(
@@ -390,6 +657,262 @@ void BM_QueryCache_Create_Fanout_3q_8t(picobench::state& state) {
 	BM_QueryCache_Create_Fanout_Multi<8, 3>(state);
 }
 
+//! Benchmarks create-time matching of plain ALL/OR/NOT queries whose ids are shared by many archetypes.
+void BM_QueryCache_Create_PlainTerms(picobench::state& state) {
+	constexpr uint32_t QueryCnt = 64;
+	constexpr uint32_t TagCnt = 16;
+	constexpr uint32_t NewArchetypeCnt = 16;
+	const uint32_t archetypeCnt = (uint32_t)state.user_data();
+
+	for (auto _: state) {
+		(void)_;
+		state.stop_timer();
+
+		ecs::World w;
+		cnt::darray<ecs::Entity> tags;
+		tags.reserve(TagCnt);
+		GAIA_FOR(TagCnt) {
+			tags.push_back(w.add());
+		}
+
+		cnt::darray<ecs::Query> queries;
+		queries.reserve(QueryCnt);
+		GAIA_FOR(QueryCnt) {
+			auto q = w.query();
+			q.all(tags[0]);
+			q.all(tags[1 + (i % 7)]);
+			q.or_(tags[8 + (i % 4)]);
+			q.or_(tags[12 + (i % 3)]);
+			q.no(tags[15]);
+			dont_optimize(q.count());
+			queries.push_back(GAIA_MOV(q));
+		}
+
+		// Existing archetypes share the selector ids which makes per-id archetype lookups expensive
+		GAIA_FOR(archetypeCnt) {
+			auto e = w.add();
+			auto eb = w.build(e);
+			eb.add(tags[0]);
+			eb.add(tags[1 + (i % 7)]);
+			eb.add(w.add());
+			eb.commit();
+		}
+
+		cnt::darray<ecs::Entity> uniqueTags;
+		uniqueTags.reserve(NewArchetypeCnt);
+		GAIA_FOR(NewArchetypeCnt) {
+			uniqueTags.push_back(w.add());
+		}
+
+		state.start_timer();
+
+		GAIA_FOR(NewArchetypeCnt) {
+			auto e = w.add();
+			auto eb = w.build(e);
+			GAIA_FOR_(TagCnt - 1, j) {
+				eb.add(tags[j]);
+			}
+			eb.add(uniqueTags[i]);
+			eb.commit();
+		}
+
+		state.stop_timer();
+		dont_optimize(queries.back().count());
+	}
+}
+
+//! Benchmarks create-time routing of many new archetypes through thousands of cached plain-id queries.
+void BM_QueryCache_Create_ManyQueries(picobench::state& state) {
+	constexpr uint32_t QueryCnt = 5000;
+	constexpr uint32_t TagCnt = 256;
+	constexpr uint32_t TagsPerArchetype = 12;
+	const uint32_t archetypeCnt = (uint32_t)state.user_data();
+
+	for (auto _: state) {
+		(void)_;
+		state.stop_timer();
+
+		ecs::World w;
+		cnt::darray<ecs::Entity> tags;
+		tags.reserve(TagCnt);
+		GAIA_FOR(TagCnt) {
+			tags.push_back(w.add());
+		}
+
+		uint32_t seed = 1;
+		auto rnd = [&](uint32_t max) {
+			seed = seed * 1664525U + 1013904223U;
+			return (seed >> 8) % max;
+		};
+
+		// Low tag ids are popular so most queries get woken up by most archetypes
+		cnt::darray<ecs::Query> queries;
+		queries.reserve(QueryCnt);
+		GAIA_FOR(QueryCnt) {
+			auto q = w.query();
+			q.all(tags[rnd(16)]);
+			q.all(tags[rnd(TagCnt)]);
+			q.all(tags[rnd(TagCnt)]);
+			q.no(tags[rnd(TagCnt)]);
+			dont_optimize(q.count());
+			queries.push_back(GAIA_MOV(q));
+		}
+
+		cnt::darray<ecs::Entity> uniqueTags;
+		uniqueTags.reserve(archetypeCnt);
+		GAIA_FOR(archetypeCnt) {
+			uniqueTags.push_back(w.add());
+		}
+
+		state.start_timer();
+
+		GAIA_FOR(archetypeCnt) {
+			auto e = w.add();
+			auto eb = w.build(e);
+			GAIA_FOR_(TagsPerArchetype / 2, j) {
+				(void)j;
+				eb.add(tags[rnd(16)]);
+			}
+			GAIA_FOR_(TagsPerArchetype / 2, j) {
+				(void)j;
+				eb.add(tags[rnd(TagCnt)]);
+			}
+			eb.add(uniqueTags[i]);
+			eb.commit();
+		}
+
+		state.stop_timer();
+		dont_optimize(queries.back().count());
+	}
+}
+
+//! Benchmarks the first match of many cached queries against an already populated world.
+//! user_data: 0 = lazy matching on first read, 1 = serial warm-up, 2 = parallel warm-up.
+void BM_QueryCache_ColdStart(picobench::state& state) {
+	constexpr uint32_t QueryCnt = 1000;
+	constexpr uint32_t TagCnt = 128;
+	constexpr uint32_t ArchetypeCnt = 4000;
+	constexpr uint32_t TagsPerArchetype = 8;
+	const auto mode = (uint32_t)state.user_data();
+
+	for (auto _: state) {
+		(void)_;
+		state.stop_timer();
+
+		ecs::World w;
+		cnt::darray<ecs::Entity> tags;
+		tags.reserve(TagCnt);
+		GAIA_FOR(TagCnt) {
+			tags.push_back(w.add());
+		}
+
+		uint32_t seed = 1;
+		auto rnd = [&](uint32_t max) {
+			seed = seed * 1664525U + 1013904223U;
+			return (seed >> 8) % max;
+		};
+
+		GAIA_FOR(ArchetypeCnt) {
+			auto e = w.add();
+			auto eb = w.build(e);
+			GAIA_FOR_(TagsPerArchetype, j) {
+				(void)j;
+				eb.add(tags[rnd(TagCnt)]);
+			}
+			eb.add(w.add());
+			eb.commit();
+		}
+
+		cnt::darray<ecs::Query> queries;
+		queries.reserve(QueryCnt);
+		GAIA_FOR(QueryCnt) {
+			auto q = w.query();
+			q.all(tags[rnd(TagCnt)]);
+			q.all(tags[rnd(TagCnt)]);
+			q.no(tags[rnd(TagCnt)]);
+			(void)q.fetch();
+			queries.push_back(GAIA_MOV(q));
+		}
+
+		state.start_timer();
+
+		if (mode == 1)
+			dont_optimize(w.warm_query_caches(ecs::QueryExecType::Serial));
+		else if (mode == 2)
+			dont_optimize(w.warm_query_caches(ecs::QueryExecType::Parallel));
+		for (auto& q: queries)
+			dont_optimize(q.empty());
+
+		state.stop_timer();
+	}
+}
+
+//! Benchmarks creating cached queries at startup with and without plans stored by a previous run.
+void BM_QueryCache_Startup_Plans(picobench::state& state) {
+	constexpr uint32_t QueryCnt = 1000;
+	constexpr uint32_t TagCnt = 128;
+	const bool usePlans = state.user_data() != 0;
+
+	auto addTags = [](ecs::World& w, cnt::darray<ecs::Entity>& tags) {
+		tags.reserve(TagCnt);
+		GAIA_FOR(TagCnt) {
+			tags.push_back(w.add());
+		}
+	};
+	auto addQueries = [](ecs::World& w, const cnt::darray<ecs::Entity>& tags, cnt::darray<ecs::Query>& queries) {
+		uint32_t seed = 1;
+		auto rnd = [&](uint32_t max) {
+			seed = seed * 1664525U + 1013904223U;
+			return (seed >> 8) % max;
+		};
+
+		queries.reserve(QueryCnt);
+		GAIA_FOR(QueryCnt) {
+			auto q = w.query();
+			q.all(tags[rnd(TagCnt)]);
+			q.all(tags[rnd(TagCnt)]);
+			q.or_(tags[rnd(TagCnt)]);
+			q.or_(tags[rnd(TagCnt)]);
+			q.no(tags[rnd(TagCnt)]);
+			if (i % 4 == 0)
+				q.all(ecs::Pair(ecs::ChildOf, ecs::Var0));
+			(void)q.fetch();
+			queries.push_back(GAIA_MOV(q));
+		}
+	};
+
+	// Plans stored by the "previous run"
+	ser::bin_stream plans;
+	{
+		ecs::World w;
+		cnt::darray<ecs::Entity> tags;
+		cnt::darray<ecs::Query> queries;
+		addTags(w, tags);
+		addQueries(w, tags, queries);
+		w.save_query_plans(ser::make_serializer(plans));
+	}
+
+	for (auto _: state) {
+		(void)_;
+		state.stop_timer();
+
+		ecs::World w;
+		cnt::darray<ecs::Entity> tags;
+		cnt::darray<ecs::Query> queries;
+		addTags(w, tags);
+		if (usePlans) {
+			plans.seek(0);
+			(void)w.load_query_plans(ser::make_serializer(plans));
+		}
+
+		state.start_timer();
+
+		addQueries(w, tags, queries);
+
+		state.stop_timer();
+	}
+}
+
 //! Benchmarks batched builder archetype resolution where only the final archetype matters.
 void BM_EntityBuilder_BatchAdd_4(picobench::state& state) {
 	for (auto _: state) {
@@ -806,6 +1329,64 @@ void BM_QueryCache_ChangedConsume_IdenticalCached_Shared(picobench::state& state
 }
 
 //! Benchmarks repeated structural invalidation and cache refresh while entities churn between existing archetypes.
+//! Benchmarks consuming 1% sparse writes spread evenly across all chunks.
+//! The chunk-version path visits every row of each changed chunk, the per-row path visits only the dirty rows.
+template <typename T, bool PerRow>
+void BM_Query_Changed_SparseWrites(picobench::state& state) {
+	const uint32_t n = (uint32_t)state.user_data();
+	const uint32_t stride = 100;
+
+	ecs::World w;
+	cnt::darray<ecs::Entity> entities;
+	entities.reserve(n);
+	GAIA_FOR(n) {
+		auto e = w.add();
+		w.add<T>(e, {(float)i, 0.0f, 0.0f});
+		entities.push_back(e);
+	}
+
+	auto qChanged = w.query().all<T>().template changed<T>();
+	auto qAll = w.query().all<T>();
+	dont_optimize(qChanged.count());
+	w.clear_dirty_rows();
+
+	for (auto _: state) {
+		(void)_;
+		state.stop_timer();
+		for (uint32_t i = 0; i < n; i += stride)
+			w.set<T>(entities[i]) = {(float)i, 1.0f, 0.0f};
+		state.start_timer();
+
+		float sum = 0.0f;
+		if constexpr (PerRow) {
+			qAll.each([&](ecs::Iter& it) {
+				auto v = it.view<T>();
+				for (const auto run: it.template dirty_rows<T>()) {
+					for (uint32_t i = run.from; i < run.to; ++i)
+						sum += v[i].x + v[i].y;
+				}
+				it.template clear_dirty_rows<T>();
+			});
+		} else {
+			qChanged.each([&](ecs::Iter& it) {
+				auto v = it.view<T>();
+				GAIA_EACH(it) {
+					sum += v[i].x + v[i].y;
+				}
+			});
+		}
+		dont_optimize(sum);
+	}
+}
+
+void BM_Query_Changed_SparseWrites_ChunkVersion(picobench::state& state) {
+	BM_Query_Changed_SparseWrites<Position, false>(state);
+}
+
+void BM_Query_Changed_SparseWrites_PerRow(picobench::state& state) {
+	BM_Query_Changed_SparseWrites<PositionRowTracked, true>(state);
+}
+
 void BM_QueryCache_Invalidate_Churn(picobench::state& state) {
 	const uint32_t n = (uint32_t)state.user_data();
 
@@ -988,6 +1569,77 @@ void BM_QueryCache_Sorted_WarmRead(picobench::state& state) {
 	}
 }
 
+//! Benchmarks re-sorting a sorted query after every sort key was rewritten with pseudo-random values.
+//! Measures the whole archetype sort: key extraction, ordering and moving the rows into place.
+void BM_QueryCache_Sorted_Resort(picobench::state& state) {
+	const uint32_t n = (uint32_t)state.user_data();
+
+	ecs::World w;
+	cnt::darray<ecs::Entity> entities;
+	create_linear_entities<true, false, true, false, false>(w, entities, n);
+
+	auto q = w.query().all<Position>().all<Health>().sort_by<Position>(
+			[]([[maybe_unused]] const ecs::World& world, const void* pData0, const void* pData1) {
+				const auto& p0 = *static_cast<const Position*>(pData0);
+				const auto& p1 = *static_cast<const Position*>(pData1);
+				if (p0.x < p1.x)
+					return -1;
+				if (p0.x > p1.x)
+					return 1;
+				return 0;
+			});
+	auto qWrite = w.query().all<Position&>();
+	dont_optimize(q.count());
+
+	uint32_t rng = 0x12345678U;
+	for (auto _: state) {
+		(void)_;
+
+		state.stop_timer();
+		qWrite.each([&](Position& p) {
+			rng ^= rng << 13U;
+			rng ^= rng >> 17U;
+			rng ^= rng << 5U;
+			p.x = (float)(rng % 100000U);
+		});
+		state.start_timer();
+
+		dont_optimize(q.count());
+	}
+}
+
+//! Benchmarks the same re-sort as BM_QueryCache_Sorted_Resort with a projected key instead of a comparator.
+//! Keys are extracted once per row and radix-sorted.
+void BM_QueryCache_SortedKey_Resort(picobench::state& state) {
+	const uint32_t n = (uint32_t)state.user_data();
+
+	ecs::World w;
+	cnt::darray<ecs::Entity> entities;
+	create_linear_entities<true, false, true, false, false>(w, entities, n);
+
+	auto q = w.query().all<Position>().all<Health>().sort_by<Position>([](const Position& p) {
+		return p.x;
+	});
+	auto qWrite = w.query().all<Position&>();
+	dont_optimize(q.count());
+
+	uint32_t rng = 0x12345678U;
+	for (auto _: state) {
+		(void)_;
+
+		state.stop_timer();
+		qWrite.each([&](Position& p) {
+			rng ^= rng << 13U;
+			rng ^= rng >> 17U;
+			rng ^= rng << 5U;
+			p.x = (float)(rng % 100000U);
+		});
+		state.start_timer();
+
+		dont_optimize(q.count());
+	}
+}
+
 //! Benchmarks steady-state warm reads for a cached sorted query spanning many matching archetypes.
 //! This isolates the exact sortBy remap path that now uses the component index for exact sort terms.
 void BM_QueryCache_Sorted_ExactMergeWarmRead(picobench::state& state) {
@@ -3039,6 +3691,9 @@ void BM_QueryCache_Create_Fanout_3q_8t(picobench::state& state);
 void BM_QueryCache_Create_Fanout_7q_4t(picobench::state& state);
 void BM_QueryCache_Create_Fanout_Scaled_31(picobench::state& state);
 void BM_QueryCache_Create_Fanout_Scaled_31_4K(picobench::state& state);
+void BM_QueryCache_ColdStart(picobench::state& state);
+void BM_QueryCache_Create_ManyQueries(picobench::state& state);
+void BM_QueryCache_Create_PlainTerms(picobench::state& state);
 void BM_QueryCache_DirectSource_WarmRead_Default(picobench::state& state);
 void BM_QueryCache_DirectSource_WarmRead_SourceState(picobench::state& state);
 void BM_QueryCache_DynamicRelation_WarmRead(picobench::state& state);
@@ -3060,6 +3715,7 @@ void BM_QueryCache_SourceTraversal_WarmRead_Lazy(picobench::state& state);
 void BM_QueryCache_SourceTraversal_WarmRead_SmallClosure(picobench::state& state);
 void BM_QueryCache_SourceTraversal_WarmRead_Snapshotted(picobench::state& state);
 void BM_QueryCache_SourceOnly_WarmRead(picobench::state& state);
+void BM_QueryCache_Startup_Plans(picobench::state& state);
 void BM_QueryCache_Wildcard_WarmRead(picobench::state& state);
 void BM_QueryCompile_Variable_1VarOrSource_Uncached(picobench::state& state);
 void BM_QueryCompile_Variable_1VarSource_Uncached(picobench::state& state);
@@ -3112,14 +3768,20 @@ void BM_Query_PrefabHealthPosition_Read_Each_Inherited_Override50(picobench::sta
 void BM_Query_PrefabHealthPosition_Read_ColdEach_Inherited(picobench::state& state);
 void BM_Query_ReadOnly_1Comp(picobench::state& state);
 void BM_Query_ReadWrite_2Comp(picobench::state& state);
+void BM_Query_Count_Repeated(picobench::state& state);
 void BM_Query_ReadWrite_2Comp_Readback(picobench::state& state);
 void BM_Query_ReadWrite_2Comp_IterLocalReadback(picobench::state& state);
+void BM_Query_Read_Positions_Arr(picobench::state& state);
+void BM_Query_Read_Positions_Cursor(picobench::state& state);
+void BM_Query_Gather_Bodies_Manual(picobench::state& state);
+void BM_Query_Gather_Bodies_Gather(picobench::state& state);
 void BM_Query_ReadWrite_2Comp_IterHelper(picobench::state& state);
 void BM_Query_ReadWrite_2Comp_EachArchLocalAccum(picobench::state& state);
 void BM_Query_ReadWrite_4Comp(picobench::state& state);
 void BM_Query_SelectiveAll_BroadFirst(picobench::state& state);
 void BM_Query_Variable_Source_Bound(picobench::state& state);
 void BM_Query_Variable_Source_Unbound(picobench::state& state);
+void BM_Query_Variable_Source_Reparent(picobench::state& state);
 
 void register_query_hot_path(PerfRunMode mode) {
 	switch (mode) {
@@ -3146,10 +3808,40 @@ void register_query_hot_path(PerfRunMode mode) {
 					.user_data(1024)
 					.label("query selective all broad-first 1K arch");
 			PICOBENCH_REG(BM_Query_ReadWrite_2Comp).PICO_SETTINGS().user_data(NEntitiesMedium).label("rw 2 comp");
+			PICOBENCH_REG(BM_Query_ReadWrite_2Comp_WithLargeComp_Inline)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesFew)
+					.label("rw 2 comp + 2K inline comp 10K");
+			PICOBENCH_REG(BM_Query_ReadWrite_2Comp_WithLargeComp_Cold)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesFew)
+					.label("rw 2 comp + 2K cold comp 10K");
+			PICOBENCH_REG(BM_Query_ReadWrite_2Comp_ManySmallArchetypes_Each)
+					.PICO_SETTINGS()
+					.user_data(1024)
+					.label("rw 2 comp 1K arch x 8 each");
+			PICOBENCH_REG(BM_Query_ReadWrite_2Comp_ManySmallArchetypes_Iter)
+					.PICO_SETTINGS()
+					.user_data(1024)
+					.label("rw 2 comp 1K arch x 8 iter");
+			PICOBENCH_REG(BM_Query_Count_Repeated).PICO_SETTINGS().user_data(1024).label("count+empty x100 1K arch");
 			PICOBENCH_REG(BM_Query_ReadWrite_2Comp_Readback)
 					.PICO_SETTINGS()
 					.user_data(NEntitiesMedium)
 					.label("rw 2 comp typed captured readback");
+			PICOBENCH_REG(BM_Query_Read_Positions_Arr).PICO_SETTINGS().user_data(NEntitiesMedium).label("read pos arr");
+			PICOBENCH_REG(BM_Query_Read_Positions_Cursor)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesMedium)
+					.label("read pos cursor 5K pages");
+			PICOBENCH_REG(BM_Query_Gather_Bodies_Manual)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesMedium)
+					.label("gather bodies, each + push");
+			PICOBENCH_REG(BM_Query_Gather_Bodies_Gather)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesMedium)
+					.label("gather bodies, gather()");
 			PICOBENCH_REG(BM_Query_ReadWrite_2Comp_IterLocalReadback)
 					.PICO_SETTINGS()
 					.user_data(NEntitiesMedium)
@@ -3238,6 +3930,10 @@ void register_query_hot_path(PerfRunMode mode) {
 					.PICO_SETTINGS()
 					.user_data(NEntitiesMedium)
 					.label("var source (unbound)");
+			PICOBENCH_REG(BM_Query_Variable_Source_Reparent)
+					.PICO_SETTINGS()
+					.user_data(1000)
+					.label("var source trav, reparent + count 1K parents");
 
 			PICOBENCH_SUITE_REG("Query cache maintenance");
 			PICOBENCH_REG(BM_QueryContext_Build_Direct_128q_4t).PICO_SETTINGS_FOCUS().label("query build direct 128q 4t");
@@ -3278,6 +3974,26 @@ void register_query_hot_path(PerfRunMode mode) {
 					.PICO_SETTINGS_FOCUS()
 					.user_data(4096)
 					.label("create fanout 3q 8t 4K arch");
+			PICOBENCH_REG(BM_QueryCache_Create_PlainTerms)
+					.PICO_SETTINGS_FOCUS()
+					.user_data(1024)
+					.label("create plain all/or/not 64q 1K arch");
+			PICOBENCH_REG(BM_QueryCache_Create_PlainTerms)
+					.PICO_SETTINGS_FOCUS()
+					.user_data(4096)
+					.label("create plain all/or/not 64q 4K arch");
+			PICOBENCH_REG(BM_QueryCache_Create_ManyQueries)
+					.PICO_SETTINGS_HEAVY()
+					.user_data(10000)
+					.label("create 10K arch 5K queries");
+			PICOBENCH_REG(BM_QueryCache_ColdStart).PICO_SETTINGS_HEAVY().user_data(0).label("cold start 1K queries lazy");
+			PICOBENCH_REG(BM_QueryCache_ColdStart).PICO_SETTINGS_HEAVY().user_data(1).label("cold start 1K queries warm");
+			PICOBENCH_REG(BM_QueryCache_ColdStart)
+					.PICO_SETTINGS_HEAVY()
+					.user_data(2)
+					.label("cold start 1K queries warm par");
+			PICOBENCH_REG(BM_QueryCache_Startup_Plans).PICO_SETTINGS_HEAVY().user_data(0).label("startup 1K queries compile");
+			PICOBENCH_REG(BM_QueryCache_Startup_Plans).PICO_SETTINGS_HEAVY().user_data(1).label("startup 1K queries plans");
 			PICOBENCH_REG(BM_EntityBuilder_BatchAdd_4).PICO_SETTINGS_FOCUS().label("builder batch add 4");
 			PICOBENCH_REG(BM_QueryCache_NoSource_WarmRead_Default)
 					.PICO_SETTINGS()
@@ -3335,6 +4051,14 @@ void register_query_hot_path(PerfRunMode mode) {
 					.PICO_SETTINGS_FOCUS()
 					.user_data(128)
 					.label("changed consume identical shared 128q");
+			PICOBENCH_REG(BM_Query_Changed_SparseWrites_ChunkVersion)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesMedium)
+					.label("changed 1% writes chunk version");
+			PICOBENCH_REG(BM_Query_Changed_SparseWrites_PerRow)
+					.PICO_SETTINGS()
+					.user_data(NEntitiesMedium)
+					.label("changed 1% writes per row");
 			PICOBENCH_REG(BM_QueryCache_Invalidate_Churn)
 					.PICO_SETTINGS_FOCUS()
 					.user_data(NEntitiesMedium)
@@ -3355,6 +4079,14 @@ void register_query_hot_path(PerfRunMode mode) {
 					.PICO_SETTINGS_FOCUS()
 					.user_data(NEntitiesFew)
 					.label("sorted warm read 10K");
+			PICOBENCH_REG(BM_QueryCache_Sorted_Resort)
+					.PICO_SETTINGS_FOCUS()
+					.user_data(NEntitiesMedium)
+					.label("sorted resort 100K");
+			PICOBENCH_REG(BM_QueryCache_SortedKey_Resort)
+					.PICO_SETTINGS_FOCUS()
+					.user_data(NEntitiesMedium)
+					.label("sorted key resort 100K");
 			PICOBENCH_REG(BM_QueryCache_Sorted_ExactMergeWarmRead)
 					.PICO_SETTINGS_FOCUS()
 					.user_data(NEntitiesFew)
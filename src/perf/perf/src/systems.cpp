@@ -81,6 +81,56 @@ void BM_SystemFrame_Identical_Shared_16(picobench::state& state) {
 	BM_SystemFrame_Identical<ecs::QueryCacheScope::Shared, 16>(state);
 }
 
+template <bool Fuse>
+void BM_SystemFrame_PhaseFusion(picobench::state& state) {
+	const uint32_t n = (uint32_t)state.user_data();
+
+	ecs::World w;
+	cnt::darray<ecs::Entity> entities;
+	create_linear_entities<true, true, false, false, true>(w, entities, n);
+
+	// Three systems streaming Position from the same chunks
+	const auto phase = w.add();
+	w.phase_fusion(phase, Fuse);
+
+	float sink = 0.0f;
+	w.system().phase(phase).all<Position&>().all<Velocity>().on_each([](ecs::Iter& it) {
+		auto p = it.view_mut<Position>(0);
+		auto v = it.view<Velocity>(1);
+
+		const auto cnt = it.size();
+		GAIA_FOR(cnt) {
+			p[i].x += v[i].x * DeltaTime;
+			p[i].y += v[i].y * DeltaTime;
+			p[i].z += v[i].z * DeltaTime;
+		}
+	});
+	w.system().phase(phase).all<Position>().all<Acceleration&>().on_each([](const Position& p, Acceleration& a) {
+		a.y = -p.y * 0.001f;
+	});
+	w.system().phase(phase).all<Position>().all<Mass>().on_each([&sink](const Position& p, const Mass& m) {
+		sink += p.x * m.value;
+	});
+
+	for (uint32_t i = 0U; i < 4U; ++i)
+		w.update();
+
+	for (auto _: state) {
+		(void)_;
+		w.update();
+	}
+
+	dont_optimize(sink);
+}
+
+void BM_SystemFrame_PhaseFusion_Off(picobench::state& state) {
+	BM_SystemFrame_PhaseFusion<false>(state);
+}
+
+void BM_SystemFrame_PhaseFusion_On(picobench::state& state) {
+	BM_SystemFrame_PhaseFusion<true>(state);
+}
+
 template <uint32_t ChainDepth>
 ecs::Entity create_is_fanout_fixture(ecs::World& w, uint32_t branches, bool attachPositionToLeavesOnly) {
 	const auto root = w.add();
@@ -419,6 +469,14 @@ void register_systems(PerfRunMode mode) {
 					.PICO_SETTINGS_FOCUS()
 					.user_data(NEntitiesMedium)
 					.label("identical shared 16 systems");
+			PICOBENCH_REG(BM_SystemFrame_PhaseFusion_Off)
+					.PICO_SETTINGS_FOCUS()
+					.user_data(NEntitiesMedium)
+					.label("phase fusion off, 3 systems");
+			PICOBENCH_REG(BM_SystemFrame_PhaseFusion_On)
+					.PICO_SETTINGS_FOCUS()
+					.user_data(NEntitiesMedium)
+					.label("phase fusion on, 3 systems");
 			PICOBENCH_REG(BM_System_Is_Semantic_D2).PICO_SETTINGS_FOCUS().user_data(1024).label("is semantic d2");
 			PICOBENCH_REG(BM_System_Is_Direct_D2).PICO_SETTINGS_FOCUS().user_data(1024).label("is direct d2");
 			PICOBENCH_REG(BM_System_Is_Semantic_D8).PICO_SETTINGS_FOCUS().user_data(1024).label("is semantic d8");
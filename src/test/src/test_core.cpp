@@ -3301,6 +3301,123 @@ TEST_CASE("Sort avoids quadratic ordered and duplicate-heavy inputs") {
 
 }
 
+TEST_CASE("Merge sort is stable") {
+	// Keys in the upper bits, original position in the lower bits
+	cnt::darray<uint32_t> arr(1000);
+	cnt::darray<uint32_t> tmp(1000);
+	uint32_t rng = 0x12345678U;
+	GAIA_FOR(arr.size()) {
+		rng ^= rng << 13U;
+		rng ^= rng >> 17U;
+		rng ^= rng << 5U;
+		arr[i] = ((rng % 37U) << 16U) | i;
+	}
+
+	uint32_t comparisons = 0;
+	core::merge_sort(arr.data(), arr.data() + arr.size(), tmp.data(), [&](uint32_t lhs, uint32_t rhs) {
+		++comparisons;
+		return (lhs >> 16U) < (rhs >> 16U);
+	});
+
+	// Equal keys keep their original order, so the whole value ends up ascending
+	for (uint32_t i = 1; i < arr.size(); ++i)
+		CHECK(arr[i - 1] < arr[i]);
+	CHECK(comparisons < 20000);
+
+	// Sorted input needs only the insertion passes and linear merges
+	comparisons = 0;
+	core::merge_sort(arr.data(), arr.data() + arr.size(), tmp.data(), [&](uint32_t lhs, uint32_t rhs) {
+		++comparisons;
+		return lhs < rhs;
+	});
+	for (uint32_t i = 1; i < arr.size(); ++i)
+		CHECK(arr[i - 1] < arr[i]);
+	CHECK(comparisons < 10000);
+
+	// Nothing to do for empty and single-element ranges
+	core::merge_sort(arr.data(), arr.data(), tmp.data(), [](uint32_t lhs, uint32_t rhs) {
+		return lhs < rhs;
+	});
+	core::merge_sort(arr.data(), arr.data() + 1, tmp.data(), [](uint32_t lhs, uint32_t rhs) {
+		return lhs < rhs;
+	});
+}
+
+TEST_CASE("Radix key preserves order") {
+	CHECK(core::radix_key(-2) < core::radix_key(-1));
+	CHECK(core::radix_key(-1) < core::radix_key(0));
+	CHECK(core::radix_key(0) < core::radix_key(1));
+	CHECK(core::radix_key((int64_t)-5) < core::radix_key((int64_t)3));
+	CHECK(core::radix_key(-10.5f) < core::radix_key(-1.0f));
+	CHECK(core::radix_key(-1.0f) < core::radix_key(-0.0f));
+	CHECK(core::radix_key(0.0f) < core::radix_key(0.5f));
+	CHECK(core::radix_key(0.5f) < core::radix_key(100.0f));
+	CHECK(core::radix_key(-3.0) < core::radix_key(2.0));
+	CHECK(core::radix_key(false) < core::radix_key(true));
+	CHECK(core::radix_key(7U) == 7U);
+}
+
+TEST_CASE("Radix key pack") {
+	enum class Prio : uint8_t { Low, High };
+
+	// Single values keep their order
+	CHECK(core::radix_key_pack(-1.0f) < core::radix_key_pack(0.5f));
+	CHECK(core::radix_key_pack(Prio::Low) < core::radix_key_pack(Prio::High));
+
+	// The first element is the most significant one
+	CHECK(core::radix_key_pack(std::make_tuple(false, 1000.f)) < core::radix_key_pack(std::make_tuple(true, -1000.f)));
+	CHECK(core::radix_key_pack(std::make_tuple(true, -1.f)) < core::radix_key_pack(std::make_tuple(true, 1.f)));
+	CHECK(core::radix_key_pack(std::make_pair(-1, 2U)) < core::radix_key_pack(std::make_pair(0, 1U)));
+	CHECK(core::radix_key_pack(std::make_pair(0, 1U)) < core::radix_key_pack(std::make_pair(0, 2U)));
+	CHECK(
+			core::radix_key_pack(std::make_tuple(Prio::High, (int16_t)-3, 7.0f)) <
+			core::radix_key_pack(std::make_tuple(Prio::High, (int16_t)-2, -7.0f)));
+
+	// 64-bit values fill the whole key
+	CHECK(core::radix_key_pack((int64_t)-1) < core::radix_key_pack((int64_t)0));
+	CHECK(core::radix_key_pack(std::make_tuple(~0ULL)) == ~0ULL);
+}
+
+TEST_CASE("Radix sort") {
+	constexpr uint32_t N = 2000;
+	cnt::darray<float> values(N);
+	cnt::darray<uint32_t> keys(N);
+	cnt::darray<uint32_t> idx(N);
+	cnt::darray<uint32_t> keysTmp(N);
+	cnt::darray<uint32_t> idxTmp(N);
+	uint32_t rng = 0x12345678U;
+	GAIA_FOR(N) {
+		rng ^= rng << 13U;
+		rng ^= rng >> 17U;
+		rng ^= rng << 5U;
+		// Plenty of duplicates and both signs
+		values[i] = (float)(int32_t)(rng % 201U) - 100.0f;
+		keys[i] = core::radix_key(values[i]);
+		idx[i] = i;
+	}
+
+	core::radix_sort(keys.data(), idx.data(), keysTmp.data(), idxTmp.data(), N);
+
+	for (uint32_t i = 1; i < N; ++i) {
+		const auto prev = idx[i - 1];
+		const auto curr = idx[i];
+		CHECK(values[prev] <= values[curr]);
+		// Stable
+		if (values[prev] == values[curr])
+			CHECK(prev < curr);
+		CHECK(keys[i] == core::radix_key(values[curr]));
+	}
+
+	// Keys sharing all bytes but the lowest one only need a single pass
+	GAIA_FOR(N) {
+		keys[i] = 0xABCD0000U | ((N - i) & 0xFFU);
+		idx[i] = i;
+	}
+	core::radix_sort(keys.data(), idx.data(), keysTmp.data(), idxTmp.data(), N);
+	for (uint32_t i = 1; i < N; ++i)
+		CHECK(keys[i - 1] <= keys[i]);
+}
+
 //-----------------------------------------------------------------
 
 namespace {
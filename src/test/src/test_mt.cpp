@@ -595,6 +595,50 @@ TEST_CASE("Multithreading - ScheduleParallelRef") {
 	CHECK(ctx.batches.load(std::memory_order_relaxed) >= 1);
 }
 
+TEST_CASE("Multithreading - NUMA node hints") {
+	const auto nodeCnt = mt::numa_node_cnt();
+	CHECK(nodeCnt >= 1);
+	CHECK(nodeCnt <= mt::MaxNumaNodes);
+	CHECK(mt::numa_curr_node() < nodeCnt);
+
+	TestWorld twld;
+
+	constexpr uint32_t EntityCount = 1000;
+	GAIA_FOR(EntityCount) {
+		auto e = wld.add();
+		wld.add<ExternalExecProbeComp>(e, {i});
+		if (i % 2 == 0)
+			wld.add<Position>(e, {(float)i, 0, 0});
+	}
+
+	// Every archetype has a home node
+	auto q = wld.query().all<ExternalExecProbeComp>();
+	q.each([&](ecs::Iter& it) {
+		CHECK(it.archetype()->numa_node() < nodeCnt);
+	});
+
+	// Chunk allocator pages are accounted per node
+	{
+		const auto stats = ecs::ChunkAllocator::get().stats();
+		uint64_t pagesTotal = 0;
+		uint64_t pagesPerNode = 0;
+		for (const auto& s: stats.stats)
+			pagesTotal += s.num_pages;
+		for (auto cnt: stats.num_pages_node)
+			pagesPerNode += cnt;
+		CHECK(pagesTotal == pagesPerNode);
+	}
+
+	// Parallel queries still visit every entity once
+	std::atomic_uint32_t cnt = 0;
+	q.each(
+			[&](const ExternalExecProbeComp&) {
+				cnt.fetch_add(1, std::memory_order_relaxed);
+			},
+			ecs::QueryExecType::Parallel);
+	CHECK(cnt.load(std::memory_order_relaxed) == EntityCount);
+}
+
 TEST_CASE("ECS - Query uses external scheduler") {
 	TestWorld twld;
 	ExternalSchedProbe probe;
@@ -821,6 +865,106 @@ TEST_CASE("ECS - System update treats main-thread systems as job barriers") {
 	CHECK(afterHits == EntityCount);
 }
 
+TEST_CASE("ECS - Warm query caches through the scheduler") {
+	TestWorld twld;
+	ExternalSchedProbe probe;
+	wld.set_sched(probe.sched());
+
+	const auto rel = wld.add();
+	const auto tgt = wld.add();
+
+	auto qPos = wld.query().all<Position>();
+	auto qPosAcc = wld.query().all<Position>().all<Acceleration>();
+	auto qPosNoAcc = wld.query().all<Position>().no<Acceleration>();
+	auto qGrouped = wld.query().all<Position>().group_by(rel);
+	auto& infoPos = qPos.fetch();
+	auto& infoPosAcc = qPosAcc.fetch();
+	auto& infoPosNoAcc = qPosNoAcc.fetch();
+	auto& infoGrouped = qGrouped.fetch();
+
+	constexpr uint32_t EntityCount = 9;
+	GAIA_FOR(EntityCount) {
+		auto e = wld.add();
+		wld.add<Position>(e, {float(i), 0.0F, 0.0F});
+		if (i % 3 == 0)
+			wld.add<Acceleration>(e, {1.0F, 0.0F, 0.0F});
+		if (i % 3 == 1)
+			wld.add(e, ecs::Pair(rel, tgt));
+	}
+
+	CHECK(wld.warm_query_caches(ecs::QueryExecType::ParallelPerf) >= 4);
+	CHECK(probe.runParallelCalls == 1);
+	CHECK(probe.waitCalls == 1);
+	CHECK(probe.delCalls == 1);
+	CHECK(probe.lastExecType == ecs::QueryExecType::ParallelPerf);
+	CHECK(probe.itemsProcessed == probe.lastItemCount);
+	// The grouped query is matched on the caller thread, the plain ones by the scheduler
+	CHECK(probe.lastItemCount >= 3);
+
+	const auto passPos = infoPos.test_match_pass_count();
+	const auto passPosAcc = infoPosAcc.test_match_pass_count();
+	const auto passPosNoAcc = infoPosNoAcc.test_match_pass_count();
+	const auto passGrouped = infoGrouped.test_match_pass_count();
+	CHECK(passPos == 1);
+	CHECK(passPosAcc == 1);
+	CHECK(passPosNoAcc == 1);
+	CHECK(passGrouped == 1);
+
+	// Warmed caches are used as they are
+	CHECK(qPos.count() == EntityCount);
+	CHECK(qPosAcc.count() == 3);
+	CHECK(qPosNoAcc.count() == 6);
+	CHECK(qGrouped.count() == EntityCount);
+	CHECK(infoPos.test_match_pass_count() == passPos);
+	CHECK(infoPosAcc.test_match_pass_count() == passPosAcc);
+	CHECK(infoPosNoAcc.test_match_pass_count() == passPosNoAcc);
+	CHECK(infoGrouped.test_match_pass_count() == passGrouped);
+	CHECK(wld.verify_query_cache());
+
+	// Nothing changed so a second warm-up does not run the matcher again
+	(void)wld.warm_query_caches(ecs::QueryExecType::Serial);
+	CHECK(probe.runParallelCalls == 1);
+	CHECK(infoPos.test_match_pass_count() == passPos);
+	CHECK(infoGrouped.test_match_pass_count() == passGrouped);
+}
+
+TEST_CASE("ECS - Warm query caches of the first phase") {
+	TestWorld twld;
+
+	GAIA_FOR(5) {
+		auto e = wld.add();
+		wld.add<Rotation>(e);
+		if (i % 2 == 0)
+			wld.add<Scale>(e);
+	}
+
+	const auto phaseA = wld.add();
+	const auto phaseB = wld.add();
+	wld.add(phaseB, {ecs::DependsOn, phaseA});
+
+	// phaseB depends on phaseA, so its systems are scheduled first
+	auto sysA = wld.system().phase(phaseA).all<Scale>().on_each([](ecs::Iter&) {}).entity();
+	auto sysB = wld.system().phase(phaseB).all<Rotation>().on_each([](ecs::Iter&) {}).entity();
+	auto qOther = wld.query().all<Rotation>().all<Scale>();
+	auto& infoOther = qOther.fetch();
+
+	auto system_query_info = [&](ecs::Entity sys) -> ecs::QueryInfo& {
+		return wld.acc_mut(sys).smut<ecs::System_>().query.fetch();
+	};
+
+	CHECK(wld.warm_query_caches(ecs::QueryExecType::Parallel, ecs::QueryWarmScope::FirstPhase) == 1);
+	CHECK(system_query_info(sysB).test_match_pass_count() == 1);
+	CHECK(system_query_info(sysA).test_match_pass_count() == 0);
+	CHECK(infoOther.test_match_pass_count() == 0);
+
+	CHECK(wld.warm_query_caches(ecs::QueryExecType::Parallel) >= 3);
+	CHECK(system_query_info(sysB).test_match_pass_count() == 1);
+	CHECK(system_query_info(sysA).test_match_pass_count() == 1);
+	CHECK(infoOther.test_match_pass_count() == 1);
+	CHECK(qOther.count() == 3);
+	CHECK(wld.verify_query_cache());
+}
+
 template <typename TQueue>
 void TestJobQueue_PushPopSteal(bool reverse) {
 	mt::JobHandle handle;
@@ -1880,3 +2024,36 @@ TEST_CASE("Multithreading - Handle reuse mixed delete modes") {
 	CHECK(autoCnt.load(std::memory_order_relaxed) == Iters);
 	CHECK(manualCnt.load(std::memory_order_relaxed) == Iters);
 }
+
+struct GatheredPosition {
+	GAIA_LAYOUT(SoA);
+	ecs::Entity e;
+	Position p;
+};
+
+TEST_CASE("ECS - Parallel query gather and scatter") {
+	TestWorld twld;
+
+	constexpr uint32_t N = 10000;
+	GAIA_FOR(N) {
+		auto e = wld.add();
+		wld.add<Position>(e, {(float)i, 0, 0});
+		if (i % 2 == 0)
+			wld.add<Scale>(e);
+	}
+
+	auto q = wld.query().all<Position&>();
+	cnt::darr_soa<GatheredPosition> rows;
+	CHECK(q.gather(rows, ecs::QueryExecType::Parallel) == N);
+
+	auto pm = rows.view_mut<1>();
+	GAIA_FOR(N) pm[i].y = pm[i].x * 2.f;
+	CHECK(q.scatter(rows, ecs::QueryExecType::Parallel) == N);
+
+	uint32_t mismatches = 0;
+	wld.query().all<Position>().each([&](const Position& p) {
+		if (p.y != p.x * 2.f)
+			++mismatches;
+	});
+	CHECK(mismatches == 0);
+}
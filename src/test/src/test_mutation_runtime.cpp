@@ -1,5 +1,7 @@
 #include "test_common.h"
 
+#include <thread>
+
 namespace {
 	//! Marker type used by tests to request World::uquery().
 	struct QueryUncached {};
@@ -674,7 +676,9 @@ TEST_CASE("Components - non trivial") {
 #if GAIA_ECS_CHUNK_ALLOCATOR
 TEST_CASE("ChunkAllocator") {
 	SUBCASE("size class thresholds") {
-		CHECK(ecs::mem_block_size_type(1) == 0);
+		CHECK(ecs::mem_block_size_type(1) == ecs::TinyMemoryBlockSizeType);
+		CHECK(ecs::mem_block_size_type(ecs::TinyMemoryBlockSize) == ecs::TinyMemoryBlockSizeType);
+		CHECK(ecs::mem_block_size_type(ecs::TinyMemoryBlockSize + 1) == 0);
 		CHECK(ecs::mem_block_size_type(ecs::MinMemoryBlockSize) == 0);
 		CHECK(ecs::mem_block_size_type(ecs::MinMemoryBlockSize + 1) == 1);
 		CHECK(ecs::mem_block_size_type(ecs::MinMemoryBlockSize * 2) == 1);
@@ -893,21 +897,22 @@ TEST_CASE("ChunkAllocator") {
 		auto& alloc = ecs::ChunkAllocator::get();
 		alloc.flush(true);
 
-		void* p8k = alloc.alloc(64);
+		constexpr auto Tiny = ecs::TinyMemoryBlockSizeType;
+		void* p2k = alloc.alloc(64);
 		void* p16k = alloc.alloc(ecs::MinMemoryBlockSize + 64);
 		void* p32k = alloc.alloc(ecs::MinMemoryBlockSize * 2 + 64);
 
 		{
 			const auto stats = alloc.stats();
-			CHECK(stats.stats[0].mem_used == ecs::mem_block_size(0));
+			CHECK(stats.stats[Tiny].mem_used == ecs::mem_block_size(Tiny));
 			CHECK(stats.stats[1].mem_used == ecs::mem_block_size(1));
 			CHECK(stats.stats[2].mem_used == ecs::mem_block_size(2));
-			CHECK(stats.stats[0].mem_requested == 64);
+			CHECK(stats.stats[Tiny].mem_requested == 64);
 			CHECK(stats.stats[1].mem_requested == ecs::MinMemoryBlockSize + 64);
 			CHECK(stats.stats[2].mem_requested == ecs::MinMemoryBlockSize * 2 + 64);
 		}
 
-		alloc.free(p8k);
+		alloc.free(p2k);
 		alloc.free(p16k);
 		alloc.free(p32k);
 		alloc.flush(true);
@@ -992,6 +997,180 @@ TEST_CASE("ChunkAllocator") {
 	}
 	#endif
 
+	SUBCASE("thread caches recycle blocks without touching shared pages") {
+		auto& alloc = ecs::ChunkAllocator::get();
+		alloc.flush(true);
+		alloc.set_thread_caches(true);
+		CHECK(alloc.thread_caches());
+
+		const auto statsBefore = alloc.thread_cache_stats();
+
+		// The first allocation misses and refills the magazine with a whole batch
+		void* p0 = alloc.alloc(ecs::MinMemoryBlockSize);
+		{
+			const auto stats = alloc.stats();
+			CHECK(stats.num_caches >= 1);
+			CHECK(stats.stats[0].num_pages == 1);
+			CHECK(stats.stats[0].num_blocks_cached == ecs::ChunkAllocatorCacheBatch - 1);
+			CHECK(stats.stats[0].mem_used == (uint64_t)ecs::mem_block_size(0) * ecs::ChunkAllocatorCacheBatch);
+		}
+
+		// Following allocations are served by the cache
+		void* blocks[ecs::ChunkAllocatorCacheBatch - 1]{};
+		for (auto& p: blocks)
+			p = alloc.alloc(ecs::MinMemoryBlockSize);
+		{
+			const auto cacheStats = alloc.thread_cache_stats();
+			CHECK(cacheStats.misses[0] - statsBefore.misses[0] == 1);
+			CHECK(cacheStats.hits[0] - statsBefore.hits[0] == ecs::ChunkAllocatorCacheBatch - 1);
+			CHECK(cacheStats.num_blocks[0] == 0);
+			CHECK(cacheStats.hit_rate(0) > 0.0);
+		}
+
+		// Freed blocks stay in the cache
+		alloc.free(p0);
+		for (auto* p: blocks)
+			alloc.free(p);
+		{
+			const auto cacheStats = alloc.thread_cache_stats();
+			CHECK(cacheStats.num_blocks[0] == ecs::ChunkAllocatorCacheBatch);
+			const auto stats = alloc.stats();
+			CHECK(stats.stats[0].num_blocks_cached == ecs::ChunkAllocatorCacheBatch);
+		}
+
+		// Overflowing the magazine returns a batch to the shared pages
+		void* many[ecs::ChunkAllocatorCacheBlocks + 1]{};
+		for (auto& p: many)
+			p = alloc.alloc(ecs::MinMemoryBlockSize);
+		for (auto* p: many)
+			alloc.free(p);
+		CHECK(alloc.thread_cache_stats().num_blocks[0] <= ecs::ChunkAllocatorCacheBlocks);
+		alloc.verify();
+
+		// Disabling the caches hands everything back
+		alloc.set_thread_caches(false);
+		{
+			const auto stats = alloc.stats();
+			CHECK(stats.stats[0].num_blocks_cached == 0);
+			CHECK(stats.stats[0].mem_used == 0);
+		}
+		alloc.flush(true);
+		CHECK(alloc.stats().stats[0].num_pages == 0);
+	}
+
+	SUBCASE("thread caches with concurrent allocations") {
+		auto& alloc = ecs::ChunkAllocator::get();
+		alloc.flush(true);
+		alloc.set_thread_caches(true);
+
+		constexpr uint32_t NThreads = 4;
+		constexpr uint32_t NBlocks = 200;
+		std::thread threads[NThreads];
+		GAIA_FOR(NThreads) {
+			threads[i] = std::thread([i, &alloc]() {
+				rnd::pseudo_random rng(i + 1);
+				void* blocks[NBlocks]{};
+				GAIA_FOR_(20, j) {
+					for (auto& p: blocks) {
+						const auto sizeType = rng.range(0, ecs::MemoryBlockSizeClasses - 1);
+						p = alloc.alloc(ecs::mem_block_size(sizeType));
+						*(uint32_t*)p = j;
+					}
+					for (auto* p: blocks) {
+						CHECK(*(uint32_t*)p == j);
+						alloc.free(p);
+					}
+				}
+			});
+		}
+		for (auto& t: threads)
+			t.join();
+
+		// Caches of finished threads were returned to the shared pages
+		alloc.set_thread_caches(false);
+		alloc.verify();
+		const auto stats = alloc.stats();
+		for (const auto& s: stats.stats) {
+			CHECK(s.num_blocks_cached == 0);
+			CHECK(s.mem_used == 0);
+		}
+		alloc.flush(true);
+	}
+
+	#if GAIA_ECS_CHUNK_ARENA
+	SUBCASE("arena carves pages contiguously and reuses released ranges") {
+		auto& alloc = ecs::ChunkAllocator::get();
+		alloc.flush(true);
+
+		constexpr uint64_t ReserveBytes = 64ull * 1024 * 1024;
+		REQUIRE(alloc.set_arena(ReserveBytes, false));
+		CHECK(alloc.arena());
+
+		constexpr auto NBlocks = ecs::detail::MemoryPage::NBlocks;
+		constexpr uint64_t PageSize8K = (uint64_t)ecs::mem_block_size(0) * NBlocks;
+
+		// Fill two pages of the smallest size class
+		void* blocks[NBlocks * 2]{};
+		for (auto& p: blocks)
+			p = alloc.alloc(ecs::MinMemoryBlockSize);
+
+		{
+			const auto stats = alloc.stats();
+			CHECK(stats.arena.mem_reserved >= ReserveBytes);
+			CHECK(stats.arena.mem_carved == PageSize8K * 2);
+			CHECK(stats.arena.mem_released == 0);
+			CHECK(stats.stats[0].num_pages == 2);
+		}
+
+		// Pages are carved next to each other
+		const auto addr0 = (uintptr_t)blocks[0];
+		const auto addr1 = (uintptr_t)blocks[NBlocks];
+		CHECK((addr1 > addr0 ? addr1 - addr0 : addr0 - addr1) == PageSize8K);
+
+		// Chunk data alignment is preserved
+		CHECK(((uintptr_t)blocks[0] + ecs::Chunk::chunk_data_area_offset()) % ecs::MemoryBlockAlignment == 0);
+
+		// Allocations can't be changed while pages are alive
+		CHECK_FALSE(alloc.set_arena(0));
+
+		for (auto* p: blocks)
+			alloc.free(p);
+		alloc.flush(true);
+
+		{
+			const auto stats = alloc.stats();
+			CHECK(stats.stats[0].num_pages == 0);
+			CHECK(stats.stats[0].mem_total == 0);
+			CHECK(stats.arena.mem_released == PageSize8K * 2);
+		}
+
+		// Released ranges are reused before carving new ones
+		void* p = alloc.alloc(ecs::MinMemoryBlockSize);
+		std::memset(p, 0x11, 128);
+		{
+			const auto stats = alloc.stats();
+			CHECK(stats.arena.mem_carved == PageSize8K * 2);
+			CHECK(stats.arena.mem_released == PageSize8K);
+		}
+		alloc.free(p);
+		alloc.flush(true);
+
+		// Worlds work on top of the arena
+		{
+			TestWorld twld;
+			auto e = wld.add();
+			wld.add<Position>(e, {1, 2, 3});
+			(void)wld.copy_n(e, 10000);
+			CHECK(wld.query().all<Position>().count() == 10001);
+		}
+		alloc.flush(true);
+
+		CHECK(alloc.set_arena(0));
+		CHECK_FALSE(alloc.arena());
+		CHECK(alloc.stats().arena.mem_reserved == 0);
+	}
+	#endif
+
 	// We do this mostly for code coverage
 	{
 		TestWorld twld;
@@ -2567,6 +2746,94 @@ TEST_CASE("Query Filter - Iter direct mutable views track changes correctly") {
 	}
 }
 
+namespace {
+	struct RowTracked {
+		GAIA_CHANGE_TRACKING(Row);
+		float x;
+	};
+} // namespace
+
+TEST_CASE("Query Filter - per-row change tracking") {
+	TestWorld twld;
+	wld.defrag_entities_per_tick(0);
+
+	constexpr uint32_t N = 200;
+	cnt::darr<ecs::Entity> ents;
+	GAIA_FOR(N) {
+		auto e = wld.add();
+		wld.add<RowTracked>(e, {(float)i});
+		wld.add<Position>(e, {(float)i, 0, 0});
+		ents.push_back(e);
+	}
+	wld.update();
+
+	auto q = wld.query().all<RowTracked>();
+	auto dirty = [&]() {
+		cnt::darr<ecs::Entity> res;
+		q.each([&](ecs::Iter& it) {
+			const auto entities = it.view<ecs::Entity>();
+			for (auto run: it.dirty_rows<RowTracked>()) {
+				CHECK(run.from < run.to);
+				for (uint32_t i = run.from; i < run.to; ++i)
+					res.push_back(entities[i]);
+			}
+		});
+		core::sort(res, [](ecs::Entity a, ecs::Entity b) {
+			return a.id() < b.id();
+		});
+		return res;
+	};
+
+	// New rows count as changed
+	CHECK(dirty().size() == N);
+	wld.clear_dirty_rows();
+	CHECK(dirty().empty());
+
+	// Only the written rows are reported
+	wld.set<RowTracked>(ents[5]) = {-1.0f};
+	wld.set<RowTracked>(ents[150]) = {-2.0f};
+	wld.set<Position>(ents[7]) = {};
+	{
+		const auto res = dirty();
+		REQUIRE(res.size() == 2);
+		CHECK(res[0] == ents[5]);
+		CHECK(res[1] == ents[150]);
+	}
+
+	// Iterator level reset
+	q.each([](ecs::Iter& it) {
+		it.clear_dirty_rows<RowTracked>();
+	});
+	CHECK(dirty().empty());
+
+	// Mutable views mark every row they cover
+	wld.query().all<RowTracked&>().each([](ecs::Iter& it) {
+		auto view = it.view_mut<RowTracked>(0);
+		GAIA_EACH(it) view[i].x += 1.0f;
+	});
+	CHECK(dirty().size() == N);
+	wld.clear_dirty_rows();
+
+	// Dirty state follows the entity when rows move around
+	wld.modify<RowTracked, false>(ents[N - 1]);
+	wld.enable(ents[N - 1], false);
+	wld.enable(ents[N - 1], true);
+	wld.del(ents[0]);
+	wld.update();
+	{
+		const auto res = dirty();
+		REQUIRE(res.size() == 1);
+		CHECK(res[0] == ents[N - 1]);
+	}
+
+	// Components tracking changes per chunk report all rows
+	uint32_t cnt = 0;
+	wld.query().all<Position>().each([&](ecs::Iter& it) {
+		cnt += it.dirty_rows<Position>().count();
+	});
+	CHECK(cnt == N - 1);
+}
+
 TEST_CASE("Query Filter - Iter auto mutable views track changes correctly") {
 	SUBCASE("AoS") {
 		TestWorld twld;
@@ -3642,6 +3909,102 @@ TEST_CASE("Query - sort") {
 		}
 	}
 
+	SUBCASE("By projected key") {
+		auto q = wld.query().all<Position>().sort_by<Position>([](const Position& p) {
+			return p.x;
+		});
+
+		cnt::darr<ecs::Entity> tmp;
+		const auto collect = [&]() {
+			tmp.clear();
+			q.each([&tmp](ecs::Iter& it) {
+				auto ents = it.view<ecs::Entity>();
+				GAIA_EACH(ents) tmp.push_back(ents[i]);
+			});
+		};
+
+		collect();
+		REQUIRE(tmp.size() == 4);
+		CHECK(tmp[0] == e2);
+		CHECK(tmp[1] == e0);
+		CHECK(tmp[2] == e3);
+		CHECK(tmp[3] == e1);
+
+		// Change some archetype and add a new entity
+		wld.add<Something>(e0, {false});
+		auto e4 = wld.add();
+		wld.add<Position>(e4, {-1, 0, 0});
+		collect();
+		REQUIRE(tmp.size() == 5);
+		CHECK(tmp[0] == e4);
+		CHECK(tmp[1] == e2);
+		CHECK(tmp[2] == e0);
+		CHECK(tmp[3] == e3);
+		CHECK(tmp[4] == e1);
+
+		// Writing the key resorts
+		wld.set<Position>(e4) = {5, 0, 0};
+		collect();
+		REQUIRE(tmp.size() == 5);
+		CHECK(tmp[0] == e2);
+		CHECK(tmp[1] == e0);
+		CHECK(tmp[2] == e3);
+		CHECK(tmp[3] == e1);
+		CHECK(tmp[4] == e4);
+	}
+
+	SUBCASE("By composite projected key") {
+		// Layer first, descending x within a layer
+		auto q = wld.query().all<Position>().all<Something>().sort_by<Something, Position>(
+				[](const Something& s, const Position& p) {
+					return std::make_tuple(s.value, -p.x);
+				});
+
+		constexpr uint32_t N = 2000;
+		for (uint32_t i = 0; i < N; ++i) {
+			auto e = wld.add();
+			wld.add<Position>(e, {(float)((i * 7919U) % 1000U), (float)i, 0});
+			wld.add<Something>(e, {i % 3 == 0});
+			// Spread the entities over several archetypes
+			if (i % 5 == 0)
+				wld.add<Acceleration>(e);
+			if (i % 7 == 0)
+				wld.add<Scale>(e);
+			if (i % 11 == 0)
+				wld.enable(e, false);
+		}
+
+		uint32_t cnt = 0;
+		bool ordered = true;
+		std::tuple<bool, float> prev{false, 1e9f};
+		q.each([&](const Position& p, const Something& s) {
+			const auto curr = std::make_tuple(s.value, -p.x);
+			if (cnt > 0 && curr < prev)
+				ordered = false;
+			prev = curr;
+			++cnt;
+		});
+		CHECK(ordered);
+		CHECK(cnt == N - (N + 10) / 11);
+	}
+
+	SUBCASE("By projected entity key") {
+		auto q = wld.query().all<Position>().sort_by<ecs::Entity>([](const ecs::Entity& e) {
+			return ~e.id();
+		});
+
+		cnt::darr<ecs::Entity> tmp;
+		q.each([&tmp](ecs::Iter& it) {
+			auto ents = it.view<ecs::Entity>();
+			GAIA_EACH(ents) tmp.push_back(ents[i]);
+		});
+		REQUIRE(tmp.size() == 4);
+		CHECK(tmp[0] == e3);
+		CHECK(tmp[1] == e2);
+		CHECK(tmp[2] == e1);
+		CHECK(tmp[3] == e0);
+	}
+
 	SUBCASE("Doesn't resort after unrelated component write") {
 		wld.add<Something>(e0, {false});
 		wld.add<Something>(e1, {false});
@@ -3661,6 +4024,76 @@ TEST_CASE("Query - sort") {
 		CHECK(g_query_sort_cmp_cnt == 0);
 	}
 
+	SUBCASE("Moves all row data across chunks") {
+		// Typed components use their swap callbacks, the runtime payload is copied bytewise
+		const auto payload = add_runtime_component(wld, "SortPayload", 4, ecs::DataStorageType::Table, 4).entity;
+
+		constexpr uint32_t N = 3000;
+		cnt::darr<ecs::Entity> ents;
+		uint32_t rng = 0x12345678U;
+		GAIA_FOR(N) {
+			rng ^= rng << 13U;
+			rng ^= rng >> 17U;
+			rng ^= rng << 5U;
+			auto e = wld.add();
+			wld.add<Position>(e, {(float)(rng % 500U), (float)i, 0});
+			wld.add<StringComponent>(e, {std::to_string(i) + StringComponentDefaultValue});
+			wld.add<RowTracked>(e, {(float)i});
+			const uint32_t value = i;
+			wld.add_raw(e, payload, &value, sizeof(value));
+			ents.push_back(e);
+		}
+		GAIA_FOR(N / 7) wld.enable(ents[i * 7], false);
+		wld.update();
+		wld.clear_dirty_rows();
+		wld.set<RowTracked>(ents[10]) = {10.0f};
+		wld.set<RowTracked>(ents[2000]) = {2000.0f};
+
+		auto q = wld.query().all<Position>().all<RowTracked>().sort_by<Position>(compare_position_counted);
+		float prevX = -1.0f;
+		uint32_t cnt = 0;
+		cnt::darr<ecs::Entity> dirty;
+		q.each([&](ecs::Iter& it) {
+			const auto entities = it.view<ecs::Entity>();
+			const auto pos = it.view<Position>();
+			GAIA_EACH(it) {
+				const auto idx = (uint32_t)pos[i].y;
+				CHECK(prevX <= pos[i].x);
+				prevX = pos[i].x;
+				++cnt;
+
+				// Every column and the entity record followed the row
+				CHECK(entities[i] == ents[idx]);
+				CHECK(wld.get<RowTracked>(entities[i]).x == (float)idx);
+				CHECK(wld.get<StringComponent>(entities[i]).value == std::to_string(idx) + StringComponentDefaultValue);
+				uint32_t value = 0;
+				memcpy(&value, wld.get_raw(entities[i], payload).data, sizeof(value));
+				CHECK(value == idx);
+			}
+			for (auto run: it.dirty_rows<RowTracked>()) {
+				for (uint32_t i = run.from; i < run.to; ++i)
+					dirty.push_back(entities[i]);
+			}
+		});
+		CHECK(cnt == N - N / 7);
+
+		// Dirty rows moved together with their entities
+		core::sort(dirty, [](ecs::Entity a, ecs::Entity b) {
+			return a.id() < b.id();
+		});
+		REQUIRE(dirty.size() == 2);
+		CHECK(dirty[0] == ents[10]);
+		CHECK(dirty[1] == ents[2000]);
+
+		// Disabled entities were sorted within their own rows
+		GAIA_FOR(N / 7) {
+			const auto e = ents[i * 7];
+			CHECK_FALSE(wld.enabled(e));
+			CHECK(wld.get<Position>(e).y == (float)(i * 7));
+			CHECK(wld.get<StringComponent>(e).value == std::to_string(i * 7) + StringComponentDefaultValue);
+		}
+	}
+
 	SUBCASE("Resorts after entity order changes") {
 		wld.add<Something>(e0, {false});
 		wld.add<Something>(e1, {false});
@@ -774,6 +774,176 @@ void Test_Query_SourceLookup() {
 	expect_positions(qSelfDownDepth1, true);
 }
 
+TEST_CASE("Query - dense iteration over many small archetypes") {
+	// Dense runners prefetch chunks ahead across archetype boundaries. Mix fully disabled and emptied
+	// archetypes in so the lookahead has to skip chunks the runner never processes.
+	constexpr uint32_t TagCnt = 6;
+	constexpr uint32_t ArchetypeCnt = 1U << TagCnt;
+	constexpr uint32_t EntitiesPerArchetype = 3;
+
+	TestWorld twld;
+	cnt::sarr<ecs::Entity, TagCnt> tags;
+	GAIA_FOR(TagCnt) tags[i] = wld.add();
+
+	cnt::darr<ecs::Entity> ents;
+	uint32_t expected = 0;
+	GAIA_FOR_(ArchetypeCnt, a) {
+		GAIA_FOR_(EntitiesPerArchetype, j) {
+			const auto e = wld.add();
+			ents.push_back(e);
+			auto builder = wld.build(e);
+			builder.add<Position>().add<Acceleration>();
+			GAIA_FOR(TagCnt) {
+				if ((a & (1U << i)) != 0)
+					builder.add(tags[i]);
+			}
+			builder.commit();
+			wld.set<Position>(e) = {(float)a, 0.0f, 0.0f};
+			wld.set<Acceleration>(e) = {1.0f, 2.0f, 3.0f};
+
+			if (a % 5 == 1)
+				wld.enable(e, false);
+			else if (a % 7 == 2)
+				wld.del(e);
+			else
+				++expected;
+		}
+	}
+	wld.update();
+
+	auto q = wld.query().all<Position&>().all<Acceleration>();
+	CHECK(q.count() == expected);
+
+	uint32_t cnt = 0;
+	q.each([&](Position& p, const Acceleration& a) {
+		p.y += a.y;
+		++cnt;
+	});
+	CHECK(cnt == expected);
+
+	cnt = 0;
+	q.each([&](ecs::Iter& it) {
+		auto p = it.view_mut<Position>(0);
+		auto a = it.view<Acceleration>(1);
+		GAIA_EACH(it) {
+			p[i].z += a[i].z;
+			++cnt;
+		}
+	});
+	CHECK(cnt == expected);
+
+	for (auto e: ents) {
+		if (!wld.valid(e) || !wld.enabled(e))
+			continue;
+		const auto& p = wld.get<Position>(e);
+		CHECK(p.y == 2.0f);
+		CHECK(p.z == 3.0f);
+	}
+}
+
+namespace {
+	struct SimdValue {
+		GAIA_CHANGE_TRACKING(Row);
+		float v;
+	};
+} // namespace
+
+TEST_CASE("Query - each_simd") {
+	constexpr uint32_t N = 37;
+	constexpr uint32_t Disabled = 3;
+	constexpr uint32_t Width = 8;
+
+	TestWorld twld;
+	cnt::darr<ecs::Entity> ents;
+	GAIA_FOR(N) {
+		const auto e = wld.add();
+		ents.push_back(e);
+		wld.add<SimdValue>(e, {(float)i});
+		wld.add<PositionSoA8>(e, {(float)i, 1.0f, 2.0f});
+	}
+	GAIA_FOR(Disabled) wld.enable(ents[i], false);
+	wld.update();
+	wld.clear_dirty_rows();
+
+	// Writes whole vectors, padding lanes included
+	auto run = [&](ecs::Constraints constraints) {
+		uint32_t cnt = 0;
+		auto q = wld.query().all<SimdValue&>().all<PositionSoA8&>();
+		q.each_simd<Width>(
+				[&](ecs::Iter& it) {
+					auto v = it.simd_view_mut<SimdValue, Width>(0);
+					auto p = it.simd_view_mut<PositionSoA8, Width>(1);
+					auto px = p.set<0>();
+					CHECK(v.size() % Width == 0);
+					CHECK(v.size() == it.simd_size<Width>());
+					CHECK(px.size() == v.size());
+					CHECK(it.simd_offset<Width>() < Width);
+					for (uint32_t i = 0; i < v.size(); ++i) {
+						v[i].v += 100.0f;
+						px[i] += 10.0f;
+					}
+					cnt += it.size();
+				},
+				constraints);
+		return cnt;
+	};
+
+	auto count_dirty = [&]() {
+		uint32_t cnt = 0;
+		wld.query().all<SimdValue>().each(
+				[&](ecs::Iter& it) {
+					cnt += it.dirty_rows<SimdValue>().count();
+				},
+				ecs::Constraints::AcceptAll);
+		return cnt;
+	};
+
+	SUBCASE("Enabled") {
+		CHECK(run(ecs::Constraints::EnabledOnly) == N - Disabled);
+
+		// Disabled entities sharing a vector with the enabled ones keep their values
+		GAIA_FOR(N) {
+			const float add = i >= Disabled ? 1.0f : 0.0f;
+			CHECK(wld.get<SimdValue>(ents[i]).v == (float)i + 100.0f * add);
+			const auto p = wld.get<PositionSoA8>(ents[i]);
+			CHECK(p.x == (float)i + 10.0f * add);
+			CHECK(p.y == 1.0f);
+			CHECK(p.z == 2.0f);
+		}
+
+		// Padding lanes are not reported as changed
+		CHECK(count_dirty() == N - Disabled);
+	}
+
+	SUBCASE("Disabled") {
+		CHECK(run(ecs::Constraints::DisabledOnly) == Disabled);
+
+		// Enabled entities sharing a vector with the disabled ones keep their values
+		GAIA_FOR(N) {
+			const float add = i < Disabled ? 1.0f : 0.0f;
+			CHECK(wld.get<SimdValue>(ents[i]).v == (float)i + 100.0f * add);
+			CHECK(wld.get<PositionSoA8>(ents[i]).x == (float)i + 10.0f * add);
+		}
+
+		CHECK(count_dirty() == Disabled);
+	}
+
+	SUBCASE("Read-only") {
+		float sum = 0.0f;
+		auto q = wld.query().all<SimdValue>();
+		q.each_simd<Width>([&](ecs::Iter& it) {
+			auto v = it.simd_view<SimdValue, Width>();
+			const auto offset = it.simd_offset<Width>();
+			CHECK(v.size() % Width == 0);
+			GAIA_FOR(it.size()) sum += v[offset + i].v;
+		});
+
+		float expected = 0.0f;
+		GAIA_FOR2(Disabled, N) expected += (float)i;
+		CHECK(sum == expected);
+	}
+}
+
 TEST_CASE("Query - source lookup") {
 	SUBCASE("Cached query") {
 		Test_Query_SourceLookup<ecs::Query>();
@@ -1012,6 +1182,81 @@ TEST_CASE("Query - mixed dynamic traversal cache tracks source closure") {
 	CHECK(info.result_cache_rev() != firstRevision);
 }
 
+TEST_CASE("Query - variable source cache rematches only changed subtrees") {
+	using DynamicKind = ecs::QueryInfo::TestDynamicCacheKind;
+
+	struct VarSrcPosition {};
+	struct VarSrcLevel {};
+
+	TestWorld twld;
+	const auto rootA = wld.add();
+	const auto rootB = wld.add();
+	wld.add<VarSrcLevel>(rootA);
+	const auto mid = wld.add();
+	wld.child(mid, rootA);
+
+	// Make sure every archetype used below exists up-front so no regular pass is needed
+	const auto spareA = wld.add();
+	wld.add<VarSrcLevel>(spareA);
+	const auto spareB = wld.add();
+	wld.child(spareB, rootB);
+
+	const auto a = wld.add();
+	wld.add<VarSrcPosition>(a);
+	wld.child(a, mid);
+	const auto b = wld.add();
+	wld.add<VarSrcPosition>(b);
+	wld.child(b, rootB);
+	const auto c = wld.add();
+	wld.add<VarSrcPosition>(c);
+	wld.child(c, rootB);
+
+	auto q = wld.query() //
+							 .all<VarSrcPosition>()
+							 .all(ecs::Pair(ecs::ChildOf, ecs::Var0))
+							 .all<VarSrcLevel>(ecs::QueryTermOptions{}.src(ecs::Var0).trav());
+	auto& info = q.fetch();
+
+	CHECK(q.count() == 1);
+	CHECK(info.test_dynamic_cache_kind() == DynamicKind::VariableSource);
+	const auto matchPassCount = info.test_match_pass_count();
+	const auto subtreePassCount = info.test_subtree_match_pass_count();
+
+	// Reparenting a leaf moves it between archetypes the cache already judged
+	wld.child(c, mid);
+	CHECK(q.count() == 2);
+	CHECK(info.test_match_pass_count() == matchPassCount);
+	CHECK(info.test_subtree_match_pass_count() == subtreePassCount);
+
+	// Moving an inner node rematches the archetypes below it
+	wld.child(mid, rootB);
+	CHECK(q.count() == 0);
+	CHECK(info.test_match_pass_count() == matchPassCount);
+	CHECK(info.test_subtree_match_pass_count() == subtreePassCount + 1);
+
+	// Ancestors gaining the source component
+	wld.add<VarSrcLevel>(rootB);
+	CHECK(q.count() == 3);
+	CHECK(info.test_match_pass_count() == matchPassCount);
+	CHECK(info.test_subtree_match_pass_count() == subtreePassCount + 2);
+
+	wld.del<VarSrcLevel>(rootB);
+	CHECK(q.count() == 0);
+	wld.child(mid, rootA);
+	CHECK(q.count() == 2);
+	CHECK(info.test_match_pass_count() == matchPassCount);
+
+	// Unrelated entities do not trigger any work
+	wld.del<VarSrcLevel>(spareA);
+	CHECK(q.count() == 2);
+	CHECK(info.test_match_pass_count() == matchPassCount);
+	CHECK(info.test_subtree_match_pass_count() == subtreePassCount + 4);
+
+	wld.del(mid);
+	wld.update();
+	CHECK(q.count() == 0);
+}
+
 TEST_CASE("Query - dynamic traversal refresh preserves reverse index revision for same membership") {
 	struct DynamicTraversalPosition {};
 	struct DynamicTraversalLevel {};
@@ -5836,3 +6081,335 @@ TEST_CASE("Query - Iter auto view accessors") {
 		CHECK(p1.z == doctest::Approx(7.0f));
 	}
 }
+
+TEST_CASE("Query - cursor") {
+	TestWorld twld;
+
+	constexpr uint32_t N = 3000;
+	cnt::darr<ecs::Entity> ents;
+	GAIA_FOR(N) {
+		auto e = wld.add();
+		wld.add<Position>(e, {(float)((i * 7) % N), 0, 0});
+		if (i % 3 == 0)
+			wld.add<Scale>(e, {1, 1, 1});
+		ents.push_back(e);
+	}
+
+	auto read_all = [](ecs::Query& q, ecs::QueryCursor& cursor, uint32_t pageSize, auto& out) {
+		uint32_t pages = 0;
+		while (true) {
+			const auto cnt = q.next(cursor, out, pageSize);
+			if (cnt == 0)
+				break;
+			CHECK(cnt <= pageSize);
+			++pages;
+		}
+		CHECK(cursor.done());
+		return pages;
+	};
+
+	SUBCASE("pages match arr") {
+		auto q = wld.query().all<Position>();
+		cnt::darr<ecs::Entity> expected;
+		q.arr(expected);
+
+		ecs::QueryCursor cursor;
+		cnt::darr<ecs::Entity> actual;
+		const auto pages = read_all(q, cursor, 256, actual);
+		CHECK(pages == (N + 255) / 256);
+		CHECK_FALSE(cursor.stale());
+		REQUIRE(actual.size() == expected.size());
+		GAIA_FOR((uint32_t)expected.size()) CHECK(actual[i] == expected[i]);
+
+		cnt::darr<Position> expectedPos;
+		q.arr(expectedPos);
+		cursor.reset();
+		cnt::darr<Position> actualPos;
+		(void)read_all(q, cursor, 1000, actualPos);
+		REQUIRE(actualPos.size() == expectedPos.size());
+		GAIA_FOR((uint32_t)expectedPos.size()) CHECK(actualPos[i].x == expectedPos[i].x);
+
+		// A finished cursor does not return anything until rewound
+		CHECK(q.next(cursor, actual, 10) == 0);
+	}
+
+	SUBCASE("new archetypes are picked up") {
+		auto q = wld.query().all<Position>();
+		ecs::QueryCursor cursor;
+		cnt::darr<ecs::Entity> actual;
+		CHECK(q.next(cursor, actual, 100) == 100);
+
+		auto e = wld.add();
+		wld.add<Position>(e);
+		wld.add<Rotation>(e);
+
+		(void)read_all(q, cursor, 500, actual);
+		CHECK_FALSE(cursor.stale());
+		CHECK(actual.size() == N + 1);
+		CHECK(core::has(actual, e));
+	}
+
+	SUBCASE("structural changes mark the cursor stale") {
+		auto q = wld.query().all<Position>();
+		ecs::QueryCursor cursor;
+		cnt::darr<ecs::Entity> actual;
+		CHECK(q.next(cursor, actual, 10) == 10);
+		CHECK_FALSE(cursor.stale());
+
+		// Remove an entity that was already returned. The last row of its chunk moves into its place.
+		wld.del(actual[0]);
+		wld.update();
+
+		// Rows moved around, so some entities might have been returned twice or skipped
+		(void)read_all(q, cursor, 500, actual);
+		CHECK(cursor.stale());
+		CHECK(actual.size() >= N - 2);
+	}
+
+	SUBCASE("sorted") {
+		auto q = wld.query().all<Position>().sort_by<Position>(
+				[]([[maybe_unused]] const ecs::World& world, const void* pData0, const void* pData1) {
+					const auto& p0 = *static_cast<const Position*>(pData0);
+					const auto& p1 = *static_cast<const Position*>(pData1);
+					return (int)p0.x - (int)p1.x;
+				});
+		cnt::darr<ecs::Entity> expected;
+		q.arr(expected);
+
+		ecs::QueryCursor cursor;
+		cnt::darr<ecs::Entity> actual;
+		(void)read_all(q, cursor, 333, actual);
+		CHECK_FALSE(cursor.stale());
+		REQUIRE(actual.size() == expected.size());
+		GAIA_FOR((uint32_t)expected.size()) CHECK(actual[i] == expected[i]);
+	}
+
+	SUBCASE("grouped") {
+		const auto scale = wld.get<Scale>();
+		auto q = wld.query().all<Position>().group_by(
+				scale, []([[maybe_unused]] const ecs::World& world, const ecs::Archetype& archetype, ecs::Entity groupBy) {
+					return archetype.has(groupBy) ? (ecs::GroupId)1 : (ecs::GroupId)2;
+				});
+		q.group_id((ecs::GroupId)1);
+		cnt::darr<ecs::Entity> expected;
+		q.arr(expected);
+		CHECK(expected.size() == N / 3);
+
+		ecs::QueryCursor cursor;
+		cnt::darr<ecs::Entity> actual;
+		(void)read_all(q, cursor, 128, actual);
+		REQUIRE(actual.size() == expected.size());
+		GAIA_FOR((uint32_t)expected.size()) CHECK(actual[i] == expected[i]);
+	}
+}
+
+TEST_CASE("Query - cached count follows structural changes") {
+	TestWorld twld;
+
+	cnt::darr<ecs::Entity> ents;
+	GAIA_FOR(100) {
+		auto e = wld.add();
+		wld.add<Position>(e);
+		ents.push_back(e);
+	}
+
+	auto q = wld.query().all<Position>();
+	CHECK(q.count() == 100);
+	CHECK(q.count() == 100);
+	CHECK_FALSE(q.empty());
+	CHECK(q.count(ecs::Constraints::DisabledOnly) == 0);
+	CHECK(q.empty(ecs::Constraints::DisabledOnly));
+
+	// Added to an already matched archetype
+	auto e = wld.add();
+	wld.add<Position>(e);
+	CHECK(q.count() == 101);
+
+	// New matched archetype
+	wld.add<Scale>(e);
+	CHECK(q.count() == 101);
+	wld.add<Rotation>(ents[0]);
+	CHECK(q.count() == 101);
+
+	// Enabled state
+	wld.enable(ents[1], false);
+	CHECK(q.count() == 100);
+	CHECK(q.count(ecs::Constraints::DisabledOnly) == 1);
+	CHECK_FALSE(q.empty(ecs::Constraints::DisabledOnly));
+	CHECK(q.count(ecs::Constraints::AcceptAll) == 101);
+	wld.enable(ents[1], true);
+	CHECK(q.count(ecs::Constraints::DisabledOnly) == 0);
+
+	// Removal
+	wld.del<Position>(ents[2]);
+	CHECK(q.count() == 100);
+	wld.del(ents[3]);
+	wld.update();
+	CHECK(q.count() == 99);
+
+	for (auto entity: ents)
+		if (wld.valid(entity))
+			wld.del(entity);
+	wld.del(e);
+	wld.update();
+	CHECK(q.empty());
+	CHECK(q.count() == 0);
+
+	// Filtered queries are never served from the cache
+	auto qc = wld.query().all<Position>().changed<Position>();
+	auto e2 = wld.add();
+	wld.add<Position>(e2);
+	CHECK(qc.count() == 1);
+	qc.each([](ecs::Iter&) {});
+	CHECK(qc.count() == 0);
+}
+
+TEST_CASE("Query - explain and profile") {
+	TestWorld twld;
+
+	GAIA_FOR(100) {
+		auto e = wld.add();
+		wld.add<Position>(e);
+		if (i % 2 == 0)
+			wld.add<Scale>(e);
+	}
+
+	auto q = wld.query().all<Position&>();
+	CHECK_FALSE(q.profiling());
+
+	auto ex = q.explain();
+	CHECK(ex.planMode == ecs::Query::QueryPlanMode::DirectDense);
+	CHECK(ex.directIterable);
+	CHECK(ex.archetypeCnt == 2);
+	CHECK(ex.chunkCnt >= 2);
+	CHECK(ex.entityCnt == 100);
+	CHECK_FALSE(ex.profiling);
+	CHECK(ex.profile.runCnt == 0);
+
+	// Nothing is collected until profiling is enabled
+	q.each([](Position&) {});
+	CHECK(q.profile_stats().runCnt == 0);
+
+	q.profile();
+	CHECK(q.profiling());
+	uint32_t cnt = 0;
+	q.each([&](Position&) {
+		++cnt;
+	});
+	q.each([&](ecs::Iter& it) {
+		cnt += it.size();
+	});
+	q.each_arch([](ecs::Iter&) {});
+	cnt::darr<ecs::Entity> ents;
+	q.arr(ents);
+	CHECK(cnt == 200);
+	CHECK(ents.size() == 100);
+
+	auto stats = q.profile_stats();
+	CHECK(stats.runCnt == 4);
+	CHECK(stats.matchCnt >= 4);
+	CHECK(stats.filteredChunkCnt == 0);
+	CHECK(stats.lastPlanMode == ecs::Query::QueryPlanMode::DirectDense);
+
+	ex = q.explain();
+	CHECK(ex.profiling);
+	CHECK(ex.profile.runCnt == 4);
+	CHECK(ex.profile.matchCnt == stats.matchCnt);
+
+	q.reset_profile();
+	CHECK(q.profiling());
+	CHECK(q.profile_stats().runCnt == 0);
+
+	q.profile(false);
+	CHECK_FALSE(q.profiling());
+
+	// Chunks skipped by changed() filters
+	auto qc = wld.query().all<Position>().changed<Position>().profile();
+	qc.each([](ecs::Iter&) {});
+	CHECK(qc.profile_stats().filteredChunkCnt == 0);
+	CHECK((qc.profile_stats().lastPlanFlags & ecs::Query::QueryPlanFlag_Filtered) != 0);
+	qc.each([](ecs::Iter&) {});
+	CHECK(qc.profile_stats().filteredChunkCnt == ex.chunkCnt);
+	CHECK(qc.explain().planFlags == qc.profile_stats().lastPlanFlags);
+}
+
+struct GatheredBody {
+	GAIA_LAYOUT(SoA);
+	ecs::Entity e;
+	Position p;
+	Rotation r;
+};
+
+TEST_CASE("Query - gather and scatter") {
+	TestWorld twld;
+
+	cnt::darr<ecs::Entity> ents;
+	GAIA_FOR(1000) {
+		auto e = wld.add();
+		wld.add<Position>(e, {(float)i, 0, 0});
+		wld.add<Rotation>(e, {0, 0, 0, (float)i});
+		if (i % 3 == 0)
+			wld.add<Scale>(e);
+		ents.push_back(e);
+	}
+	wld.enable(ents[10], false);
+
+	auto q = wld.query().all<Position&>().all<Rotation>();
+	cnt::darr_soa<GatheredBody> rows;
+	const auto cnt = q.gather(rows);
+	CHECK(cnt == 999);
+	CHECK(rows.size() == 999);
+
+	{
+		const auto ev = rows.view<0>();
+		const auto pv = rows.view<1>();
+		const auto rv = rows.view<2>();
+		uint32_t mismatches = 0;
+		uint32_t i = 0;
+		// Rows come in the order each() visits them
+		q.each([&](ecs::Entity e, Position& p) {
+			if (ev[i] != e || pv[i].x != p.x || rv[i].w != wld.get<Rotation>(e).w)
+				++mismatches;
+			++i;
+		});
+		CHECK(i == cnt);
+		CHECK(mismatches == 0);
+	}
+
+	auto qc = wld.query().all<Position>().changed<Position>();
+	qc.each([](ecs::Iter&) {});
+
+	auto pm = rows.view_mut<1>();
+	GAIA_FOR(cnt) pm[i].y = 5.f;
+	CHECK(q.scatter(rows) == cnt);
+	{
+		const auto ev = rows.view<0>();
+		uint32_t mismatches = 0;
+		GAIA_FOR(cnt) {
+			if (wld.get<Position>(ev[i]).y != 5.f)
+				++mismatches;
+		}
+		CHECK(mismatches == 0);
+		CHECK(wld.get<Position>(ents[10]).y == 0.f);
+	}
+
+	// Scattered columns are reported as changed
+	uint32_t changedCnt = 0;
+	qc.each([&](ecs::Iter& it) {
+		changedCnt += it.size();
+	});
+	CHECK(changedCnt == cnt);
+
+	// Raw buffers with changed() filters. Scatter visits the rows of the last gather.
+	cnt::darr<ecs::Entity> entBuf(ents.size());
+	cnt::darr<Position> posBuf(ents.size());
+	CHECK(qc.gather(std::span(entBuf.data(), entBuf.size()), std::span(posBuf.data(), posBuf.size())) == 0);
+	wld.set<Position>(ents[500]) = {1, 2, 3};
+	const auto changedRows = qc.gather(std::span(entBuf.data(), entBuf.size()), std::span(posBuf.data(), posBuf.size()));
+	CHECK(changedRows > 0);
+	CHECK(changedRows < cnt);
+	GAIA_FOR(changedRows) posBuf[i].z = 9.f;
+	CHECK(qc.scatter(std::span(entBuf.data(), changedRows), std::span(posBuf.data(), changedRows)) == changedRows);
+	CHECK(wld.get<Position>(ents[500]).z == 9.f);
+	CHECK(wld.get<Position>(ents[0]).z == 0.f);
+}
@@ -1416,6 +1416,137 @@ TEST_CASE("Query - create selectors with wildcard pair over broad exact term on
 	CHECK(deps.create_selectors_view()[0] == ecs::Pair(rel, ecs::All));
 }
 
+TEST_CASE("Query - create-time matching of plain ids") {
+	TestWorld twld;
+
+	auto rel = wld.add();
+	auto tgt = wld.add();
+
+	auto qAll = wld.query().all<Position>().all<Acceleration>();
+	auto qOrNot = wld.query().all<Position>().or_<Rotation>().or_<Scale>().no<Acceleration>();
+	auto qPair = wld.query().all<Position>().all(ecs::Pair(rel, tgt)).no<Else>();
+	auto qWildcard = wld.query().all<Position>().all(ecs::Pair(rel, ecs::All));
+
+	using MatchKind = ecs::QueryCtx::CreateArchetypeMatchKind;
+	CHECK(qAll.fetch().ctx().data.createArchetypeMatchKind == MatchKind::SortedIds);
+	CHECK(qOrNot.fetch().ctx().data.createArchetypeMatchKind == MatchKind::SortedIds);
+	CHECK(qPair.fetch().ctx().data.createArchetypeMatchKind == MatchKind::SortedIds);
+	CHECK(qWildcard.fetch().ctx().data.createArchetypeMatchKind != MatchKind::SortedIds);
+
+	// Warm the caches so new archetypes are propagated at creation time
+	CHECK(qAll.count() == 0);
+	CHECK(qOrNot.count() == 0);
+	CHECK(qPair.count() == 0);
+	CHECK(qWildcard.count() == 0);
+
+	auto create = [&](bool pos, bool acc, bool rot, bool scl, bool pair, bool els) {
+		auto e = wld.add();
+		if (pos)
+			wld.add<Position>(e);
+		if (acc)
+			wld.add<Acceleration>(e);
+		if (rot)
+			wld.add<Rotation>(e);
+		if (scl)
+			wld.add<Scale>(e);
+		if (pair)
+			wld.add(e, ecs::Pair(rel, tgt));
+		if (els)
+			wld.add<Else>(e);
+	};
+
+	create(true, true, false, false, false, false);
+	create(true, true, true, false, false, false);
+	create(true, false, true, false, false, false);
+	create(false, false, false, true, false, false);
+	create(false, true, false, true, false, false);
+	create(true, false, false, false, true, false);
+	create(true, false, true, false, true, true);
+	create(true, true, false, true, true, false);
+
+	CHECK(qAll.count() == 3);
+	CHECK(qOrNot.count() == 2);
+	CHECK(qPair.count() == 2);
+	CHECK(qWildcard.count() == 3);
+}
+
+TEST_CASE("Query - create-time ALL prefilter with many queries") {
+	TestWorld twld;
+
+	constexpr uint32_t TagCnt = 80;
+	cnt::darr<ecs::Entity> tags;
+	GAIA_FOR(TagCnt) tags.push_back(wld.add());
+
+	uint32_t seed = 1;
+	auto rnd = [&](uint32_t max) {
+		seed = seed * 1664525U + 1013904223U;
+		return (seed >> 8) % max;
+	};
+
+	cnt::darr<ecs::Query> cached;
+	cnt::darr<ecs::Query> uncached;
+	auto add_queries = [&](uint32_t cnt) {
+		GAIA_FOR(cnt) {
+			const auto ia = rnd(TagCnt);
+			const auto ib = (ia + 1 + rnd(TagCnt - 1)) % TagCnt;
+			const auto a = tags[ia];
+			const auto b = tags[ib];
+			const auto c = tags[rnd(TagCnt)];
+			const bool useNot = rnd(2) == 0;
+
+			auto qc = wld.query().all(a).all(b);
+			auto qu = wld.query().kind(ecs::QueryCacheKind::None).all(a).all(b);
+			if (useNot && c != a && c != b) {
+				qc.no(c);
+				qu.no(c);
+			}
+			(void)qc.count();
+			cached.push_back(GAIA_MOV(qc));
+			uncached.push_back(GAIA_MOV(qu));
+		}
+	};
+
+	auto add_archetypes = [&](uint32_t cnt) {
+		GAIA_FOR(cnt) {
+			auto e = wld.add();
+			auto eb = wld.build(e);
+			GAIA_FOR_(6 + rnd(10), j) eb.add(tags[rnd(TagCnt)]);
+			eb.commit();
+		}
+	};
+
+	auto check_queries = [&]() {
+		GAIA_EACH(cached) {
+			CHECK(cached[i].count() == uncached[i].count());
+		}
+	};
+
+	add_queries(300);
+	add_archetypes(200);
+	check_queries();
+
+	// Released handles get recycled by new queries
+	cached.resize(100);
+	uncached.resize(100);
+	add_queries(200);
+	add_archetypes(200);
+	check_queries();
+
+	SUBCASE("Is relationship added later") {
+		auto base = wld.add();
+		auto derived = wld.add();
+		auto qc = wld.query().all(base).all(tags[0]);
+		auto qu = wld.query().kind(ecs::QueryCacheKind::None).all(base).all(tags[0]);
+		CHECK(qc.count() == 0);
+
+		wld.as(derived, base);
+		auto e = wld.add();
+		wld.add(e, tags[0]);
+		wld.add(e, derived);
+		CHECK(qc.count() == qu.count());
+	}
+}
+
 TEST_CASE("Query - kind and policy") {
 	TestWorld twld;
 
@@ -1636,7 +1636,7 @@ static uint32_t find_serialized_entity_archetype_idx(ecs::World& world, ecs::Ent
 		if (isAlive) {
 			uint32_t idx = 0;
 			uint32_t dataRaw = 0;
-			uint16_t row = 0;
+			ecs::ChunkRow row = 0;
 			uint16_t flags = 0;
 			uint32_t refCnt = 0;
 			uint32_t archetypeIdx = 0;
@@ -1706,8 +1706,8 @@ make_legacy_named_entity_snapshot(uint32_t oldLastCoreComponentId, uint32_t arch
 	s.save(archetypeIdx);
 	s.save((uint32_t)1); // chunkCnt
 	s.save((uint32_t)0); // chunkIdx
-	s.save((uint16_t)1); // count
-	s.save((uint16_t)1); // countEnabled
+	s.save((ecs::ChunkRow)1); // count
+	s.save((ecs::ChunkRow)1); // countEnabled
 	s.save((uint16_t)0); // dead
 	s.save((uint16_t)0); // lifespanCountdown
 	s.save(legacyEntity);
@@ -2619,6 +2619,85 @@ TEST_CASE("Serialization - world + query") {
 	}
 }
 
+TEST_CASE("Serialization - query plans") {
+	ser::bin_stream plans;
+	util::str bytecodeAll;
+	util::str bytecodeOrNot;
+	util::str bytecodeVar;
+
+	{
+		TestWorld in;
+		auto& w = in.m_w;
+		(void)w.add<Position>();
+		(void)w.add<Acceleration>();
+		(void)w.add<Rotation>();
+
+		auto qAll = w.query().all<Position>().all<Acceleration>();
+		auto qOrNot = w.query().all<Position>().or_<Rotation>().or_<Acceleration>().no<Scale>();
+		auto qVar = w.query().all(ecs::Pair(ecs::ChildOf, ecs::Var0)).all<Position>(ecs::QueryTermOptions{}.src(ecs::Var0));
+		bytecodeAll = qAll.bytecode();
+		bytecodeOrNot = qOrNot.bytecode();
+		bytecodeVar = qVar.bytecode();
+
+		// Nothing was loaded so every query had to be compiled
+		CHECK(w.query_plan_hits() == 0);
+		w.save_query_plans(ser::make_serializer(plans));
+	}
+
+	// Same components registered in the same order reuse the stored plans
+	{
+		TestWorld twld;
+		(void)wld.add<Position>();
+		(void)wld.add<Acceleration>();
+		(void)wld.add<Rotation>();
+
+		plans.seek(0);
+		CHECK(wld.load_query_plans(ser::make_serializer(plans)));
+
+		auto qAll = wld.query().all<Position>().all<Acceleration>();
+		auto qOrNot = wld.query().all<Position>().or_<Rotation>().or_<Acceleration>().no<Scale>();
+		auto qVar =
+				wld.query().all(ecs::Pair(ecs::ChildOf, ecs::Var0)).all<Position>(ecs::QueryTermOptions{}.src(ecs::Var0));
+		CHECK(qAll.bytecode() == bytecodeAll);
+		CHECK(qOrNot.bytecode() == bytecodeOrNot);
+		CHECK(qVar.bytecode() == bytecodeVar);
+		CHECK(wld.query_plan_hits() == 1);
+
+		auto parent = wld.add();
+		wld.add<Position>(parent);
+		wld.add<Acceleration>(parent);
+		auto child = wld.add();
+		wld.add(child, ecs::Pair(ecs::ChildOf, parent));
+		auto rotated = wld.add();
+		wld.add<Position>(rotated);
+		wld.add<Rotation>(rotated);
+		wld.add<Scale>(rotated);
+
+		CHECK(qAll.count() == 1);
+		CHECK(qOrNot.count() == 1);
+		CHECK(qVar.count() == 1);
+	}
+
+	// A different component registered under the same id invalidates the plan
+	{
+		TestWorld twld;
+		(void)wld.add<Scale>();
+		(void)wld.add<Acceleration>();
+
+		plans.seek(0);
+		CHECK(wld.load_query_plans(ser::make_serializer(plans)));
+
+		auto q = wld.query().all<Scale>().all<Acceleration>();
+		CHECK(q.count() == 0);
+		CHECK(wld.query_plan_hits() == 0);
+
+		auto e = wld.add();
+		wld.add<Scale>(e);
+		wld.add<Acceleration>(e);
+		CHECK(q.count() == 1);
+	}
+}
+
 TEST_CASE("Serialization - world json runtime pair payload") {
 	struct RuntimePairSchema {
 		ecs::Entity relation = ecs::EntityBad;
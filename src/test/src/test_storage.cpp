@@ -952,3 +952,348 @@ TEST_CASE("World set writes back when the proxy finishes") {
 		CHECK(updated.z == doctest::Approx(16.0f));
 	}
 }
+
+namespace {
+	struct WideParticle {
+		GAIA_CHUNK_SIZE(Wide);
+		float x;
+	};
+} // namespace
+
+TEST_CASE("Wide chunks") {
+	TestWorld twld;
+
+	constexpr uint32_t N = 200000;
+	auto e0 = wld.add();
+	wld.add<WideParticle>(e0, {0.0f});
+	(void)wld.copy_n(e0, N - 1);
+
+	auto q = wld.query().all<WideParticle&>();
+	CHECK(q.count() == N);
+
+	uint32_t chunkCnt = 0;
+	uint32_t maxCapacity = 0;
+	float expected = 0.0f;
+	q.each([&](ecs::Iter& it) {
+		++chunkCnt;
+		maxCapacity = core::get_max(maxCapacity, (uint32_t)it.chunk()->capacity());
+
+		auto v = it.view_mut<WideParticle>();
+		GAIA_EACH(it) {
+			v[i].x = expected;
+			expected += 1.0f;
+		}
+	});
+
+#if GAIA_ECS_WIDE_CHUNKS
+	// Rows past the 16-bit range are addressable
+	CHECK(maxCapacity > UINT16_MAX);
+	CHECK(chunkCnt <= 3);
+#else
+	// The hint is ignored without wide chunk support
+	CHECK(maxCapacity <= ecs::ChunkHeader::MAX_CHUNK_ENTITIES);
+	CHECK(chunkCnt > 3);
+#endif
+
+	// Entity records point at the right rows
+	cnt::darr<ecs::Entity> ents;
+	q.arr(ents);
+	REQUIRE(ents.size() == N);
+	{
+		const auto last = ents[N - 1];
+		CHECK(wld.get<WideParticle>(last).x == doctest::Approx((float)(N - 1)));
+		const auto mid = ents[70000];
+		CHECK(wld.get<WideParticle>(mid).x == doctest::Approx(70000.0f));
+	}
+
+	// Removing a row moves the last row of the chunk into its place
+	wld.del(ents[1]);
+	CHECK(q.count() == N - 1);
+	CHECK(wld.get<WideParticle>(ents[0]).x == doctest::Approx(0.0f));
+	CHECK(wld.get<WideParticle>(ents[70000]).x == doctest::Approx(70000.0f));
+	CHECK(wld.get<WideParticle>(ents[N - 1]).x == doctest::Approx((float)(N - 1)));
+
+	// Disabled rows are moved in front of the enabled ones
+	wld.enable(ents[N - 1], false);
+	CHECK(q.count() == N - 2);
+	CHECK_FALSE(wld.enabled(ents[N - 1]));
+	CHECK(wld.get<WideParticle>(ents[N - 1]).x == doctest::Approx((float)(N - 1)));
+	wld.enable(ents[N - 1], true);
+	CHECK(q.count() == N - 1);
+
+	uint32_t rows = 0;
+	wld.query().all<WideParticle>().each([&](const WideParticle& p) {
+		rows += p.x != 1.0f;
+	});
+	CHECK(rows == N - 1);
+}
+
+namespace {
+	struct CompactLabel {
+		std::string value;
+	};
+} // namespace
+
+TEST_CASE("Chunk compaction") {
+	TestWorld twld;
+	// Keep the entity-count based defragmentation out of the way
+	wld.defrag_entities_per_tick(0);
+
+	constexpr uint32_t N = 20000;
+	cnt::darr<ecs::Entity> ents;
+	ents.reserve(N);
+	GAIA_FOR(N) {
+		auto e = wld.add();
+		wld.add<Position>(e, {(float)i, 0, 0});
+		wld.add<PositionSoA>(e, {(float)i, 1, 2});
+		wld.add<CompactLabel>(e, {std::to_string(i) + "-label-long-enough-to-avoid-sso"});
+		ents.push_back(e);
+	}
+
+	auto q = wld.query().all<Position>().all<PositionSoA>().all<CompactLabel>();
+	auto count_chunks = [&]() {
+		uint32_t chunkCnt = 0;
+		q.each(
+				[&](ecs::Iter&) {
+					++chunkCnt;
+				},
+				ecs::Constraints::AcceptAll);
+		return chunkCnt;
+	};
+
+	// Let the archetype outgrow its tiny chunk
+	wld.update();
+
+	const uint32_t capacity = wld.fetch(ents[0]).pArchetype->props().capacity;
+	const uint32_t chunksBefore = count_chunks();
+	CHECK(chunksBefore == (N + capacity - 1) / capacity);
+
+	// Leave roughly every 10th entity alive and disable some of the survivors
+	cnt::darr<ecs::Entity> alive;
+	GAIA_FOR(N) {
+		if (i % 10 != 3) {
+			wld.del(ents[i]);
+			continue;
+		}
+		alive.push_back(ents[i]);
+		if (i % 20 == 3)
+			wld.enable(ents[i], false);
+	}
+	wld.update();
+	CHECK(count_chunks() == chunksBefore);
+
+	// Compact without a time limit
+	const auto stats = wld.compact_chunks(0);
+	CHECK_FALSE(stats.budgetExhausted);
+	CHECK(stats.chunksFreed > 0);
+	CHECK(stats.entitiesMoved > 0);
+	CHECK(stats.bytesReclaimed >= (uint64_t)stats.chunksFreed * ecs::mem_block_size(0));
+	CHECK(wld.compact_stats().chunksFreed == stats.chunksFreed);
+
+	const auto aliveCnt = (uint32_t)alive.size();
+	CHECK(count_chunks() == (aliveCnt + capacity - 1) / capacity);
+	CHECK(q.count(ecs::Constraints::AcceptAll) == aliveCnt);
+
+	// Moved entities keep their data and enabled state
+	for (auto e: alive) {
+		const auto& ec = wld.fetch(e);
+		CHECK(ec.pChunk->entity_view()[ec.row] == e);
+
+		const auto idx = (uint32_t)wld.get<Position>(e).x;
+		CHECK(ents[idx] == e);
+		CHECK(wld.get<PositionSoA>(e).x == (float)idx);
+		CHECK(wld.get<CompactLabel>(e).value == std::to_string(idx) + "-label-long-enough-to-avoid-sso");
+		CHECK(wld.enabled(e) == (idx % 20 != 3));
+	}
+
+	// A second run has nothing left to merge
+	const auto stats2 = wld.compact_chunks(0);
+	CHECK(stats2.chunksFreed == 0);
+	CHECK(stats2.entitiesMoved == 0);
+
+	// Compaction can run as a part of garbage collection
+	GAIA_FOR(aliveCnt) {
+		if (i % 2 == 0)
+			wld.del(alive[i]);
+	}
+	wld.compact_budget_per_tick(1000000);
+	wld.update();
+	wld.update();
+	CHECK(q.count(ecs::Constraints::AcceptAll) == aliveCnt - (aliveCnt + 1) / 2);
+	CHECK(count_chunks() == (aliveCnt - (aliveCnt + 1) / 2 + capacity - 1) / capacity);
+}
+
+TEST_CASE("Tiny chunks") {
+	TestWorld twld;
+	wld.defrag_entities_per_tick(0);
+
+	// The first chunk of an archetype is tiny
+	auto e0 = wld.add();
+	wld.add<Position>(e0, {0, 0, 0});
+	auto* pArchetype = wld.fetch(e0).pArchetype;
+	const auto& props = pArchetype->props();
+	REQUIRE(props.tinyCapacity != 0);
+	CHECK(props.tinyCapacity < props.capacity);
+	CHECK(wld.fetch(e0).pChunk->capacity() == props.tinyCapacity);
+	CHECK(pArchetype->tiny_chunk_cnt() == 1);
+
+	auto check_data = [&](const cnt::darr<ecs::Entity>& ents) {
+		GAIA_EACH(ents) {
+			const auto e = ents[i];
+			const auto& ec = wld.fetch(e);
+			CHECK(ec.pArchetype == pArchetype);
+			CHECK(ec.pChunk->entity_view()[ec.row] == e);
+			CHECK(wld.get<Position>(e).x == (float)i);
+			CHECK(wld.enabled(e) == (i != 1));
+		}
+	};
+
+	// Grow past the tiny capacity. The tiny chunk is merged into a regular chunk by the garbage collector.
+	const uint32_t N = props.tinyCapacity * 3;
+	cnt::darr<ecs::Entity> ents;
+	ents.push_back(e0);
+	for (uint32_t i = 1; i < N; ++i) {
+		auto e = wld.add();
+		wld.add<Position>(e, {(float)i, 0, 0});
+		ents.push_back(e);
+	}
+	wld.enable(ents[1], false);
+	CHECK(pArchetype->chunks().size() == 2);
+	CHECK(pArchetype->tiny_chunk_cnt() == 1);
+
+	wld.update();
+	CHECK(pArchetype->chunks().size() == 1);
+	CHECK(pArchetype->tiny_chunk_cnt() == 0);
+	CHECK(pArchetype->chunks()[0]->capacity() == props.capacity);
+	check_data(ents);
+
+	// Shrink below half of the tiny capacity. The regular chunk is replaced with a tiny one.
+	const uint32_t M = props.tinyCapacity / 2;
+	for (uint32_t i = M; i < N; ++i)
+		wld.del(ents[i]);
+	ents.resize(M);
+	wld.update();
+	wld.update();
+	CHECK(pArchetype->chunks().size() == 1);
+	CHECK(pArchetype->tiny_chunk_cnt() == 1);
+	CHECK(pArchetype->chunks()[0]->capacity() == props.tinyCapacity);
+	check_data(ents);
+
+	// New entities go to the tiny chunk
+	auto e = wld.add();
+	wld.add<Position>(e, {(float)M, 0, 0});
+	ents.push_back(e);
+	CHECK(wld.fetch(e).pChunk == pArchetype->chunks()[0]);
+	check_data(ents);
+}
+
+namespace {
+	struct ColdBlob {
+		GAIA_STORAGE(Cold);
+		uint32_t data[512];
+	};
+
+	struct ColdLabel {
+		GAIA_STORAGE(Cold);
+		std::string value;
+	};
+} // namespace
+
+TEST_CASE("Cold storage") {
+	TestWorld twld;
+
+	const auto& item = wld.add<ColdBlob>();
+	CHECK(item.comp.storage_type() == ecs::DataStorageType::Cold);
+	CHECK(ecs::component_uses_table_storage(item.comp));
+
+	constexpr uint32_t N = 5000;
+	cnt::darr<ecs::Entity> ents;
+	GAIA_FOR(N) {
+		auto e = wld.add();
+		wld.add<Position>(e, {(float)i, 0, 0});
+		wld.add<ColdBlob>(e);
+		auto& blob = wld.acc_mut(e).mut<ColdBlob>();
+		blob.data[0] = i;
+		blob.data[511] = i * 2;
+		ents.push_back(e);
+	}
+
+	// The cold component does not reduce the capacity of the chunk
+	const auto* pArchetype = wld.fetch(ents[0]).pArchetype;
+	CHECK(pArchetype->props().capacity > ecs::Chunk::chunk_data_bytes(ecs::MaxRegularMemoryBlockSize) / sizeof(ColdBlob));
+
+	auto check_data = [&]() {
+		for (const auto e: ents) {
+			const auto& pos = wld.get<Position>(e);
+			const auto& blob = wld.get<ColdBlob>(e);
+			CHECK(blob.data[0] == (uint32_t)pos.x);
+			CHECK(blob.data[511] == (uint32_t)pos.x * 2);
+		}
+	};
+	check_data();
+
+	// Views of cold components work the same way views of other components do
+	uint32_t cnt = 0;
+	wld.query().all<Position>().all<ColdBlob&>().each([&](ecs::Iter& it) {
+		auto p = it.view<Position>();
+		auto b = it.view_mut<ColdBlob>();
+		GAIA_EACH(it) {
+			CHECK(b[i].data[0] == (uint32_t)p[i].x);
+			b[i].data[1] = b[i].data[0] + 1;
+			++cnt;
+		}
+	});
+	CHECK(cnt == N);
+	wld.query().all<Position>().all<ColdBlob>().each([&](const Position& p, const ColdBlob& b) {
+		CHECK(b.data[1] == (uint32_t)p.x + 1);
+	});
+
+	// Rows of the side block follow rows of the chunk
+	wld.del(ents[0]);
+	wld.del(ents[N / 2]);
+	core::swap_erase(ents, N / 2);
+	core::swap_erase(ents, 0);
+	wld.enable(ents[100], false);
+	wld.enable(ents[200], false);
+	wld.enable(ents[100], true);
+	check_data();
+
+	// Moving to a different archetype carries the data along
+	wld.add<Acceleration>(ents[10], {1, 2, 3});
+	wld.del<Position>(ents[20]);
+	wld.add<Position>(ents[20], {(float)wld.get<ColdBlob>(ents[20]).data[0], 0, 0});
+	check_data();
+
+	// Removing the cold component keeps the rest of the data intact
+	const auto x = wld.get<Position>(ents[30]).x;
+	wld.del<ColdBlob>(ents[30]);
+	CHECK_FALSE(wld.has<ColdBlob>(ents[30]));
+	CHECK(wld.get<Position>(ents[30]).x == x);
+	core::swap_erase(ents, 30);
+	wld.update();
+	check_data();
+}
+
+TEST_CASE("Cold storage - non-trivial component") {
+	TestWorld twld;
+
+	cnt::darr<ecs::Entity> ents;
+	cnt::darr<std::string> labels;
+	GAIA_FOR(100) {
+		auto e = wld.add();
+		labels.push_back(std::string("label_with_heap_storage_") + std::to_string(i));
+		wld.add<ColdLabel>(e, {labels.back()});
+		ents.push_back(e);
+	}
+
+	wld.del(ents[0]);
+	core::swap_erase(ents, 0);
+	core::swap_erase(labels, 0);
+	wld.add<Position>(ents[5]);
+	ents.push_back(wld.copy(ents[6]));
+	labels.push_back(labels[6]);
+
+	GAIA_EACH(ents) {
+		CHECK(wld.get<ColdLabel>(ents[i]).value == labels[i]);
+	}
+}
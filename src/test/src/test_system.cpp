@@ -667,6 +667,73 @@ TEST_CASE("System - phased systems respect intra-phase DependsOn postorder") {
 	}
 }
 
+TEST_CASE("System - phase fusion interleaves systems per chunk") {
+	auto run = [](bool fuse, bool conflicting) {
+		TestWorld twld;
+
+		// Two archetypes so every system visits at least two chunks
+		GAIA_FOR(4) {
+			auto e = wld.add();
+			wld.add<Position>(e, {(float)i, 0, 0});
+			if (i % 2 != 0)
+				wld.add<Rotation>(e, {0, 0, 0, 0});
+		}
+
+		const auto phase = wld.add();
+		wld.phase_fusion(phase, fuse);
+		CHECK(wld.phase_fusion(phase) == fuse);
+
+		cnt::darr<char> order;
+		float sum = 0.0f;
+		auto sysA = wld.system().phase(phase).all<Position&>();
+		if (conflicting)
+			sysA.writes<Scale>();
+		sysA.on_each([&](ecs::Iter& it) {
+			order.push_back('A');
+			auto posView = it.view_mut<Position>();
+			GAIA_EACH(it) posView[i].x += 1.0f;
+		});
+		auto sysB = wld.system().phase(phase).all<Position>();
+		if (conflicting)
+			sysB.reads<Scale>();
+		sysB.on_each([&](ecs::Iter&) {
+			order.push_back('B');
+		});
+		wld.system().phase(phase).all<Position>().on_each([&](const Position& p) {
+			sum += p.x;
+		});
+
+		wld.update();
+		CHECK(sum == doctest::Approx(10.0f));
+		return order;
+	};
+
+	{
+		const auto order = run(false, false);
+		REQUIRE(order.size() >= 4);
+		CHECK(order[0] == 'A');
+		CHECK(order[1] == 'A');
+		CHECK(order[order.size() - 1] == 'B');
+	}
+	{
+		// The callbacks run back to back on each chunk
+		const auto order = run(true, false);
+		REQUIRE(order.size() >= 4);
+		for (uint32_t i = 0; i < order.size(); i += 2) {
+			CHECK(order[i] == 'A');
+			CHECK(order[i + 1] == 'B');
+		}
+	}
+	{
+		// Conflicting explicit access declarations split the fused group
+		const auto order = run(true, true);
+		REQUIRE(order.size() >= 4);
+		CHECK(order[0] == 'A');
+		CHECK(order[1] == 'A');
+		CHECK(order[order.size() - 1] == 'B');
+	}
+}
+
 TEST_CASE("System - phase dependencies run deepest phases before their targets") {
 	cnt::darr<char> order;
 	TestWorld twld;